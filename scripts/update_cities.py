@@ -1,6 +1,7 @@
 #!/usr/bin/env python3
 import csv
 import io
+import math
 import os
 import zipfile
 import urllib.request
@@ -12,6 +13,10 @@ ADMIN1_URL = "https://download.geonames.org/export/dump/admin1CodesASCII.txt"
 
 OUT_H = "src/core/CitiesData.h"
 
+# Spatial index resolution (1-degree cells); must match CitiesManager.
+GRID_LAT_SIZE = 180
+GRID_LON_SIZE = 360
+
 
 def download_text(url):
     print(f"Fetching {url}...")
@@ -55,6 +60,61 @@ def format_pop(n_str):
     return str(n)
 
 
+def cell_of(lat, lon):
+    lat_idx = min(max(int(math.floor(lat + 90.0)), 0), GRID_LAT_SIZE - 1)
+    lon_idx = int(math.floor(lon + 180.0)) % GRID_LON_SIZE
+    return lat_idx * GRID_LON_SIZE + lon_idx
+
+
+def write_header(cities):
+    """Emit the cities sorted by 1-degree cell, with a CSR cell index.
+
+    Cities in cell c are g_CityData[g_CityCellStart[c] .. g_CityCellStart[c+1]).
+    Everything is constexpr, so CitiesManager needs no start-up work.
+    """
+    cities = [(round(lat, 4), round(lon, 4), name) for lat, lon, name in cities]
+    cities.sort(key=lambda c: (cell_of(c[0], c[1]), c[2]))
+    ncells = GRID_LAT_SIZE * GRID_LON_SIZE
+    starts = [0] * (ncells + 1)
+    for lat, lon, _ in cities:
+        starts[cell_of(lat, lon) + 1] += 1
+    for i in range(ncells):
+        starts[i + 1] += starts[i]
+    index_type = "uint16_t" if len(cities) < 65536 else "uint32_t"
+
+    print(f"Writing {len(cities)} cities to {OUT_H}...")
+    with open(OUT_H, "w", encoding="utf-8") as f:
+        f.write("#pragma once\n\n")
+        f.write("// Generated by scripts/update_cities.py. Do not edit.\n\n")
+        f.write("#include <cstddef>\n")
+        f.write("#include <cstdint>\n")
+        f.write("#include <string_view>\n\n")
+        f.write("struct StaticCityEntry {\n")
+        f.write("    float lat;\n")
+        f.write("    float lon;\n")
+        f.write("    std::string_view name;\n")
+        f.write("};\n\n")
+        f.write(f"constexpr int g_CityGridLat = {GRID_LAT_SIZE};\n")
+        f.write(f"constexpr int g_CityGridLon = {GRID_LON_SIZE};\n")
+        f.write(f"using CityIndex = {index_type};\n\n")
+        f.write("// Sorted by cell: (floor(lat + 90), floor(lon + 180)).\n")
+        f.write("static constexpr StaticCityEntry g_CityData[] = {\n")
+        for lat, lon, name in cities:
+            # Escape quotes in name
+            safe_name = name.replace("\\", "\\\\").replace('"', '\\"')
+            # Explicit byte length: no constexpr strlen over 33k names
+            nbytes = len(name.encode("utf-8"))
+            f.write(f'    {{{lat:.4f}f, {lon:.4f}f, {{"{safe_name}", {nbytes}}}}},\n')
+        f.write("};\n\n")
+        f.write(f"static constexpr size_t g_CityDataSize = {len(cities)};\n\n")
+        f.write("// First city of each cell; cell c spans [start[c], start[c + 1]).\n")
+        f.write(f"static constexpr CityIndex g_CityCellStart[{ncells + 1}] = {{\n")
+        for i in range(0, ncells + 1, 16):
+            row = ", ".join(str(v) for v in starts[i:i + 16])
+            f.write(f"    {row},\n")
+        f.write("};\n")
+
+
 def update():
     countries = load_countries()
     admins = load_admin1()
@@ -94,23 +154,7 @@ def update():
             except:
                 continue
 
-    print(f"Writing {len(cities)} cities to {OUT_H}...")
-    with open(OUT_H, "w", encoding="utf-8") as f:
-        f.write("#pragma once\n\n")
-        f.write("#include <cstddef>\n\n")
-        f.write("struct StaticCityEntry {\n")
-        f.write("    float lat;\n")
-        f.write("    float lon;\n")
-        f.write("    const char* name;\n")
-        f.write("};\n\n")
-        f.write("static const StaticCityEntry g_CityData[] = {\n")
-        for lat, lon, name in cities:
-            # Escape quotes in name
-            safe_name = name.replace('"', '\\"')
-            f.write(f'    {{{lat:.4f}f, {lon:.4f}f, "{safe_name}"}},\n')
-        f.write("};\n\n")
-        f.write(f"static const size_t g_CityDataSize = {len(cities)};\n")
-
+    write_header(cities)
 
 if __name__ == "__main__":
     if not os.path.exists("src/core"):
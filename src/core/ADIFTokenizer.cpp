@@ -0,0 +1,197 @@
+#include "ADIFTokenizer.h"
+
+#include <algorithm>
+
+// --- Tag lookup ---
+
+namespace {
+
+constexpr char upper(char c) { return (c >= 'a' && c <= 'z') ? c - 32 : c; }
+
+// FNV-1a over the upper-cased name. The seed was chosen so that every
+// known tag lands in its own slot; the static_assert below keeps it so.
+constexpr uint32_t kTagSeed = 14;
+constexpr size_t kTagSlots = 128;
+
+constexpr size_t tagSlot(std::string_view name) {
+  uint32_t h = kTagSeed;
+  for (char c : name) {
+    h ^= static_cast<unsigned char>(upper(c));
+    h *= 16777619u;
+  }
+  return h % kTagSlots;
+}
+
+struct TagName {
+  std::string_view name;
+  ADIFTag tag;
+};
+
+constexpr TagName kTagNames[] = {
+    {"CALL", ADIFTag::Call},
+    {"MODE", ADIFTag::Mode},
+    {"SUBMODE", ADIFTag::Submode},
+    {"BAND", ADIFTag::Band},
+    {"FREQ", ADIFTag::Freq},
+    {"QSO_DATE", ADIFTag::QsoDate},
+    {"TIME_ON", ADIFTag::TimeOn},
+    {"RST_SENT", ADIFTag::RstSent},
+    {"RST_RCVD", ADIFTag::RstRcvd},
+    {"NAME", ADIFTag::Name},
+    {"QTH", ADIFTag::Qth},
+    {"GRIDSQUARE", ADIFTag::Gridsquare},
+    {"COUNTRY", ADIFTag::Country},
+    {"CQZ", ADIFTag::Cqz},
+    {"ITUZ", ADIFTag::Ituz},
+    {"DXCC", ADIFTag::Dxcc},
+    {"CONTEST_ID", ADIFTag::ContestId},
+    {"SAT_NAME", ADIFTag::SatName},
+    {"SAT_MODE", ADIFTag::SatMode},
+    {"PROP_MODE", ADIFTag::PropMode},
+    {"TX_PWR", ADIFTag::TxPwr},
+    {"OPERATOR", ADIFTag::Operator},
+    {"STATION_CALLSIGN", ADIFTag::StationCallsign},
+    {"MY_GRIDSQUARE", ADIFTag::MyGridsquare},
+    {"COMMENT", ADIFTag::Comment},
+    {"NOTES", ADIFTag::Notes},
+    {"LAT", ADIFTag::Lat},
+    {"LON", ADIFTag::Lon},
+    {"ADIF_VER", ADIFTag::AdifVer},
+    {"EOH", ADIFTag::Eoh},
+    {"EOR", ADIFTag::Eor},
+};
+
+struct TagTable {
+  TagName slots[kTagSlots] = {};
+  bool perfect = true;
+
+  constexpr TagTable() {
+    for (const auto &t : kTagNames) {
+      size_t s = tagSlot(t.name);
+      if (!slots[s].name.empty())
+        perfect = false;
+      slots[s] = t;
+    }
+  }
+};
+
+constexpr TagTable kTagTable;
+static_assert(kTagTable.perfect, "ADIF tag hash collision: pick a new seed");
+
+bool equalsUpper(std::string_view name, std::string_view upperName) {
+  if (name.size() != upperName.size())
+    return false;
+  for (size_t i = 0; i < name.size(); ++i) {
+    if (upper(name[i]) != upperName[i])
+      return false;
+  }
+  return true;
+}
+
+bool isSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+} // namespace
+
+ADIFTag adifTagFromName(std::string_view name) {
+  const TagName &slot = kTagTable.slots[tagSlot(name)];
+  if (!slot.name.empty() && equalsUpper(name, slot.name))
+    return slot.tag;
+  return ADIFTag::Unknown;
+}
+
+bool ADIFRecord::empty() const {
+  for (const auto &f : fields) {
+    if (!f.empty())
+      return false;
+  }
+  return true;
+}
+
+// --- Tokenizer ---
+
+bool ADIFTokenizer::next(ADIFRecord &record) {
+  record.clear();
+  const size_t n = data_.size();
+
+  while (pos_ < n) {
+    size_t lt = data_.find('<', pos_);
+    if (lt == std::string_view::npos) {
+      pos_ = n;
+      break;
+    }
+
+    // Tag specifier: <NAME>, <NAME:LEN> or <NAME:LEN:TYPE>
+    size_t gt = data_.find('>', lt + 1);
+    if (gt == std::string_view::npos) {
+      pos_ = n;
+      break;
+    }
+    std::string_view spec = data_.substr(lt + 1, gt - lt - 1);
+    size_t colon = spec.find(':');
+    std::string_view name = spec.substr(0, colon);
+    // A stray '<' in free text: resume scanning just after it.
+    if (name.empty() || name.find('<') != std::string_view::npos) {
+      pos_ = lt + 1;
+      continue;
+    }
+    ADIFTag tag = adifTagFromName(name);
+
+    if (colon == std::string_view::npos) {
+      pos_ = gt + 1;
+      if (tag == ADIFTag::Eor) {
+        consumed_ = pos_;
+        return true;
+      }
+      if (tag == ADIFTag::Eoh) {
+        header_ = record;
+        record.clear();
+        consumed_ = pos_;
+        continue;
+      }
+      // Non-standard <NAME>value: the value runs up to the next tag.
+      size_t end = data_.find('<', pos_);
+      if (end == std::string_view::npos)
+        end = n;
+      size_t last = end;
+      while (last > pos_ && isSpace(data_[last - 1]))
+        --last;
+      if (tag != ADIFTag::Unknown)
+        record.fields[static_cast<size_t>(tag)] =
+            data_.substr(pos_, last - pos_);
+      pos_ = end;
+      continue;
+    }
+
+    // Length, ignoring any data type indicator after a second colon. It
+    // saturates at the input size: anything longer is clamped below anyway,
+    // and a run of digits in a corrupt file must not wrap size_t.
+    size_t len = 0;
+    bool digits = false;
+    for (size_t i = colon + 1; i < spec.size() && spec[i] != ':'; ++i) {
+      char c = spec[i];
+      if (c >= '0' && c <= '9') {
+        if (len <= n)
+          len = len * 10 + static_cast<size_t>(c - '0');
+        digits = true;
+      } else if (!isSpace(c)) {
+        digits = false;
+        break;
+      }
+    }
+    pos_ = gt + 1;
+    if (!digits)
+      continue;
+
+    // The value is exactly LEN bytes and may itself contain '<'.
+    len = std::min(len, n - pos_);
+    if (tag != ADIFTag::Unknown && tag != ADIFTag::Eor && tag != ADIFTag::Eoh)
+      record.fields[static_cast<size_t>(tag)] = data_.substr(pos_, len);
+    pos_ += len;
+  }
+
+  trailing_ = record;
+  record.clear();
+  return false;
+}
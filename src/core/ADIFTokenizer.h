@@ -0,0 +1,90 @@
+#pragma once
+
+#include "MappedFile.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// ADIF fields the application reads. Anything else is skipped by length.
+enum class ADIFTag : uint8_t {
+  Unknown,
+  Call,
+  Mode,
+  Submode,
+  Band,
+  Freq,
+  QsoDate,
+  TimeOn,
+  RstSent,
+  RstRcvd,
+  Name,
+  Qth,
+  Gridsquare,
+  Country,
+  Cqz,
+  Ituz,
+  Dxcc,
+  ContestId,
+  SatName,
+  SatMode,
+  PropMode,
+  TxPwr,
+  Operator,
+  StationCallsign,
+  MyGridsquare,
+  Comment,
+  Notes,
+  Lat,
+  Lon,
+  AdifVer,
+  Eoh,
+  Eor,
+  Count
+};
+
+// Case-insensitive tag name lookup via a perfect hash over the names above.
+ADIFTag adifTagFromName(std::string_view name);
+
+// One record (or the header). Fields point into the tokenizer's input.
+struct ADIFRecord {
+  std::array<std::string_view, static_cast<size_t>(ADIFTag::Count)> fields;
+
+  std::string_view operator[](ADIFTag tag) const {
+    return fields[static_cast<size_t>(tag)];
+  }
+  bool empty() const;
+  void clear() { fields.fill({}); }
+};
+
+// Single-pass ADIF tokenizer. Walks each <TAG:LEN[:TYPE]>value exactly
+// once and yields records as string_views into the input, so no field is
+// copied until the caller decides to keep it. Handles an optional header
+// (ended by <EOH>), lower/mixed-case tags, type indicators, values that
+// contain '<' or line breaks, and the non-standard <TAG>value form.
+class ADIFTokenizer {
+public:
+  explicit ADIFTokenizer(std::string_view data, size_t offset = 0)
+      : data_(data), pos_(offset), consumed_(offset) {}
+
+  // Next <EOR>-terminated record. Returns false at end of input; fields
+  // seen after the last <EOR> are then available from trailing().
+  bool next(ADIFRecord &record);
+
+  // Header fields, once the tokenizer has passed <EOH>.
+  const ADIFRecord &header() const { return header_; }
+
+  // Fields of an unterminated record at the end of input.
+  const ADIFRecord &trailing() const { return trailing_; }
+
+  // Byte offset just past the last complete record (or the header).
+  size_t consumed() const { return consumed_; }
+
+private:
+  std::string_view data_;
+  size_t pos_ = 0;
+  size_t consumed_ = 0;
+  ADIFRecord header_;
+  ADIFRecord trailing_;
+};
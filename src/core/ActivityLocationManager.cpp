@@ -1,17 +1,125 @@
 #include "ActivityLocationManager.h"
 #include "Logger.h"
+#include "MappedFile.h"
 #include "StringUtils.h"
 #include "WorkerService.h"
 #include <sstream>
 #include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <fstream>
 
-bool POTAPark::operator<(const POTAPark& other) const {
-    return std::strcmp(reference, other.reference) < 0;
+namespace {
+
+const char* const kKindNames[] = {"POTA", "SOTA"};
+const char* const kSnapshotFiles[] = {"pota_refs.bin", "sota_refs.bin"};
+
+// Snapshot file: this header, then `count` ActivityRef sorted by reference.
+// Native byte order; bump the version whenever the layout changes.
+struct SnapshotHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t count;
+    uint32_t reserved;
+    uint64_t sourceTag; // hash of the CSV's ETag/Last-Modified, or its bytes
+};
+static_assert(sizeof(SnapshotHeader) == 24, "SnapshotHeader is a file format");
+
+constexpr char kSnapshotMagic[4] = {'H', 'C', 'A', 'R'};
+constexpr uint32_t kSnapshotVersion = 1;
+
+uint64_t hashBytes(const std::string& data) {
+    uint64_t h = 1469598103934665603ull;
+    for (unsigned char c : data) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    return h;
 }
 
-bool SOTASummit::operator<(const SOTASummit& other) const {
+bool writeSnapshot(const std::filesystem::path& path,
+                   const std::vector<ActivityRef>& refs, uint64_t sourceTag) {
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+
+    SnapshotHeader hdr{};
+    std::memcpy(hdr.magic, kSnapshotMagic, sizeof(hdr.magic));
+    hdr.version = kSnapshotVersion;
+    hdr.count = static_cast<uint32_t>(refs.size());
+    hdr.sourceTag = sourceTag;
+
+    // Write aside and rename, so a mapped older snapshot stays intact
+    std::filesystem::path tmp = path;
+    tmp += ".tmp";
+    {
+        std::ofstream ofs(tmp, std::ios::binary | std::ios::trunc);
+        if (!ofs) return false;
+        ofs.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+        ofs.write(reinterpret_cast<const char*>(refs.data()),
+                  static_cast<std::streamsize>(refs.size() * sizeof(ActivityRef)));
+        if (!ofs) return false;
+    }
+    std::filesystem::rename(tmp, path, ec);
+    return !ec;
+}
+
+} // namespace
+
+// Immutable sorted table of references, either mapped from a snapshot file
+// or built in memory from a freshly parsed CSV.
+class ActivityLocationManager::RefTable {
+public:
+    RefTable(std::vector<ActivityRef> refs, uint64_t sourceTag)
+        : owned_(std::move(refs)), refs_(owned_.data()), count_(owned_.size()),
+          sourceTag_(sourceTag) {}
+
+    // nullptr if the file is missing or not a current-format snapshot
+    static std::unique_ptr<RefTable> open(const std::filesystem::path& path) {
+        auto file = std::make_unique<MappedFile>(path, MappedFile::Access::Random);
+        std::string_view data = file->data();
+        if (!file->isOpen() || data.size() < sizeof(SnapshotHeader)) return nullptr;
+
+        SnapshotHeader hdr;
+        std::memcpy(&hdr, data.data(), sizeof(hdr));
+        if (std::memcmp(hdr.magic, kSnapshotMagic, sizeof(hdr.magic)) != 0 ||
+            hdr.version != kSnapshotVersion ||
+            data.size() != sizeof(hdr) + size_t(hdr.count) * sizeof(ActivityRef)) {
+            LOG_W("ActivityLoc", "Ignoring stale or damaged snapshot {}", path.string());
+            return nullptr;
+        }
+
+        std::unique_ptr<RefTable> table(new RefTable({}, hdr.sourceTag));
+        table->refs_ = reinterpret_cast<const ActivityRef*>(data.data() + sizeof(hdr));
+        table->count_ = hdr.count;
+        table->file_ = std::move(file);
+        return table;
+    }
+
+    const ActivityRef* find(const std::string& ref) const {
+        char key[sizeof(ActivityRef::reference)] = {};
+        std::strncpy(key, ref.c_str(), sizeof(key) - 1);
+        const ActivityRef* end = refs_ + count_;
+        const ActivityRef* it = std::lower_bound(refs_, end, key,
+            [](const ActivityRef& r, const char* k) {
+                return std::strncmp(r.reference, k, sizeof(r.reference)) < 0;
+            });
+        if (it != end && std::strncmp(it->reference, key, sizeof(key)) == 0)
+            return it;
+        return nullptr;
+    }
+
+    size_t size() const { return count_; }
+    uint64_t sourceTag() const { return sourceTag_; }
+
+private:
+    std::unique_ptr<MappedFile> file_;
+    std::vector<ActivityRef> owned_;
+    const ActivityRef* refs_ = nullptr;
+    size_t count_ = 0;
+    uint64_t sourceTag_ = 0;
+};
+
+bool ActivityRef::operator<(const ActivityRef& other) const {
     return std::strcmp(reference, other.reference) < 0;
 }
 
@@ -20,17 +128,25 @@ ActivityLocationManager& ActivityLocationManager::getInstance() {
     return instance;
 }
 
+ActivityLocationManager::~ActivityLocationManager() = default;
+
 void ActivityLocationManager::init(NetworkManager& net, const std::filesystem::path& cacheDir) {
     cacheDir_ = cacheDir;
     net_ = &net;
     loadApiCache();
 
-    // Check for a pre-seeded summitslist.csv in configDir or cwd before hitting the network
+    bool fresh[kKinds];
+    for (int k = 0; k < kKinds; ++k)
+        fresh[k] = loadSnapshot(static_cast<Kind>(k));
+
+    // Without a SOTA snapshot, check for a pre-seeded summitslist.csv in
+    // configDir or cwd before hitting the network
     std::filesystem::path seedLocations[] = {
         cacheDir_.parent_path() / "summitslist.csv",
         std::filesystem::current_path() / "summitslist.csv"
     };
     for (const auto& p : seedLocations) {
+        if (current_[kSOTA].load()) break;
         std::error_code ec;
         if (std::filesystem::exists(p, ec)) {
             LOG_I("ActivityLoc", "Found pre-seeded SOTA CSV at {}", p.string());
@@ -39,49 +155,70 @@ void ActivityLocationManager::init(NetworkManager& net, const std::filesystem::p
                 std::string data((std::istreambuf_iterator<char>(ifs)),
                                  std::istreambuf_iterator<char>());
                 WorkerService::getInstance().submitTask([this, data = std::move(data)]() {
-                    parseSOTA(data);
-                });
+                    ingest(kSOTA, data, hashBytes(data));
+                }, TaskPriority::Background);
             }
             break;
         }
     }
 
-    fetchAndLoad(net);
+    for (int k = 0; k < kKinds; ++k) {
+        if (!fresh[k])
+            fetchAndLoad(net, static_cast<Kind>(k));
+    }
 }
 
-bool ActivityLocationManager::getPOTALocation(const std::string& ref, float& lat, float& lon) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (potaParks_.empty()) return false;
+std::filesystem::path ActivityLocationManager::snapshotPath(Kind kind) const {
+    return cacheDir_ / kSnapshotFiles[kind];
+}
 
-    POTAPark target;
-    std::strncpy(target.reference, ref.c_str(), sizeof(target.reference) - 1);
-    
-    auto it = std::lower_bound(potaParks_.begin(), potaParks_.end(), target);
-    if (it != potaParks_.end() && std::strcmp(it->reference, target.reference) == 0) {
-        lat = it->lat;
-        lon = it->lon;
-        return true;
+bool ActivityLocationManager::loadSnapshot(Kind kind) {
+    std::filesystem::path path = snapshotPath(kind);
+    auto table = RefTable::open(path);
+    if (!table) return false;
+
+    LOG_I("ActivityLoc", "Mapped {} {} references from snapshot", table->size(),
+          kKindNames[kind]);
+    publish(kind, std::move(table));
+
+    // The snapshot's mtime is when the CSV was last confirmed current
+    std::error_code ec;
+    auto mtime = std::filesystem::last_write_time(path, ec);
+    if (ec) return false;
+    return std::filesystem::file_time_type::clock::now() - mtime <
+           std::chrono::seconds(CSV_CACHE_SECONDS);
+}
+
+void ActivityLocationManager::publish(Kind kind, std::unique_ptr<RefTable> table) {
+    const RefTable* t = table.get();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tables_.push_back(std::move(table));
     }
-    return false;
+    current_[kind].store(t, std::memory_order_release);
+    if (kind == kPOTA) ready_ = true;
 }
 
-bool ActivityLocationManager::getSOTALocation(const std::string& ref, float& lat, float& lon) {
-    std::lock_guard<std::mutex> lock(mutex_);
+bool ActivityLocationManager::lookup(Kind kind, const std::string& ref,
+                                     float& lat, float& lon) const {
+    const RefTable* table = current_[kind].load(std::memory_order_acquire);
+    if (!table) return false;
+    const ActivityRef* r = table->find(ref);
+    if (!r) return false;
+    lat = r->lat;
+    lon = r->lon;
+    return true;
+}
 
-    if (!sotaSummits_.empty()) {
-        SOTASummit target;
-        std::strncpy(target.reference, ref.c_str(), sizeof(target.reference) - 1);
-        target.reference[sizeof(target.reference) - 1] = '\0';
+bool ActivityLocationManager::getPOTALocation(const std::string& ref, float& lat, float& lon) {
+    return lookup(kPOTA, ref, lat, lon);
+}
 
-        auto it = std::lower_bound(sotaSummits_.begin(), sotaSummits_.end(), target);
-        if (it != sotaSummits_.end() && std::strcmp(it->reference, target.reference) == 0) {
-            lat = it->lat;
-            lon = it->lon;
-            return true;
-        }
-    }
+bool ActivityLocationManager::getSOTALocation(const std::string& ref, float& lat, float& lon) {
+    if (lookup(kSOTA, ref, lat, lon)) return true;
 
     // Fallback: per-summit API cache (populated by resolveSummitAsync)
+    std::lock_guard<std::mutex> lock(mutex_);
     auto cit = sotaApiCache_.find(ref);
     if (cit != sotaApiCache_.end()) {
         lat = cit->second.first;
@@ -92,28 +229,44 @@ bool ActivityLocationManager::getSOTALocation(const std::string& ref, float& lat
     return false;
 }
 
-void ActivityLocationManager::fetchAndLoad(NetworkManager& net) {
-    // Fetch POTA
-    net.fetchAsync(POTA_CSV_URL, [this](std::string data) {
+void ActivityLocationManager::fetchAndLoad(NetworkManager& net, Kind kind) {
+    const char* url = kind == kPOTA ? POTA_CSV_URL : SOTA_CSV_URL;
+    net.fetchAsync(url, [this, kind, url](std::string data) {
         if (data.empty()) {
-            LOG_E("ActivityLoc", "Failed to fetch POTA CSV");
+            LOG_E("ActivityLoc", "Failed to fetch {} CSV", kKindNames[kind]);
             return;
         }
-        WorkerService::getInstance().submitTask([this, data = std::move(data)]() {
-            parsePOTA(data);
-        });
-    }, 86400 * 7); // Cache for 7 days
+        std::string validator = net_->cacheValidator(url);
+        uint64_t tag = validator.empty() ? hashBytes(data) : hashBytes(validator);
+        WorkerService::getInstance().submitTask([this, kind, tag, data = std::move(data)]() {
+            ingest(kind, data, tag);
+        }, TaskPriority::Background);
+    }, CSV_CACHE_SECONDS);
+}
 
-    // Fetch SOTA
-    net.fetchAsync(SOTA_CSV_URL, [this](std::string data) {
-        if (data.empty()) {
-            LOG_E("ActivityLoc", "Failed to fetch SOTA CSV");
-            return;
-        }
-        WorkerService::getInstance().submitTask([this, data = std::move(data)]() {
-            parseSOTA(data);
-        });
-    }, 86400 * 7);
+void ActivityLocationManager::ingest(Kind kind, const std::string& csvData,
+                                     uint64_t sourceTag) {
+    std::lock_guard<std::mutex> ingestLock(ingestMutex_);
+    std::filesystem::path path = snapshotPath(kind);
+
+    const RefTable* current = current_[kind].load(std::memory_order_acquire);
+    if (current && current->sourceTag() == sourceTag) {
+        LOG_I("ActivityLoc", "{} list unchanged, keeping snapshot", kKindNames[kind]);
+        std::error_code ec;
+        std::filesystem::last_write_time(
+            path, std::filesystem::file_time_type::clock::now(), ec);
+        return;
+    }
+
+    std::vector<ActivityRef> refs =
+        kind == kPOTA ? parsePOTA(csvData) : parseSOTA(csvData);
+    if (refs.empty()) return;
+
+    if (!writeSnapshot(path, refs, sourceTag))
+        LOG_W("ActivityLoc", "Could not write snapshot {}", path.string());
+
+    LOG_I("ActivityLoc", "Loaded {} {} references", refs.size(), kKindNames[kind]);
+    publish(kind, std::make_unique<RefTable>(std::move(refs), sourceTag));
 }
 
 // Lightweight CSV helper: splits a line into fields, handling quotes
@@ -136,20 +289,20 @@ static std::vector<std::string> splitCSVLine(const std::string& line) {
     return fields;
 }
 
-void ActivityLocationManager::parsePOTA(const std::string& data) {
+std::vector<ActivityRef> ActivityLocationManager::parsePOTA(const std::string& data) {
     LOG_I("ActivityLoc", "Parsing POTA data...");
-    std::vector<POTAPark> parks;
+    std::vector<ActivityRef> parks;
     std::stringstream ss(data);
     std::string line;
     
     // Header: "reference","name","active","entityId","locationDesc","latitude","longitude","grid"
-    if (!std::getline(ss, line)) return;
+    if (!std::getline(ss, line)) return parks;
 
     while (std::getline(ss, line)) {
         if (line.empty()) continue;
         auto fields = splitCSVLine(line);
         if (fields.size() >= 7) {
-            POTAPark p;
+            ActivityRef p;
             std::strncpy(p.reference, fields[0].c_str(), sizeof(p.reference) - 1);
             p.reference[sizeof(p.reference) - 1] = '\0';
             p.lat = StringUtils::safe_stof(fields[5]);
@@ -159,18 +312,12 @@ void ActivityLocationManager::parsePOTA(const std::string& data) {
     }
 
     std::sort(parks.begin(), parks.end());
-    
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        potaParks_ = std::move(parks);
-    }
-    LOG_I("ActivityLoc", "Loaded {} POTA parks", potaParks_.size());
-    ready_ = true;
+    return parks;
 }
 
-void ActivityLocationManager::parseSOTA(const std::string& data) {
+std::vector<ActivityRef> ActivityLocationManager::parseSOTA(const std::string& data) {
     LOG_I("ActivityLoc", "Parsing SOTA data...");
-    std::vector<SOTASummit> summits;
+    std::vector<ActivityRef> summits;
     std::stringstream ss(data);
     std::string line;
 
@@ -178,14 +325,14 @@ void ActivityLocationManager::parseSOTA(const std::string& data) {
     //   Line 1: "SOTA Summits List (Date=...)"
     //   Line 2: SummitCode,AssociationName,RegionName,SummitName,AltM,AltFt,GridRef1,GridRef2,Longitude,Latitude,...
     // Columns: [0]=SummitCode [6]=GridRef1 [7]=GridRef2 [8]=Longitude [9]=Latitude
-    if (!std::getline(ss, line)) return; // title line
-    if (!std::getline(ss, line)) return; // column header line
+    if (!std::getline(ss, line)) return summits; // title line
+    if (!std::getline(ss, line)) return summits; // column header line
 
     while (std::getline(ss, line)) {
         if (line.empty()) continue;
         auto fields = splitCSVLine(line);
         if (fields.size() >= 10) {
-            SOTASummit s;
+            ActivityRef s;
             std::strncpy(s.reference, fields[0].c_str(), sizeof(s.reference) - 1);
             s.reference[sizeof(s.reference) - 1] = '\0';
             s.lat = StringUtils::safe_stof(fields[9]);  // Latitude column
@@ -195,12 +342,7 @@ void ActivityLocationManager::parseSOTA(const std::string& data) {
     }
 
     std::sort(summits.begin(), summits.end());
-
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        sotaSummits_ = std::move(summits);
-    }
-    LOG_I("ActivityLoc", "Loaded {} SOTA summits", sotaSummits_.size());
+    return summits;
 }
 
 void ActivityLocationManager::resolveSummitAsync(const std::string& ref) {
@@ -249,7 +391,8 @@ void ActivityLocationManager::resolveSummitAsync(const std::string& ref) {
         }
 
         // Persist cache asynchronously
-        WorkerService::getInstance().submitTask([this]() { saveApiCache(); });
+        WorkerService::getInstance().submitTask([this]() { saveApiCache(); },
+                                                TaskPriority::Background);
     }, 86400 * 30); // Cache API responses for 30 days
 }
 
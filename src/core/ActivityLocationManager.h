@@ -3,35 +3,33 @@
 #include "../network/NetworkManager.h"
 #include <string>
 #include <vector>
+#include <memory>
 #include <mutex>
 #include <atomic>
+#include <cstdint>
 #include <unordered_map>
 #include <unordered_set>
 
-struct POTAPark {
+// One park or summit. Fixed layout: a snapshot file is a header followed by
+// an array of these, sorted by reference.
+struct ActivityRef {
     char reference[16];
     float lat;
     float lon;
 
-    bool operator<(const POTAPark& other) const;
-};
-
-struct SOTASummit {
-    char reference[16];
-    float lat;
-    float lon;
-
-    bool operator<(const SOTASummit& other) const;
+    bool operator<(const ActivityRef& other) const;
 };
+static_assert(sizeof(ActivityRef) == 24, "ActivityRef is a file format");
 
 class ActivityLocationManager {
 public:
     static ActivityLocationManager& getInstance();
 
-    // Initialization: kicks off background fetch if needed
+    // Initialization: maps the cached snapshots and kicks off a background
+    // refresh when they are stale
     void init(NetworkManager& net, const std::filesystem::path& cacheDir);
 
-    // Coordinate lookups (thread-safe)
+    // Coordinate lookups (thread-safe, lock-free for the bulk tables)
     bool getPOTALocation(const std::string& ref, float& lat, float& lon);
     bool getSOTALocation(const std::string& ref, float& lat, float& lon);
 
@@ -41,19 +39,34 @@ public:
     bool isReady() const { return ready_.load(); }
 
 private:
+    enum Kind { kPOTA = 0, kSOTA = 1, kKinds };
+    class RefTable;
+
     ActivityLocationManager() = default;
-    ~ActivityLocationManager() = default;
+    ~ActivityLocationManager();
     ActivityLocationManager(const ActivityLocationManager&) = delete;
     ActivityLocationManager& operator=(const ActivityLocationManager&) = delete;
 
-    void fetchAndLoad(NetworkManager& net);
-    void parsePOTA(const std::string& csvData);
-    void parseSOTA(const std::string& csvData);
+    // Map <cache>/<kind>.bin. True if it exists and is recent enough that
+    // the CSV need not be checked this run.
+    bool loadSnapshot(Kind kind);
+    void fetchAndLoad(NetworkManager& net, Kind kind);
+    // Parse a CSV (unless sourceTag matches the table already loaded),
+    // write the snapshot and publish the result.
+    void ingest(Kind kind, const std::string& csvData, uint64_t sourceTag);
+    void publish(Kind kind, std::unique_ptr<RefTable> table);
+    bool lookup(Kind kind, const std::string& ref, float& lat, float& lon) const;
+    std::filesystem::path snapshotPath(Kind kind) const;
+
+    static std::vector<ActivityRef> parsePOTA(const std::string& csvData);
+    static std::vector<ActivityRef> parseSOTA(const std::string& csvData);
     void loadApiCache();
     void saveApiCache();
 
-    std::vector<POTAPark> potaParks_;
-    std::vector<SOTASummit> sotaSummits_;
+    // Current table per kind. Readers only load the pointer; tables are
+    // immutable and kept alive in tables_ until shutdown (a handful per run).
+    std::atomic<const RefTable*> current_[kKinds] = {};
+    std::vector<std::unique_ptr<RefTable>> tables_;
 
     // Per-summit API cache (fallback for summits not in bulk CSV)
     std::unordered_map<std::string, std::pair<float,float>> sotaApiCache_;
@@ -61,9 +74,11 @@ private:
 
     NetworkManager* net_ = nullptr;
     mutable std::mutex mutex_;
+    std::mutex ingestMutex_; // one rebuild (and snapshot write) at a time
     std::atomic<bool> ready_{false};
     std::filesystem::path cacheDir_;
 
+    static constexpr int CSV_CACHE_SECONDS = 86400 * 7;
     static constexpr const char* POTA_CSV_URL = "https://pota.app/all_parks_ext.csv";
     static constexpr const char* SOTA_CSV_URL = "https://storage.sota.org.uk/summitslist.csv";
     static constexpr const char* SOTA_SUMMIT_API = "https://api2.sota.org.uk/api/summits/";
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -9,6 +10,19 @@ struct AuroraDataPoint {
   std::chrono::system_clock::time_point timestamp;
 };
 
+// NOAA OVATION aurora probability field. Cells are 1 degree, longitude
+// 0..359 east by latitude -90..90; row 0 is the south pole.
+struct AuroraGrid {
+  static constexpr int W = 360;
+  static constexpr int H = 181;
+
+  std::vector<float> percent = std::vector<float>(W * H, 0.0f);
+  float maxPercent = 0.0f;
+  std::chrono::system_clock::time_point fetched{};
+
+  float at(int lon, int lat) const { return percent[(lat + 90) * W + lon]; }
+};
+
 class AuroraHistoryStore {
 public:
   static constexpr int MAX_POINTS = 48; // 24 hours at 30-min intervals
@@ -45,7 +59,20 @@ public:
     return !history_.empty();
   }
 
+  // Latest OVATION grid. Published as an immutable snapshot so the map can
+  // detect new data by pointer comparison.
+  void setGrid(std::shared_ptr<const AuroraGrid> grid) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    grid_ = std::move(grid);
+  }
+
+  std::shared_ptr<const AuroraGrid> gridSnapshot() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return grid_;
+  }
+
 private:
   mutable std::mutex mutex_;
   std::vector<AuroraDataPoint> history_;
+  std::shared_ptr<const AuroraGrid> grid_;
 };
@@ -0,0 +1,116 @@
+#include "CallbookCache.h"
+#include "DatabaseManager.h"
+#include "StringUtils.h"
+
+#include <cstdlib>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace {
+
+std::string sqlEscape(const std::string &s) {
+  std::string out;
+  out.reserve(s.size());
+  for (char c : s) {
+    if (c == '\'')
+      out += "''";
+    else
+      out += c;
+  }
+  return out;
+}
+
+int64_t nowSeconds() {
+  return std::chrono::duration_cast<std::chrono::seconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+json toJson(const CallbookData &d) {
+  return {{"name", d.name},       {"address", d.address},
+          {"city", d.city},       {"state", d.state},
+          {"zip", d.zip},         {"country", d.country},
+          {"grid", d.grid},       {"lat", d.lat},
+          {"lon", d.lon},         {"lotw", d.lotw},
+          {"eqsl", d.eqsl},       {"bureau", d.bureau},
+          {"bioUrl", d.bioUrl},   {"imageUrl", d.imageUrl}};
+}
+
+void fromJson(const json &j, CallbookData &d) {
+  d.name = j.value("name", "");
+  d.address = j.value("address", "");
+  d.city = j.value("city", "");
+  d.state = j.value("state", "");
+  d.zip = j.value("zip", "");
+  d.country = j.value("country", "");
+  d.grid = j.value("grid", "");
+  d.lat = j.value("lat", 0.0f);
+  d.lon = j.value("lon", 0.0f);
+  d.lotw = j.value("lotw", false);
+  d.eqsl = j.value("eqsl", false);
+  d.bureau = j.value("bureau", "");
+  d.bioUrl = j.value("bioUrl", "");
+  d.imageUrl = j.value("imageUrl", "");
+}
+
+} // namespace
+
+namespace CallbookCache {
+
+Hit get(const std::string &call, const std::string &source,
+        std::chrono::seconds ttl, std::chrono::seconds negativeTtl,
+        CallbookData &out) {
+  std::string sql = "SELECT found, fetched_at, data FROM callbook WHERE "
+                    "callsign = '" +
+                    sqlEscape(call) + "' AND source = '" + sqlEscape(source) +
+                    "'";
+
+  Hit hit = Hit::Miss;
+  int64_t now = nowSeconds();
+  DatabaseManager::instance().query(
+      sql, [&](const DatabaseManager::Row &row) {
+        if (row.size() < 3)
+          return false;
+        bool found = StringUtils::safe_stoi(row[0]) != 0;
+        int64_t age = now - std::strtoll(row[1].c_str(), nullptr, 10);
+        if (age > (found ? ttl : negativeTtl).count())
+          return false;
+        if (!found) {
+          hit = Hit::NotFound;
+          return false;
+        }
+        try {
+          fromJson(json::parse(row[2]), out);
+          out.callsign = call;
+          out.source = source;
+          hit = Hit::Found;
+        } catch (...) {
+          // Unreadable row: treat as a miss and let the fetch overwrite it
+        }
+        return false;
+      });
+  return hit;
+}
+
+void put(const std::string &call, const std::string &source,
+         const CallbookData *data) {
+  std::string sql =
+      "INSERT OR REPLACE INTO callbook (callsign, source, found, fetched_at, "
+      "data) VALUES ('" +
+      sqlEscape(call) + "', '" + sqlEscape(source) + "', " +
+      (data ? "1" : "0") + ", " + std::to_string(nowSeconds()) + ", '" +
+      (data ? sqlEscape(toJson(*data).dump(-1, ' ', false,
+                                           json::error_handler_t::replace))
+            : std::string()) +
+      "')";
+  DatabaseManager::instance().exec(sql);
+}
+
+void prune(std::chrono::seconds maxAge) {
+  DatabaseManager::instance().exec(
+      "DELETE FROM callbook WHERE fetched_at < " +
+      std::to_string(nowSeconds() - maxAge.count()));
+}
+
+} // namespace CallbookCache
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "CallbookData.h"
+
+#include <chrono>
+#include <string>
+
+// Persistent per-source callbook results, kept in the shared SQLite
+// database so a call looked up once is not fetched again until its TTL
+// runs out. "Not found" answers are cached too, with their own TTL.
+namespace CallbookCache {
+
+enum class Hit { Miss, Found, NotFound };
+
+// Fresh cached answer from source for an (upper-case) callsign.
+Hit get(const std::string &call, const std::string &source,
+        std::chrono::seconds ttl, std::chrono::seconds negativeTtl,
+        CallbookData &out);
+
+// Record an answer; data == nullptr records "not found".
+void put(const std::string &call, const std::string &source,
+         const CallbookData *data);
+
+// Drop entries older than maxAge.
+void prune(std::chrono::seconds maxAge);
+
+} // namespace CallbookCache
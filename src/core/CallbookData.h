@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mutex>
 #include <string>
 
 struct CallbookData {
@@ -29,9 +30,16 @@ struct CallbookData {
 
 class CallbookStore {
 public:
-  const CallbookData &get() const { return data_; }
-  void set(const CallbookData &d) { data_ = d; }
+  CallbookData get() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return data_;
+  }
+  void set(const CallbookData &d) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    data_ = d;
+  }
 
 private:
+  mutable std::mutex mutex_;
   CallbookData data_;
 };
@@ -1,25 +1,21 @@
 #pragma once
 
-#include <mutex>
-#include <string>
-#include <vector>
+#include <string_view>
 
+// Nearest-city lookup over the generated CitiesData.h. The spatial index
+// (cities sorted by 1-degree cell, plus per-cell offsets) is compile-time
+// data, so there is nothing to build at start-up and lookups need no lock.
 class CitiesManager {
 public:
   static CitiesManager &getInstance();
 
-  void init();
+  // Nearest city by great-circle distance, if one lies within kMaxMiles.
+  // Returns an empty view if none is found. The view refers to static data.
+  std::string_view findNearest(float lat, float lon,
+                               float *dist_miles = nullptr) const;
 
-  // Find name of nearest city within a reasonable distance (e.g. 50km)
-  // Returns empty string if none found.
-  std::string findNearest(float lat, float lon, float *dist_miles = nullptr);
+  static constexpr float kMaxMiles = 175.0f;
 
 private:
   CitiesManager() = default;
-  std::mutex mutex_;
-  bool initialized_ = false;
-
-  // Spatial grid for fast lookups. Grid is 180x360 cells (1-degree resolution).
-  // Each cell contains a vector of indices into the g_CityData array.
-  std::vector<std::vector<std::vector<size_t>>> grid_;
 };
@@ -157,6 +157,8 @@ bool ConfigManager::load(AppConfig &config) const {
         config.propOverlay = PropOverlayType::Muf;
       else if (po == "voacap")
         config.propOverlay = PropOverlayType::Voacap;
+      else if (po == "drap")
+        config.propOverlay = PropOverlayType::Drap;
       else
         config.propOverlay = PropOverlayType::None;
     } else if (ap.contains("show_muf_rt")) {
@@ -170,6 +172,7 @@ bool ConfigManager::load(AppConfig &config) const {
     config.propPower = ap.value("prop_power", 100);
     config.mufRtOpacity = ap.value("muf_rt_opacity", 40);
     config.showSatTrack = ap.value("show_sat_track", true);
+    config.showAurora = ap.value("show_aurora", true);
     config.qrzUsername = ap.value("qrz_username", "");
     config.qrzPassword = ap.value("qrz_password", "");
   }
@@ -201,6 +204,11 @@ bool ConfigManager::load(AppConfig &config) const {
     config.corsProxyUrl = n.value("cors_proxy_url", config.corsProxyUrl);
   }
 
+  // Memory
+  if (json.contains("memory")) {
+    config.vramBudgetMb = json["memory"].value("vram_budget_mb", 0);
+  }
+
   // Brightness
   if (json.contains("brightness")) {
     auto &br = json["brightness"];
@@ -309,6 +317,7 @@ bool ConfigManager::load(AppConfig &config) const {
     config.rotatorHost = r.value("host", "");
     config.rotatorPort = r.value("port", 4533);
     config.rotatorAutoTrack = r.value("auto_track", false);
+    config.rotatorPollMs = r.value("poll_ms", 250);
   }
 
   // Rig (Hamlib rigctld)
@@ -317,6 +326,7 @@ bool ConfigManager::load(AppConfig &config) const {
     config.rigHost = r.value("host", "");
     config.rigPort = r.value("port", 4532);
     config.rigAutoTune = r.value("auto_tune", true);
+    config.rigPollMs = r.value("poll_ms", 250);
   }
 
   // Require at least a callsign to consider config valid
@@ -355,6 +365,8 @@ bool ConfigManager::save(const AppConfig &config) const {
     po = "muf";
   else if (config.propOverlay == PropOverlayType::Voacap)
     po = "voacap";
+  else if (config.propOverlay == PropOverlayType::Drap)
+    po = "drap";
   json["appearance"]["prop_overlay"] = po;
   json["appearance"]["prop_band"] = config.propBand;
   json["appearance"]["prop_mode"] = config.propMode;
@@ -364,6 +376,7 @@ bool ConfigManager::save(const AppConfig &config) const {
       (config.propOverlay == PropOverlayType::Muf);
   json["appearance"]["muf_rt_opacity"] = config.mufRtOpacity;
   json["appearance"]["show_sat_track"] = config.showSatTrack;
+  json["appearance"]["show_aurora"] = config.showAurora;
   json["appearance"]["qrz_username"] = config.qrzUsername;
   json["appearance"]["qrz_password"] = config.qrzPassword;
 
@@ -381,14 +394,17 @@ bool ConfigManager::save(const AppConfig &config) const {
   json["power"]["gps_enabled"] = config.gpsEnabled;
 
   json["network"]["cors_proxy_url"] = config.corsProxyUrl;
+  json["memory"]["vram_budget_mb"] = config.vramBudgetMb;
 
   json["rotator"]["host"] = config.rotatorHost;
   json["rotator"]["port"] = config.rotatorPort;
   json["rotator"]["auto_track"] = config.rotatorAutoTrack;
+  json["rotator"]["poll_ms"] = config.rotatorPollMs;
 
   json["rig"]["host"] = config.rigHost;
   json["rig"]["port"] = config.rigPort;
   json["rig"]["auto_tune"] = config.rigAutoTune;
+  json["rig"]["poll_ms"] = config.rigPollMs;
 
   auto saveRotation = [&](const std::string &key,
                           const std::vector<WidgetType> &vec) {
@@ -9,7 +9,7 @@
 #include <SDL.h>
 
 enum class LiveSpotSource { PSK, RBN, WSPR };
-enum class PropOverlayType { None, Muf, Voacap, Reliability, Toa };
+enum class PropOverlayType { None, Muf, Voacap, Reliability, Toa, Drap };
 enum class WeatherOverlayType { None, Clouds, WxMb };
 
 struct AppConfig {
@@ -35,6 +35,7 @@ struct AppConfig {
       int mufRtOpacity = 40; // percentage
       bool showSatTrack = true; // Show satellite ground track line on world map
       bool showBeacons = true; // Show NCDXF beacons on world map
+      bool showAurora = true;  // Show the aurora oval on world map
       
       // Pane widget selection (top bar panes 1–3)  // Pane widget selection (rotation sets)
   std::vector<WidgetType> pane1Rotation = {WidgetType::SOLAR};
@@ -78,11 +79,13 @@ struct AppConfig {
   std::string rotatorHost = "";  // Empty = disabled
   int rotatorPort = 4533;        // Default Hamlib rotctld port
   bool rotatorAutoTrack = false; // Auto-track satellite when enabled
+  int rotatorPollMs = 250;       // Azimuth/elevation poll interval
 
   // Rig (Hamlib rigctld)
   std::string rigHost = ""; // Empty = disabled
   int rigPort = 4532;       // Default Hamlib rigctld port
   bool rigAutoTune = true;  // Auto-tune when clicking DX spots
+  int rigPollMs = 250;      // Frequency/mode/PTT poll interval
 
   // QRZ
   std::string qrzUsername;
@@ -109,6 +112,11 @@ struct AppConfig {
   // Security
   bool gpsEnabled = false;
 
+  // Memory
+  // Texture VRAM budget in MB; least recently used re-creatable textures are
+  // evicted above it. 0 = auto (capped on KMSDRM, unlimited elsewhere).
+  int vramBudgetMb = 0;
+
   // Network (WASM)
   // CORS proxy prefix prepended to all external URLs in the WASM build.
   // Default "/proxy/" works with the bundled serve.py and the nginx snippet.
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -14,6 +15,7 @@ struct DXClusterSpot {
 
   int txDxcc = 0;
   int rxDxcc = 0;
+  uint8_t worked = 0; // WorkedFlags at the time the spot arrived
 
   std::string mode;
   double freqKhz = 0.0;
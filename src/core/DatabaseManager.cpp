@@ -46,6 +46,14 @@ bool DatabaseManager::init(const std::filesystem::path &dbPath) {
     );
     CREATE INDEX IF NOT EXISTS idx_dx_spotted_at ON dx_spots(spotted_at);
     CREATE UNIQUE INDEX IF NOT EXISTS idx_dx_unique ON dx_spots(tx_call, rx_call, freq_khz, spotted_at);
+    CREATE TABLE IF NOT EXISTS callbook (
+      callsign TEXT NOT NULL,
+      source TEXT NOT NULL,
+      found INTEGER NOT NULL,
+      fetched_at INTEGER NOT NULL,
+      data TEXT,
+      PRIMARY KEY (callsign, source)
+    );
   )";
 
   char *errMsg = nullptr;
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// NOAA D-Region Absorption Prediction. Each cell is the highest frequency
+// (MHz) suffering 1 dB of absorption on a vertical pass through the D
+// region; 0 means no significant absorption. Cells are on a regular
+// lat/lon lattice: row 0 is the northernmost latitude, column 0 the
+// westernmost longitude.
+struct DrapGrid {
+  int w = 0;
+  int h = 0;
+  float lat0 = 0.0f;    // latitude of row 0
+  float latStep = 0.0f; // negative, rows run south
+  float lon0 = 0.0f;    // longitude of column 0
+  float lonStep = 0.0f;
+  std::vector<float> mhz; // h rows of w
+  float maxMhz = 0.0f;
+  std::chrono::system_clock::time_point fetched{};
+
+  float cell(int row, int col) const { return mhz[row * w + col]; }
+
+  // Bilinear sample. Latitude clamps at the outermost rows, longitude wraps
+  // across the date line.
+  float at(double lat, double lon) const {
+    if (w < 2 || h < 2)
+      return 0.0f;
+    double fy = std::clamp((lat - lat0) / latStep, 0.0, double(h - 1));
+    double fx = (lon - lon0) / lonStep;
+    fx -= std::floor(fx / w) * w;
+
+    int y0 = std::min(static_cast<int>(fy), h - 2);
+    int x0 = std::min(static_cast<int>(fx), w - 1);
+    int x1 = (x0 + 1) % w;
+    float ty = static_cast<float>(fy - y0);
+    float tx = static_cast<float>(fx - x0);
+
+    float top = cell(y0, x0) + (cell(y0, x1) - cell(y0, x0)) * tx;
+    float bot = cell(y0 + 1, x0) + (cell(y0 + 1, x1) - cell(y0 + 1, x0)) * tx;
+    return top + (bot - top) * ty;
+  }
+};
+
+class DrapStore {
+public:
+  // Published as an immutable snapshot so consumers can detect new data by
+  // pointer comparison.
+  void setGrid(std::shared_ptr<const DrapGrid> grid) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    grid_ = std::move(grid);
+  }
+
+  std::shared_ptr<const DrapGrid> gridSnapshot() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return grid_;
+  }
+
+private:
+  mutable std::mutex mutex_;
+  std::shared_ptr<const DrapGrid> grid_;
+};
@@ -0,0 +1,182 @@
+#include "FetchScheduler.h"
+#include "Logger.h"
+
+#include <algorithm>
+
+FetchScheduler::~FetchScheduler() {
+  if (!state_)
+    return;
+  for (const auto &job : jobs_)
+    state_->fetchJobs.erase(job.name);
+}
+
+void FetchScheduler::add(const std::string &name,
+                         std::chrono::seconds interval, Priority priority,
+                         Task task, std::chrono::seconds jitter,
+                         const std::string &healthKey) {
+  Job job;
+  job.name = name;
+  job.interval = interval;
+  // Keep the jitter well inside the interval so runs never bunch up.
+  job.jitter = std::min<Clock::duration>(jitter, interval / 4);
+  job.priority = priority;
+  job.task = std::move(task);
+  job.healthKey = healthKey;
+  job.nextRun = Clock::now();
+  jobs_.push_back(std::move(job));
+  publish(jobs_.back());
+}
+
+void FetchScheduler::tick() {
+  auto now = Clock::now();
+
+  for (auto &job : jobs_) {
+    if (job.outcome)
+      checkOutcome(job, now);
+  }
+
+  for (auto &job : jobs_) {
+    if (job.priority == Priority::Critical && now >= job.nextRun)
+      run(job, now);
+  }
+
+  // At most one background job per spacing interval, most overdue first.
+  if (now - lastBackground_ < kBackgroundSpacing)
+    return;
+  Job *due = nullptr;
+  for (auto &job : jobs_) {
+    if (job.priority == Priority::Background && now >= job.nextRun &&
+        (!due || job.nextRun < due->nextRun))
+      due = &job;
+  }
+  if (due) {
+    run(*due, now);
+    lastBackground_ = now;
+  }
+}
+
+void FetchScheduler::run(Job &job, Clock::time_point now) {
+  auto outcome = std::make_shared<NetworkManager::Outcome>();
+  {
+    NetworkManager::OutcomeScope scope(outcome);
+    job.task();
+  }
+  job.taskTime = Clock::now() - now;
+
+  job.lastRun = now;
+  job.lastRunWall = std::chrono::system_clock::now();
+  job.nextRun = now + job.interval + jitterOffset(job);
+  job.outcome = std::move(outcome);
+
+  LOG_D("FetchScheduler", "{} started {} request(s)", job.name,
+        job.outcome->started.load());
+  // Jobs that only hit the cache or start nothing are done already.
+  checkOutcome(job, Clock::now());
+  publish(job);
+}
+
+void FetchScheduler::checkOutcome(Job &job, Clock::time_point now) {
+  const NetworkManager::Outcome &net = *job.outcome;
+  bool netDone = net.pending.load(std::memory_order_acquire) == 0;
+  int started = net.started.load();
+  int failed = net.failed.load();
+
+  ServiceSlot::Snapshot status;
+  bool reported = false;
+  bool healthDone = true;
+  if (state_ && !job.healthKey.empty()) {
+    if (const ServiceSlot *slot = state_->services.find(job.healthKey))
+      status = slot->snapshot();
+    reported = status.updates > 0;
+    healthDone =
+        reported && status.ok && status.lastSuccess >= job.lastRunWall;
+  }
+
+  if (netDone && failed > 0) {
+    fail(job, now,
+         std::to_string(failed) + " of " + std::to_string(started) +
+             " request(s) failed");
+  } else if (netDone && healthDone) {
+    // Measured to the last response, or to the service's own report.
+    Clock::duration took = job.taskTime;
+    if (started > 0)
+      took = Clock::time_point(Clock::duration(net.lastDone.load())) -
+             job.lastRun;
+    if (!job.healthKey.empty())
+      took = std::max(took, std::chrono::duration_cast<Clock::duration>(
+                                status.lastSuccess - job.lastRunWall));
+    succeed(job, took,
+            job.healthKey.empty() ? std::chrono::system_clock::now()
+                                  : status.lastSuccess);
+  } else if (now - job.lastRun >= kHealthGrace) {
+    if (reported && !status.ok) {
+      fail(job, now, status.message);
+    } else {
+      // No news within the grace period: nothing to back off from.
+      LOG_D("FetchScheduler", "{} has not completed after {} s", job.name,
+            std::chrono::duration_cast<std::chrono::seconds>(kHealthGrace)
+                .count());
+      job.failures = 0;
+      job.outcome.reset();
+    }
+  } else {
+    return;
+  }
+  publish(job);
+}
+
+void FetchScheduler::succeed(Job &job, Clock::duration took,
+                             std::chrono::system_clock::time_point at) {
+  job.outcome.reset();
+  job.failures = 0;
+  job.lastSuccess = at;
+  job.lastDurationMs =
+      std::chrono::duration<double, std::milli>(took).count();
+  LOG_D("FetchScheduler", "{} finished in {:.1f} ms", job.name,
+        job.lastDurationMs);
+}
+
+void FetchScheduler::fail(Job &job, Clock::time_point now,
+                          const std::string &why) {
+  job.outcome.reset();
+  ++job.failures;
+  auto backoff =
+      kRetryBase * (1 << std::min(job.failures - 1, kMaxBackoffShift));
+  job.nextRun =
+      job.lastRun + std::min<Clock::duration>(backoff, job.interval);
+  LOG_W("FetchScheduler", "{} failed ({}), attempt {}, retry in {} s",
+        job.name, why, job.failures,
+        std::chrono::duration_cast<std::chrono::seconds>(job.nextRun - now)
+            .count());
+}
+
+FetchScheduler::Clock::duration
+FetchScheduler::jitterOffset(const Job &job) {
+  auto range = std::chrono::duration_cast<std::chrono::milliseconds>(
+                   job.jitter)
+                   .count();
+  if (range <= 0)
+    return Clock::duration::zero();
+  std::uniform_int_distribution<long long> dist(-range, range);
+  return std::chrono::milliseconds(dist(rng_));
+}
+
+void FetchScheduler::publish(const Job &job) const {
+  if (!state_)
+    return;
+  auto toWall = [](Clock::time_point t) {
+    return std::chrono::time_point_cast<std::chrono::system_clock::duration>(
+        std::chrono::system_clock::now() + (t - Clock::now()));
+  };
+
+  FetchJobStatus s;
+  s.critical = job.priority == Priority::Critical;
+  s.intervalSec = static_cast<int>(
+      std::chrono::duration_cast<std::chrono::seconds>(job.interval).count());
+  s.nextRun = toWall(job.nextRun);
+  s.lastRun = job.lastRunWall;
+  s.lastSuccess = job.lastSuccess;
+  s.lastDurationMs = job.lastDurationMs;
+  s.failures = job.failures;
+  state_->fetchJobs.set(job.name, s);
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "HamClockState.h"
+#include "../network/NetworkManager.h"
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// Runs the periodic provider fetches. Each job has its own interval, a
+// jitter window and a priority class: critical jobs run on the first tick
+// so the first frame has data, background jobs are started one at a time
+// with a minimum spacing, so neither startup nor a shared interval turns
+// into a burst of requests. A job whose fetches fail is retried with
+// exponential backoff.
+//
+// tick() is called from the main loop and runs jobs on the main thread;
+// jobs are expected to hand the real work to NetworkManager or
+// WorkerService and return quickly. The requests a job starts through
+// NetworkManager while it runs are its failure signal: the run fails if
+// any of them does. A job may also name a service health key, in which
+// case the run only succeeds once that service reports success too, which
+// also catches a response that arrives but doesn't parse.
+class FetchScheduler {
+public:
+  using Clock = std::chrono::steady_clock;
+  using Task = std::function<void()>;
+
+  enum class Priority { Critical, Background };
+
+  explicit FetchScheduler(HamClockState *state = nullptr) : state_(state) {}
+  ~FetchScheduler();
+
+  FetchScheduler(const FetchScheduler &) = delete;
+  FetchScheduler &operator=(const FetchScheduler &) = delete;
+
+  // Register a job. It becomes due immediately. healthKey optionally names
+  // an entry in HamClockState::services that must also report success.
+  void add(const std::string &name, std::chrono::seconds interval,
+           Priority priority, Task task,
+           std::chrono::seconds jitter = std::chrono::seconds(0),
+           const std::string &healthKey = "");
+
+  void tick();
+
+private:
+  struct Job {
+    std::string name;
+    Clock::duration interval{};
+    Clock::duration jitter{};
+    Priority priority = Priority::Background;
+    Task task;
+    std::string healthKey;
+
+    Clock::time_point nextRun{};
+    Clock::time_point lastRun{};
+    std::chrono::system_clock::time_point lastRunWall{};
+    std::chrono::system_clock::time_point lastSuccess{};
+    double lastDurationMs = 0.0;
+    Clock::duration taskTime{}; // time task() itself took
+    int failures = 0;
+    // Requests of the run in flight, null once its outcome is known.
+    std::shared_ptr<NetworkManager::Outcome> outcome;
+  };
+
+  void run(Job &job, Clock::time_point now);
+  void checkOutcome(Job &job, Clock::time_point now);
+  void succeed(Job &job, Clock::duration took,
+               std::chrono::system_clock::time_point at);
+  void fail(Job &job, Clock::time_point now, const std::string &why);
+  Clock::duration jitterOffset(const Job &job);
+  void publish(const Job &job) const;
+
+  static constexpr auto kBackgroundSpacing = std::chrono::seconds(2);
+  // How long a run may take to complete or report through its health key.
+  static constexpr auto kHealthGrace = std::chrono::seconds(60);
+  static constexpr auto kRetryBase = std::chrono::seconds(30);
+  static constexpr int kMaxBackoffShift = 8;
+
+  HamClockState *state_;
+  std::vector<Job> jobs_;
+  Clock::time_point lastBackground_{};
+  std::mt19937 rng_{std::random_device{}()};
+};
@@ -1,17 +1,81 @@
 #pragma once
 
 #include "Astronomy.h"
+#include "Reactive.h"
+#include "ServiceRegistry.h"
 
 #include <chrono>
+#include <cmath>
+#include <ctime>
 #include <map>
+#include <mutex>
 #include <string>
 
-struct ServiceStatus {
-  bool ok = false;
-  std::string lastError;
+// Published by FetchScheduler for each registered job.
+struct FetchJobStatus {
+  bool critical = false;
+  int intervalSec = 0;
+  int failures = 0;
+  // Start of the last run until its requests completed (or its service
+  // reported success).
+  double lastDurationMs = 0.0;
+  std::chrono::system_clock::time_point nextRun{};
+  std::chrono::system_clock::time_point lastRun{};
   std::chrono::system_clock::time_point lastSuccess{};
 };
 
+// FetchScheduler writes job status on the main thread while the web server
+// reads it, so readers get a copy taken under the lock.
+class FetchJobBoard {
+public:
+  void set(const std::string &name, const FetchJobStatus &status) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    jobs_[name] = status;
+  }
+  void erase(const std::string &name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    jobs_.erase(name);
+  }
+  std::map<std::string, FetchJobStatus> snapshot() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return jobs_;
+  }
+
+private:
+  mutable std::mutex mutex_;
+  std::map<std::string, FetchJobStatus> jobs_;
+};
+
+// Graph tolerance for locations: closer than tolerance on both axes is the
+// same value.
+inline Reactive::SameFn<LatLon> withinDegrees(double tolerance) {
+  return [tolerance](const LatLon &a, const LatLon &b) {
+    return std::fabs(a.lat - b.lat) < tolerance &&
+           std::fabs(a.lon - b.lon) < tolerance;
+  };
+}
+
+struct DXTarget {
+  LatLon loc = {0, 0};
+  bool active = false;
+
+  bool operator==(const DXTarget &o) const {
+    return active == o.active && loc.lat == o.loc.lat && loc.lon == o.loc.lon;
+  }
+};
+
+// Short path from DE to an active DX.
+struct PathInfo {
+  double bearingDeg = 0.0;
+  double distanceKm = 0.0;
+  bool valid = false;
+
+  bool operator==(const PathInfo &o) const {
+    return valid == o.valid && bearingDeg == o.bearingDeg &&
+           distanceKm == o.distanceKm;
+  }
+};
+
 struct HamClockState {
   // DE (home) station — set from config
   LatLon deLocation = {0, 0};
@@ -25,5 +89,70 @@ struct HamClockState {
 
   // Telemetry
   float fps = 0.0f;
-  std::map<std::string, ServiceStatus> services;
+  // Providers claim a slot at start-up and update it from their own
+  // threads; the web server reads it concurrently.
+  ServiceRegistry services;
+  FetchJobBoard fetchJobs;
+
+  // Derived-value graph (see Reactive.h). Locations are changed through
+  // setDE()/setDX(), which keep the plain fields above in step.
+  // DE moves under kDeToleranceDeg (GPS jitter) are ignored.
+  static constexpr double kDeToleranceDeg = 0.001;
+
+  Reactive::Source<LatLon> de{{0, 0}, withinDegrees(kDeToleranceDeg)};
+  Reactive::Source<DXTarget> dx;
+  Reactive::Source<int64_t> utcHour{-1}; // hours since the epoch
+  Reactive::Source<int> utcDay{-1};      // day of the year, 1-366
+
+  Reactive::Derived<PathInfo, LatLon, DXTarget> path{
+      [](const LatLon &from, const DXTarget &to) {
+        PathInfo p;
+        if (to.active) {
+          p.bearingDeg = Astronomy::calculateBearing(from, to.loc);
+          p.distanceKm = Astronomy::calculateDistance(from, to.loc);
+          p.valid = true;
+        }
+        return p;
+      },
+      Reactive::equal<PathInfo>, de, dx};
+
+  Reactive::Derived<SunTimes, LatLon, int> deSun{
+      [](const LatLon &loc, const int &day) {
+        return Astronomy::calculateSunTimes(loc.lat, loc.lon, day);
+      },
+      [](const SunTimes &a, const SunTimes &b) {
+        return a.hasRise == b.hasRise && a.hasSet == b.hasSet &&
+               a.sunrise == b.sunrise && a.sunset == b.sunset;
+      },
+      de, utcDay};
+
+  // Returns true if DE moved beyond the tolerance. Without a grid, one is
+  // computed from the location.
+  bool setDE(LatLon loc, const std::string &grid = {}) {
+    bool moved = de.set(loc);
+    if (moved)
+      deLocation = loc;
+    if (!grid.empty())
+      deGrid = grid;
+    else if (moved)
+      deGrid = Astronomy::latLonToGrid(loc.lat, loc.lon);
+    return moved;
+  }
+
+  void setDX(LatLon loc) {
+    dxLocation = loc;
+    dxGrid = Astronomy::latLonToGrid(loc.lat, loc.lon);
+    dxActive = true;
+    dx.set({loc, true});
+  }
+
+  // Advance the clock sources; called once per frame.
+  void tickClock(std::chrono::system_clock::time_point now) {
+    std::time_t t = std::chrono::system_clock::to_time_t(now);
+    if (!utcHour.set(static_cast<int64_t>(t) / 3600))
+      return;
+    std::tm utc{};
+    Astronomy::portable_gmtime(&t, &utc);
+    utcDay.set(utc.tm_yday + 1);
+  }
 };
@@ -49,6 +49,7 @@ struct SpotRecord {
   double freqKhz;
   std::string receiverGrid; // Maidenhead locator of receiving station
   std::string senderCallsign;
+  std::string mode; // empty if the source does not report it
 };
 
 struct LiveSpotData {
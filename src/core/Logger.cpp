@@ -1,6 +1,12 @@
 #include "Logger.h"
+#include <array>
+#include <deque>
 #include <filesystem>
+#include <mutex>
 #include <spdlog/sinks/rotating_file_sink.h>
+#ifndef __EMSCRIPTEN__
+#include <spdlog/async.h>
+#endif
 
 #ifdef _WIN32
 #include <io.h>
@@ -12,6 +18,36 @@
 
 std::shared_ptr<spdlog::logger> Log::s_Logger;
 
+namespace {
+
+// Category names never move once interned, so categoryName() reads them
+// without the lock. Id 0 ("Main") also catches overflow.
+constexpr size_t kMaxCategories = 256;
+std::mutex categoryMutex;
+std::deque<std::string> categoryStorage;
+std::array<std::string_view, kMaxCategories> categoryNames = {"Main"};
+size_t categoryCount = 1;
+
+// Messages queued for the logging thread. When full, the oldest queued
+// message is dropped rather than blocking the caller.
+constexpr size_t kQueueSize = 8192;
+
+} // namespace
+
+Log::Category Log::intern(std::string_view name) {
+  std::lock_guard<std::mutex> lock(categoryMutex);
+  for (size_t i = 0; i < categoryCount; ++i) {
+    if (categoryNames[i] == name)
+      return static_cast<Category>(i);
+  }
+  if (categoryCount == kMaxCategories)
+    return 0;
+  categoryNames[categoryCount] = categoryStorage.emplace_back(name);
+  return static_cast<Category>(categoryCount++);
+}
+
+std::string_view Log::categoryName(Category id) { return categoryNames[id]; }
+
 void Log::init(const std::string &fallbackDir) {
   std::fprintf(stderr, "Initializing spdlog...\n");
   spdlog::set_pattern("%^[%Y-%m-%d %H:%M:%S.%e] [%l] %v%$");
@@ -45,8 +81,16 @@ void Log::init(const std::string &fallbackDir) {
     }
   }
 
+#ifndef __EMSCRIPTEN__
+  // File and console writes happen on spdlog's worker thread
+  spdlog::init_thread_pool(kQueueSize, 1);
+  s_Logger = std::make_shared<spdlog::async_logger>(
+      "HAMCLOCK", sinks.begin(), sinks.end(), spdlog::thread_pool(),
+      spdlog::async_overflow_policy::overrun_oldest);
+#else
   s_Logger =
       std::make_shared<spdlog::logger>("HAMCLOCK", sinks.begin(), sinks.end());
+#endif
   // Default to WARN level - use --log-level to change
   s_Logger->set_level(spdlog::level::warn);
   spdlog::flush_on(spdlog::level::warn);
@@ -55,3 +99,20 @@ void Log::init(const std::string &fallbackDir) {
   LOG_INFO("Logger initialized with {} sinks", sinks.size());
   std::fprintf(stderr, "spdlog initialized successfully.\n");
 }
+
+void Log::shutdown() {
+#ifndef __EMSCRIPTEN__
+  if (auto pool = spdlog::thread_pool()) {
+    if (size_t dropped = pool->overrun_counter())
+      std::fprintf(stderr, "Logger dropped %zu messages (queue full)\n",
+                   dropped);
+  }
+#endif
+  // Services may still be winding down; the level is atomic, so turning it
+  // off makes their late calls no-ops instead of racing the teardown.
+  if (s_Logger) {
+    s_Logger->flush();
+    s_Logger->set_level(spdlog::level::off);
+  }
+  spdlog::shutdown(); // joins the logging thread once the queue is drained
+}
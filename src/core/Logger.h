@@ -1,14 +1,22 @@
 #pragma once
 
+#include <cstdint>
 #include <fmt/format.h>
 #include <memory>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/spdlog.h>
 #include <string>
+#include <string_view>
+#include <type_traits>
 
 class Log {
 public:
+  // Interned category name ("Rig", "DXCluster", ...), see intern().
+  using Category = uint16_t;
+
   static void init(const std::string &fallbackDir = "");
+  // Drain the async queue and stop the logging thread. Call before exit.
+  static void shutdown();
 
   static std::shared_ptr<spdlog::logger> &get() { return s_Logger; }
 
@@ -19,80 +27,66 @@ public:
     }
   }
 
-  // Categorized logging. We format the entire message into a string first
-  // to bypass spdlog's consteval validation of the format string.
-  // This is necessary in C++20 where fmt's compile-time checking is very
-  // strict.
-  template <typename... Args>
-  static void t(const std::string &cat, const std::string &f, Args &&...args) {
-    if (s_Logger && s_Logger->should_log(spdlog::level::trace)) {
-      std::string msg =
-          fmt::format(fmt::runtime("[{}] {}"), cat,
-                      fmt::vformat(f, fmt::make_format_args(args...)));
-      s_Logger->log(spdlog::level::trace, msg);
-    }
-  }
-  template <typename... Args>
-  static void d(const std::string &cat, const std::string &f, Args &&...args) {
-    if (s_Logger && s_Logger->should_log(spdlog::level::debug)) {
-      std::string msg =
-          fmt::format(fmt::runtime("[{}] {}"), cat,
-                      fmt::vformat(f, fmt::make_format_args(args...)));
-      s_Logger->log(spdlog::level::debug, msg);
-    }
-  }
-  template <typename... Args>
-  static void i(const std::string &cat, const std::string &f, Args &&...args) {
-    if (s_Logger && s_Logger->should_log(spdlog::level::info)) {
-      std::string msg =
-          fmt::format(fmt::runtime("[{}] {}"), cat,
-                      fmt::vformat(f, fmt::make_format_args(args...)));
-      s_Logger->log(spdlog::level::info, msg);
-    }
-  }
-  template <typename... Args>
-  static void w(const std::string &cat, const std::string &f, Args &&...args) {
-    if (s_Logger && s_Logger->should_log(spdlog::level::warn)) {
-      std::string msg =
-          fmt::format(fmt::runtime("[{}] {}"), cat,
-                      fmt::vformat(f, fmt::make_format_args(args...)));
-      s_Logger->log(spdlog::level::warn, msg);
-    }
-  }
-  template <typename... Args>
-  static void e(const std::string &cat, const std::string &f, Args &&...args) {
-    if (s_Logger && s_Logger->should_log(spdlog::level::err)) {
-      std::string msg =
-          fmt::format(fmt::runtime("[{}] {}"), cat,
-                      fmt::vformat(f, fmt::make_format_args(args...)));
-      s_Logger->log(spdlog::level::err, msg);
-    }
-  }
-  template <typename... Args>
-  static void c(const std::string &cat, const std::string &f, Args &&...args) {
-    if (s_Logger && s_Logger->should_log(spdlog::level::critical)) {
-      std::string msg =
-          fmt::format(fmt::runtime("[{}] {}"), cat,
-                      fmt::vformat(f, fmt::make_format_args(args...)));
-      s_Logger->log(spdlog::level::critical, msg);
-    }
+  static bool enabled(spdlog::level::level_enum level) {
+    return s_Logger && s_Logger->should_log(level);
   }
 
-  // Redirect standard macros through categorized helpers to ensure consistent
-  // bypass of spdlog/fmt consteval validation for literal strings in C++20.
-#define LOG_TRACE(...) ::Log::t("Main", __VA_ARGS__)
-#define LOG_DEBUG(...) ::Log::d("Main", __VA_ARGS__)
-#define LOG_INFO(...) ::Log::i("Main", __VA_ARGS__)
-#define LOG_WARN(...) ::Log::w("Main", __VA_ARGS__)
-#define LOG_ERROR(...) ::Log::e("Main", __VA_ARGS__)
-#define LOG_CRITICAL(...) ::Log::c("Main", __VA_ARGS__)
+  // Id for a category name, assigning one on first use. Takes a lock, so
+  // the LOG_* macros call it once per call site for literal names.
+  static Category intern(std::string_view name);
+  static std::string_view categoryName(Category id);
 
-#define LOG_T(cat, f, ...) ::Log::t(cat, f, ##__VA_ARGS__)
-#define LOG_D(cat, f, ...) ::Log::d(cat, f, ##__VA_ARGS__)
-#define LOG_I(cat, f, ...) ::Log::i(cat, f, ##__VA_ARGS__)
-#define LOG_W(cat, f, ...) ::Log::w(cat, f, ##__VA_ARGS__)
-#define LOG_E(cat, f, ...) ::Log::e(cat, f, ##__VA_ARGS__)
+  // "[cat] message", formatted into a stack buffer and handed to the async
+  // logger without a heap allocation for ordinary message lengths. The
+  // format string is checked at compile time.
+  template <typename... Args>
+  static void write(spdlog::level::level_enum level, Category cat,
+                    fmt::format_string<Args...> f, Args &&...args) {
+    if (!enabled(level))
+      return;
+    spdlog::memory_buf_t buf;
+    std::string_view name = categoryName(cat);
+    buf.push_back('[');
+    buf.append(name.data(), name.data() + name.size());
+    buf.push_back(']');
+    buf.push_back(' ');
+    fmt::format_to(fmt::appender(buf), f, std::forward<Args>(args)...);
+    s_Logger->log(level, spdlog::string_view_t(buf.data(), buf.size()));
+  }
 
 private:
   static std::shared_ptr<spdlog::logger> s_Logger;
 };
+
+// Category id for a LOG_* call. A string literal is interned once per call
+// site; anything else (e.g. a service's name member) on every call.
+#define HAMCLOCK_LOG_CATEGORY(cat)                                             \
+  ([&]() -> ::Log::Category {                                                  \
+    if constexpr (std::is_array_v<std::remove_reference_t<decltype(cat)>>) {   \
+      static const ::Log::Category id = ::Log::intern(cat);                    \
+      return id;                                                               \
+    } else {                                                                   \
+      return ::Log::intern(cat);                                               \
+    }                                                                          \
+  }())
+
+// Arguments are not evaluated when the level is off.
+#define HAMCLOCK_LOG(level, cat, ...)                                          \
+  do {                                                                         \
+    if (::Log::enabled(level))                                                 \
+      ::Log::write(level, HAMCLOCK_LOG_CATEGORY(cat), __VA_ARGS__);            \
+  } while (0)
+
+#define LOG_TRACE(...) HAMCLOCK_LOG(spdlog::level::trace, "Main", __VA_ARGS__)
+#define LOG_DEBUG(...) HAMCLOCK_LOG(spdlog::level::debug, "Main", __VA_ARGS__)
+#define LOG_INFO(...) HAMCLOCK_LOG(spdlog::level::info, "Main", __VA_ARGS__)
+#define LOG_WARN(...) HAMCLOCK_LOG(spdlog::level::warn, "Main", __VA_ARGS__)
+#define LOG_ERROR(...) HAMCLOCK_LOG(spdlog::level::err, "Main", __VA_ARGS__)
+#define LOG_CRITICAL(...)                                                      \
+  HAMCLOCK_LOG(spdlog::level::critical, "Main", __VA_ARGS__)
+
+#define LOG_T(cat, ...) HAMCLOCK_LOG(spdlog::level::trace, cat, __VA_ARGS__)
+#define LOG_D(cat, ...) HAMCLOCK_LOG(spdlog::level::debug, cat, __VA_ARGS__)
+#define LOG_I(cat, ...) HAMCLOCK_LOG(spdlog::level::info, cat, __VA_ARGS__)
+#define LOG_W(cat, ...) HAMCLOCK_LOG(spdlog::level::warn, cat, __VA_ARGS__)
+#define LOG_E(cat, ...) HAMCLOCK_LOG(spdlog::level::err, cat, __VA_ARGS__)
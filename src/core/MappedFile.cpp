@@ -0,0 +1,54 @@
+#include "MappedFile.h"
+
+#include <fstream>
+#include <iterator>
+
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+#define MAPPED_FILE_USE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::filesystem::path &path, Access access) {
+#ifdef MAPPED_FILE_USE_MMAP
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd >= 0) {
+    struct stat st{};
+    if (::fstat(fd, &st) == 0) {
+      size_ = static_cast<size_t>(st.st_size);
+      if (size_ == 0) {
+        open_ = true;
+      } else {
+        void *p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+          ::madvise(p, size_, access == Access::Random ? MADV_RANDOM
+                                                       : MADV_SEQUENTIAL);
+          data_ = static_cast<const char *>(p);
+          open_ = mapped_ = true;
+        }
+      }
+    }
+    ::close(fd);
+    if (open_)
+      return;
+  }
+#endif
+  (void)access;
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open())
+    return;
+  buffer_.assign(std::istreambuf_iterator<char>(file),
+                 std::istreambuf_iterator<char>());
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+  open_ = true;
+}
+
+MappedFile::~MappedFile() {
+#ifdef MAPPED_FILE_USE_MMAP
+  if (mapped_)
+    ::munmap(const_cast<char *>(data_), size_);
+#endif
+}
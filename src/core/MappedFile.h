@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+// Read-only view of a whole file. Memory-mapped where the platform allows,
+// otherwise read into a buffer; either way data() stays valid for the
+// lifetime of the object.
+class MappedFile {
+public:
+  // Read-ahead hint for the mapping.
+  enum class Access { Sequential, Random };
+
+  explicit MappedFile(const std::filesystem::path &path,
+                      Access access = Access::Sequential);
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  bool isOpen() const { return open_; }
+  std::string_view data() const { return {data_, size_}; }
+
+private:
+  const char *data_ = nullptr;
+  size_t size_ = 0;
+  bool open_ = false;
+  bool mapped_ = false;
+  std::string buffer_; // fallback when mmap is unavailable
+};
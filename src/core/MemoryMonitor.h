@@ -35,9 +35,15 @@ BOOL WINAPI K32GetProcessMemoryInfo(HANDLE Process,
 
 #include "Logger.h"
 #include <SDL.h>
+#include <algorithm>
 #include <atomic>
 #include <cstdio>
+#include <functional>
+#include <map>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #if defined(__linux__)
 #include <unistd.h>
@@ -58,6 +64,10 @@ public:
   void destroyTexture(SDL_Texture *&tex) {
     if (!tex)
       return;
+    {
+      std::lock_guard<std::mutex> lock(residentMutex_);
+      residents_.erase(tex);
+    }
     int w, h;
     if (SDL_QueryTexture(tex, nullptr, nullptr, &w, &h) == 0) {
       markVramDestroyed(static_cast<int64_t>(w) * h * 4);
@@ -66,6 +76,91 @@ public:
     tex = nullptr;
   }
 
+  // --- Texture residency ---
+  // Every texture is registered with its owner and the frame it was last
+  // used. Textures registered with an evictor are re-creatable: when the VRAM
+  // budget is exceeded the least recently used ones are handed back to their
+  // owner, which must release them via destroyTexture() and rebuild from its
+  // CPU or disk copy on next use. Textures without an evictor are pinned.
+  // All calls other than ownerUsage() are main-thread only.
+  using Evictor = std::function<void(SDL_Texture *)>;
+
+  struct OwnerUsage {
+    int64_t bytes = 0;
+    int64_t evictableBytes = 0;
+    int count = 0;
+  };
+
+  // Registers a new texture and accounts its VRAM. Calling again for an
+  // already tracked texture only updates its owner and evictor.
+  void trackTexture(SDL_Texture *tex, const char *owner,
+                    Evictor evictor = nullptr) {
+    if (!tex)
+      return;
+    int w = 0, h = 0;
+    SDL_QueryTexture(tex, nullptr, nullptr, &w, &h);
+    int64_t bytes = static_cast<int64_t>(w) * h * 4;
+
+    std::lock_guard<std::mutex> lock(residentMutex_);
+    auto [it, inserted] = residents_.try_emplace(tex);
+    if (inserted) {
+      it->second.bytes = bytes;
+      addVram(bytes);
+    }
+    it->second.owner = owner;
+    it->second.evictor = std::move(evictor);
+    it->second.lastFrame = frame_;
+  }
+
+  void touchTexture(SDL_Texture *tex) {
+    if (!tex)
+      return;
+    std::lock_guard<std::mutex> lock(residentMutex_);
+    auto it = residents_.find(tex);
+    if (it != residents_.end())
+      it->second.lastFrame = frame_;
+  }
+
+  // 0 disables eviction.
+  void setVramBudget(int64_t bytes) { vramBudget_ = bytes; }
+  int64_t getVramBudget() const { return vramBudget_.load(); }
+  uint64_t getEvictionCount() const { return evictions_.load(); }
+
+  // Call once per frame before rendering. Advances the LRU clock and trims
+  // back under budget. Textures drawn in the current or the previous frame
+  // are never evicted: at this point the current frame hasn't touched
+  // anything yet, so the previous frame is the visible working set.
+  void beginFrame() {
+    {
+      std::lock_guard<std::mutex> lock(residentMutex_);
+      ++frame_;
+    }
+    enforceBudget(0);
+  }
+
+  // Makes room for an allocation of the given size before it is attempted.
+  void reserveVram(int64_t bytes) { enforceBudget(bytes); }
+
+  std::map<std::string, OwnerUsage> ownerUsage() const {
+    std::map<std::string, OwnerUsage> usage;
+    int64_t tracked = 0;
+    {
+      std::lock_guard<std::mutex> lock(residentMutex_);
+      for (const auto &[tex, r] : residents_) {
+        OwnerUsage &u = usage[r.owner];
+        u.bytes += r.bytes;
+        u.count++;
+        if (r.evictor)
+          u.evictableBytes += r.bytes;
+        tracked += r.bytes;
+      }
+    }
+    int64_t untracked = getVramEstimated() - tracked;
+    if (untracked > 0)
+      usage["untracked"].bytes = untracked;
+    return usage;
+  }
+
   // Get Resident Set Size (RSS) in bytes
   size_t getRSS() {
 #if defined(__linux__)
@@ -105,5 +200,56 @@ public:
 
 private:
   MemoryMonitor() : vramBytes_(0) {}
+
+  struct Resident {
+    std::string owner;
+    int64_t bytes = 0;
+    uint64_t lastFrame = 0;
+    Evictor evictor;
+  };
+
+  void enforceBudget(int64_t incoming) {
+    int64_t budget = vramBudget_.load();
+    if (budget <= 0)
+      return;
+    int64_t used = getVramEstimated() + incoming;
+    if (used <= budget)
+      return;
+
+    std::vector<std::pair<SDL_Texture *, const Resident *>> lru;
+    std::vector<std::pair<SDL_Texture *, Evictor>> victims;
+    {
+      std::lock_guard<std::mutex> lock(residentMutex_);
+      for (const auto &[tex, r] : residents_) {
+        if (r.evictor && r.lastFrame + 1 < frame_)
+          lru.emplace_back(tex, &r);
+      }
+      std::sort(lru.begin(), lru.end(), [](const auto &a, const auto &b) {
+        return a.second->lastFrame < b.second->lastFrame;
+      });
+      for (const auto &[tex, r] : lru) {
+        if (used <= budget)
+          break;
+        used -= r->bytes;
+        victims.emplace_back(tex, r->evictor);
+      }
+    }
+    if (victims.empty())
+      return;
+
+    // Evictors call back into destroyTexture(), so run them unlocked.
+    for (auto &[tex, evict] : victims)
+      evict(tex);
+    evictions_ += victims.size();
+    LOG_D("Memory", "Evicted {} textures, VRAM now {:.2f} / {:.2f} MB",
+          victims.size(), getVramEstimated() / 1024.0 / 1024.0,
+          budget / 1024.0 / 1024.0);
+  }
+
   std::atomic<int64_t> vramBytes_;
+  std::atomic<int64_t> vramBudget_{0};
+  std::atomic<uint64_t> evictions_{0};
+  mutable std::mutex residentMutex_;
+  std::unordered_map<SDL_Texture *, Resident> residents_;
+  uint64_t frame_ = 0;
 };
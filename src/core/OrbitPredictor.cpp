@@ -1,6 +1,8 @@
 #include "OrbitPredictor.h"
 #include "Astronomy.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstdio>
 
@@ -19,6 +21,7 @@ void OrbitPredictor::setObserver(double latDeg, double lonDeg,
     predict_destroy_observer(observer_);
   observer_ = predict_create_observer("QTH", latDeg * kDeg2Rad,
                                       lonDeg * kDeg2Rad, altMeters);
+  ++generation_;
   if (!observer_) {
     std::fprintf(stderr, "OrbitPredictor: failed to create observer\n");
   }
@@ -30,6 +33,7 @@ bool OrbitPredictor::loadTLE(const SatelliteTLE &tle) {
     elements_ = nullptr;
   }
   satName_.clear();
+  ++generation_;
 
   elements_ = predict_parse_tle(tle.line1.c_str(), tle.line2.c_str());
   if (!elements_) {
@@ -157,12 +161,60 @@ std::vector<GroundTrackPoint> OrbitPredictor::groundTrack(std::time_t startUtc,
     while (lon < -180.0)
       lon += 360.0;
 
-    track.push_back(GroundTrackPoint(lat, lon));
+    track.push_back(GroundTrackPoint(lat, lon, t));
   }
 
   return track;
 }
 
+size_t OrbitPredictor::extendGroundTrack(std::deque<GroundTrackPoint> &track,
+                                         std::time_t fromUtc,
+                                         std::time_t untilUtc) const {
+  if (!elements_)
+    return 0;
+
+  // Propagate one sample and pick the step to the next one: fine while the
+  // sub-satellite point is inside (or approaching) the observer's footprint.
+  auto sample = [&](std::time_t t, int &step) {
+    struct predict_position pos{};
+    predict_orbit(elements_, &pos, predict_to_julian(t));
+
+    double lat = pos.latitude * kRad2Deg;
+    double lon = std::remainder(pos.longitude * kRad2Deg, 360.0);
+
+    step = kTrackCoarseStepSec;
+    if (observer_) {
+      double dLat = pos.latitude - observer_->latitude;
+      double dLon = pos.longitude - observer_->longitude;
+      double a = std::sin(dLat / 2) * std::sin(dLat / 2) +
+                 std::cos(observer_->latitude) * std::cos(pos.latitude) *
+                     std::sin(dLon / 2) * std::sin(dLon / 2);
+      double distKm = 2.0 * 6371.0 * std::asin(std::sqrt(std::min(1.0, a)));
+      if (distKm < pos.footprint / 2.0 + 1000.0)
+        step = kTrackFineStepSec;
+    }
+    return GroundTrackPoint(lat, lon, t);
+  };
+
+  size_t added = 0;
+  int step = kTrackCoarseStepSec;
+  std::time_t t = fromUtc;
+  if (track.empty()) {
+    track.push_back(sample(t, step));
+    ++added;
+  } else {
+    // Re-derive the step from the last sample rather than storing it.
+    t = track.back().t;
+    sample(t, step);
+  }
+
+  for (t += step; t <= untilUtc; t += step) {
+    track.push_back(sample(t, step));
+    ++added;
+  }
+  return added;
+}
+
 double OrbitPredictor::tleAgeDays() const {
   if (!elements_)
     return -1.0;
@@ -183,18 +235,122 @@ double OrbitPredictor::tleAgeDays() const {
   return (nowSec - epochSec) / 86400.0;
 }
 
-double OrbitPredictor::dopplerShift(double downlinkHz) const {
+void OrbitPredictor::refreshPassCache(std::time_t utc) const {
+  PassCache &c = passCache_;
+  if (c.valid && c.generation == generation_ && utc <= c.pass.losTime)
+    return;
+
+  c = PassCache{};
+  c.generation = generation_;
   if (!isReady())
-    return 0.0;
+    return;
+
+  if (observeAt(utc).elevation > 0.0) {
+    // Already up: find this pass's AOS rather than the next one's.
+    auto up = [&](std::time_t t) { return observeAt(t).elevation > 0.0; };
+    std::time_t a = utc;
+    for (int guard = 0; guard < 120 && up(a - 30); ++guard)
+      a -= 30;
+    std::time_t lo = a - 30, hi = a;
+    while (hi - lo > 1) {
+      std::time_t mid = lo + (hi - lo) / 2;
+      if (up(mid))
+        hi = mid;
+      else
+        lo = mid;
+    }
+    c.pass.aosTime = hi;
+    c.pass.aosAz = observeAt(hi).azimuth;
+
+    predict_julian_date_t jd = predict_to_julian(utc);
+    struct predict_observation los = predict_next_los(observer_, elements_, jd);
+    c.pass.losTime = predict_from_julian(los.time);
+    c.pass.losAz = std::fmod(los.azimuth * kRad2Deg + 360.0, 360.0);
+    struct predict_observation maxEl =
+        predict_at_max_elevation(observer_, elements_, jd);
+    c.pass.maxEl = maxEl.elevation * kRad2Deg;
+  } else {
+    c.pass = nextPassAfter(utc);
+  }
+  c.valid = c.pass.losTime > c.pass.aosTime;
+
+  // Sample the pass for interpolation. Pathological passes (deep-space
+  // orbits lingering for hours) are left to direct propagation.
+  long duration = static_cast<long>(c.pass.losTime - c.pass.aosTime);
+  if (!c.valid || duration > 6 * 3600)
+    return;
+
+  size_t n = static_cast<size_t>(duration / kPassSampleSec) + 2;
+  for (auto *v : {&c.az, &c.azRate, &c.el, &c.elRate, &c.range, &c.rangeRate})
+    v->reserve(n);
+  c.visible.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    std::time_t t = c.pass.aosTime + static_cast<std::time_t>(i) * kPassSampleSec;
+    struct predict_position pos{};
+    predict_orbit(elements_, &pos, predict_to_julian(t));
+    struct predict_observation obs{};
+    predict_observe_orbit(observer_, &pos, &obs);
+
+    c.az.push_back(std::fmod(obs.azimuth * kRad2Deg + 360.0, 360.0));
+    c.azRate.push_back(obs.azimuth_rate * kRad2Deg);
+    c.el.push_back(obs.elevation * kRad2Deg);
+    c.elRate.push_back(obs.elevation_rate * kRad2Deg);
+    c.range.push_back(obs.range);
+    c.rangeRate.push_back(obs.range_rate);
+    c.visible.push_back(obs.visible);
+  }
+}
 
-  // Get current observation for range_rate
-  predict_julian_date_t jd = predict_to_julian(std::time(nullptr));
+SatPass OrbitPredictor::cachedPass(std::time_t utc) const {
+  std::lock_guard<std::mutex> lock(passMutex_);
+  refreshPassCache(utc);
+  return passCache_.pass;
+}
 
-  struct predict_position pos{};
-  predict_orbit(elements_, &pos, jd);
+SatObservation OrbitPredictor::trackAt(double utc) const {
+  {
+    std::lock_guard<std::mutex> lock(passMutex_);
+    refreshPassCache(static_cast<std::time_t>(utc));
+    const PassCache &c = passCache_;
+    double x = (utc - static_cast<double>(c.pass.aosTime)) / kPassSampleSec;
+    if (c.az.size() >= 2 && x >= 0.0 &&
+        x < static_cast<double>(c.az.size() - 1)) {
+      size_t i = static_cast<size_t>(x);
+      double u = x - static_cast<double>(i);
+      const double h = kPassSampleSec;
+
+      // Cubic Hermite between samples i and i+1 using the SGP4 rates.
+      auto hermite = [&](double p0, double p1, double m0, double m1) {
+        double u2 = u * u, u3 = u2 * u;
+        return (2 * u3 - 3 * u2 + 1) * p0 + (u3 - 2 * u2 + u) * h * m0 +
+               (-2 * u3 + 3 * u2) * p1 + (u3 - u2) * h * m1;
+      };
+
+      SatObservation result;
+      // Unwrap azimuth across north before interpolating.
+      double az1 = c.az[i] + std::remainder(c.az[i + 1] - c.az[i], 360.0);
+      result.azimuth = std::fmod(
+          hermite(c.az[i], az1, c.azRate[i], c.azRate[i + 1]) + 360.0, 360.0);
+      result.elevation =
+          hermite(c.el[i], c.el[i + 1], c.elRate[i], c.elRate[i + 1]);
+      result.range =
+          hermite(c.range[i], c.range[i + 1], c.rangeRate[i], c.rangeRate[i + 1]);
+      result.rangeRate = c.rangeRate[i] + u * (c.rangeRate[i + 1] - c.rangeRate[i]);
+      result.visible = c.visible[u < 0.5 ? i : i + 1];
+      return result;
+    }
+  }
+  return observeAt(static_cast<std::time_t>(utc));
+}
 
-  struct predict_observation obs{};
-  predict_observe_orbit(observer_, &pos, &obs);
+double OrbitPredictor::dopplerShift(double downlinkHz) const {
+  if (!isReady())
+    return 0.0;
 
-  return predict_doppler_shift(&obs, downlinkHz);
+  // Same as predict_doppler_shift(), from the interpolated range rate.
+  constexpr double kSpeedOfLight = 299792458.0; // m/s
+  auto now = std::chrono::system_clock::now();
+  double utc = std::chrono::duration<double>(now.time_since_epoch()).count();
+  SatObservation obs = trackAt(utc);
+  return -downlinkHz * (obs.rangeRate * 1000.0) / kSpeedOfLight;
 }
@@ -4,7 +4,10 @@
 
 #include <predict/predict.h>
 
+#include <cstdint>
 #include <ctime>
+#include <deque>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -56,6 +59,29 @@ public:
   std::vector<GroundTrackPoint>
   groundTrack(std::time_t startUtc, int minutes = 90, int stepSec = 30) const;
 
+  // Append samples to a sliding-window ground track until `untilUtc`,
+  // continuing from its last sample (or `fromUtc` when empty). The step
+  // tightens while the satellite is within range of the observer so the
+  // visible arc stays smooth. Returns the number of samples appended.
+  size_t extendGroundTrack(std::deque<GroundTrackPoint> &track,
+                           std::time_t fromUtc, std::time_t untilUtc) const;
+
+  // Bumped whenever the TLE or observer changes, so cached tracks can tell
+  // when they are stale.
+  uint32_t generation() const { return generation_; }
+
+  // --- Cached pass tracking ---
+
+  // The pass in progress, or the next one, from `utc`. The AOS/LOS search
+  // runs once per pass; until LOS this is a cache lookup. Thread-safe.
+  SatPass cachedPass(std::time_t utc) const;
+
+  // Observation at a (fractional) UTC time. Inside the cached pass this
+  // interpolates precomputed az/el/range samples with no SGP4 work, so it
+  // can be called at any rate; elsewhere it falls back to observeAt().
+  // Thread-safe.
+  SatObservation trackAt(double utc) const;
+
   // Calculate Doppler shift for a given downlink frequency (Hz).
   // Returns frequency offset in Hz.
   double dopplerShift(double downlinkHz) const;
@@ -66,8 +92,29 @@ public:
 private:
   static constexpr double kDeg2Rad = 3.14159265358979323846 / 180.0;
   static constexpr double kRad2Deg = 180.0 / 3.14159265358979323846;
+  static constexpr int kTrackFineStepSec = 10;
+  static constexpr int kTrackCoarseStepSec = 30;
+  static constexpr int kPassSampleSec = 4;
+
+  // Refresh passCache_ if it is stale. Caller holds passMutex_.
+  void refreshPassCache(std::time_t utc) const;
 
   predict_observer_t *observer_ = nullptr;
   predict_orbital_elements_t *elements_ = nullptr;
   std::string satName_;
+  uint32_t generation_ = 0;
+
+  // Samples of the current/next pass every kPassSampleSec from AOS, with
+  // the rates needed for Hermite interpolation between them.
+  struct PassCache {
+    uint32_t generation = 0;
+    bool valid = false;
+    SatPass pass;
+    std::vector<double> az, azRate; // degrees, degrees/s
+    std::vector<double> el, elRate; // degrees, degrees/s
+    std::vector<double> range, rangeRate;
+    std::vector<bool> visible;
+  };
+  mutable PassCache passCache_;
+  mutable std::mutex passMutex_;
 };
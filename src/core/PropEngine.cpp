@@ -1,8 +1,12 @@
 #include "PropEngine.h"
 #include "../services/IonosondeProvider.h"
+#include "Astronomy.h"
+#include "WorkerService.h"
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <map>
+#include <optional>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -14,13 +18,14 @@ static const std::map<std::string, double> MODE_ADVANTAGE_DB = {
     {"WSPR", 25.0}, {"SSB", 0.0},   {"AM", -6.0},  {"FM", -3.0},
     {"RTTY", 5.0},  {"PSK31", 14.0}};
 
+static double modeAdvantageDb(const std::string &mode) {
+  auto it = MODE_ADVANTAGE_DB.find(mode);
+  return it != MODE_ADVANTAGE_DB.end() ? it->second : 0.0;
+}
+
 double PropEngine::calculateSignalMargin(const std::string &mode,
                                          double watts) {
-  double modeAdv = 0.0;
-  auto it = MODE_ADVANTAGE_DB.find(mode);
-  if (it != MODE_ADVANTAGE_DB.end()) {
-    modeAdv = it->second;
-  }
+  double modeAdv = modeAdvantageDb(mode);
 
   double p = std::max(0.01, watts);
   double powerOffset = 10.0 * std::log10(p / 100.0);
@@ -185,6 +190,34 @@ double PropEngine::calculateTOA(double distKm, double muf, double freqMhz) {
   return std::min(elDeg, 90.0);
 }
 
+double PropEngine::calculateAbsorption(const DrapGrid &drap, double txLat,
+                                       double txLon, double rxLat,
+                                       double rxLon, double midLat,
+                                       double midLon, double distKm,
+                                       double freqMhz) {
+  if (drap.maxMhz <= 0.0f || freqMhz <= 0.0)
+    return 0.0;
+
+  // DRAP maps the frequency with 1 dB of vertical absorption; absorption
+  // falls off as f^-1.5 above it (the SWPC product's own scaling).
+  auto verticalDb = [&](double lat, double lon) {
+    double haf = drap.at(lat, lon);
+    return haf > 0.0 ? std::pow(haf / freqMhz, 1.5) : 0.0;
+  };
+
+  // Same hop geometry as calculateTOA. An oblique ray spends sec(i) longer
+  // in the layer; the curved Earth caps that at about 3.5.
+  const double h = 350.0;
+  double hops = std::max(1.0, std::ceil(distKm / 3500.0));
+  double hopDist = distKm / hops;
+  double sinEl = std::sin(std::atan2(2.0 * h, hopDist));
+  double secI = std::min(3.5, 1.0 / std::max(sinEl, 1e-3));
+
+  double ends = verticalDb(txLat, txLon) + verticalDb(rxLat, rxLon);
+  double middle = (2.0 * hops - 2.0) * verticalDb(midLat, midLon);
+  return secI * (ends + middle);
+}
+
 // Haversine helper
 static double haversineKm(double lat1, double lon1, double lat2, double lon2) {
   double R = 6371.0;
@@ -200,7 +233,7 @@ static double haversineKm(double lat1, double lon1, double lat2, double lon2) {
 std::vector<float>
 PropEngine::generateGrid(const PropPathParams &params, const SolarData &sw,
                          const class IonosondeProvider *ionoProvider,
-                         int outputType) {
+                         int outputType, const DrapGrid *drap) {
   // outputType: 0=MUF, 1=Reliability, 2=TOA (take-off angle degrees)
 
   std::vector<float> grid;
@@ -301,10 +334,15 @@ PropEngine::generateGrid(const PropPathParams &params, const SolarData &sw,
         float val = (float)calculateTOA(dist, muf, params.mhz);
         grid[y * MAP_W + x] = val;
       } else {
-        // Reliability
+        // Reliability, less whatever the D region soaks up on the way
+        double pathMarginDb = marginDb;
+        if (drap)
+          pathMarginDb -= calculateAbsorption(*drap, params.txLat, params.txLon,
+                                              lat, lon, midLatDeg, midLonDeg,
+                                              dist, params.mhz);
         float val = (float)calculateReliability(
             params.mhz, dist, midLatDeg, midLonDeg, utcHour, sfi, ssn, kIndex,
-            iono, utcHour, marginDb);
+            iono, utcHour, pathMarginDb);
         grid[y * MAP_W + x] = val;
       }
     }
@@ -312,3 +350,452 @@ PropEngine::generateGrid(const PropPathParams &params, const SolarData &sw,
 
   return grid;
 }
+// ---------------------------------------------------------------------------
+// Area coverage (ITU-R P.533 style)
+// ---------------------------------------------------------------------------
+
+namespace {
+
+constexpr double kEarthR = 6371.0;
+constexpr double kDeg = M_PI / 180.0;
+
+constexpr double kMinElevation = 3.0 * kDeg; // P.533 floor for all modes
+constexpr double kEHeight = 110.0;           // E-layer reflection, km
+constexpr double kDHeight = 100.0;           // D-region crossing, km
+constexpr double kGyroMhz = 1.2;             // electron gyrofrequency
+constexpr double kGroundLossDb = 2.0;        // per ground reflection
+constexpr double kLzDb = 8.72;               // P.533 "not otherwise included"
+constexpr double kSsbRequiredSnrDbHz = 48.0;
+// Day-to-day spread: the MUF as a fraction of itself, the SNR in dB.
+constexpr double kF2MufSigma = 0.12;
+constexpr double kEMufSigma = 0.05;
+constexpr double kSnrSigmaDb = 8.0;
+
+double normalCdf(double x) { return 0.5 * std::erfc(-x / std::sqrt(2.0)); }
+
+// Longest hop off a layer at heightKm that still leaves at kMinElevation.
+double maxHopKm(double heightKm) {
+  double theta = M_PI / 2.0 - kMinElevation -
+                 std::asin(kEarthR * std::cos(kMinElevation) /
+                           (kEarthR + heightKm));
+  return 2.0 * kEarthR * theta;
+}
+
+// Ray geometry of one hop over a round Earth, without inverse trig.
+struct Hop {
+  double tanElevation;
+  double cosElevation;
+  double slantKm; // virtual path length of the hop
+
+  Hop(double hopKm, double heightKm) {
+    double theta = hopKm / (2.0 * kEarthR);
+    double s = std::sin(theta);
+    double c = std::cos(theta);
+    tanElevation = (c - kEarthR / (kEarthR + heightKm)) / s;
+    cosElevation = 1.0 / std::sqrt(1.0 + tanElevation * tanElevation);
+    double sinElevation = tanElevation * cosElevation;
+    slantKm = 2.0 * kEarthR * s / (cosElevation * c - sinElevation * s);
+  }
+
+  // Secant of the angle of incidence on a layer at heightKm.
+  double secIncidence(double heightKm) const {
+    double sinI = kEarthR * cosElevation / (kEarthR + heightKm);
+    return 1.0 / std::sqrt(std::max(1e-6, 1.0 - sinI * sinI));
+  }
+};
+
+// Ionospheric characteristics at a point, with the P.533 F2 factors that
+// follow from them: the MUF factor B, the longest hop dmax and C(3000).
+struct IonoPoint {
+  double foF2 = 0.0;
+  double foE = 0.0;
+  double hmF2 = 320.0;
+  double absorption = 0.0; // George-Bradley (1+0.0037R)cos(0.881chi)^1.3
+  double b = 3.0;
+  double dmax = 4000.0;
+  double c3000 = 1.0;
+  double maxHop = 3300.0; // longest F2 hop above kMinElevation
+
+  static double cd(double hopKm, double dmax) {
+    double z = std::clamp(1.0 - 2.0 * hopKm / dmax, -1.0, 1.0);
+    return 0.74 +
+           z * (-0.591 +
+                z * (-0.424 +
+                     z * (-0.090 + z * (0.088 + z * (0.181 + z * 0.096)))));
+  }
+
+  void setF2(double m3000) {
+    double x = std::max(foF2 / std::max(foE, 0.1), 2.0);
+    double x2 = x * x;
+    b = m3000 - 0.124 + (m3000 * m3000 - 4.0) *
+                            (0.0215 + 0.005 * std::sin(7.854 / x - 1.9635));
+    dmax = std::clamp(4780.0 + (12610.0 + 2140.0 / x2 - 49720.0 / (x2 * x2) +
+                                688900.0 / (x2 * x2 * x2)) *
+                                   (1.0 / b - 0.303),
+                      1000.0, 4000.0);
+    c3000 = cd(3000.0, dmax);
+    maxHop = maxHopKm(hmF2);
+  }
+
+  // Basic F2 MUF of a hop of hopKm.
+  double f2Muf(double hopKm) const {
+    return (1.0 + cd(hopKm, dmax) / c3000 * (b - 1.0)) * foF2 +
+           kGyroMhz / 2.0 * std::max(0.0, 1.0 - hopKm / dmax);
+  }
+};
+
+// The ionosphere on a 5 degree lattice, sampled once per map so a pixel
+// costs bilinear lookups instead of ionosonde searches. Away from stations
+// foF2 and M(3000)F2 come from a sunspot and zenith angle model; within
+// reach of one the measurements take over smoothly.
+class IonoMap {
+public:
+  IonoMap(const IonosondeProvider *provider, double ssn, std::time_t utc) {
+    SubSolarPoint sun =
+        Astronomy::sunPosition(std::chrono::system_clock::from_time_t(utc));
+    double sinDec = std::sin(sun.lat * kDeg);
+    double cosDec = std::cos(sun.lat * kDeg);
+    double r = std::clamp(ssn, 0.0, 250.0);
+
+    for (int row = 0; row < kRows; ++row) {
+      double lat = 90.0 - row * kStepDeg;
+      for (int col = 0; col < kCols; ++col) {
+        double lon = -180.0 + col * kStepDeg;
+        double cosChi = std::sin(lat * kDeg) * sinDec +
+                        std::cos(lat * kDeg) * cosDec *
+                            std::cos((lon - sun.lon) * kDeg);
+        IonoPoint &p = nodes_[row * kCols + col];
+
+        // foF2 follows the sun but decays slowly after sunset; the polar
+        // caps run lower.
+        double sunlit = std::clamp((cosChi + 0.3) / 1.3, 0.0, 1.0);
+        double day = 6.0 + 0.055 * r;
+        double night = 3.0 + 0.02 * r;
+        p.foF2 = night + (day - night) * std::pow(sunlit, 0.6);
+        if (std::abs(lat) > 60.0)
+          p.foF2 *= 1.0 - 0.25 * (std::abs(lat) - 60.0) / 30.0;
+        double m3000 = 2.9 + 0.3 * sunlit - 0.0015 * r;
+        std::optional<double> hmF2;
+
+        if (provider) {
+          InterpolatedIonosonde s = provider->interpolate(lat, lon);
+          if (s.stationsUsed > 0 && s.foF2 > 0.0) {
+            double k = s.nearestDistance / 3000.0;
+            double w = std::clamp(1.0 - k * k, 0.0, 1.0);
+            p.foF2 += (s.foF2 - p.foF2) * w;
+            m3000 += (s.md - m3000) * w;
+            if (s.hmF2.has_value())
+              hmF2 = 1490.0 / m3000 - 176.0 +
+                     (s.hmF2.value() - (1490.0 / m3000 - 176.0)) * w;
+          }
+        }
+        // Shimazaki, unless a station measured it.
+        p.hmF2 = std::clamp(hmF2.value_or(1490.0 / m3000 - 176.0), 200.0,
+                            500.0);
+
+        // P.1239 foE, with a weak residual layer at night.
+        p.foE = cosChi > 0.0
+                    ? 0.9 * std::pow((180.0 + 1.44 * r) * cosChi, 0.25)
+                    : 0.0;
+        p.foE = std::max(p.foE, 0.5);
+        double chi = std::acos(std::clamp(cosChi, -1.0, 1.0));
+        p.absorption = (1.0 + 0.0037 * r) *
+                       std::pow(std::max(0.0, std::cos(0.881 * chi)), 1.3);
+        p.setF2(m3000);
+      }
+    }
+  }
+
+  IonoPoint at(double lat, double lon) const {
+    double fy = std::clamp((90.0 - lat) / kStepDeg, 0.0, kRows - 1.0);
+    double fx = (lon + 180.0) / kStepDeg;
+    if (fx < 0.0)
+      fx += kCols - 1;
+    else if (fx >= kCols - 1)
+      fx -= kCols - 1;
+    int y0 = std::min(static_cast<int>(fy), kRows - 2);
+    int x0 = std::clamp(static_cast<int>(fx), 0, kCols - 2);
+    double ty = fy - y0;
+    double tx = fx - x0;
+
+    const IonoPoint &a = nodes_[y0 * kCols + x0];
+    const IonoPoint &b = nodes_[y0 * kCols + x0 + 1];
+    const IonoPoint &c = nodes_[(y0 + 1) * kCols + x0];
+    const IonoPoint &d = nodes_[(y0 + 1) * kCols + x0 + 1];
+    double wa = (1.0 - tx) * (1.0 - ty), wb = tx * (1.0 - ty);
+    double wc = (1.0 - tx) * ty, wd = tx * ty;
+    auto mix = [&](double IonoPoint::*f) {
+      return a.*f * wa + b.*f * wb + c.*f * wc + d.*f * wd;
+    };
+    IonoPoint p;
+    p.foF2 = mix(&IonoPoint::foF2);
+    p.foE = mix(&IonoPoint::foE);
+    p.hmF2 = mix(&IonoPoint::hmF2);
+    p.absorption = mix(&IonoPoint::absorption);
+    p.b = mix(&IonoPoint::b);
+    p.dmax = mix(&IonoPoint::dmax);
+    p.c3000 = mix(&IonoPoint::c3000);
+    p.maxHop = mix(&IonoPoint::maxHop);
+    return p;
+  }
+
+  // At a point given as a (not necessarily unit) vector.
+  IonoPoint at(double x, double y, double z) const {
+    double n = std::sqrt(x * x + y * y + z * z);
+    return at(std::asin(std::clamp(z / n, -1.0, 1.0)) / kDeg,
+              std::atan2(y, x) / kDeg);
+  }
+
+private:
+  static constexpr int kStepDeg = 5;
+  static constexpr int kRows = 180 / kStepDeg + 1;
+  static constexpr int kCols = 360 / kStepDeg + 1; // 180E repeats 180W
+
+  std::vector<IonoPoint> nodes_ = std::vector<IonoPoint>(kRows * kCols);
+};
+
+// Everything that is the same for every pixel of one map.
+struct CoverageModel {
+  const IonoMap &iono;
+  const DrapGrid *drap;
+  CoverageOutput output;
+  double txLat, txLon;
+  double ax, ay, az; // transmitter unit vector
+  IonoPoint tx;
+  bool longPath;
+  double mhz;
+  double ptDbw;
+  double noiseDbw;    // in 1 Hz
+  double fieldToDbw;  // dB(1 uV/m) to dBW into an isotropic antenna
+  double requiredSnr; // dB-Hz
+  double absorptionDenom;
+  double kIndex;
+  double maxEHop;
+  double minTanElevation;
+
+  struct Mode {
+    double muf, tanElevation, fieldDbu, reliability;
+  };
+
+  // Field strength and reliability of an n-hop mode.
+  Mode mode(int hops, const Hop &hop, double muf, bool eLayer,
+            const IonoPoint &rx, const IonoPoint &mid, double midLat,
+            double extraAbsorptionDb) const {
+    // George-Bradley absorption. The first and last D-region crossings are
+    // near the ends, the others near the midpoint.
+    double li = 677.2 * hop.secIncidence(kDHeight) *
+                (tx.absorption + rx.absorption +
+                 (2.0 * hops - 2.0) * mid.absorption) /
+                2.0 / absorptionDenom;
+    li = std::max(li, extraAbsorptionDb);
+
+    double lm = 0.0;
+    if (mhz > muf)
+      lm = eLayer ? 130.0 * (mhz / muf - 1.0) * (mhz / muf - 1.0)
+                  : 36.0 * std::sqrt(mhz / muf - 1.0);
+    double lg = kGroundLossDb * (hops - 1);
+    // Auroral losses; geographic latitude stands in for geomagnetic.
+    double lh = std::abs(midLat) >= 67.0 - 2.0 * kIndex
+                    ? hops * (2.0 + 1.5 * kIndex)
+                    : 0.0;
+
+    Mode m{muf, hop.tanElevation, 0.0, 0.0};
+    m.fieldDbu = 104.15 + ptDbw - 20.0 * std::log10(hops * hop.slantKm) - li -
+                 lm - lg - lh - kLzDb;
+    if (output == CoverageOutput::Reliability ||
+        output == CoverageOutput::Toa) {
+      double sigma = eLayer ? kEMufSigma : kF2MufSigma;
+      double snr = m.fieldDbu + fieldToDbw - noiseDbw;
+      m.reliability = normalCdf((muf - mhz) / (sigma * muf)) *
+                      normalCdf((snr - requiredSnr) / kSnrSigmaDb);
+    }
+    return m;
+  }
+
+  float pixel(double lat, double lon, double bx, double by, double bz,
+              double cosAngle) const {
+    double shortAngle = std::acos(cosAngle);
+    if (shortAngle * kEarthR < 10.0) {
+      switch (output) {
+      case CoverageOutput::Muf:
+        return static_cast<float>(tx.foF2);
+      case CoverageOutput::Reliability:
+        return 100.0f;
+      default:
+        return 0.0f;
+      }
+    }
+    double angle = longPath ? 2.0 * M_PI - shortAngle : shortAngle;
+    double distKm = angle * kEarthR;
+
+    // The long path midpoint is the antipode of the short one; at the
+    // antipode itself any great circle will do.
+    double sign = longPath ? -1.0 : 1.0;
+    double mx = sign * (ax + bx), my = sign * (ay + by), mz = sign * (az + bz);
+    double midLat = txLat, midLon = txLon;
+    if (mx * mx + my * my + mz * mz > 1e-12) {
+      midLat = std::asin(std::clamp(
+                   mz / std::sqrt(mx * mx + my * my + mz * mz), -1.0, 1.0)) /
+               kDeg;
+      midLon = std::atan2(my, mx) / kDeg;
+    }
+    IonoPoint mid = iono.at(midLat, midLon);
+
+    // F2: the lowest order mode and the next two. Beyond one hop the MUF
+    // is the lower of the control points half a hop in from each end.
+    int n0 = std::max(1, static_cast<int>(std::ceil(
+                             distKm / std::min(mid.dmax, mid.maxHop))));
+    IonoPoint first = mid, last = mid;
+    double s = std::sin(angle);
+    if (n0 > 1 && std::abs(s) > 1e-6) {
+      double t = 1.0 / (2.0 * n0);
+      double wa = std::sin((1.0 - t) * angle) / s;
+      double wb = std::sin(t * angle) / s;
+      first = iono.at(wa * ax + wb * bx, wa * ay + wb * by, wa * az + wb * bz);
+      last = iono.at(wb * ax + wa * bx, wb * ay + wa * by, wb * az + wa * bz);
+    }
+    auto f2Muf = [&](double hopKm) {
+      return std::min(first.f2Muf(hopKm), last.f2Muf(hopKm));
+    };
+    double f2Height = (first.hmF2 + last.hmF2) / 2.0;
+
+    // E: the lowest order mode on paths short enough for it to matter.
+    bool eMode = distKm <= 4000.0 && mid.foE > 1.0;
+    int eHops = eMode ? static_cast<int>(std::ceil(distKm / maxEHop)) : 0;
+    std::optional<Hop> eHop;
+    double eMuf = 0.0;
+    if (eMode) {
+      eHop.emplace(distKm / eHops, kEHeight);
+      eMuf = mid.foE * eHop->secIncidence(kEHeight);
+    }
+
+    if (output == CoverageOutput::Muf)
+      return static_cast<float>(std::max(f2Muf(distKm / n0), eMuf));
+
+    IonoPoint rx = iono.at(lat, lon);
+    double extraDb = 0.0;
+    if (drap)
+      extraDb = PropEngine::calculateAbsorption(*drap, txLat, txLon, lat, lon,
+                                                midLat, midLon, distKm, mhz);
+
+    Mode modes[4];
+    int count = 0;
+    for (int hops = n0; hops < n0 + 3; ++hops) {
+      Hop hop(distKm / hops, f2Height);
+      if (hop.tanElevation >= minTanElevation)
+        modes[count++] = mode(hops, hop, f2Muf(distKm / hops), false, rx, mid,
+                              midLat, extraDb);
+    }
+    if (eMode)
+      modes[count++] =
+          mode(eHops, *eHop, eMuf, true, rx, mid, midLat, extraDb);
+
+    switch (output) {
+    case CoverageOutput::FieldStrength:
+    case CoverageOutput::Snr: {
+      // Mode powers add.
+      double power = 0.0;
+      for (int i = 0; i < count; ++i)
+        power += std::pow(10.0, modes[i].fieldDbu / 10.0);
+      if (power <= 0.0)
+        return 0.0f;
+      double fieldDbu = 10.0 * std::log10(power);
+      return static_cast<float>(output == CoverageOutput::Snr
+                                    ? fieldDbu + fieldToDbw - noiseDbw
+                                    : fieldDbu);
+    }
+    default: {
+      // The path is as reliable as its best mode.
+      const Mode *best = nullptr;
+      for (int i = 0; i < count; ++i) {
+        if (!best || modes[i].reliability > best->reliability)
+          best = &modes[i];
+      }
+      if (!best)
+        return 0.0f;
+      if (output == CoverageOutput::Reliability)
+        return static_cast<float>(100.0 * best->reliability);
+      return best->muf >= mhz
+                 ? static_cast<float>(std::atan(best->tanElevation) / kDeg)
+                 : 0.0f;
+    }
+    }
+  }
+};
+
+} // namespace
+
+std::vector<float>
+PropEngine::generateCoverage(const PropPathParams &params, const SolarData &sw,
+                             const class IonosondeProvider *ionoProvider,
+                             CoverageOutput output, const DrapGrid *drap,
+                             TaskPriority priority) {
+  std::time_t utc = params.utc ? params.utc : std::time(nullptr);
+  double ssn = (sw.sunspot_number > 0) ? (double)sw.sunspot_number : 50.0;
+  IonoMap iono(ionoProvider, ssn, utc);
+
+  double mhz = std::max(1.0, params.mhz);
+  double logF = std::log10(mhz);
+  // P.372 rural man-made and galactic noise; kT0 is -204 dBW/Hz.
+  double fam = 10.0 * std::log10(std::pow(10.0, (67.2 - 27.7 * logF) / 10.0) +
+                                 std::pow(10.0, (52.0 - 23.0 * logF) / 10.0));
+
+  double txPhi = params.txLat * kDeg;
+  double txLam = params.txLon * kDeg;
+  CoverageModel model{iono,
+                      drap,
+                      output,
+                      params.txLat,
+                      params.txLon,
+                      std::cos(txPhi) * std::cos(txLam),
+                      std::cos(txPhi) * std::sin(txLam),
+                      std::sin(txPhi),
+                      iono.at(params.txLat, params.txLon),
+                      params.path == 1,
+                      mhz,
+                      10.0 * std::log10(std::max(0.01, params.watts)),
+                      fam - 204.0,
+                      -20.0 * logF - 107.2,
+                      kSsbRequiredSnrDbHz - modeAdvantageDb(params.mode),
+                      std::pow(mhz + kGyroMhz, 1.98) + 10.2,
+                      static_cast<double>(sw.k_index),
+                      maxHopKm(kEHeight),
+                      std::tan(kMinElevation) - 1e-9};
+
+  std::vector<double> lons(MAP_W), cosLon(MAP_W), sinLon(MAP_W);
+  for (int x = 0; x < MAP_W; ++x) {
+    lons[x] = (x * 360.0 / MAP_W) - 180.0;
+    cosLon[x] = std::cos(lons[x] * kDeg);
+    sinLon[x] = std::sin(lons[x] * kDeg);
+  }
+
+  std::vector<float> grid(MAP_W * MAP_H);
+  WorkerService::getInstance().parallelFor(
+      MAP_H, 8,
+      [&](size_t y0, size_t y1) {
+        std::vector<double> bx(MAP_W), by(MAP_W), cosAngle(MAP_W);
+        for (size_t y = y0; y < y1; ++y) {
+          double lat = 90.0 - (y * 180.0 / MAP_H);
+          double sinLat = std::sin(lat * kDeg);
+          double cosLat = std::cos(lat * kDeg);
+
+          // Straight-line arithmetic over the row, which the compiler
+          // vectorises; the per-pixel pass below is mostly trig.
+          for (int x = 0; x < MAP_W; ++x) {
+            bx[x] = cosLat * cosLon[x];
+            by[x] = cosLat * sinLon[x];
+            cosAngle[x] = std::min(
+                1.0, std::max(-1.0, model.ax * bx[x] + model.ay * by[x] +
+                                        model.az * sinLat));
+          }
+
+          float *out = grid.data() + y * MAP_W;
+          for (int x = 0; x < MAP_W; ++x)
+            out[x] = model.pixel(lat, lons[x], bx[x], by[x], sinLat,
+                                 cosAngle[x]);
+        }
+      },
+      priority);
+
+  return grid;
+}
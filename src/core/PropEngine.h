@@ -1,7 +1,10 @@
 #pragma once
 
+#include "DrapData.h"
 #include "IonosondeData.h"
 #include "SolarData.h"
+#include "WorkerService.h"
+#include <ctime>
 #include <string>
 #include <vector>
 
@@ -13,6 +16,16 @@ struct PropPathParams {
   std::string mode; // "SSB", "CW", "FT8", etc.
   int toa;          // Take-off angle (approx)
   int path;         // 0=Short, 1=Long
+  std::time_t utc = 0; // Time of the prediction, 0 = now
+};
+
+// Layers of an area coverage map, see PropEngine::generateCoverage().
+enum class CoverageOutput {
+  Muf,           // operational MUF of the path, MHz
+  FieldStrength, // median field strength, dB(1 uV/m)
+  Snr,           // median signal-to-noise ratio, dB-Hz
+  Reliability,   // chance the SNR meets the mode's requirement, 0-100 %
+  Toa,           // elevation of the most reliable mode, degrees (0 = none)
 };
 
 class PropEngine {
@@ -65,15 +78,56 @@ public:
    */
   static double calculateTOA(double distKm, double muf, double freqMhz);
 
+  /**
+   * D-region absorption (dB) along a path, from the DRAP grid.
+   * The D region is crossed twice per hop; the first and last crossings are
+   * sampled near the end points and the others at the path midpoint.
+   * @param freqMhz Operating frequency
+   * @return Total one-way absorption in dB (0 if the grid shows none)
+   */
+  static double calculateAbsorption(const DrapGrid &drap, double txLat,
+                                    double txLon, double rxLat, double rxLon,
+                                    double midLat, double midLon,
+                                    double distKm, double freqMhz);
+
   /**
    * Generate a 660x330 grid of values.
    * @param params Transmission parameters
    * @param swSpaceWeather Current space weather (SFI, SSN, K, etc.)
    * @param ionoProvider Reference to provider for fetching iono data per-point
    * @param outputType 0=MUF, 1=Reliability, 2=TOA (take-off angle)
+   * @param drap Current DRAP grid (optional); its absorption comes off the
+   *             signal margin of each reliability path
    * @return vector of floats (0-100 for Rel, 0-50 for MUF, 0-40 for TOA degrees)
    */
   static std::vector<float>
   generateGrid(const PropPathParams &params, const SolarData &sw,
-               const class IonosondeProvider *ionoProvider, int outputType);
+               const class IonosondeProvider *ionoProvider, int outputType,
+               const DrapGrid *drap = nullptr);
+
+  /**
+   * Point-to-area HF prediction from the transmitter to every pixel of a
+   * 660x330 map, after ITU-R P.533: E and F2 modes are selected per path
+   * from foF2, M(3000)F2, hmF2 and foE at its control points, and each
+   * mode's field strength, SNR against P.372 rural noise and MUF
+   * probability give the reliability. Ionosonde data is used where there
+   * is any and blends into a sunspot/zenith-angle model elsewhere.
+   * Rows are spread over the calling thread and idle workers. One map
+   * costs about 80 ms (MUF) to 200 ms (the other layers) of CPU on a
+   * single desktop x86 core, so callers should not recompute it per frame
+   * or per request.
+   * @param params Transmitter, frequency, mode, power, path and time
+   * @param sw Space weather (SSN, K)
+   * @param ionoProvider Ionosonde data (optional)
+   * @param output Layer to return
+   * @param drap Current DRAP grid (optional); replaces the modelled
+   *             D-region absorption where it reports more
+   * @param priority Lane the worker helpers are queued in
+   * @return MAP_W x MAP_H floats, row 0 at 90N, column 0 at 180W
+   */
+  static std::vector<float>
+  generateCoverage(const PropPathParams &params, const SolarData &sw,
+                   const class IonosondeProvider *ionoProvider,
+                   CoverageOutput output, const DrapGrid *drap = nullptr,
+                   TaskPriority priority = TaskPriority::Interactive);
 };
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <tuple>
+#include <utility>
+
+// A small pull-based dependency graph for values derived from DE/DX, time
+// and solar data. Every node has a version that goes up when its value
+// changes. A Derived node recomputes lazily, on the first read after one of
+// its inputs moved, and keeps its version when the result is the same
+// within its tolerance. Consumers hold a Watch and ask changed() instead of
+// caching and comparing the inputs themselves.
+//
+// Nodes may be set and read from any thread. The graph must be acyclic,
+// and every node must outlive the nodes and watches that read it.
+namespace Reactive {
+
+template <typename T>
+using SameFn = std::function<bool(const T &a, const T &b)>;
+
+template <typename T> bool equal(const T &a, const T &b) { return a == b; }
+
+template <typename T> class Node {
+public:
+  virtual ~Node() = default;
+  virtual T get() const = 0;
+  // Increases whenever get() would return a different value.
+  virtual uint64_t version() const = 0;
+};
+
+// An input of the graph.
+template <typename T> class Source : public Node<T> {
+public:
+  explicit Source(T initial = T{}, SameFn<T> same = equal<T>)
+      : value_(std::move(initial)), same_(std::move(same)) {}
+
+  // True if value differs from the current one beyond the tolerance.
+  bool set(const T &value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (same_(value_, value))
+      return false;
+    value_ = value;
+    version_.fetch_add(1, std::memory_order_release);
+    return true;
+  }
+
+  T get() const override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return value_;
+  }
+
+  uint64_t version() const override {
+    return version_.load(std::memory_order_acquire);
+  }
+
+private:
+  mutable std::mutex mutex_;
+  T value_;
+  SameFn<T> same_;
+  std::atomic<uint64_t> version_{1};
+};
+
+// fn(inputs...) cached until an input changes. A recomputed value that is
+// the same as the cached one (per same) does not count as a change, so a
+// coarse node in front of an expensive consumer filters out small moves.
+template <typename T, typename... In> class Derived : public Node<T> {
+public:
+  using Fn = std::function<T(const In &...)>;
+
+  Derived(Fn fn, SameFn<T> same, const Node<In> &...inputs)
+      : fn_(std::move(fn)), same_(std::move(same)), inputs_(&inputs...) {}
+
+  T get() const override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    refresh(std::index_sequence_for<In...>{});
+    return value_;
+  }
+
+  uint64_t version() const override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    refresh(std::index_sequence_for<In...>{});
+    return version_;
+  }
+
+private:
+  template <size_t... I> void refresh(std::index_sequence<I...>) const {
+    // Versions are read before values: a racing set() costs at most one
+    // extra recompute, never a missed one.
+    std::array<uint64_t, sizeof...(In)> seen = {
+        std::get<I>(inputs_)->version()...};
+    if (version_ && seen == seen_)
+      return;
+    seen_ = seen;
+    T v = fn_(std::get<I>(inputs_)->get()...);
+    if (version_ && same_(value_, v))
+      return;
+    value_ = std::move(v);
+    ++version_;
+  }
+
+  Fn fn_;
+  SameFn<T> same_;
+  std::tuple<const Node<In> *...> inputs_;
+
+  mutable std::mutex mutex_;
+  mutable T value_{};
+  mutable std::array<uint64_t, sizeof...(In)> seen_{};
+  mutable uint64_t version_ = 0; // 0 = never computed
+};
+
+// A consumer's view of a node: changed() is true on the first call and then
+// once after each change of the node.
+template <typename T> class Watch {
+public:
+  explicit Watch(const Node<T> &node) : node_(&node) {}
+
+  bool changed() {
+    uint64_t v = node_->version();
+    if (v == seen_)
+      return false;
+    seen_ = v;
+    return true;
+  }
+
+  T get() const { return node_->get(); }
+
+private:
+  const Node<T> *node_;
+  uint64_t seen_ = 0;
+};
+
+} // namespace Reactive
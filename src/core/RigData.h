@@ -4,27 +4,6 @@
 #include <mutex>
 #include <string>
 
-// Rig command types for async execution
-enum class RigCommand {
-  SET_FREQ,    // Set VFO frequency
-  GET_FREQ,    // Get VFO frequency
-  SET_MODE,    // Set operating mode
-  GET_MODE,    // Get operating mode
-  SET_PTT,     // Set PTT state
-  GET_PTT,     // Get PTT state
-  DISCONNECT,  // Disconnect from rig
-};
-
-// Command structure for producer-consumer queue
-struct RigCommandRequest {
-  RigCommand command;
-  long long freqHz = 0;        // For SET_FREQ
-  std::string mode;             // For SET_MODE (USB, LSB, CW, FM, etc.)
-  int passbandHz = 0;           // For SET_MODE
-  bool ptt = false;             // For SET_PTT
-  std::string customCmd;        // For raw Hamlib commands
-};
-
 // Rig state and status data
 struct RigData {
   long long freqHz = 0;         // Current VFO frequency in Hz
@@ -58,6 +37,19 @@ public:
     data_.lastUpdate = std::chrono::system_clock::now();
   }
 
+  void setMode(const std::string &mode, int passbandHz) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    data_.mode = mode;
+    data_.passbandHz = passbandHz;
+    data_.lastUpdate = std::chrono::system_clock::now();
+  }
+
+  void setPTT(bool ptt) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    data_.ptt = ptt;
+    data_.lastUpdate = std::chrono::system_clock::now();
+  }
+
   void setConnected(bool connected) {
     std::lock_guard<std::mutex> lock(mutex_);
     data_.connected = connected;
@@ -0,0 +1,270 @@
+#include "SatPassEngine.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace {
+
+constexpr double kDeg2Rad = 3.14159265358979323846 / 180.0;
+constexpr double kRad2Deg = 180.0 / 3.14159265358979323846;
+
+// Elevation-only view of one satellite, used by the scanner.
+double elevationAt(const predict_orbital_elements_t *el,
+                   const predict_observer_t *obs, std::time_t t) {
+  struct predict_position pos{};
+  predict_orbit(el, &pos, predict_to_julian(t));
+  if (pos.decayed)
+    return -90.0;
+  struct predict_observation o{};
+  predict_observe_orbit(obs, &pos, &o);
+  return o.elevation * kRad2Deg;
+}
+
+} // namespace
+
+SatPassEngine::Catalog::~Catalog() {
+  for (auto *el : elements)
+    predict_destroy_orbital_elements(el);
+}
+
+void SatPassEngine::setCatalog(const std::vector<SatelliteTLE> &tles) {
+  // Parse outside the lock; a scan in flight keeps the old catalog alive.
+  auto cat = std::make_shared<Catalog>();
+  cat->elements.reserve(tles.size());
+  for (const auto &tle : tles) {
+    predict_orbital_elements_t *el =
+        predict_parse_tle(tle.line1.c_str(), tle.line2.c_str());
+    if (!el)
+      continue;
+
+    // Scan step ~1/100 of the orbital period: about a minute for LEO.
+    // Geosynchronous birds never rise or set, so they are not scanned.
+    int step = 0;
+    if (!predict_is_geosynchronous(el) && el->mean_motion > 0.0) {
+      double periodSec = 86400.0 / el->mean_motion;
+      step = std::clamp(static_cast<int>(periodSec / 100.0), 30, 300);
+    }
+
+    cat->elements.push_back(el);
+    cat->noradIds.push_back(tle.noradId);
+    cat->names.push_back(tle.name);
+    cat->stepSec.push_back(step);
+  }
+
+  std::lock_guard<std::mutex> lock(scanMutex_);
+  scannedTo_.assign(cat->elements.size(), 0);
+  catalog_ = std::move(cat);
+  ++generation_;
+  std::lock_guard<std::mutex> tableLock(tableMutex_);
+  passes_.clear();
+  horizon_ = 0;
+}
+
+void SatPassEngine::setObserver(double latDeg, double lonDeg,
+                                double altMeters) {
+  ObserverPtr obs(predict_create_observer("QTH", latDeg * kDeg2Rad,
+                                          lonDeg * kDeg2Rad, altMeters),
+                  predict_destroy_observer);
+
+  std::lock_guard<std::mutex> lock(scanMutex_);
+  observer_ = std::move(obs);
+  std::fill(scannedTo_.begin(), scannedTo_.end(), 0);
+  ++generation_;
+  std::lock_guard<std::mutex> tableLock(tableMutex_);
+  passes_.clear();
+  horizon_ = 0;
+}
+
+void SatPassEngine::scan(const Catalog &cat, const predict_observer_t *obs,
+                         size_t i, std::time_t from, std::time_t until,
+                         std::time_t &scannedTo,
+                         std::vector<UpcomingPass> &out) {
+  const int step = cat.stepSec[i];
+  if (step <= 0)
+    return;
+
+  const predict_orbital_elements_t *sat = cat.elements[i];
+  auto azimuthAt = [&](std::time_t t) {
+    struct predict_position pos{};
+    predict_orbit(sat, &pos, predict_to_julian(t));
+    struct predict_observation o{};
+    predict_observe_orbit(obs, &pos, &o);
+    return std::fmod(o.azimuth * kRad2Deg + 360.0, 360.0);
+  };
+  // First second at which the satellite is above the horizon if `rising`,
+  // or below it otherwise, between a and b (1 s resolution).
+  auto crossing = [&](std::time_t a, std::time_t b, bool rising) {
+    while (b - a > 1) {
+      std::time_t mid = a + (b - a) / 2;
+      if ((elevationAt(sat, obs, mid) > 0.0) == rising)
+        b = mid;
+      else
+        a = mid;
+    }
+    return b;
+  };
+
+  // Never scanned (or fallen behind): start from now.
+  std::time_t t = std::max(scannedTo, from);
+  double el = elevationAt(sat, obs, t);
+  bool up = el > 0.0;
+  SatPass pass;
+  std::time_t maxT = t;
+  double maxEl = el;
+
+  // Fresh start in the middle of a pass: walk back to find its AOS.
+  if (up) {
+    std::time_t b = t;
+    for (int guard = 0; guard < 360 && elevationAt(sat, obs, b - step) > 0.0;
+         ++guard)
+      b -= step;
+    pass.aosTime = crossing(b - step, b, true);
+    pass.aosAz = azimuthAt(pass.aosTime);
+  }
+
+  // A pass still open at `until` is followed to its LOS, within reason.
+  const std::time_t limit = until + 6 * 3600;
+  while (up ? t < limit : t < until) {
+    std::time_t tn = t + step;
+    double en = elevationAt(sat, obs, tn);
+
+    if (!up && en > 0.0) {
+      up = true;
+      pass = SatPass{};
+      pass.aosTime = crossing(t, tn, true);
+      pass.aosAz = azimuthAt(pass.aosTime);
+      maxEl = en;
+      maxT = tn;
+    } else if (up && en > 0.0) {
+      if (en > maxEl) {
+        maxEl = en;
+        maxT = tn;
+      }
+    } else if (up) {
+      up = false;
+      pass.losTime = crossing(t, tn, false);
+      pass.losAz = azimuthAt(pass.losTime);
+
+      // Refine the culmination around the best coarse sample.
+      std::time_t lo = std::max(pass.aosTime, maxT - step);
+      std::time_t hi = std::min(pass.losTime, maxT + step);
+      while (hi - lo > 2) {
+        std::time_t m1 = lo + (hi - lo) / 3;
+        std::time_t m2 = hi - (hi - lo) / 3;
+        if (elevationAt(sat, obs, m1) < elevationAt(sat, obs, m2))
+          lo = m1;
+        else
+          hi = m2;
+      }
+      pass.maxEl = std::max(maxEl, elevationAt(sat, obs, lo + (hi - lo) / 2));
+
+      out.push_back({cat.noradIds[i], cat.names[i], pass});
+    }
+    t = tn;
+  }
+
+  scannedTo = t;
+}
+
+void SatPassEngine::refresh(std::time_t now) {
+  std::lock_guard<std::mutex> refreshLock(refreshMutex_);
+
+  std::shared_ptr<const Catalog> cat;
+  ObserverPtr obs;
+  std::vector<std::time_t> scannedTo;
+  uint64_t generation;
+  {
+    std::lock_guard<std::mutex> lock(scanMutex_);
+    cat = catalog_;
+    obs = observer_;
+    scannedTo = scannedTo_;
+    generation = generation_;
+  }
+  if (!obs || !cat || cat->elements.empty())
+    return;
+
+  auto started = std::chrono::steady_clock::now();
+  const std::time_t until = now + kWindowHours * 3600;
+  const size_t n = cat->elements.size();
+
+  unsigned nThreads = 1;
+#ifndef __EMSCRIPTEN__
+  nThreads = std::clamp(std::thread::hardware_concurrency(), 1u, 4u);
+#endif
+  std::vector<std::vector<UpcomingPass>> found(nThreads);
+  auto work = [&](unsigned tid) {
+    for (size_t i = tid; i < n; i += nThreads)
+      scan(*cat, obs.get(), i, now, until, scannedTo[i], found[tid]);
+  };
+  std::vector<std::thread> pool;
+  for (unsigned tid = 1; tid < nThreads; ++tid)
+    pool.emplace_back(work, tid);
+  work(0);
+  for (auto &th : pool)
+    th.join();
+
+  // Publish the new horizons and passes, unless the catalog or observer was
+  // replaced meanwhile: the table has been cleared and the next refresh
+  // starts over.
+  std::lock_guard<std::mutex> lock(scanMutex_);
+  if (generation != generation_) {
+    LOG_D("SatPassEngine", "Catalog or observer changed during scan, "
+          "discarding");
+    return;
+  }
+  scannedTo_.swap(scannedTo);
+
+  size_t added = 0;
+  {
+    std::lock_guard<std::mutex> lock(tableMutex_);
+    passes_.erase(std::remove_if(passes_.begin(), passes_.end(),
+                                 [now](const UpcomingPass &p) {
+                                   return p.pass.losTime < now;
+                                 }),
+                  passes_.end());
+    for (auto &batch : found) {
+      added += batch.size();
+      passes_.insert(passes_.end(), std::make_move_iterator(batch.begin()),
+                     std::make_move_iterator(batch.end()));
+    }
+    std::sort(passes_.begin(), passes_.end(),
+              [](const UpcomingPass &a, const UpcomingPass &b) {
+                return a.pass.aosTime < b.pass.aosTime;
+              });
+
+    nextLos_ = until;
+    for (const auto &p : passes_)
+      nextLos_ = std::min(nextLos_, p.pass.losTime);
+    horizon_ = until;
+  }
+
+  auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - started)
+                .count();
+  LOG_D("SatPassEngine", "Scanned {} satellites on {} threads: {} new passes "
+        "in {} ms", n, nThreads, added, ms);
+}
+
+bool SatPassEngine::needsRefresh(std::time_t now) const {
+  std::lock_guard<std::mutex> lock(tableMutex_);
+  // Refresh when a pass ends, and at least hourly to extend the window.
+  return horizon_ == 0 || now > nextLos_ ||
+         now + kWindowHours * 3600 - horizon_ > 3600;
+}
+
+std::vector<UpcomingPass> SatPassEngine::nextPasses(size_t count,
+                                                    double minElDeg,
+                                                    std::time_t after) const {
+  std::vector<UpcomingPass> result;
+  std::lock_guard<std::mutex> lock(tableMutex_);
+  for (const auto &p : passes_) {
+    if (result.size() >= count)
+      break;
+    if (p.pass.losTime > after && p.pass.maxEl >= minElDeg)
+      result.push_back(p);
+  }
+  return result;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "SatelliteTypes.h"
+
+#include <predict/predict.h>
+
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Catalog-wide pass prediction. refresh() sweeps the whole catalog across
+// worker threads and keeps a table of upcoming passes sorted by AOS. Each
+// satellite remembers how far it has been scanned, so later refreshes only
+// propagate the new tail of the look-ahead window. The scan works on a
+// snapshot of the catalog and observer, so setCatalog(), setObserver() and
+// readers are never blocked behind it.
+class SatPassEngine {
+public:
+  SatPassEngine() = default;
+
+  SatPassEngine(const SatPassEngine &) = delete;
+  SatPassEngine &operator=(const SatPassEngine &) = delete;
+
+  // Replace the catalog. Invalidates the pass table.
+  void setCatalog(const std::vector<SatelliteTLE> &tles);
+
+  // Set the observer location. Invalidates the pass table.
+  void setObserver(double latDeg, double lonDeg, double altMeters = 0.0);
+
+  // Drop expired passes and scan every satellite up to now + window.
+  // Expensive on the first call; run from a worker thread.
+  void refresh(std::time_t now);
+
+  // True when a pass has ended or the window needs extending.
+  bool needsRefresh(std::time_t now) const;
+
+  // Next `count` passes reaching at least minElDeg that have not ended by
+  // `after`, in AOS order.
+  std::vector<UpcomingPass> nextPasses(size_t count, double minElDeg,
+                                       std::time_t after) const;
+
+  static constexpr int kWindowHours = 24;
+
+private:
+  // Immutable once built; shared with any scan in flight.
+  struct Catalog {
+    ~Catalog();
+    // Propagator state is allocated and owned by libpredict (the SGP4/SDP4
+    // model hangs off each element set), so it stays one pointer per
+    // satellite. The scanner's own per-satellite fields are plain arrays.
+    std::vector<predict_orbital_elements_t *> elements;
+    std::vector<int> noradIds;
+    std::vector<std::string> names;
+    std::vector<int> stepSec; // coarse scan step, 0 = never rises or sets
+  };
+  using ObserverPtr = std::shared_ptr<predict_observer_t>;
+
+  static void scan(const Catalog &cat, const predict_observer_t *obs,
+                   size_t i, std::time_t from, std::time_t until,
+                   std::time_t &scannedTo, std::vector<UpcomingPass> &out);
+
+  // Current catalog, observer and per-satellite scan horizon. Guarded by
+  // scanMutex_, which is only held to snapshot or publish them;
+  // generation_ changes whenever the catalog or observer is replaced.
+  std::shared_ptr<const Catalog> catalog_;
+  ObserverPtr observer_;
+  std::vector<std::time_t> scannedTo_;
+  uint64_t generation_ = 0;
+  mutable std::mutex scanMutex_;
+  // Serialises refresh() calls so two scans never cover the same span.
+  std::mutex refreshMutex_;
+
+  // Pass table, sorted by AOS. Guarded by tableMutex_.
+  std::vector<UpcomingPass> passes_;
+  std::time_t nextLos_ = 0;
+  std::time_t horizon_ = 0;
+  mutable std::mutex tableMutex_;
+};
@@ -1,6 +1,7 @@
 #include "SatelliteManager.h"
 #include "../services/RotatorService.h"
 #include "Logger.h"
+#include "WorkerService.h"
 
 #include <algorithm>
 #include <cctype>
@@ -41,8 +42,20 @@ void SatelliteManager::fetch(bool force) {
 }
 
 void SatelliteManager::update() {
-  // Deprecated: Tracking logic moved to RotatorService::pollLoop
-  // This function is kept for API compatibility but is now a no-op
+  std::time_t now = std::time(nullptr);
+  if (!hasData() || passRefreshBusy_ || !passEngine_.needsRefresh(now))
+    return;
+
+  passRefreshBusy_ = true;
+  WorkerService::getInstance().submitTask([this, now]() {
+    passEngine_.refresh(now);
+    passRefreshBusy_ = false;
+  });
+}
+
+std::vector<UpcomingPass>
+SatelliteManager::upcomingPasses(size_t count, double minElDeg) const {
+  return passEngine_.nextPasses(count, minElDeg, std::time(nullptr));
 }
 
 void SatelliteManager::trackSatellite(const std::string &satName) {
@@ -129,6 +142,7 @@ void SatelliteManager::parse(const std::string &raw) {
   }
 
   LOG_I("SatelliteManager", "Parsed {} satellites", result.size());
+  passEngine_.setCatalog(result);
 
   std::lock_guard<std::mutex> lock(mutex_);
   satellites_ = std::move(result);
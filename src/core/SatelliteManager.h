@@ -2,7 +2,9 @@
 
 #include "../network/NetworkManager.h"
 #include "OrbitPredictor.h"
+#include "SatPassEngine.h"
 #include "SatelliteTypes.h"
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <mutex>
@@ -21,6 +23,8 @@ public:
       now = std::time(nullptr);
     return predictor_.observeAt(now);
   }
+  // Interpolated from the pass cache; cheap enough to call at any rate.
+  SatObservation track(double utc) const { return predictor_.trackAt(utc); }
   const std::string &getName() const { return tle_.name; }
   const SatelliteTLE &getTLE() const { return tle_; }
 
@@ -34,9 +38,16 @@ public:
   explicit SatelliteManager(NetworkManager &net);
   void fetch(bool force = false);
 
-  // Deprecated: Tracking logic moved to RotatorService
+  // Schedules a background refresh of the pass table when a pass has ended
+  // or the look-ahead window needs extending. Cheap; call every tick.
+  // (Rotator tracking lives in RotatorService.)
   void update();
 
+  // Next `count` passes over the observer reaching minElDeg, across the
+  // whole catalog, in AOS order. Thread-safe.
+  std::vector<UpcomingPass> upcomingPasses(size_t count,
+                                           double minElDeg = 0.0) const;
+
   std::vector<SatelliteTLE> getSatellites() const;
   bool hasData() const;
   const SatelliteTLE *findByNoradId(int noradId) const;
@@ -49,6 +60,7 @@ public:
   void setObserver(double lat, double lon) {
     obsLat_ = lat;
     obsLon_ = lon;
+    passEngine_.setObserver(lat, lon);
   }
 
 private:
@@ -69,4 +81,7 @@ private:
   std::unique_ptr<Satellite> currentSat_;
   double obsLat_ = 0.0;
   double obsLon_ = 0.0;
+
+  SatPassEngine passEngine_;
+  std::atomic<bool> passRefreshBusy_{false};
 };
@@ -36,11 +36,20 @@ struct SatPass {
   double maxEl = 0.0;      // max elevation during pass (degrees)
 };
 
+// An entry in the catalog-wide pass table.
+struct UpcomingPass {
+  int noradId = 0;
+  std::string name;
+  SatPass pass;
+};
+
 // Ground track point for orbit path rendering.
 struct GroundTrackPoint {
   double lat = 0.0;
   double lon = 0.0;
+  std::time_t t = 0; // UTC time of the sample
 
   GroundTrackPoint() = default;
-  GroundTrackPoint(double la, double lo) : lat(la), lon(lo) {}
+  GroundTrackPoint(double la, double lo, std::time_t ts = 0)
+      : lat(la), lon(lo), t(ts) {}
 };
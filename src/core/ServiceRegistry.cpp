@@ -0,0 +1,257 @@
+#include "ServiceRegistry.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fmt/format.h>
+#include <utility>
+#include <vector>
+
+namespace {
+
+int64_t systemNowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+// Label values may not contain raw backslashes, quotes or newlines.
+std::string escapeLabel(std::string_view v) {
+  std::string out;
+  out.reserve(v.size());
+  for (char c : v) {
+    if (c == '\\' || c == '"') {
+      out += '\\';
+      out += c;
+    } else if (c == '\n') {
+      out += "\\n";
+    } else {
+      out += c;
+    }
+  }
+  return out;
+}
+
+} // namespace
+
+void ServiceSlot::AtomicHistogram::record(
+    const std::array<double, kBuckets - 1> &bounds,
+    std::chrono::steady_clock::duration d) {
+  double sec = std::chrono::duration<double>(d).count();
+  size_t i = std::lower_bound(bounds.begin(), bounds.end(), sec) - bounds.begin();
+  buckets[i].fetch_add(1, std::memory_order_relaxed);
+  sumNs.fetch_add(static_cast<uint64_t>(std::max<int64_t>(
+                      0, std::chrono::duration_cast<std::chrono::nanoseconds>(d)
+                             .count())),
+                  std::memory_order_relaxed);
+  count.fetch_add(1, std::memory_order_relaxed);
+}
+
+ServiceSlot::Histogram ServiceSlot::AtomicHistogram::load() const {
+  Histogram h;
+  for (size_t i = 0; i < kBuckets; ++i)
+    h.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+  h.count = count.load(std::memory_order_relaxed);
+  h.sumSec = sumNs.load(std::memory_order_relaxed) / 1e9;
+  return h;
+}
+
+void ServiceSlot::setMessage(std::string_view message) {
+  message = message.substr(0, kMessageWords * 8 - 1);
+  std::array<uint64_t, kMessageWords> words{};
+  std::memcpy(words.data(), message.data(), message.size());
+
+  // Writers of the same slot (a provider thread and a worker, say) take
+  // turns by flipping the sequence to odd.
+  uint32_t seq = messageSeq_.load(std::memory_order_relaxed);
+  for (;;) {
+    if (!(seq & 1) &&
+        messageSeq_.compare_exchange_weak(seq, seq + 1,
+                                          std::memory_order_acquire))
+      break;
+    seq = messageSeq_.load(std::memory_order_relaxed);
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+  for (size_t i = 0; i < kMessageWords; ++i)
+    message_[i].store(words[i], std::memory_order_relaxed);
+  messageSeq_.store(seq + 2, std::memory_order_release);
+}
+
+void ServiceSlot::setStatus(bool ok, std::string_view message) {
+  setMessage(message);
+  ok_.store(ok, std::memory_order_relaxed);
+  updates_.fetch_add(1, std::memory_order_release);
+}
+
+void ServiceSlot::markOk(std::string_view message) {
+  lastSuccessNs_.store(systemNowNs(), std::memory_order_relaxed);
+  consecutiveFailures_.store(0, std::memory_order_relaxed);
+  setStatus(true, message);
+}
+
+void ServiceSlot::markFailed(std::string_view why) {
+  failures_.fetch_add(1, std::memory_order_relaxed);
+  consecutiveFailures_.fetch_add(1, std::memory_order_relaxed);
+  setStatus(false, why);
+}
+
+void ServiceSlot::markPending(std::string_view message) {
+  setStatus(false, message);
+}
+
+void ServiceSlot::recordFetch(std::chrono::steady_clock::duration latency,
+                              size_t bytes) {
+  fetch_.record(kFetchBuckets, latency);
+  bytes_.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void ServiceSlot::recordParse(std::chrono::steady_clock::duration took,
+                              size_t items) {
+  parse_.record(kParseBuckets, took);
+  items_.fetch_add(items, std::memory_order_relaxed);
+}
+
+ServiceSlot::Snapshot ServiceSlot::snapshot() const {
+  Snapshot s;
+  s.updates = updates_.load(std::memory_order_acquire);
+  s.ok = ok_.load(std::memory_order_relaxed);
+  s.lastSuccess = std::chrono::system_clock::time_point(
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(
+          std::chrono::nanoseconds(
+              lastSuccessNs_.load(std::memory_order_relaxed))));
+  s.failures = failures_.load(std::memory_order_relaxed);
+  s.consecutiveFailures = consecutiveFailures_.load(std::memory_order_relaxed);
+  s.bytes = bytes_.load(std::memory_order_relaxed);
+  s.items = items_.load(std::memory_order_relaxed);
+  s.fetch = fetch_.load();
+  s.parse = parse_.load();
+
+  std::array<uint64_t, kMessageWords> words{};
+  for (;;) {
+    uint32_t before = messageSeq_.load(std::memory_order_acquire);
+    if (before & 1)
+      continue;
+    for (size_t i = 0; i < kMessageWords; ++i)
+      words[i] = message_[i].load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (messageSeq_.load(std::memory_order_relaxed) == before)
+      break;
+  }
+  const char *text = reinterpret_cast<const char *>(words.data());
+  s.message.assign(text, strnlen(text, kMessageWords * 8));
+  return s;
+}
+
+ServiceSlot *ServiceRegistry::claim(std::string_view name) {
+  std::lock_guard<std::mutex> lock(claimMutex_);
+  size_t n = count_.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < n; ++i) {
+    if (slots_[i].name() == name)
+      return &slots_[i];
+  }
+  if (n == kMaxSlots) {
+    LOG_W("ServiceRegistry", "No free slot for '{}', not reported", name);
+    return &overflow_;
+  }
+
+  ServiceSlot &slot = slots_[n];
+  slot.nameLen_ = std::min(name.size(), ServiceSlot::kNameMax);
+  std::memcpy(slot.name_.data(), name.data(), slot.nameLen_);
+  // Publishes the name to forEach()/find() readers.
+  count_.store(n + 1, std::memory_order_release);
+  return &slot;
+}
+
+const ServiceSlot *ServiceRegistry::find(std::string_view name) const {
+  const ServiceSlot *found = nullptr;
+  forEach([&](const ServiceSlot &slot) {
+    if (!found && slot.name() == name)
+      found = &slot;
+  });
+  return found;
+}
+
+std::string ServiceRegistry::renderPrometheus() const {
+  std::vector<std::pair<std::string, ServiceSlot::Snapshot>> rows;
+  forEach([&](const ServiceSlot &slot) {
+    rows.emplace_back(escapeLabel(slot.name()), slot.snapshot());
+  });
+
+  fmt::memory_buffer out;
+  auto header = [&](const char *metric, const char *type, const char *help) {
+    fmt::format_to(fmt::appender(out), "# HELP {} {}\n# TYPE {} {}\n", metric,
+                   help, metric, type);
+  };
+  auto series = [&](const char *metric, auto value) {
+    for (const auto &[name, s] : rows)
+      fmt::format_to(fmt::appender(out), "{}{{service=\"{}\"}} {}\n", metric,
+                     name, value(s));
+  };
+  auto histogram = [&](const char *metric, const char *help,
+                       const std::array<double, ServiceSlot::kBuckets - 1>
+                           &bounds,
+                       ServiceSlot::Histogram ServiceSlot::Snapshot::*field) {
+    header(metric, "histogram", help);
+    for (const auto &[name, s] : rows) {
+      const ServiceSlot::Histogram &h = s.*field;
+      uint64_t cumulative = 0;
+      for (size_t i = 0; i < ServiceSlot::kBuckets; ++i) {
+        cumulative += h.buckets[i];
+        if (i < bounds.size())
+          fmt::format_to(fmt::appender(out),
+                         "{}_bucket{{service=\"{}\",le=\"{}\"}} {}\n", metric,
+                         name, bounds[i], cumulative);
+        else
+          fmt::format_to(fmt::appender(out),
+                         "{}_bucket{{service=\"{}\",le=\"+Inf\"}} {}\n",
+                         metric, name, cumulative);
+      }
+      fmt::format_to(fmt::appender(out), "{}_sum{{service=\"{}\"}} {}\n",
+                     metric, name, h.sumSec);
+      fmt::format_to(fmt::appender(out), "{}_count{{service=\"{}\"}} {}\n",
+                     metric, name, h.count);
+    }
+  };
+
+  header("hamclock_service_up", "gauge",
+         "1 if the last operation of the service succeeded.");
+  series("hamclock_service_up",
+         [](const ServiceSlot::Snapshot &s) { return s.ok ? 1 : 0; });
+
+  header("hamclock_service_last_success_timestamp_seconds", "gauge",
+         "Unix time of the last success, 0 if none yet.");
+  series("hamclock_service_last_success_timestamp_seconds",
+         [](const ServiceSlot::Snapshot &s) {
+           return std::chrono::duration_cast<std::chrono::seconds>(
+                      s.lastSuccess.time_since_epoch())
+               .count();
+         });
+
+  header("hamclock_service_failures_total", "counter", "Failed operations.");
+  series("hamclock_service_failures_total",
+         [](const ServiceSlot::Snapshot &s) { return s.failures; });
+
+  header("hamclock_service_consecutive_failures", "gauge",
+         "Failures since the last success.");
+  series("hamclock_service_consecutive_failures",
+         [](const ServiceSlot::Snapshot &s) { return s.consecutiveFailures; });
+
+  header("hamclock_service_received_bytes_total", "counter",
+         "Bytes received from the source.");
+  series("hamclock_service_received_bytes_total",
+         [](const ServiceSlot::Snapshot &s) { return s.bytes; });
+
+  header("hamclock_service_parsed_items_total", "counter",
+         "Records (spots, rows, samples) parsed from the source.");
+  series("hamclock_service_parsed_items_total",
+         [](const ServiceSlot::Snapshot &s) { return s.items; });
+
+  histogram("hamclock_service_fetch_duration_seconds",
+            "Time from request to complete response.",
+            ServiceSlot::kFetchBuckets, &ServiceSlot::Snapshot::fetch);
+  histogram("hamclock_service_parse_duration_seconds",
+            "Time spent parsing a response.", ServiceSlot::kParseBuckets,
+            &ServiceSlot::Snapshot::parse);
+
+  return fmt::to_string(out);
+}
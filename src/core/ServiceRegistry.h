@@ -0,0 +1,132 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+// Health and metrics of one data source. Every field is an atomic, so
+// provider threads update a slot and the web server reads it without a
+// lock. The status message is guarded by a sequence lock: a reader retries
+// if a writer was in the middle of replacing it.
+class ServiceSlot {
+public:
+  // Buckets of a histogram, in seconds. The last bucket is +Inf.
+  static constexpr std::array<double, 10> kFetchBuckets = {
+      0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0, 30.0, 60.0};
+  static constexpr std::array<double, 10> kParseBuckets = {
+      0.0001, 0.0005, 0.001, 0.005, 0.01, 0.05, 0.1, 0.5, 1.0, 5.0};
+  static constexpr size_t kBuckets = kFetchBuckets.size() + 1;
+  static_assert(kParseBuckets.size() + 1 == kBuckets);
+
+  struct Histogram {
+    std::array<uint64_t, kBuckets> buckets{}; // not cumulative
+    uint64_t count = 0;
+    double sumSec = 0.0;
+  };
+
+  struct Snapshot {
+    bool ok = false;
+    uint64_t updates = 0; // status changes so far, 0 = never reported
+    std::string message;
+    std::chrono::system_clock::time_point lastSuccess{};
+    uint64_t failures = 0;
+    uint64_t consecutiveFailures = 0;
+    uint64_t bytes = 0;
+    uint64_t items = 0;
+    Histogram fetch;
+    Histogram parse;
+  };
+
+  std::string_view name() const { return {name_.data(), nameLen_}; }
+
+  // Status. markOk() and markFailed() are the outcome of an operation and
+  // count towards the failure metrics; markPending() reports progress
+  // ("Connecting...") without counting either way.
+  void markOk(std::string_view message = {});
+  void markFailed(std::string_view why);
+  void markPending(std::string_view message);
+  // Replace the message and keep the status ("Connected").
+  void setMessage(std::string_view message);
+
+  // A completed transfer: how long it took and how much arrived.
+  void recordFetch(std::chrono::steady_clock::duration latency, size_t bytes);
+  // Data read from a stream, without a latency.
+  void addBytes(size_t bytes) {
+    bytes_.fetch_add(bytes, std::memory_order_relaxed);
+  }
+  void recordParse(std::chrono::steady_clock::duration took, size_t items);
+
+  Snapshot snapshot() const;
+
+private:
+  friend class ServiceRegistry;
+
+  static constexpr size_t kNameMax = 31;
+  static constexpr size_t kMessageWords = 16; // 128 bytes, NUL padded
+
+  struct AtomicHistogram {
+    std::array<std::atomic<uint64_t>, kBuckets> buckets{};
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> sumNs{0};
+
+    void record(const std::array<double, kBuckets - 1> &bounds,
+                std::chrono::steady_clock::duration d);
+    Histogram load() const;
+  };
+
+  void setStatus(bool ok, std::string_view message);
+
+  std::array<char, kNameMax + 1> name_{};
+  size_t nameLen_ = 0;
+
+  std::atomic<bool> ok_{false};
+  std::atomic<uint64_t> updates_{0};
+  std::atomic<int64_t> lastSuccessNs_{0}; // system_clock, since the epoch
+  std::atomic<uint64_t> failures_{0};
+  std::atomic<uint64_t> consecutiveFailures_{0};
+  std::atomic<uint64_t> bytes_{0};
+  std::atomic<uint64_t> items_{0};
+  AtomicHistogram fetch_;
+  AtomicHistogram parse_;
+
+  // Odd while a writer is replacing message_.
+  std::atomic<uint32_t> messageSeq_{0};
+  std::array<std::atomic<uint64_t>, kMessageWords> message_{};
+};
+
+// Fixed table of ServiceSlots, one per data source. Providers claim their
+// slot once at start-up and keep the pointer; slots are never removed or
+// moved, so the pointer stays valid for the life of the registry.
+class ServiceRegistry {
+public:
+  static constexpr size_t kMaxSlots = 48;
+
+  // The slot for name, created on first use. When the table is full, a
+  // shared slot that is never reported is returned, so callers need not
+  // check for nullptr.
+  ServiceSlot *claim(std::string_view name);
+
+  // nullptr if nothing claimed name.
+  const ServiceSlot *find(std::string_view name) const;
+
+  // fn(const ServiceSlot &) for each claimed slot, in claim order.
+  template <typename Fn> void forEach(Fn &&fn) const {
+    size_t n = count_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < n; ++i)
+      fn(slots_[i]);
+  }
+
+  // Prometheus text exposition format (version 0.0.4).
+  std::string renderPrometheus() const;
+
+private:
+  std::array<ServiceSlot, kMaxSlots> slots_;
+  std::atomic<size_t> count_{0};
+  std::mutex claimMutex_; // serialises claim(), readers never take it
+  ServiceSlot overflow_;
+};
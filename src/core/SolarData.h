@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Reactive.h"
+
 #include <chrono>
 #include <mutex>
 
@@ -27,6 +29,18 @@ struct SolarData {
   bool valid = false;
 };
 
+// The part of SolarData that propagation models depend on.
+struct SolarIndices {
+  int sfi = 0;
+  int k_index = 0;
+  int sunspot_number = 0;
+
+  bool operator==(const SolarIndices &o) const {
+    return sfi == o.sfi && k_index == o.k_index &&
+           sunspot_number == o.sunspot_number;
+  }
+};
+
 class SolarDataStore {
 public:
   SolarData get() const {
@@ -35,11 +49,19 @@ public:
   }
 
   void set(const SolarData &data) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    data_ = data;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      data_ = data;
+    }
+    if (data.valid)
+      indices_.set({data.sfi, data.k_index, data.sunspot_number});
   }
 
+  // Graph node for consumers that only need to know when indices change.
+  const Reactive::Node<SolarIndices> &indices() const { return indices_; }
+
 private:
   mutable std::mutex mutex_;
   SolarData data_;
+  Reactive::Source<SolarIndices> indices_;
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <chrono>
 #include <mutex>
 #include <string>
@@ -17,6 +18,14 @@ class WatchlistHitStore {
 public:
   void addHit(const WatchlistHit &hit) {
     std::lock_guard<std::mutex> lock(mutex_);
+    // Polled sources re-report the same station every fetch; keep only its
+    // latest hit per source.
+    hits_.erase(std::remove_if(hits_.begin(), hits_.end(),
+                               [&](const WatchlistHit &h) {
+                                 return h.call == hit.call &&
+                                        h.source == hit.source;
+                               }),
+                hits_.end());
     hits_.insert(hits_.begin(), hit);
     if (hits_.size() > 50)
       hits_.pop_back();
@@ -0,0 +1,295 @@
+#include "WatchlistMatcher.h"
+#include "WorkedIndex.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdlib>
+#include <map>
+
+namespace {
+
+constexpr int kOther = 37;
+
+// Character -> input class: A-Z (either case) 0..25, 0-9 26..35, '/' 36.
+constexpr std::array<uint8_t, 256> makeClassTable() {
+  std::array<uint8_t, 256> t{};
+  for (int c = 0; c < 256; ++c)
+    t[c] = kOther;
+  for (int c = 'A'; c <= 'Z'; ++c)
+    t[c] = static_cast<uint8_t>(c - 'A');
+  for (int c = 'a'; c <= 'z'; ++c)
+    t[c] = static_cast<uint8_t>(c - 'a');
+  for (int c = '0'; c <= '9'; ++c)
+    t[c] = static_cast<uint8_t>(26 + c - '0');
+  t['/'] = 36;
+  return t;
+}
+constexpr std::array<uint8_t, 256> kClassOf = makeClassTable();
+
+bool equalsNoCase(std::string_view a, std::string_view b) {
+  if (a.size() != b.size())
+    return false;
+  for (size_t i = 0; i < a.size(); ++i) {
+    if (std::toupper(static_cast<unsigned char>(a[i])) !=
+        std::toupper(static_cast<unsigned char>(b[i])))
+      return false;
+  }
+  return true;
+}
+
+std::string upper(std::string_view s) {
+  std::string out(s);
+  for (char &c : out)
+    c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+  return out;
+}
+
+// Glob NFA over all patterns. State i of pattern p means "the first i
+// characters of p are matched"; a '*' state loops on every input.
+struct GlobNfa {
+  struct Pattern {
+    std::string glob;
+    uint16_t rule;
+    uint32_t base; // id of this pattern's state 0
+  };
+  std::vector<Pattern> patterns;
+  std::vector<uint32_t> owner; // state id -> pattern index
+  uint32_t states = 0;
+
+  void add(std::string glob, uint16_t rule) {
+    uint32_t n = static_cast<uint32_t>(glob.size()) + 1;
+    patterns.push_back({std::move(glob), rule, states});
+    owner.insert(owner.end(), n, static_cast<uint32_t>(patterns.size() - 1));
+    states += n;
+  }
+
+  // Add s and everything reachable through '*' (which may match nothing).
+  void close(uint32_t s, std::vector<uint32_t> &set) const {
+    const Pattern &p = patterns[owner[s]];
+    for (;;) {
+      set.push_back(s);
+      uint32_t i = s - p.base;
+      if (i >= p.glob.size() || p.glob[i] != '*')
+        break;
+      ++s;
+    }
+  }
+
+  void step(const std::vector<uint32_t> &from, int cls,
+            std::vector<uint32_t> &to) const {
+    to.clear();
+    for (uint32_t s : from) {
+      const Pattern &p = patterns[owner[s]];
+      uint32_t i = s - p.base;
+      if (i >= p.glob.size())
+        continue;
+      char c = p.glob[i];
+      if (c == '*')
+        close(s, to); // consume c and stay
+      else if (c == '?' || kClassOf[static_cast<unsigned char>(c)] == cls)
+        close(s + 1, to);
+    }
+    std::sort(to.begin(), to.end());
+    to.erase(std::unique(to.begin(), to.end()), to.end());
+  }
+};
+
+} // namespace
+
+bool WatchRule::parse(std::string_view entry, WatchRule &out) {
+  WatchRule r;
+  size_t pos = 0;
+  auto nextToken = [&]() -> std::string_view {
+    while (pos < entry.size() &&
+           std::isspace(static_cast<unsigned char>(entry[pos])))
+      ++pos;
+    size_t begin = pos;
+    while (pos < entry.size() &&
+           !std::isspace(static_cast<unsigned char>(entry[pos])))
+      ++pos;
+    return entry.substr(begin, pos - begin);
+  };
+
+  std::string head = upper(nextToken());
+  if (head.empty())
+    return false;
+
+  if (head.rfind("DXCC:", 0) == 0) {
+    char *end = nullptr;
+    long n = std::strtol(head.c_str() + 5, &end, 10);
+    if (end == head.c_str() + 5 || *end != '\0' || n <= 0)
+      return false;
+    r.dxcc = static_cast<int>(n);
+  } else {
+    for (char c : head) {
+      if (c != '*' && c != '?' && kClassOf[static_cast<unsigned char>(c)] ==
+                                      kOther)
+        return false;
+    }
+    // Runs of '*' are one '*'
+    head.erase(std::unique(head.begin(), head.end(),
+                           [](char a, char b) { return a == '*' && b == '*'; }),
+               head.end());
+    if (head == "*")
+      return false; // would match every spot
+    r.pattern = head;
+  }
+  r.text = head;
+
+  for (std::string_view tok = nextToken(); !tok.empty(); tok = nextToken()) {
+    int band = WorkedIndex::bandIndexOf(tok);
+    if (band >= 0) {
+      r.bands |= static_cast<uint16_t>(1u << band);
+      r.text += ' ';
+      r.text += kBands[band].name;
+    } else {
+      r.modes.push_back(upper(tok));
+      r.text += ' ';
+      r.text += r.modes.back();
+    }
+  }
+
+  out = std::move(r);
+  return true;
+}
+
+std::unique_ptr<const WatchlistMatcher>
+WatchlistMatcher::compile(std::vector<WatchRule> rules) {
+  if (rules.size() > UINT16_MAX)
+    return nullptr;
+  std::unique_ptr<WatchlistMatcher> m(new WatchlistMatcher());
+  m->rules_ = std::move(rules);
+
+  GlobNfa nfa;
+  for (size_t i = 0; i < m->rules_.size(); ++i) {
+    const WatchRule &r = m->rules_[i];
+    auto idx = static_cast<uint16_t>(i);
+    if (r.dxcc > 0) {
+      m->dxccRules_.push_back({r.dxcc, idx});
+      continue;
+    }
+    nfa.add(r.pattern, idx);
+    // A plain call also matches its portable forms
+    if (r.pattern.find_first_of("*?/") == std::string::npos)
+      nfa.add(r.pattern + "/*", idx);
+  }
+  std::sort(m->dxccRules_.begin(), m->dxccRules_.end());
+
+  // Subset construction. State 0 is the dead (empty) set.
+  std::vector<std::vector<uint32_t>> sets(1);
+  std::map<std::vector<uint32_t>, uint16_t> ids{{{}, kDead}};
+  auto intern = [&](std::vector<uint32_t> set) -> int {
+    auto it = ids.find(set);
+    if (it != ids.end())
+      return it->second;
+    if (sets.size() >= kMaxStates)
+      return -1;
+    auto id = static_cast<uint16_t>(sets.size());
+    ids.emplace(set, id);
+    sets.push_back(std::move(set));
+    return id;
+  };
+
+  std::vector<uint32_t> startSet;
+  for (const auto &p : nfa.patterns)
+    nfa.close(p.base, startSet);
+  std::sort(startSet.begin(), startSet.end());
+  startSet.erase(std::unique(startSet.begin(), startSet.end()),
+                 startSet.end());
+  int start = intern(std::move(startSet));
+  if (start < 0)
+    return nullptr;
+  m->start_ = static_cast<uint16_t>(start);
+
+  std::vector<uint32_t> to;
+  for (size_t s = 0; s < sets.size(); ++s) {
+    m->next_.resize((s + 1) * kClasses, kDead);
+    if (s == kDead)
+      continue;
+    for (int cls = 0; cls < kClasses; ++cls) {
+      nfa.step(sets[s], cls, to);
+      int id = to.empty() ? kDead : intern(to);
+      if (id < 0)
+        return nullptr;
+      m->next_[s * kClasses + cls] = static_cast<uint16_t>(id);
+    }
+  }
+
+  // Accepting rules per DFA state
+  m->acceptBegin_.reserve(sets.size() + 1);
+  for (const auto &set : sets) {
+    m->acceptBegin_.push_back(static_cast<uint32_t>(m->acceptRules_.size()));
+    size_t first = m->acceptRules_.size();
+    for (uint32_t st : set) {
+      const auto &p = nfa.patterns[nfa.owner[st]];
+      if (st - p.base == p.glob.size())
+        m->acceptRules_.push_back(p.rule);
+    }
+    std::sort(m->acceptRules_.begin() + first, m->acceptRules_.end());
+    m->acceptRules_.erase(
+        std::unique(m->acceptRules_.begin() + first, m->acceptRules_.end()),
+        m->acceptRules_.end());
+  }
+  m->acceptBegin_.push_back(static_cast<uint32_t>(m->acceptRules_.size()));
+
+  return m;
+}
+
+bool WatchlistMatcher::filtersPass(const WatchRule &r, int band,
+                                   std::string_view mode) const {
+  if (r.bands && (band < 0 || !(r.bands & (1u << band))))
+    return false;
+  if (r.modes.empty())
+    return true;
+  for (const auto &m : r.modes) {
+    if (m == "PHONE" || m == "DATA") {
+      int mc = WorkedIndex::modeClassOf(mode);
+      if (mc == (m == "PHONE" ? WorkedIndex::kPhone : WorkedIndex::kData))
+        return true;
+    } else if (equalsNoCase(mode, m)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+int WatchlistMatcher::match(std::string_view call, double freqKhz,
+                            std::string_view mode, int dxcc) const {
+  int best = -1;
+  int band = -2; // not yet computed
+
+  if (start_ != kDead) {
+    uint16_t s = start_;
+    for (char c : call) {
+      s = next_[s * kClasses + kClassOf[static_cast<unsigned char>(c)]];
+      if (s == kDead)
+        break;
+    }
+    for (uint32_t i = acceptBegin_[s]; i < acceptBegin_[s + 1]; ++i) {
+      const WatchRule &r = rules_[acceptRules_[i]];
+      if (band == -2)
+        band = freqToBandIndex(freqKhz);
+      if (filtersPass(r, band, mode)) {
+        best = acceptRules_[i];
+        break;
+      }
+    }
+  }
+
+  if (dxcc > 0 && !dxccRules_.empty()) {
+    auto it = std::lower_bound(dxccRules_.begin(), dxccRules_.end(),
+                               std::make_pair(dxcc, uint16_t(0)));
+    for (; it != dxccRules_.end() && it->first == dxcc; ++it) {
+      if (best >= 0 && it->second > best)
+        break;
+      if (band == -2)
+        band = freqToBandIndex(freqKhz);
+      if (filtersPass(rules_[it->second], band, mode)) {
+        best = it->second;
+        break;
+      }
+    }
+  }
+  return best;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// One watchlist entry: "PATTERN [BAND...] [MODE...]", e.g. "K1ABC",
+// "VP8*", "*/MM 20m CW" or "DXCC:291 FT8".
+//  - A call pattern may use '*' (any run) and '?' (any one character).
+//    A plain call also matches its portable forms (K1ABC/P).
+//  - "DXCC:<n>" matches every call resolving to that entity.
+//  - Band tokens are kBands names; any other token is a mode. "PHONE" and
+//    "DATA" match their whole mode class. No band/mode means any.
+struct WatchRule {
+  std::string text;    // normalized entry, as shown in the UI
+  std::string pattern; // call glob; empty for DXCC rules
+  int dxcc = -1;
+  uint16_t bands = 0; // bit per kBands index; 0 = any band
+  std::vector<std::string> modes;
+
+  // Parse an entry. Returns false (and leaves out untouched) if malformed.
+  static bool parse(std::string_view entry, WatchRule &out);
+};
+
+// Watchlist compiled into a DFA over callsign characters, so a spot is
+// tested with one table step per byte regardless of the number of entries.
+// Immutable once built; share it freely between threads.
+class WatchlistMatcher {
+public:
+  // Build from parsed rules. Returns nullptr if the wildcard patterns
+  // would need more than kMaxStates DFA states.
+  static std::unique_ptr<const WatchlistMatcher>
+  compile(std::vector<WatchRule> rules);
+
+  // Index of the first rule matching the spot, or -1. mode may be empty
+  // (then only rules without a mode filter match); dxcc < 0 is unknown.
+  int match(std::string_view call, double freqKhz, std::string_view mode,
+            int dxcc) const;
+
+  // True if some rule needs the spot's DXCC entity.
+  bool needsDxcc() const { return !dxccRules_.empty(); }
+
+  size_t size() const { return rules_.size(); }
+  const WatchRule &rule(size_t i) const { return rules_[i]; }
+
+  static constexpr size_t kMaxStates = UINT16_MAX;
+
+private:
+  // Input alphabet: A-Z (case folded), 0-9, '/', everything else.
+  static constexpr int kClasses = 38;
+  static constexpr uint16_t kDead = 0;
+
+  WatchlistMatcher() = default;
+  bool filtersPass(const WatchRule &r, int band, std::string_view mode) const;
+
+  std::vector<uint16_t> next_; // state * kClasses + class -> state
+  uint16_t start_ = kDead;
+  // Rules accepted in each state: acceptRules_[acceptBegin_[s] ..
+  // acceptBegin_[s + 1]), ascending.
+  std::vector<uint32_t> acceptBegin_;
+  std::vector<uint16_t> acceptRules_;
+  std::vector<std::pair<int, uint16_t>> dxccRules_; // (dxcc, rule), sorted
+  std::vector<WatchRule> rules_;
+};
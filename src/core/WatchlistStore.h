@@ -1,40 +1,66 @@
 #pragma once
 
-#include <algorithm>
+#include "Logger.h"
+#include "PrefixManager.h"
+#include "WatchlistMatcher.h"
+
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
 struct WatchlistData {
-  std::set<std::string> calls;
+  std::set<std::string> calls; // normalized entries (WatchRule::text)
 };
 
+// Watchlist entries plus their compiled matcher. Edits rebuild the matcher
+// and publish it with an atomic shared_ptr swap, so match() never waits on
+// an edit and can be called from every spot source thread. A superseded
+// matcher is freed when the last match() using it returns.
 class WatchlistStore {
 public:
-  void add(const std::string &call) {
+  explicit WatchlistStore(PrefixManager *pm = nullptr)
+      : pm_(pm), current_(WatchlistMatcher::compile({})) {}
+
+  // Add an entry (see WatchRule for the syntax). False if it is malformed
+  // or the watchlist could not be compiled with it.
+  bool add(const std::string &entry) {
+    WatchRule rule;
+    if (!WatchRule::parse(entry, rule)) {
+      LOG_W("Watchlist", "Ignoring malformed entry '{}'", entry);
+      return false;
+    }
     std::lock_guard<std::mutex> lock(mutex_);
-    std::string c = call;
-    std::transform(c.begin(), c.end(), c.begin(), ::toupper);
-    data_.calls.insert(c);
+    if (!data_.calls.insert(rule.text).second)
+      return true;
+    if (!rebuild()) {
+      data_.calls.erase(rule.text);
+      return false;
+    }
+    return true;
   }
 
-  void remove(const std::string &call) {
+  void remove(const std::string &entry) {
+    WatchRule rule;
+    if (!WatchRule::parse(entry, rule))
+      return;
     std::lock_guard<std::mutex> lock(mutex_);
-    std::string c = call;
-    std::transform(c.begin(), c.end(), c.begin(), ::toupper);
-    data_.calls.erase(c);
+    if (data_.calls.erase(rule.text))
+      rebuild();
   }
 
-  bool contains(const std::string &call) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    std::string c = call;
-    // Handle suffix like K1ABC/P
-    size_t slash = c.find('/');
-    if (slash != std::string::npos)
-      c = c.substr(0, slash);
-    std::transform(c.begin(), c.end(), c.begin(), ::toupper);
-    return data_.calls.count(c) > 0;
+  // Index of the first matching entry, or -1. dxcc < 0 means unknown; it
+  // is resolved through the PrefixManager only if a DXCC entry exists.
+  int match(std::string_view call, double freqKhz, std::string_view mode,
+            int dxcc = -1) const {
+    std::shared_ptr<const WatchlistMatcher> m =
+        std::atomic_load_explicit(&current_, std::memory_order_acquire);
+    if (dxcc < 0 && pm_ && m->needsDxcc())
+      dxcc = pm_->findDXCC(std::string(call));
+    return m->match(call, freqKhz, mode, dxcc);
   }
 
   std::vector<std::string> getAll() const {
@@ -43,6 +69,29 @@ public:
   }
 
 private:
+  // Compile data_ and publish it. Caller holds mutex_.
+  bool rebuild() {
+    std::vector<WatchRule> rules;
+    rules.reserve(data_.calls.size());
+    for (const auto &text : data_.calls) {
+      WatchRule r;
+      if (WatchRule::parse(text, r))
+        rules.push_back(std::move(r));
+    }
+    auto m = WatchlistMatcher::compile(std::move(rules));
+    if (!m) {
+      LOG_W("Watchlist", "Too many wildcard entries to compile");
+      return false;
+    }
+    std::atomic_store_explicit(
+        &current_, std::shared_ptr<const WatchlistMatcher>(std::move(m)),
+        std::memory_order_release);
+    return true;
+  }
+
   mutable std::mutex mutex_;
   WatchlistData data_;
+  PrefixManager *pm_;
+  // Accessed only through std::atomic_load/atomic_store
+  std::shared_ptr<const WatchlistMatcher> current_;
 };
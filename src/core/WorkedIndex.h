@@ -0,0 +1,158 @@
+#pragma once
+
+#include "DXClusterData.h"
+#include "LiveSpotData.h"
+
+#include <atomic>
+#include <cctype>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+// Flags describing a spotted station relative to the logbook.
+enum WorkedFlags : uint8_t {
+  kWorkedCall = 1 << 0, // this callsign is in the log
+  kNewDxcc = 1 << 1,    // entity never worked
+  kNewBand = 1 << 2,    // entity worked, but not on this band
+  kNewSlot = 1 << 3,    // entity worked on this band, but not in this mode
+};
+
+// "Worked before" index built from the ADIF log. Callsigns are kept as
+// 64-bit hashes; each DXCC entity has one bitset of band x mode-class
+// slots, so a spot is classified with a hash probe and a few bit tests.
+// Records are added as the log is parsed, including appended QSOs.
+class WorkedIndex {
+public:
+  enum ModeClass { kCw = 0, kPhone = 1, kData = 2, kModeClasses = 3 };
+
+  void clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    calls_.clear();
+    entities_.clear();
+    ++generation_;
+  }
+
+  // Record a QSO. dxcc <= 0 and band/mode -1 are allowed (unknown).
+  void add(std::string_view call, int dxcc, int band, int modeClass) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    calls_.insert(hashCall(call));
+    if (dxcc > 0 && dxcc < kMaxDxcc) {
+      if (static_cast<size_t>(dxcc) >= entities_.size())
+        entities_.resize(dxcc + 1, 0);
+      uint64_t &slots = entities_[dxcc];
+      slots |= kEntityBit;
+      if (band >= 0) {
+        slots |= modeClass >= 0 ? slotBit(band, modeClass)
+                                : slotBit(band, kCw) | slotBit(band, kPhone) |
+                                      slotBit(band, kData);
+      }
+    }
+    ++generation_;
+  }
+
+  // Classify a spot. mode may be empty (most cluster spots).
+  uint8_t lookup(std::string_view call, int dxcc, double freqKhz,
+                 std::string_view mode) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint8_t flags = calls_.count(hashCall(call)) ? kWorkedCall : 0;
+    if (dxcc <= 0)
+      return flags;
+
+    uint64_t slots =
+        static_cast<size_t>(dxcc) < entities_.size() ? entities_[dxcc] : 0;
+    if (!(slots & kEntityBit))
+      return flags | kNewDxcc;
+
+    int band = freqToBandIndex(freqKhz);
+    if (band < 0)
+      return flags;
+    uint64_t bandMask =
+        slotBit(band, kCw) | slotBit(band, kPhone) | slotBit(band, kData);
+    if (!(slots & bandMask))
+      return flags | kNewBand;
+
+    int mc = modeClassOf(mode);
+    if (mc >= 0 && !(slots & slotBit(band, mc)))
+      flags |= kNewSlot;
+    return flags;
+  }
+
+  uint8_t lookup(const DXClusterSpot &spot) const {
+    return lookup(spot.txCall, spot.txDxcc, spot.freqKhz, spot.mode);
+  }
+
+  // Bumped on every change, so views can re-classify cached spots.
+  uint32_t generation() const { return generation_.load(); }
+
+  static int bandIndexOf(std::string_view band) {
+    for (int i = 0; i < kNumBands; ++i) {
+      if (equalsNoCase(band, kBands[i].name))
+        return i;
+    }
+    return -1;
+  }
+
+  static int modeClassOf(std::string_view mode) {
+    if (mode.empty())
+      return -1;
+    if (equalsNoCase(mode, "CW"))
+      return kCw;
+    for (const char *m : {"SSB", "USB", "LSB", "AM", "FM", "PHONE", "DV"}) {
+      if (equalsNoCase(mode, m))
+        return kPhone;
+    }
+    return kData;
+  }
+
+private:
+  static constexpr int kMaxDxcc = 1024;
+  static constexpr uint64_t kEntityBit = uint64_t(1) << 63;
+  static_assert(kNumBands * kModeClasses < 63, "slot bits overflow");
+
+  static uint64_t slotBit(int band, int modeClass) {
+    return uint64_t(1) << (band * kModeClasses + modeClass);
+  }
+
+  static bool equalsNoCase(std::string_view a, std::string_view b) {
+    if (a.size() != b.size())
+      return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+      if (std::toupper(static_cast<unsigned char>(a[i])) !=
+          std::toupper(static_cast<unsigned char>(b[i])))
+        return false;
+    }
+    return true;
+  }
+
+  // Hash of the base callsign: upper-cased, and for K1ABC/P, VE3/K1ABC and
+  // the like the longest '/'-separated part.
+  static uint64_t hashCall(std::string_view call) {
+    std::string_view base;
+    size_t start = 0;
+    while (start <= call.size()) {
+      size_t slash = call.find('/', start);
+      std::string_view part = call.substr(
+          start, slash == std::string_view::npos ? slash : slash - start);
+      if (part.size() > base.size())
+        base = part;
+      if (slash == std::string_view::npos)
+        break;
+      start = slash + 1;
+    }
+    uint64_t h = 1469598103934665603ull;
+    for (char c : base) {
+      h ^= static_cast<unsigned char>(
+          std::toupper(static_cast<unsigned char>(c)));
+      h *= 1099511628211ull;
+    }
+    return h;
+  }
+
+  mutable std::mutex mutex_;
+  std::unordered_set<uint64_t> calls_;
+  std::vector<uint64_t> entities_; // indexed by DXCC entity number
+  std::atomic<uint32_t> generation_{0};
+};
@@ -1,17 +1,30 @@
 #include "WorkerService.h"
 #include "Logger.h"
+#include <algorithm>
+#include <cstring>
 #include <pthread.h> // For setting thread priority
 
+namespace {
+// Index of the calling worker's own queue, or -1 off the pool.
+thread_local int tlsWorkerIndex = -1;
+} // namespace
+
 WorkerService &WorkerService::getInstance() {
   static WorkerService instance;
   return instance;
 }
 
 WorkerService::WorkerService() {
-  const size_t num_threads = 2; // A small pool for embedded devices
+  // One worker per core, kept small for embedded devices
+  const size_t num_threads =
+      std::clamp<size_t>(std::thread::hardware_concurrency(), 2, 4);
+  queues_.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; ++i)
+    queues_.push_back(std::make_unique<Queue>());
+
   workers_.reserve(num_threads);
   for (size_t i = 0; i < num_threads; ++i) {
-    workers_.emplace_back([this] { this->workerLoop(); });
+    workers_.emplace_back([this, i] { this->workerLoop(i); });
 
 #ifdef __linux__
     // Set thread priority to SCHED_IDLE to avoid interfering with UI thread
@@ -33,22 +46,70 @@ WorkerService::~WorkerService() {
   stop();
 }
 
-void WorkerService::workerLoop() {
-  while (true) {
-    std::function<void()> task;
+void WorkerService::push(Task task, TaskPriority priority) {
+  // Workers keep what they spawn; other threads spread work round-robin.
+  size_t q = tlsWorkerIndex >= 0
+                 ? static_cast<size_t>(tlsWorkerIndex)
+                 : nextQueue_.fetch_add(1, std::memory_order_relaxed) %
+                       queues_.size();
+  {
+    std::lock_guard<std::mutex> lock(queues_[q]->mutex);
+    queues_[q]->lanes[static_cast<size_t>(priority)].push_back(
+        std::move(task));
+  }
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex_);
+    pending_.fetch_add(1);
+  }
+  wake_.notify_one();
+}
+
+bool WorkerService::popTask(size_t self, Task &out) {
+  const size_t n = queues_.size();
+  for (size_t lane = 0; lane < kLanes; ++lane) {
+    // Own queue: newest first (its data is likely still in cache)
     {
-      std::unique_lock<std::mutex> lock(queueMutex_);
-      condition_.wait(lock, [this] { return shouldStop_ || !tasks_.empty(); });
+      Queue &q = *queues_[self];
+      std::lock_guard<std::mutex> lock(q.mutex);
+      if (!q.lanes[lane].empty()) {
+        out = std::move(q.lanes[lane].back());
+        q.lanes[lane].pop_back();
+        pending_.fetch_sub(1);
+        return true;
+      }
+    }
+    // Steal the oldest task from the other queues
+    for (size_t k = 1; k < n; ++k) {
+      Queue &q = *queues_[(self + k) % n];
+      std::lock_guard<std::mutex> lock(q.mutex);
+      if (!q.lanes[lane].empty()) {
+        out = std::move(q.lanes[lane].front());
+        q.lanes[lane].pop_front();
+        pending_.fetch_sub(1);
+        return true;
+      }
+    }
+  }
+  return false;
+}
 
-      if (shouldStop_ && tasks_.empty()) {
+void WorkerService::workerLoop(size_t self) {
+  tlsWorkerIndex = static_cast<int>(self);
+  while (true) {
+    Task task;
+    if (!popTask(self, task)) {
+      std::unique_lock<std::mutex> lock(sleepMutex_);
+      wake_.wait(lock, [this] { return shouldStop_ || pending_.load() > 0; });
+      if (shouldStop_ && pending_.load() == 0) {
         return;
       }
-
-      task = std::move(tasks_.front());
-      tasks_.pop();
+      continue;
     }
+
+    if (task.cancelled && task.cancelled->load(std::memory_order_relaxed))
+      continue;
     try {
-        task();
+        task.fn();
     } catch (const std::exception& e) {
         LOG_E("WorkerService", "Exception in background task: {}", e.what());
     } catch (...) {
@@ -57,26 +118,102 @@ void WorkerService::workerLoop() {
   }
 }
 
-void WorkerService::submitTask(std::function<void()> task) {
+void WorkerService::submitTask(std::function<void()> task,
+                               TaskPriority priority) {
   {
-    std::unique_lock<std::mutex> lock(queueMutex_);
+    std::lock_guard<std::mutex> lock(sleepMutex_);
     if (shouldStop_) {
       return; // Don't accept new tasks if shutting down
     }
-    tasks_.push(std::move(task));
   }
-  condition_.notify_one();
+  push({std::move(task), nullptr}, priority);
+}
+
+void WorkerService::submitTask(std::function<void()> task,
+                               TaskPriority priority,
+                               const CancelToken &token) {
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex_);
+    if (shouldStop_) {
+      return; // Don't accept new tasks if shutting down
+    }
+  }
+  push({std::move(task), token.flag_}, priority);
+}
+
+void WorkerService::parallelFor(size_t n, size_t grain,
+                                const std::function<void(size_t, size_t)> &fn,
+                                TaskPriority priority) {
+  if (n == 0)
+    return;
+  grain = std::max<size_t>(grain, 1);
+  const size_t chunks = (n + grain - 1) / grain;
+
+  struct Job {
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> done{0};
+    std::mutex mutex;
+    std::condition_variable finished;
+  };
+  auto job = std::make_shared<Job>();
+
+  // A helper that starts after the caller returned finds no chunk left and
+  // never touches fn.
+  auto run = [job, n, grain, chunks, &fn] {
+    for (;;) {
+      size_t c = job->next.fetch_add(1, std::memory_order_relaxed);
+      if (c >= chunks)
+        return;
+      fn(c * grain, std::min(n, (c + 1) * grain));
+      if (job->done.fetch_add(1, std::memory_order_acq_rel) + 1 == chunks) {
+        std::lock_guard<std::mutex> lock(job->mutex);
+        job->finished.notify_all();
+      }
+    }
+  };
+
+  size_t helpers = std::min(chunks - 1, workers_.size());
+  for (size_t i = 0; i < helpers; ++i)
+    submitTask(run, priority);
+  run();
+
+  std::unique_lock<std::mutex> lock(job->mutex);
+  job->finished.wait(lock, [&] {
+    return job->done.load(std::memory_order_acquire) == chunks;
+  });
+}
+
+void WorkerService::postToMain(std::function<void()> fn,
+                               const CancelToken &token) {
+  std::lock_guard<std::mutex> lock(completionMutex_);
+  completions_.push_back({std::move(fn), token.flag_});
+}
+
+size_t WorkerService::drainCompletions() {
+  std::vector<Task> batch;
+  {
+    std::lock_guard<std::mutex> lock(completionMutex_);
+    batch.swap(completions_);
+  }
+  size_t ran = 0;
+  for (auto &c : batch) {
+    if (c.cancelled && c.cancelled->load(std::memory_order_relaxed))
+      continue;
+    c.fn();
+    ++ran;
+  }
+  return ran;
 }
 
 void WorkerService::stop() {
   {
-    std::unique_lock<std::mutex> lock(queueMutex_);
+    std::unique_lock<std::mutex> lock(sleepMutex_);
     if (shouldStop_) {
         return;
     }
     shouldStop_ = true;
   }
-  condition_.notify_all();
+  wake_.notify_all();
   for (std::thread &worker : workers_) {
     if (worker.joinable()) {
       worker.join();
@@ -1,12 +1,40 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
 #include <functional>
 #include <future>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
+// Lanes are served strictly in order: an idle worker takes interactive work
+// (e.g. the prop grid for a band the user just picked) before anything
+// queued in the lower lanes.
+enum class TaskPriority { Interactive = 0, Normal = 1, Background = 2 };
+
+// Shared cancellation flag. Copies refer to the same flag; a task whose
+// token is cancelled before it starts is dropped, and so is its completion
+// if the token is cancelled before the main thread runs it.
+class CancelToken {
+public:
+  CancelToken() : flag_(std::make_shared<std::atomic<bool>>(false)) {}
+
+  void cancel() const { flag_->store(true, std::memory_order_relaxed); }
+  bool cancelled() const { return flag_->load(std::memory_order_relaxed); }
+
+private:
+  friend class WorkerService;
+  std::shared_ptr<std::atomic<bool>> flag_;
+};
+
+// Worker pool with one work-stealing queue per thread. Each queue has a
+// deque per priority lane; a worker pops the newest task of its own queue
+// and steals the oldest from the others, highest lane first.
 class WorkerService {
 public:
   static WorkerService &getInstance();
@@ -14,21 +42,93 @@ public:
   ~WorkerService();
 
   // Submit a task to be executed by a worker thread.
-  void submitTask(std::function<void()> task);
+  void submitTask(std::function<void()> task,
+                  TaskPriority priority = TaskPriority::Normal);
+  void submitTask(std::function<void()> task, TaskPriority priority,
+                  const CancelToken &token);
+
+  // Run fn on a worker and return its result as a future.
+  template <typename F>
+  auto submit(F fn, TaskPriority priority = TaskPriority::Normal)
+      -> std::future<std::invoke_result_t<F>> {
+    using R = std::invoke_result_t<F>;
+    auto task = std::make_shared<std::packaged_task<R()>>(std::move(fn));
+    std::future<R> result = task->get_future();
+    submitTask([task] { (*task)(); }, priority);
+    return result;
+  }
+
+  // Run fn on a worker, then done(result) on the main thread from
+  // drainCompletions(). Nothing runs once the token is cancelled.
+  template <typename F, typename Done>
+  void submitThen(F fn, Done done, TaskPriority priority,
+                  const CancelToken &token = CancelToken()) {
+    submitTask(
+        [this, fn = std::move(fn), done = std::move(done), token]() mutable {
+          if constexpr (std::is_void_v<std::invoke_result_t<F>>) {
+            fn();
+            postToMain(std::move(done), token);
+          } else {
+            postToMain(
+                [done = std::move(done), result = fn()]() mutable {
+                  done(std::move(result));
+                },
+                token);
+          }
+        },
+        priority, token);
+  }
+
+  // Run fn(begin, end) over [0, n) in chunks of grain, on the calling
+  // thread and on any idle workers, and return once every chunk is done.
+  // Safe from a worker: the caller never waits for a chunk that no thread
+  // has picked up, so a busy pool only makes it slower.
+  void parallelFor(size_t n, size_t grain,
+                   const std::function<void(size_t, size_t)> &fn,
+                   TaskPriority priority = TaskPriority::Normal);
+
+  // Queue fn to run on the main thread in the next drainCompletions().
+  void postToMain(std::function<void()> fn,
+                  const CancelToken &token = CancelToken());
+
+  // Run the completions queued so far. Main thread, once per frame.
+  size_t drainCompletions();
 
   // Stop all worker threads.
   void stop();
 
 private:
+  struct Task {
+    std::function<void()> fn;
+    std::shared_ptr<std::atomic<bool>> cancelled; // null: not cancellable
+  };
+
+  static constexpr size_t kLanes = 3;
+
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> lanes[kLanes];
+  };
+
   WorkerService();
   WorkerService(const WorkerService &) = delete;
   WorkerService &operator=(const WorkerService &) = delete;
 
-  void workerLoop();
+  void push(Task task, TaskPriority priority);
+  bool popTask(size_t self, Task &out);
+  void workerLoop(size_t self);
 
-  bool shouldStop_ = false;
+  std::vector<std::unique_ptr<Queue>> queues_;
   std::vector<std::thread> workers_;
-  std::queue<std::function<void()>> tasks_;
-  std::mutex queueMutex_;
-  std::condition_variable condition_;
+  std::atomic<size_t> nextQueue_{0};
+
+  // Sleep/wake. pending_ counts queued tasks and is raised under sleepMutex_
+  // so a worker cannot miss a wakeup between its scan and its wait.
+  std::mutex sleepMutex_;
+  std::condition_variable wake_;
+  std::atomic<size_t> pending_{0};
+  bool shouldStop_ = false;
+
+  std::mutex completionMutex_;
+  std::vector<Task> completions_;
 };
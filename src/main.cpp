@@ -2,11 +2,12 @@
 #include "core/AuroraHistoryStore.h"
 #include "core/BrightnessManager.h"
 #include "core/CPUMonitor.h"
-#include "core/CitiesManager.h"
 #include "core/ConfigManager.h"
 #include "core/DXClusterData.h"
 #include "core/DatabaseManager.h"
 #include "core/DisplayPower.h"
+#include "core/DrapData.h"
+#include "core/FetchScheduler.h"
 #include "core/HamClockState.h"
 #include "core/LiveSpotData.h"
 #include "core/PrefixManager.h"
@@ -20,6 +21,7 @@
 #endif
 #include "core/SoundManager.h"
 #include "core/WidgetType.h"
+#include "core/WorkedIndex.h"
 #include "core/WorkerService.h"
 
 #include "network/NetworkManager.h"
@@ -85,6 +87,7 @@
 #include "ui/SDOPanel.h"
 #include "ui/SantaPanel.h"
 #include "ui/SetupScreen.h"
+#include "ui/SoftwarePresenter.h"
 #include "ui/SpaceWeatherPanel.h"
 #include "ui/TextureManager.h"
 #include "ui/TimePanel.h"
@@ -95,6 +98,7 @@
 
 #include "core/Constants.h"
 #include "core/Logger.h"
+#include "core/MemoryMonitor.h"
 #include <SDL.h>
 #include <SDL_image.h>
 #include <SDL_ttf.h>
@@ -148,6 +152,7 @@ struct AppContext {
   int globalWinH = INITIAL_HEIGHT;
   int globalDrawW = INITIAL_WIDTH;
   int globalDrawH = INITIAL_HEIGHT;
+  bool fullRedraw = false; // software renderer without damage tracking
 
   // Layout Metrics
   float layScale = 1.0f;
@@ -159,6 +164,7 @@ struct AppContext {
   // Data Stores
   std::shared_ptr<SolarDataStore> solarStore;
   std::shared_ptr<AuroraHistoryStore> auroraHistoryStore;
+  std::shared_ptr<DrapStore> drapStore;
   std::shared_ptr<WatchlistStore> watchlistStore;
   std::shared_ptr<RSSDataStore> rssStore;
   std::shared_ptr<WatchlistHitStore> watchlistHitStore;
@@ -174,6 +180,7 @@ struct AppContext {
   std::shared_ptr<CallbookStore> callbookStore;
   std::shared_ptr<DstStore> dstStore;
   std::shared_ptr<ADIFStore> adifStore;
+  std::shared_ptr<WorkedIndex> workedIndex;
   std::shared_ptr<SantaStore> santaStore;
   std::shared_ptr<RotatorDataStore> rotatorStore;
   std::shared_ptr<RigDataStore> rigStore;
@@ -215,6 +222,7 @@ struct DashboardContext {
   TextureManager texMgr;
   FontCatalog fontCatalog;
   DebugOverlay debugOverlay;
+  std::unique_ptr<SoftwarePresenter> presenter; // software renderer only
 
   // Providers
   std::unique_ptr<NOAAProvider> noaaProvider;
@@ -237,7 +245,7 @@ struct DashboardContext {
   std::unique_ptr<ADIFProvider> adifProvider;
   std::unique_ptr<MufRtProvider> mufRtProvider;
   std::unique_ptr<CloudProvider> cloudProvider;
-  std::unique_ptr<IonosondeProvider> ionosondeProvider;
+  std::shared_ptr<IonosondeProvider> ionosondeProvider;
   std::unique_ptr<SantaProvider> santaProvider;
   std::unique_ptr<SatelliteManager> satMgr;
   std::unique_ptr<AsteroidProvider> asteroidProvider;
@@ -248,6 +256,7 @@ struct DashboardContext {
   std::unique_ptr<RotatorService> rotatorService;
   std::unique_ptr<RigService> rigService;
 #endif
+  std::unique_ptr<FetchScheduler> scheduler;
 
   // UI Components
   std::unique_ptr<TimePanel> timePanel;
@@ -265,18 +274,25 @@ struct DashboardContext {
   std::vector<Widget *> eventWidgets;
 
   // State
-  Uint32 lastFetchMs = 0;
   Uint32 lastResizeMs = 0;
   Uint32 lastFpsUpdate = 0;
   int frames = 0;
   Uint32 lastMouseMotionMs = 0;
   bool cursorVisible = true;
   Uint32 lastSleepAssert = 0;
+  bool modalShown = false;
 
   // State for background data aggregation
   std::vector<std::string> rssHeadlines[3];
   bool rssDataDirty = false;
 
+  // Refetch triggers from the state graph. Weather follows DE only at a
+  // resolution that matters for a forecast.
+  Reactive::Derived<LatLon, LatLon> weatherOrigin;
+  Reactive::Watch<LatLon> weatherOriginWatch;
+  Reactive::Watch<DXTarget> dxWatch;
+  Reactive::Watch<SolarIndices> solarWatch;
+
   DashboardContext(AppContext &ctx);
   ~DashboardContext() = default;
 
@@ -337,8 +353,7 @@ extern "C" EMSCRIPTEN_KEEPALIVE void hamclock_after_idbfs() {
   if (ctx.cfgMgr.load(ctx.appCfg)) {
     LOG_I("Main", "Config loaded: callsign={}", ctx.appCfg.callsign);
     ctx.state->deCallsign = ctx.appCfg.callsign;
-    ctx.state->deGrid = ctx.appCfg.grid;
-    ctx.state->deLocation = {ctx.appCfg.lat, ctx.appCfg.lon};
+    ctx.state->setDE({ctx.appCfg.lat, ctx.appCfg.lon}, ctx.appCfg.grid);
     ctx.netManager->setCorsProxyUrl(ctx.appCfg.corsProxyUrl);
     ctx.activeSetup = AppContext::SetupMode::None;
   } else {
@@ -397,6 +412,8 @@ int main(int argc, char *argv[]) {
       forceFullscreen = true;
     } else if (arg == "-s" || arg == "--software") {
       forceSoftware = true;
+    } else if (arg == "--full-redraw") {
+      ctx.fullRedraw = true;
     } else if (arg == "--log-level" && i + 1 < argc) {
       logLevel = argv[++i];
     } else if (arg == "-h" || arg == "--help") {
@@ -576,6 +593,18 @@ int main(int argc, char *argv[]) {
     return EXIT_FAILURE;
   }
 
+  // Texture residency budget. On KMSDRM textures come out of the CMA pool,
+  // which is small and shared with the scanout buffers.
+  int64_t vramBudgetMb = ctx.appCfg.vramBudgetMb;
+  const char *videoDriver = SDL_GetCurrentVideoDriver();
+  if (vramBudgetMb == 0 && videoDriver &&
+      SDL_strcasecmp(videoDriver, "kmsdrm") == 0)
+    vramBudgetMb = 96;
+  if (vramBudgetMb > 0) {
+    MemoryMonitor::getInstance().setVramBudget(vramBudgetMb * 1024 * 1024);
+    LOG_I("Main", "Texture VRAM budget: {} MB", vramBudgetMb);
+  }
+
   // --- Initialize Persistent State ---
   ctx.updateLayoutMetrics();
 
@@ -586,11 +615,11 @@ int main(int argc, char *argv[]) {
   ActivityLocationManager::getInstance().init(*ctx.netManager, ctx.cfgMgr.configDir() / "cache");
 
   ctx.prefixMgr.init();
-  CitiesManager::getInstance().init();
 
   ctx.solarStore = std::make_shared<SolarDataStore>();
   ctx.auroraHistoryStore = std::make_shared<AuroraHistoryStore>();
-  ctx.watchlistStore = std::make_shared<WatchlistStore>();
+  ctx.drapStore = std::make_shared<DrapStore>();
+  ctx.watchlistStore = std::make_shared<WatchlistStore>(&ctx.prefixMgr);
   ctx.rssStore = std::make_shared<RSSDataStore>();
   ctx.watchlistHitStore = std::make_shared<WatchlistHitStore>();
   ctx.spotStore = std::make_shared<LiveSpotDataStore>();
@@ -606,14 +635,14 @@ int main(int argc, char *argv[]) {
   ctx.callbookStore = std::make_shared<CallbookStore>();
   ctx.dstStore = std::make_shared<DstStore>();
   ctx.adifStore = std::make_shared<ADIFStore>();
+  ctx.workedIndex = std::make_shared<WorkedIndex>();
   ctx.santaStore = std::make_shared<SantaStore>();
   ctx.rotatorStore = std::make_shared<RotatorDataStore>();
   ctx.rigStore = std::make_shared<RigDataStore>();
   ctx.state = std::make_shared<HamClockState>();
 
   ctx.state->deCallsign = ctx.appCfg.callsign;
-  ctx.state->deGrid = ctx.appCfg.grid;
-  ctx.state->deLocation = {ctx.appCfg.lat, ctx.appCfg.lon};
+  ctx.state->setDE({ctx.appCfg.lat, ctx.appCfg.lon}, ctx.appCfg.grid);
 
   ctx.cpuMonitor = std::make_shared<CPUMonitor>();
   ctx.cpuMonitor->init();
@@ -660,6 +689,7 @@ int main(int argc, char *argv[]) {
   SDL_DestroyRenderer(ctx.renderer);
   SDL_DestroyWindow(ctx.window);
   SDL_Quit();
+  Log::shutdown();
   return EXIT_SUCCESS;
 }
 
@@ -703,7 +733,11 @@ void AppContext::updateLayoutMetrics() {
 
 DashboardContext::DashboardContext(AppContext &ctx)
     : fontMgr(), texMgr(), fontCatalog(fontMgr), debugOverlay(fontMgr),
-      satMgr(std::make_unique<SatelliteManager>(*ctx.netManager)) {
+      satMgr(std::make_unique<SatelliteManager>(*ctx.netManager)),
+      weatherOrigin([](const LatLon &de) { return de; }, withinDegrees(0.1),
+                    ctx.state->de),
+      weatherOriginWatch(weatherOrigin), dxWatch(ctx.state->dx),
+      solarWatch(ctx.solarStore->indices()) {
   // Reset idle timer to now so the cursor-hide logic doesn't fire immediately
   lastMouseMotionMs = SDL_GetTicks();
   // Load font
@@ -736,6 +770,7 @@ DashboardContext::DashboardContext(AppContext &ctx)
   auto callbookStore = ctx.callbookStore;
   auto dstStore = ctx.dstStore;
   auto adifStore = ctx.adifStore;
+  auto workedIndex = ctx.workedIndex;
   auto santaStore = ctx.santaStore;
   auto rotatorStore = ctx.rotatorStore;
   auto rigStore = ctx.rigStore;
@@ -746,14 +781,12 @@ DashboardContext::DashboardContext(AppContext &ctx)
   auto auroraHistoryStore = ctx.auroraHistoryStore;
   noaaProvider = std::make_unique<NOAAProvider>(
       netManager, solarStore, auroraHistoryStore, state.get());
-  noaaProvider->fetch();
 
   rssProvider = std::make_unique<RSSProvider>(netManager, rssStore);
-  rssProvider->fetch();
 
   spotProvider = std::make_unique<LiveSpotProvider>(
       netManager, spotStore, appCfg, state.get(), dxcStore);
-  spotProvider->fetch();
+  spotProvider->setWatchlist(watchlistStore, watchlistHitStore);
 
 #ifndef __EMSCRIPTEN__
   rotatorService =
@@ -763,7 +796,6 @@ DashboardContext::DashboardContext(AppContext &ctx)
   rigService->start();
 #endif
 
-  satMgr->fetch();
 #ifndef __EMSCRIPTEN__
   satMgr->setRotatorService(rotatorService.get());
 #endif
@@ -771,71 +803,123 @@ DashboardContext::DashboardContext(AppContext &ctx)
 
   activityProvider =
       std::make_unique<ActivityProvider>(netManager, activityStore);
-  activityProvider->fetch();
+  activityProvider->setWatchlist(watchlistStore, watchlistHitStore);
 
   dxcProvider = std::make_unique<DXClusterProvider>(
       dxcStore, ctx.prefixMgr, watchlistStore, watchlistHitStore, state.get());
+  dxcProvider->setWorkedIndex(workedIndex);
 #ifndef __EMSCRIPTEN__
   dxcProvider->start(appCfg);
 #endif
 
   rbnProvider =
       std::make_unique<RBNProvider>(dxcStore, ctx.prefixMgr, state.get());
+  rbnProvider->setWorkedIndex(workedIndex);
+  rbnProvider->setWatchlist(watchlistStore, watchlistHitStore);
 #ifndef __EMSCRIPTEN__
   rbnProvider->start(appCfg);
 #endif
 
   bandProvider =
       std::make_unique<BandConditionsProvider>(solarStore, bandStore);
-  bandProvider->update();
 
   contestProvider = std::make_unique<ContestProvider>(netManager, contestStore);
-  contestProvider->fetch();
 
   moonProvider = std::make_unique<MoonProvider>(netManager, moonStore);
-  moonProvider->update(appCfg.lat, appCfg.lon);
 
   historyProvider = std::make_unique<HistoryProvider>(netManager, historyStore);
-  historyProvider->fetchFlux();
-  historyProvider->fetchSSN();
-  historyProvider->fetchKp();
 
   deWeatherProvider =
       std::make_unique<WeatherProvider>(netManager, deWeatherStore, 0);
-  deWeatherProvider->fetch(state->deLocation.lat, state->deLocation.lon);
 
   dxWeatherProvider =
       std::make_unique<WeatherProvider>(netManager, dxWeatherStore, 1);
-  dxWeatherProvider->fetch(state->dxLocation.lat, state->dxLocation.lon);
 
   sdoProvider = std::make_unique<SDOProvider>(netManager);
-  drapProvider = std::make_unique<DRAPProvider>(netManager);
+  drapProvider = std::make_unique<DRAPProvider>(netManager, ctx.drapStore);
   auroraProvider = std::make_shared<AuroraProvider>(netManager);
 
   callbookProvider =
       std::make_shared<CallbookProvider>(netManager, callbookStore);
+  callbookProvider->setQRZCredentials(appCfg.qrzUsername, appCfg.qrzPassword);
   callbookProvider->lookup("K1ABC");
 
   dstProvider = std::make_unique<DstProvider>(netManager, dstStore);
-  dstProvider->fetch();
 
   adifProvider = std::make_unique<ADIFProvider>(adifStore, ctx.prefixMgr);
-  adifProvider->fetch(ctx.cfgMgr.configDir() / "logs.adif");
-
-      mufRtProvider = std::make_unique<MufRtProvider>(netManager);
-      mufRtProvider->update();
-  
-      cloudProvider = std::make_unique<CloudProvider>(netManager);
-      cloudProvider->update();
-  
-      ionosondeProvider = std::make_unique<IonosondeProvider>(netManager);  ionosondeProvider->update();
-
-      asteroidProvider = std::make_unique<AsteroidProvider>(netManager);
-      asteroidProvider->update();
-  
-      beaconProvider = std::make_unique<BeaconProvider>();
-  
-      santaProvider = std::make_unique<SantaProvider>(santaStore);  santaProvider->update();
+  adifProvider->setWorkedIndex(workedIndex);
+  adifProvider->watch(ctx.cfgMgr.configDir() / "logs.adif");
+
+  mufRtProvider = std::make_unique<MufRtProvider>(netManager);
+  mufRtProvider->update();
+
+  cloudProvider = std::make_unique<CloudProvider>(netManager);
+  cloudProvider->update();
+
+  ionosondeProvider = std::make_shared<IonosondeProvider>(netManager);
+
+  asteroidProvider = std::make_unique<AsteroidProvider>(netManager);
+
+  beaconProvider = std::make_unique<BeaconProvider>();
+
+  santaProvider = std::make_unique<SantaProvider>(santaStore);
+  santaProvider->update();
+
+  // Periodic fetches. Critical jobs run on the first frame; background jobs
+  // are started one at a time after that and drift apart by their jitter.
+  using std::chrono::hours;
+  using std::chrono::minutes;
+  using std::chrono::seconds;
+  using Priority = FetchScheduler::Priority;
+  scheduler = std::make_unique<FetchScheduler>(state.get());
+  auto adifPath = ctx.cfgMgr.configDir() / "logs.adif";
+
+  scheduler->add("NOAA", minutes(15), Priority::Critical,
+                 [this] { noaaProvider->fetch(); }, seconds(60), "NOAA:KIndex");
+  scheduler->add("DRAP", minutes(15), Priority::Critical,
+                 [this] { drapProvider->fetch(); }, seconds(60));
+  scheduler->add("Moon", minutes(15), Priority::Critical,
+                 [this, &appCfg] {
+                   moonProvider->update(appCfg.lat, appCfg.lon);
+                 });
+  scheduler->add("DEWeather", minutes(15), Priority::Critical,
+                 [this, state] {
+                   deWeatherProvider->fetch(state->deLocation.lat,
+                                            state->deLocation.lon);
+                 },
+                 seconds(60));
+  scheduler->add("ADIF", minutes(15), Priority::Critical,
+                 [this, adifPath] { adifProvider->fetch(adifPath); });
+
+  scheduler->add("LiveSpot", minutes(15), Priority::Background,
+                 [this] { spotProvider->fetch(); }, seconds(60));
+  scheduler->add("RSS", minutes(15), Priority::Background,
+                 [this] { rssProvider->fetch(); }, seconds(60));
+  scheduler->add("Activity", minutes(15), Priority::Background,
+                 [this] { activityProvider->fetch(); }, seconds(60));
+  scheduler->add("DXWeather", minutes(15), Priority::Background,
+                 [this, state] {
+                   dxWeatherProvider->fetch(state->dxLocation.lat,
+                                            state->dxLocation.lon);
+                 },
+                 seconds(60));
+  scheduler->add("Ionosonde", minutes(10), Priority::Background,
+                 [this] { ionosondeProvider->update(); }, seconds(60));
+  scheduler->add("Contests", minutes(15), Priority::Background,
+                 [this] { contestProvider->fetch(); }, seconds(120));
+  scheduler->add("History:Flux", minutes(15), Priority::Background,
+                 [this] { historyProvider->fetchFlux(); }, seconds(120));
+  scheduler->add("History:SSN", minutes(15), Priority::Background,
+                 [this] { historyProvider->fetchSSN(); }, seconds(120));
+  scheduler->add("History:Kp", minutes(15), Priority::Background,
+                 [this] { historyProvider->fetchKp(); }, seconds(120));
+  scheduler->add("Asteroids", minutes(15), Priority::Background,
+                 [this] { asteroidProvider->update(); }, seconds(120));
+  scheduler->add("Dst", hours(1), Priority::Background,
+                 [this] { dstProvider->fetch(); }, seconds(300));
+  // SatelliteManager only downloads when its cached TLEs are a day old.
+  scheduler->add("Satellites", hours(1), Priority::Background,
+                 [this] { satMgr->fetch(); }, seconds(300));
 
   SDL_Color cyan = {0, 200, 255, 255};
   timePanel =
@@ -857,15 +941,18 @@ DashboardContext::DashboardContext(AppContext &ctx)
       widgetPool[type] =
           std::make_unique<SpaceWeatherPanel>(0, 0, 0, 0, fontMgr, solarStore);
       break;
-    case WidgetType::DX_CLUSTER:
+    case WidgetType::DX_CLUSTER: {
 #ifndef __EMSCRIPTEN__
-      widgetPool[type] = std::make_unique<DXClusterPanel>(
+      auto panel = std::make_unique<DXClusterPanel>(
           0, 0, 0, 0, fontMgr, dxcStore, rigService.get(), &appCfg);
 #else
-      widgetPool[type] = std::make_unique<DXClusterPanel>(
-          0, 0, 0, 0, fontMgr, dxcStore, nullptr, &appCfg);
+      auto panel = std::make_unique<DXClusterPanel>(0, 0, 0, 0, fontMgr,
+                                                    dxcStore, nullptr, &appCfg);
 #endif
+      panel->setWorkedIndex(workedIndex);
+      widgetPool[type] = std::move(panel);
       break;
+    }
     case WidgetType::LIVE_SPOTS:
       widgetPool[type] = std::make_unique<LiveSpotPanel>(
           0, 0, 0, 0, fontMgr, *spotProvider, spotStore, appCfg, ctx.cfgMgr);
@@ -938,7 +1025,7 @@ DashboardContext::DashboardContext(AppContext &ctx)
       break;
     case WidgetType::DRAP:
       widgetPool[type] = std::make_unique<DRAPPanel>(0, 0, 0, 0, fontMgr,
-                                                     texMgr, *drapProvider);
+                                                     texMgr, ctx.drapStore);
       break;
     case WidgetType::AURORA:
       widgetPool[type] = std::make_unique<AuroraPanel>(0, 0, 0, 0, fontMgr,
@@ -1070,12 +1157,18 @@ DashboardContext::DashboardContext(AppContext &ctx)
   mapArea->setOnConfigChanged([&ctx] { ctx.cfgMgr.save(ctx.appCfg); });
   mapArea->setSpotStore(spotStore);
   mapArea->setDXClusterStore(dxcStore);
+  mapArea->setWorkedIndex(workedIndex);
   mapArea->setADIFStore(adifStore);
   mapArea->setMufRtProvider(mufRtProvider.get());
   mapArea->setCloudProvider(cloudProvider.get());
   mapArea->setBeaconProvider(beaconProvider.get());
   mapArea->setAuroraStore(auroraHistoryStore);
+  mapArea->setDrapStore(ctx.drapStore);
   mapArea->setIonosondeProvider(ionosondeProvider.get());
+#ifndef __EMSCRIPTEN__
+  if (ctx.webServer)
+    ctx.webServer->setPropagationSources(ionosondeProvider, ctx.drapStore);
+#endif
   mapArea->setSolarDataStore(ctx.solarStore.get());
       mapArea->setActivityStore(ctx.activityStore);
   
@@ -1154,9 +1247,20 @@ DashboardContext::DashboardContext(AppContext &ctx)
                   localPanel.get(),     dxSatPane.get(), mapArea.get(),
                   rssBanner.get()};
 
-  lastFetchMs = SDL_GetTicks();
   lastFpsUpdate = SDL_GetTicks();
   frames = 0;
+  // The scheduler runs the first weather fetches
+  weatherOriginWatch.changed();
+  dxWatch.changed();
+
+#ifndef __EMSCRIPTEN__
+  if (SoftwarePresenter::supported(ctx.renderer)) {
+    presenter = std::make_unique<SoftwarePresenter>(ctx.window, ctx.renderer,
+                                                    !ctx.fullRedraw);
+    LOG_I("Main", "Software renderer: {}",
+          ctx.fullRedraw ? "full redraw" : "presenting damaged regions");
+  }
+#endif
 
   // Initial layout calculation
   fontCatalog.recalculate(LOGICAL_WIDTH, LOGICAL_HEIGHT);
@@ -1173,30 +1277,26 @@ void DashboardContext::update(AppContext &ctx) {
 
   Uint32 now = SDL_GetTicks();
 
-  // Background refresh every 15 minutes
-  if (now - lastFetchMs > 15 * 60 * 1000) {
-    noaaProvider->fetch();
-    rssProvider->fetch();
-    spotProvider->fetch();
-    satMgr->fetch();
-    activityProvider->fetch();
+  ctx.state->tickClock(std::chrono::system_clock::now());
+  scheduler->tick();
+
+  // Band conditions only depend on the solar indices; weather is refetched
+  // when DE or DX moves (the scheduler covers the first fetch)
+  if (solarWatch.changed())
     bandProvider->update();
-    contestProvider->fetch();
-    moonProvider->update(appCfg.lat, appCfg.lon);
-    deWeatherProvider->fetch(ctx.state->deLocation.lat,
-                             ctx.state->deLocation.lon);
-    dxWeatherProvider->fetch(ctx.state->dxLocation.lat,
-                             ctx.state->dxLocation.lon);
-    historyProvider->fetchFlux();
-    historyProvider->fetchSSN();
-    historyProvider->fetchKp();
-    adifProvider->fetch(ctx.cfgMgr.configDir() / "logs.adif");
-    mufRtProvider->update();
-    ionosondeProvider->update();
-    asteroidProvider->update();
-    lastFetchMs = now;
+  if (weatherOriginWatch.changed()) {
+    LatLon de = weatherOriginWatch.get();
+    deWeatherProvider->fetch(de.lat, de.lon);
+  }
+  if (dxWatch.changed()) {
+    DXTarget dx = dxWatch.get();
+    if (dx.active)
+      dxWeatherProvider->fetch(dx.loc.lat, dx.loc.lon);
   }
 
+  // Results of background tasks that finish on the main thread
+  WorkerService::getInstance().drainCompletions();
+
   SDL_Event event;
   while (SDL_PollEvent(&event)) {
     if (event.type == SDL_MOUSEMOTION || event.type == SDL_MOUSEBUTTONDOWN ||
@@ -1208,6 +1308,12 @@ void DashboardContext::update(AppContext &ctx) {
         cursorVisible = true;
       }
     }
+    if (presenter &&
+        (event.type == SDL_MOUSEMOTION || event.type == SDL_MOUSEBUTTONDOWN ||
+         event.type == SDL_MOUSEBUTTONUP || event.type == SDL_MOUSEWHEEL ||
+         event.type == SDL_FINGERDOWN || event.type == SDL_FINGERMOTION ||
+         event.type == SDL_KEYDOWN || event.type == SDL_TEXTINPUT))
+      presenter->damageAll();
 
     switch (event.type) {
     case SDL_QUIT:
@@ -1273,8 +1379,12 @@ void DashboardContext::update(AppContext &ctx) {
           fontCatalog.recalculate(event.window.data1, event.window.data2);
           layout.recalculate(event.window.data1, event.window.data2);
         }
+        if (presenter)
+          presenter->invalidate();
         render(ctx); // renderFrame
       } else if (event.window.event == SDL_WINDOWEVENT_EXPOSED) {
+        if (presenter)
+          presenter->invalidate();
         render(ctx);
       }
       break;
@@ -1282,15 +1392,6 @@ void DashboardContext::update(AppContext &ctx) {
       // Handle custom application events
       if (event.type >= AE_BASE_EVENT) {
         switch (event.type - AE_BASE_EVENT) {
-        case AE_SATELLITE_TRACK_READY: {
-          auto *track =
-              static_cast<std::vector<GroundTrackPoint> *>(event.user.data1);
-          if (track && ctx.dashboard && ctx.dashboard->mapArea) {
-            ctx.dashboard->mapArea->onSatTrackReady(*track);
-          }
-          delete track; // Free the memory allocated by the worker thread
-          break;
-        }
         case AE_RSS_DATA_READY: {
           int feed_idx = event.user.code;
           auto *headlines =
@@ -1419,24 +1520,8 @@ void DashboardContext::update(AppContext &ctx) {
           delete update;
           break;
         }
-                  case AE_HISTORY_DATA_READY: {
-                    auto *update = static_cast<HistorySeries *>(event.user.data1);
-                    if (update && ctx.historyStore) {
-                      ctx.historyStore->update(update->name, *update);
-                    }
-                    delete update;
-                    break;
-                  }
-                  case AE_PROP_DATA_READY: {
-                    auto *grid = static_cast<std::vector<float> *>(event.user.data1);
-                    if (grid && ctx.dashboard && ctx.dashboard->mapArea) {
-                      ctx.dashboard->mapArea->onPropDataReady(
-                          static_cast<PropOverlayType>(event.user.code), *grid);
-                    }
-                    delete grid;
-                    break;
-                  }
-                  }      }
+        }
+      }
       break;
     }
 
@@ -1580,26 +1665,43 @@ void DashboardContext::update(AppContext &ctx) {
 
   for (auto *w : widgets)
     w->update();
-  // satMgr->update(); // Deprecated: Auto-tracking handled by RotatorService
+  satMgr->update();
   ctx.brightnessMgr->update();
 }
 
 void DashboardContext::render(AppContext &ctx) {
-  SDL_SetRenderDrawColor(ctx.renderer, 0, 0, 0, 255);
-  SDL_RenderClear(ctx.renderer);
+  MemoryMonitor::getInstance().beginFrame();
+
+  Widget *activeModal = nullptr;
+  for (auto *w : widgets) {
+    if (w->isModalActive())
+      activeModal = w;
+  }
+
+  if (!presenter) {
+    SDL_SetRenderDrawColor(ctx.renderer, 0, 0, 0, 255);
+    SDL_RenderClear(ctx.renderer);
+  }
 
   if (FIDELITY_MODE) {
     SDL_RenderSetViewport(ctx.renderer, nullptr);
     SDL_RenderSetScale(ctx.renderer, ctx.layScale, ctx.layScale);
   }
 
-  Widget *activeModal = nullptr;
-  for (auto *w : widgets) {
-    if (w->isModalActive())
-      activeModal = w;
-    SDL_Rect clip = w->getRect();
+  if (presenter) {
+    // The modal backdrop dims everything, on the way in and out
+    if (activeModal || modalShown)
+      presenter->invalidate();
+    modalShown = activeModal != nullptr;
+    presenter->beginFrame(widgets);
+  }
+
+  for (size_t i = 0; i < widgets.size(); ++i) {
+    if (presenter && !presenter->needsRepaint(i))
+      continue;
+    SDL_Rect clip = widgets[i]->getRect();
     SDL_RenderSetClipRect(ctx.renderer, &clip);
-    w->render(ctx.renderer);
+    widgets[i]->render(ctx.renderer);
   }
   SDL_RenderSetClipRect(ctx.renderer, nullptr);
 
@@ -1611,7 +1713,10 @@ void DashboardContext::render(AppContext &ctx) {
     activeModal->renderModal(ctx.renderer);
   }
 
-  SDL_RenderPresent(ctx.renderer);
+  if (presenter)
+    presenter->present();
+  else
+    SDL_RenderPresent(ctx.renderer);
   if (FIDELITY_MODE) {
     SDL_RenderSetScale(ctx.renderer, 1.0f, 1.0f);
   }
@@ -1749,8 +1854,7 @@ void main_tick() {
       ctx.activeSetup = AppContext::SetupMode::None;
       // Update state
       ctx.state->deCallsign = ctx.appCfg.callsign;
-      ctx.state->deGrid = ctx.appCfg.grid;
-      ctx.state->deLocation = {ctx.appCfg.lat, ctx.appCfg.lon};
+      ctx.state->setDE({ctx.appCfg.lat, ctx.appCfg.lon}, ctx.appCfg.grid);
     }
 
   } else {
@@ -1765,8 +1869,7 @@ void main_tick() {
     // here on the main thread so no SDL calls happen off-thread.
     if (ctx.configReloadRequested.exchange(false, std::memory_order_acq_rel)) {
       ctx.state->deCallsign = ctx.appCfg.callsign;
-      ctx.state->deGrid = ctx.appCfg.grid;
-      ctx.state->deLocation = {ctx.appCfg.lat, ctx.appCfg.lon};
+      ctx.state->setDE({ctx.appCfg.lat, ctx.appCfg.lon}, ctx.appCfg.grid);
       ctx.netManager->setCorsProxyUrl(ctx.appCfg.corsProxyUrl);
       // Re-apply theme/metric to all live widgets without rebuilding dashboard
       if (ctx.dashboard) {
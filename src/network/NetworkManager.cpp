@@ -54,10 +54,37 @@ static size_t headerCallback(char *ptr, size_t size, size_t nmemb,
 
 // ... (existing includes)
 
+static thread_local std::shared_ptr<NetworkManager::Outcome> t_outcome;
+
+NetworkManager::OutcomeScope::OutcomeScope(std::shared_ptr<Outcome> outcome)
+    : previous_(std::move(t_outcome)) {
+  t_outcome = std::move(outcome);
+}
+
+NetworkManager::OutcomeScope::~OutcomeScope() {
+  t_outcome = std::move(previous_);
+}
+
 // Basic in-memory cache to prevent accidental tight-loop fetches
 void NetworkManager::fetchAsync(const std::string &url,
                                 std::function<void(std::string)> callback,
                                 int cacheAgeSeconds, bool force) {
+  if (t_outcome) {
+    // An empty body is how every path below reports failure.
+    t_outcome->started++;
+    t_outcome->pending++;
+    callback = [outcome = t_outcome,
+                cb = std::move(callback)](std::string data) {
+      bool ok = !data.empty();
+      cb(std::move(data));
+      if (!ok)
+        outcome->failed++;
+      outcome->lastDone =
+          std::chrono::steady_clock::now().time_since_epoch().count();
+      outcome->pending.fetch_sub(1, std::memory_order_release);
+    };
+  }
+
   // Check memory cache first
   CacheEntry cached;
   bool hasCache = false;
@@ -384,3 +411,11 @@ void NetworkManager::loadCache() {
     }
   }
 }
+
+std::string NetworkManager::cacheValidator(const std::string &url) {
+  std::lock_guard<std::mutex> lock(cacheMutex_);
+  auto it = cache_.find(url);
+  if (it == cache_.end())
+    return "";
+  return !it->second.etag.empty() ? it->second.etag : it->second.lastModified;
+}
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <ctime>
 #include <filesystem>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
@@ -23,6 +26,33 @@ public:
                   std::function<void(std::string)> callback,
                   int cacheAgeSeconds = 3600, bool force = false);
 
+  // ETag (or Last-Modified) of the cached response for url, empty if the
+  // server sent neither. Lets callers skip reprocessing unchanged data.
+  std::string cacheValidator(const std::string &url);
+
+  // How the requests started under an OutcomeScope went. Updated from the
+  // request threads; a request counts as done once its callback returned.
+  struct Outcome {
+    std::atomic<int> started{0};
+    std::atomic<int> pending{0};
+    std::atomic<int> failed{0};
+    std::atomic<std::chrono::steady_clock::rep> lastDone{0};
+  };
+
+  // While alive, every fetchAsync() made on this thread (by any manager)
+  // reports into outcome. Lets a caller learn whether the fetches behind an
+  // opaque task succeeded without the task reporting it. Scopes nest.
+  class OutcomeScope {
+  public:
+    explicit OutcomeScope(std::shared_ptr<Outcome> outcome);
+    ~OutcomeScope();
+    OutcomeScope(const OutcomeScope &) = delete;
+    OutcomeScope &operator=(const OutcomeScope &) = delete;
+
+  private:
+    std::shared_ptr<Outcome> previous_;
+  };
+
   // Set CORS proxy prefix (WASM only). Called at startup from AppConfig.
   // All subsequent fetchAsync calls prepend this to external URLs.
   void setCorsProxyUrl(const std::string &url) { corsProxyUrl_ = url; }
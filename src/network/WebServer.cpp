@@ -2,18 +2,25 @@
 
 #include <SDL.h>
 
+#include "../core/Astronomy.h"
 #include "../core/ConfigManager.h"
 #include "../core/HamClockState.h"
+#include "../core/MemoryMonitor.h"
+#include "../core/PropEngine.h"
 #include "../core/SolarData.h"
 #include "../core/StringUtils.h"
 #include "../core/WatchlistStore.h"
+#include "../services/IonosondeProvider.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <future>
 #include <httplib.h>
 #include <nlohmann/json.hpp>
 
 #include "../core/Logger.h"
 
 #ifdef ENABLE_DEBUG_API
-#include "../core/Astronomy.h"
 #include "../core/UIRegistry.h"
 #include <iomanip>
 #include <iostream>
@@ -56,6 +63,14 @@ void WebServer::stop() {
 #endif
 }
 
+void WebServer::setPropagationSources(
+    std::weak_ptr<const IonosondeProvider> iono,
+    std::shared_ptr<DrapStore> drap) {
+  std::lock_guard<std::mutex> lock(propMutex_);
+  iono_ = std::move(iono);
+  drap_ = std::move(drap);
+}
+
 void WebServer::run() {
 #ifndef __EMSCRIPTEN__
   httplib::Server svr;
@@ -369,20 +384,18 @@ void WebServer::run() {
 
   // ---------------------------------------------------------------------------
   // Propagation Overlay API
-  // Provides schemas and proxy support for VOACAP/MUF-RT overlay generation.
-  // For on-demand VOACAP overlays, set the OHB_URL environment variable to
-  // point to an open-hamclock-backend instance (e.g. http://localhost:8081).
+  // VOACAP-style coverage maps are computed in-process by PropEngine. If the
+  // OHB_URL environment variable points to an open-hamclock-backend instance
+  // (e.g. http://localhost:8081), its equivalent URL is returned as well.
   // ---------------------------------------------------------------------------
 
   // GET /api/propagation/voacap
-  //   Returns overlay schema and proxy URL to open-hamclock-backend.
+  //   Returns a 660x330 coverage map from the DE (or tx_lat/tx_lon) location.
   //   Parameters: tx_lat, tx_lon, band (80m/40m/.../6m), freq_mhz, hour_utc,
   //               year, month, path (0/1), mode (SSB/CW/FT8/WSPR/AM/RTTY),
-  //               watts, overlay_type (muf/reliability/toa)
+  //               watts, overlay_type (muf/reliability/toa/snr/field)
   svr.Get("/api/propagation/voacap", [this](const httplib::Request &req,
                                             httplib::Response &res) {
-    nlohmann::json j;
-
     // Extract parameters (with defaults from current state)
     double txLat = state_ ? state_->deLocation.lat : 0.0;
     double txLon = state_ ? state_->deLocation.lon : 0.0;
@@ -445,106 +458,235 @@ void WebServer::run() {
                                   ? req.get_param_value("overlay_type")
                                   : "reliability";
 
-    // Build OHB backend URL from environment or config
-    const char *ohbEnv = std::getenv("OHB_URL");
-    std::string ohbUrl = ohbEnv ? std::string(ohbEnv) : "";
-    if (ohbUrl.empty() && cfg_) {
-      // Check config for optional backend URL
-      // (future: cfg_->ohbUrl when that field is added to AppConfig)
-      ohbUrl = "";
-    }
-
-    j["schema_version"] = "1.0";
-    j["overlay_type"] = overlayType;
-    j["projection"] = "equirectangular";
-    j["bounds"] = {
-        {"west", -180}, {"east", 180}, {"south", -90}, {"north", 90}};
-    j["width"] = 660;
-    j["height"] = 330;
-    j["request_params"] = {{"tx_lat", txLat},
-                           {"tx_lon", txLon},
-                           {"freq_mhz", freqMhz},
-                           {"band", band},
-                           {"hour_utc", hourUtc},
-                           {"year", year},
-                           {"month", month},
-                           {"mode", mode},
-                           {"watts", watts},
-                           {"path", path},
-                           {"overlay_type", overlayType}};
-
-    // Colormaps for each overlay type
+    CoverageOutput output = CoverageOutput::Reliability;
+    const char *units = "%";
     if (overlayType == "muf") {
-      j["colormap"] = nlohmann::json::array({
-          {{"value", 0}, {"color", "#4000C0"}, {"label", "0 MHz"}},
-          {{"value", 4}, {"color", "#0040FF"}, {"label", "4 MHz"}},
-          {{"value", 9}, {"color", "#00CCFF"}, {"label", "9 MHz"}},
-          {{"value", 15}, {"color", "#80FFFF"}, {"label", "15 MHz"}},
-          {{"value", 20}, {"color", "#00FF80"}, {"label", "20 MHz"}},
-          {{"value", 27}, {"color", "#FFFF00"}, {"label", "27 MHz"}},
-          {{"value", 30}, {"color", "#FF8000"}, {"label", "30 MHz"}},
-          {{"value", 35}, {"color", "#FF0000"}, {"label", "35+ MHz"}},
-      });
+      output = CoverageOutput::Muf;
+      units = "MHz";
     } else if (overlayType == "toa") {
-      j["colormap"] = nlohmann::json::array({
-          {{"value", 0}, {"color", "#00FF80"}, {"label", "0 ms"}},
-          {{"value", 5}, {"color", "#80FF40"}, {"label", "5 ms"}},
-          {{"value", 15}, {"color", "#FFFF00"}, {"label", "15 ms"}},
-          {{"value", 25}, {"color", "#FF80C0"}, {"label", "25 ms"}},
-          {{"value", 40}, {"color", "#808080"}, {"label", "40 ms"}},
-      });
-    } else { // reliability
-      j["colormap"] = nlohmann::json::array({
-          {{"value", 0}, {"color", "#606060"}, {"label", "0%"}},
-          {{"value", 21}, {"color", "#CC4080"}, {"label", "21%"}},
-          {{"value", 40}, {"color", "#FFFF00"}, {"label", "40%"}},
-          {{"value", 60}, {"color", "#80FF40"}, {"label", "60%"}},
-          {{"value", 83}, {"color", "#00FF80"}, {"label", "83%"}},
-          {{"value", 100}, {"color", "#FFFFFF"}, {"label", "100%"}},
-      });
+      output = CoverageOutput::Toa;
+      units = "deg";
+    } else if (overlayType == "snr") {
+      output = CoverageOutput::Snr;
+      units = "dB-Hz";
+    } else if (overlayType == "field") {
+      output = CoverageOutput::FieldStrength;
+      units = "dBuV/m";
+    } else {
+      overlayType = "reliability";
     }
 
-    if (!ohbUrl.empty()) {
-      // Backend configured — return proxy URL
-      std::string endpoint =
-          (overlayType == "muf")   ? "/ham/HamClock/fetchVOACAP-MUF.pl"
-          : (overlayType == "toa") ? "/ham/HamClock/fetchVOACAP-TOA.pl"
-                                   : "/ham/HamClock/fetchBandConditions.pl";
-
-      char qs[512];
-      std::snprintf(qs, sizeof(qs),
-                    "TXLAT=%.4f&TXLNG=%.4f&MHZ=%.3f&UTC=%d&YEAR=%d&MONTH=%d&"
-                    "PATH=%d&MODE=%s&WATTS=%d&WIDTH=660&HEIGHT=330",
-                    txLat, txLon, freqMhz, hourUtc, year, month, path,
-                    mode.c_str(), watts);
-
-      j["backend_url"] = ohbUrl;
-      j["overlay_endpoint"] = ohbUrl + endpoint + "?" + std::string(qs);
-      j["compute_location"] = "backend";
-      j["status"] = "backend_configured";
-      j["note"] =
-          (overlayType != "reliability")
-              ? "Note: fetchVOACAP-MUF.pl and fetchVOACAP-TOA.pl are not yet "
-                "implemented in open-hamclock-backend. Use "
-                "overlay_type=reliability for DE-to-DX band conditions."
-              : "Fetch the overlay_endpoint URL to get band conditions data.";
-    } else {
-      // No backend — return instructions and KC2G fallback
-      j["backend_url"] = nullptr;
-      j["compute_location"] = "not_configured";
-      j["status"] = "backend_not_configured";
-      j["setup_instructions"] = {
-          {"step1", "Start open-hamclock-backend: cd open-hamclock-backend && "
-                    "docker-compose up"},
-          {"step2", "Set environment variable OHB_URL=http://localhost:8081"},
-          {"step3", "Restart hamclock-next"},
-      };
+    // The requested hour of today, or of mid-month for another month.
+    std::tm when = utcTm;
+    if (year != utcTm.tm_year + 1900 || month != utcTm.tm_mon + 1)
+      when.tm_mday = 15;
+    when.tm_year = year - 1900;
+    when.tm_mon = std::clamp(month, 1, 12) - 1;
+    when.tm_hour = std::clamp(hourUtc, 0, 23);
+    when.tm_min = 0;
+    when.tm_sec = 0;
+
+    PropPathParams params{};
+    params.txLat = txLat;
+    params.txLon = txLon;
+    params.mhz = freqMhz;
+    params.watts = watts;
+    params.mode = mode;
+    params.path = path;
+    params.utc = Astronomy::portable_timegm(&when);
+
+    SolarData sw = solar_ ? solar_->get() : SolarData{};
+    std::shared_ptr<const IonosondeProvider> iono;
+    std::shared_ptr<const DrapGrid> drap;
+    {
+      std::lock_guard<std::mutex> lock(propMutex_);
+      iono = iono_.lock();
+      if (drap_)
+        drap = drap_->gridSnapshot();
     }
+    if (iono && !iono->hasData())
+      iono.reset();
 
-    j["ttl_seconds"] = 1800;
-    j["docs"] = "docs/parity.md";
+    const char *ohbEnv = std::getenv("OHB_URL");
+    std::string ohbUrl = ohbEnv ? std::string(ohbEnv) : "";
 
-    res.set_content(j.dump(2), "application/json");
+    // Everything the body depends on. params.utc is a whole hour, so the
+    // current map is shared until the hour or one of the inputs changes.
+    std::ostringstream keyStream;
+    keyStream << std::setprecision(10) << txLat << '|' << txLon << '|'
+              << freqMhz << '|' << band << '|' << hourUtc << '|' << year
+              << '|' << month << '|' << mode << '|' << watts << '|' << path
+              << '|' << overlayType << '|' << params.utc << '|'
+              << sw.sunspot_number << '|' << sw.k_index << '|'
+              << (iono ? iono->generation() : 0) << '|' << drap.get() << '|'
+              << ohbUrl;
+    const std::string key = keyStream.str();
+
+    std::promise<std::string> computed;
+    std::shared_future<std::string> body;
+    bool hit = false;
+    {
+      std::lock_guard<std::mutex> lock(voacapMutex_);
+      auto now = std::chrono::steady_clock::now();
+      voacapCache_.erase(
+          std::remove_if(voacapCache_.begin(), voacapCache_.end(),
+                         [now](const VoacapEntry &e) {
+                           return now - e.created >
+                                  std::chrono::seconds(kVoacapTtlSeconds);
+                         }),
+          voacapCache_.end());
+      auto it = std::find_if(
+          voacapCache_.begin(), voacapCache_.end(),
+          [&](const VoacapEntry &e) { return e.key == key; });
+      if (it != voacapCache_.end()) {
+        VoacapEntry entry = std::move(*it);
+        voacapCache_.erase(it);
+        body = entry.body;
+        voacapCache_.push_front(std::move(entry));
+        hit = true;
+      } else {
+        body = computed.get_future().share();
+        voacapCache_.push_front({key, drap, now, body});
+        if (voacapCache_.size() > kVoacapCacheEntries)
+          voacapCache_.pop_back();
+      }
+    }
+
+    // Worker helpers queue behind the dashboard's own work; this thread
+    // computes regardless, so a busy pool only makes the request slower.
+    auto render = [&]() -> std::string {
+      nlohmann::json j;
+      auto started = std::chrono::steady_clock::now();
+      std::vector<float> grid = PropEngine::generateCoverage(
+          params, sw, iono.get(), output, drap.get(), TaskPriority::Background);
+      auto tookMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - started)
+                        .count();
+
+      j["schema_version"] = "1.0";
+      j["overlay_type"] = overlayType;
+      j["projection"] = "equirectangular";
+      j["bounds"] = {
+          {"west", -180}, {"east", 180}, {"south", -90}, {"north", 90}};
+      j["width"] = PropEngine::MAP_W;
+      j["height"] = PropEngine::MAP_H;
+      j["request_params"] = {{"tx_lat", txLat},
+                             {"tx_lon", txLon},
+                             {"freq_mhz", freqMhz},
+                             {"band", band},
+                             {"hour_utc", hourUtc},
+                             {"year", year},
+                             {"month", month},
+                             {"mode", mode},
+                             {"watts", watts},
+                             {"path", path},
+                             {"overlay_type", overlayType}};
+
+      // Colormaps for each overlay type
+      if (overlayType == "muf") {
+        j["colormap"] = nlohmann::json::array({
+            {{"value", 0}, {"color", "#4000C0"}, {"label", "0 MHz"}},
+            {{"value", 4}, {"color", "#0040FF"}, {"label", "4 MHz"}},
+            {{"value", 9}, {"color", "#00CCFF"}, {"label", "9 MHz"}},
+            {{"value", 15}, {"color", "#80FFFF"}, {"label", "15 MHz"}},
+            {{"value", 20}, {"color", "#00FF80"}, {"label", "20 MHz"}},
+            {{"value", 27}, {"color", "#FFFF00"}, {"label", "27 MHz"}},
+            {{"value", 30}, {"color", "#FF8000"}, {"label", "30 MHz"}},
+            {{"value", 35}, {"color", "#FF0000"}, {"label", "35+ MHz"}},
+        });
+      } else if (overlayType == "toa") {
+        j["colormap"] = nlohmann::json::array({
+            {{"value", 0}, {"color", "#00FF80"}, {"label", "0 deg"}},
+            {{"value", 5}, {"color", "#80FF40"}, {"label", "5 deg"}},
+            {{"value", 15}, {"color", "#FFFF00"}, {"label", "15 deg"}},
+            {{"value", 25}, {"color", "#FF80C0"}, {"label", "25 deg"}},
+            {{"value", 40}, {"color", "#808080"}, {"label", "40 deg"}},
+        });
+      } else if (overlayType == "snr") {
+        j["colormap"] = nlohmann::json::array({
+            {{"value", 0}, {"color", "#606060"}, {"label", "0 dB-Hz"}},
+            {{"value", 30}, {"color", "#CC4080"}, {"label", "30 dB-Hz"}},
+            {{"value", 45}, {"color", "#FFFF00"}, {"label", "45 dB-Hz"}},
+            {{"value", 60}, {"color", "#80FF40"}, {"label", "60 dB-Hz"}},
+            {{"value", 80}, {"color", "#FFFFFF"}, {"label", "80+ dB-Hz"}},
+        });
+      } else if (overlayType == "field") {
+        j["colormap"] = nlohmann::json::array({
+            {{"value", -20}, {"color", "#606060"}, {"label", "-20 dBuV/m"}},
+            {{"value", 0}, {"color", "#CC4080"}, {"label", "0 dBuV/m"}},
+            {{"value", 20}, {"color", "#FFFF00"}, {"label", "20 dBuV/m"}},
+            {{"value", 40}, {"color", "#80FF40"}, {"label", "40 dBuV/m"}},
+            {{"value", 60}, {"color", "#FFFFFF"}, {"label", "60+ dBuV/m"}},
+        });
+      } else { // reliability
+        j["colormap"] = nlohmann::json::array({
+            {{"value", 0}, {"color", "#606060"}, {"label", "0%"}},
+            {{"value", 21}, {"color", "#CC4080"}, {"label", "21%"}},
+            {{"value", 40}, {"color", "#FFFF00"}, {"label", "40%"}},
+            {{"value", 60}, {"color", "#80FF40"}, {"label", "60%"}},
+            {{"value", 83}, {"color", "#00FF80"}, {"label", "83%"}},
+            {{"value", 100}, {"color", "#FFFFFF"}, {"label", "100%"}},
+        });
+      }
+
+      // Row-major from 90N, columns from 180W, one decimal.
+      nlohmann::json values = nlohmann::json::array();
+      values.get_ref<nlohmann::json::array_t &>().reserve(grid.size());
+      for (float v : grid)
+        values.push_back(std::round(v * 10.0f) / 10.0);
+      j["units"] = units;
+      j["values"] = std::move(values);
+      j["model"] = "itu-r-p533";
+      j["inputs"] = {{"ssn", sw.sunspot_number},
+                     {"k_index", sw.k_index},
+                     {"ionosonde", iono != nullptr},
+                     {"drap", drap != nullptr}};
+      j["compute_location"] = "local";
+      j["compute_ms"] = tookMs;
+      j["status"] = "ok";
+
+      if (!ohbUrl.empty()) {
+        // The same map from the backend, for comparison
+        std::string endpoint =
+            (overlayType == "muf")   ? "/ham/HamClock/fetchVOACAP-MUF.pl"
+            : (overlayType == "toa") ? "/ham/HamClock/fetchVOACAP-TOA.pl"
+                                     : "/ham/HamClock/fetchBandConditions.pl";
+
+        char qs[512];
+        std::snprintf(qs, sizeof(qs),
+                      "TXLAT=%.4f&TXLNG=%.4f&MHZ=%.3f&UTC=%d&YEAR=%d&MONTH=%d&"
+                      "PATH=%d&MODE=%s&WATTS=%d&WIDTH=660&HEIGHT=330",
+                      txLat, txLon, freqMhz, hourUtc, year, month, path,
+                      mode.c_str(), watts);
+
+        j["backend_url"] = ohbUrl;
+        j["overlay_endpoint"] = ohbUrl + endpoint + "?" + std::string(qs);
+      } else {
+        j["backend_url"] = nullptr;
+      }
+
+      j["ttl_seconds"] = kVoacapTtlSeconds;
+      j["docs"] = "docs/parity.md";
+
+      // Compact: the values alone are over 200k numbers.
+      return j.dump();
+    };
+
+    if (!hit) {
+      try {
+        computed.set_value(render());
+      } catch (...) {
+        computed.set_exception(std::current_exception());
+        std::lock_guard<std::mutex> lock(voacapMutex_);
+        voacapCache_.erase(
+            std::remove_if(voacapCache_.begin(), voacapCache_.end(),
+                           [&](const VoacapEntry &e) { return e.key == key; }),
+            voacapCache_.end());
+        throw;
+      }
+    }
+    res.set_header("X-Cache", hit ? "HIT" : "MISS");
+    res.set_content(body.get(), "application/json");
   });
 
   // GET /api/propagation/muf_rt
@@ -743,14 +885,10 @@ void WebServer::run() {
             if (req.has_param("target"))
               target = req.get_param_value("target");
 
-            if (target == "de") {
-              state_->deLocation = {lat, lon};
-              state_->deGrid = Astronomy::latLonToGrid(lat, lon);
-            } else {
-              state_->dxLocation = {lat, lon};
-              state_->dxGrid = Astronomy::latLonToGrid(lat, lon);
-              state_->dxActive = true;
-            }
+            if (target == "de")
+              state_->setDE({lat, lon});
+            else
+              state_->setDX({lat, lon});
             nlohmann::json j;
             j["target"] = target;
             j["lat"] = lat;
@@ -869,7 +1007,22 @@ void WebServer::run() {
   svr.Get("/debug/watchlist/add",
           [this](const httplib::Request &req, httplib::Response &res) {
             if (req.has_param("call") && watchlist_) {
-              watchlist_->add(req.get_param_value("call"));
+              if (watchlist_->add(req.get_param_value("call"))) {
+                res.set_content("ok", "text/plain");
+              } else {
+                res.status = 400;
+                res.set_content("invalid watchlist entry", "text/plain");
+              }
+            } else {
+              res.status = 400;
+              res.set_content("missing call or watchlist store", "text/plain");
+            }
+          });
+
+  svr.Get("/debug/watchlist/remove",
+          [this](const httplib::Request &req, httplib::Response &res) {
+            if (req.has_param("call") && watchlist_) {
+              watchlist_->remove(req.get_param_value("call"));
               res.set_content("ok", "text/plain");
             } else {
               res.status = 400;
@@ -905,6 +1058,22 @@ void WebServer::run() {
             res.set_content(j.dump(2), "application/json");
           });
 
+  svr.Get("/debug/memory",
+          [](const httplib::Request &, httplib::Response &res) {
+            auto &mem = MemoryMonitor::getInstance();
+            nlohmann::json j;
+            j["rss_bytes"] = mem.getRSS();
+            j["vram_bytes"] = mem.getVramEstimated();
+            j["vram_budget_bytes"] = mem.getVramBudget();
+            j["evictions"] = mem.getEvictionCount();
+            for (const auto &[owner, u] : mem.ownerUsage()) {
+              j["owners"][owner] = {{"bytes", u.bytes},
+                                    {"evictable_bytes", u.evictableBytes},
+                                    {"textures", u.count}};
+            }
+            res.set_content(j.dump(2), "application/json");
+          });
+
   svr.Get("/debug/logs", [](const httplib::Request &, httplib::Response &res) {
     nlohmann::json j;
     j["status"] = "OK";
@@ -916,23 +1085,58 @@ void WebServer::run() {
   svr.Get("/debug/health", [this](const httplib::Request &,
                                   httplib::Response &res) {
     nlohmann::json j;
-    for (const auto &[name, status] : state_->services) {
+    auto fmtTime = [](std::chrono::system_clock::time_point tp) {
+      auto t = std::chrono::system_clock::to_time_t(tp);
+      std::tm tm_utc{};
+      Astronomy::portable_gmtime(&t, &tm_utc);
+      std::stringstream ss;
+      ss << std::put_time(&tm_utc, "%Y-%m-%d %H:%M:%S");
+      return ss.str();
+    };
+
+    state_->services.forEach([&](const ServiceSlot &slot) {
+      ServiceSlot::Snapshot status = slot.snapshot();
+      if (status.updates == 0)
+        return; // claimed but not started (e.g. disabled in config)
       nlohmann::json s;
       s["ok"] = status.ok;
-      s["lastError"] = status.lastError;
-      if (status.lastSuccess.time_since_epoch().count() > 0) {
-        auto t = std::chrono::system_clock::to_time_t(status.lastSuccess);
-        std::tm tm_utc{};
-        Astronomy::portable_gmtime(&t, &tm_utc);
-        std::stringstream ss;
-        ss << std::put_time(&tm_utc, "%Y-%m-%d %H:%M:%S");
-        s["lastSuccess"] = ss.str();
-      }
-      j[name] = s;
+      s["lastError"] = status.message;
+      s["consecutiveFailures"] = status.consecutiveFailures;
+      if (status.lastSuccess.time_since_epoch().count() > 0)
+        s["lastSuccess"] = fmtTime(status.lastSuccess);
+      j[std::string(slot.name())] = s;
+    });
+
+    // Scheduled fetch jobs, under "Fetch:<job>"
+    auto now = std::chrono::system_clock::now();
+    for (const auto &[name, job] : state_->fetchJobs.snapshot()) {
+      nlohmann::json s;
+      s["ok"] = job.failures == 0;
+      s["priority"] = job.critical ? "critical" : "background";
+      s["intervalSec"] = job.intervalSec;
+      s["nextRunInSec"] = std::max<long long>(
+          0, std::chrono::duration_cast<std::chrono::seconds>(job.nextRun - now)
+                 .count());
+      s["lastDurationMs"] = job.lastDurationMs;
+      s["failures"] = job.failures;
+      if (job.lastRun.time_since_epoch().count() > 0)
+        s["lastRun"] = fmtTime(job.lastRun);
+      if (job.lastSuccess.time_since_epoch().count() > 0)
+        s["lastSuccess"] = fmtTime(job.lastSuccess);
+      if (job.failures > 0)
+        s["lastError"] = std::to_string(job.failures) + " failed attempt(s)";
+      j["Fetch:" + name] = s;
     }
     res.set_content(j.dump(2), "application/json");
   });
 
+  // Prometheus scrape target: per-service latency, size and parse metrics
+  svr.Get("/metrics", [this](const httplib::Request &,
+                             httplib::Response &res) {
+    res.set_content(state_->services.renderPrometheus(),
+                    "text/plain; version=0.0.4");
+  });
+
   // Display Power Control
   svr.Get("/api/display/status",
           [this](const httplib::Request &, httplib::Response &res) {
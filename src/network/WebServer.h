@@ -2,8 +2,12 @@
 
 #include "../core/Constants.h"
 #include <atomic>
+#include <chrono>
+#include <deque>
+#include <future>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <thread>
 
 // Forward declaration to avoid pulling SDL into the header
@@ -15,6 +19,9 @@ class ConfigManager;
 class WatchlistStore;
 class SolarDataStore;
 class DisplayPower;
+class IonosondeProvider;
+class DrapStore;
+struct DrapGrid;
 
 class WebServer {
 public:
@@ -29,6 +36,11 @@ public:
   void start();
   void stop();
 
+  // Inputs of /api/propagation/voacap. The provider belongs to the
+  // dashboard, which may be torn down while the server runs.
+  void setPropagationSources(std::weak_ptr<const IonosondeProvider> iono,
+                             std::shared_ptr<DrapStore> drap);
+
 private:
   void run();
 
@@ -39,6 +51,24 @@ private:
   std::shared_ptr<WatchlistStore> watchlist_;
   std::shared_ptr<SolarDataStore> solar_;
   std::shared_ptr<DisplayPower> displayPower_;
+  std::mutex propMutex_; // guards iono_ and drap_
+  std::weak_ptr<const IonosondeProvider> iono_;
+  std::shared_ptr<DrapStore> drap_;
+
+  // /api/propagation/voacap responses, keyed by the request and the model
+  // inputs (hour, SSN, K, ionosonde generation, DRAP snapshot). A request
+  // arriving while an identical one computes waits for its result.
+  struct VoacapEntry {
+    std::string key;
+    std::shared_ptr<const DrapGrid> drap; // keeps the keyed snapshot alive
+    std::chrono::steady_clock::time_point created;
+    std::shared_future<std::string> body;
+  };
+  std::mutex voacapMutex_;
+  std::deque<VoacapEntry> voacapCache_; // most recently used first
+  static constexpr size_t kVoacapCacheEntries = 6; // ~1 MB each
+  static constexpr int kVoacapTtlSeconds = 1800;
+
   std::atomic<bool> *reloadFlag_; // points to AppContext::configReloadRequested
   int port_;
   std::thread thread_;
@@ -1,315 +1,294 @@
 #include "ADIFProvider.h"
+#include "../core/ADIFTokenizer.h"
 #include "../core/Astronomy.h"
 #include "../core/Logger.h"
 #include "../core/PrefixManager.h"
 #include "../core/StringUtils.h"
+#include "../core/WorkedIndex.h"
 #include <algorithm>
-#include <cctype>
-#include <fstream>
+#include <chrono>
+
+#if defined(__linux__) && !defined(__EMSCRIPTEN__)
+#define ADIF_USE_INOTIFY 1
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
 
 ADIFProvider::ADIFProvider(std::shared_ptr<ADIFStore> store,
                            PrefixManager &prefixMgr)
     : store_(std::move(store)), prefixMgr_(prefixMgr) {}
 
+ADIFProvider::~ADIFProvider() {
+  watching_ = false;
+  if (watchThread_.joinable())
+    watchThread_.join();
+}
+
 void ADIFProvider::fetch(const std::filesystem::path &path) {
   if (std::filesystem::exists(path)) {
     processFile(path);
   }
 }
 
-// Enhanced ADIF tag parser supporting all data types
-static std::string getTagContent(const std::string &line,
-                                 const std::string &tag) {
-  // Case-insensitive tag search
-  std::string upperLine = line;
-  std::string upperTag = tag;
-  std::transform(upperLine.begin(), upperLine.end(), upperLine.begin(),
-                 [](unsigned char c) { return std::toupper(c); });
-  std::transform(upperTag.begin(), upperTag.end(), upperTag.begin(),
-                 [](unsigned char c) { return std::toupper(c); });
+void ADIFProvider::watch(const std::filesystem::path &path) {
+#ifdef ADIF_USE_INOTIFY
+  if (watching_.exchange(true))
+    return;
+  watchThread_ = std::thread(&ADIFProvider::watchLoop, this, path);
+#else
+  (void)path;
+#endif
+}
 
-  size_t pos = upperLine.find("<" + upperTag + ":");
-  if (pos == std::string::npos) {
-    // Try without length specifier (ADIF 3.x allows <TAG>value)
-    pos = upperLine.find("<" + upperTag + ">");
-    if (pos != std::string::npos) {
-      size_t start = pos + upperTag.length() + 2;
-      size_t end = upperLine.find("<", start);
-      if (end != std::string::npos) {
-        return line.substr(start, end - start);
+void ADIFProvider::watchLoop(std::filesystem::path path) {
+#ifdef ADIF_USE_INOTIFY
+  // Watch the directory rather than the file so that a logger which
+  // replaces the file (write + rename) or creates it later is still seen.
+  int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  int wd = fd < 0 ? -1
+                  : inotify_add_watch(fd, path.parent_path().c_str(),
+                                      IN_MODIFY | IN_CLOSE_WRITE | IN_CREATE |
+                                          IN_MOVED_TO);
+  if (wd < 0) {
+    LOG_W("ADIFProvider", "Cannot watch {}, relying on periodic refresh",
+          path.string());
+    if (fd >= 0)
+      close(fd);
+    return;
+  }
+  LOG_I("ADIFProvider", "Following {}", path.string());
+
+  const std::string fileName = path.filename().string();
+  alignas(struct inotify_event) char buf[4096];
+  bool pending = false;
+  while (watching_) {
+    struct pollfd pfd = {fd, POLLIN, 0};
+    // Short timeout while a change is pending, to coalesce a burst of
+    // writes into one parse.
+    int ready = poll(&pfd, 1, pending ? 200 : 500);
+    if (ready > 0) {
+      ssize_t len;
+      while ((len = read(fd, buf, sizeof(buf))) > 0) {
+        for (char *p = buf; p < buf + len;) {
+          auto *ev = reinterpret_cast<struct inotify_event *>(p);
+          if (ev->len > 0 && fileName == ev->name)
+            pending = true;
+          p += sizeof(struct inotify_event) + ev->len;
+        }
       }
+    } else if (ready == 0 && pending) {
+      pending = false;
+      fetch(path);
     }
-    return "";
   }
+  close(fd);
+#else
+  (void)path;
+#endif
+}
 
-  size_t colon = line.find(":", pos);
-  size_t typeStart = colon + 1;
-
-  // Check for type specifier (e.g., <FREQ:9:N>)
-  size_t nextColon = line.find(":", typeStart);
-  size_t close = line.find(">", typeStart);
+uint64_t ADIFProvider::fingerprint(std::string_view data, size_t offset) {
+  constexpr size_t kSpan = 4096;
+  uint64_t h = 1469598103934665603ull;
+  auto mix = [&h](std::string_view bytes) {
+    for (unsigned char c : bytes) {
+      h ^= c;
+      h *= 1099511628211ull;
+    }
+  };
+  offset = std::min(offset, data.size());
+  mix(data.substr(0, std::min(offset, kSpan)));
+  if (offset > kSpan)
+    mix(data.substr(offset - std::min(offset - kSpan, kSpan),
+                    std::min(offset - kSpan, kSpan)));
+  return h;
+}
 
-  if (close == std::string::npos)
-    return "";
+static std::string bandFromFreq(const std::string &freq) {
+  double freqMhz = StringUtils::safe_stod(freq);
+  if (freqMhz >= 1.8 && freqMhz < 2.0)
+    return "160m";
+  if (freqMhz >= 3.5 && freqMhz < 4.0)
+    return "80m";
+  if (freqMhz >= 7.0 && freqMhz < 7.3)
+    return "40m";
+  if (freqMhz >= 10.1 && freqMhz < 10.15)
+    return "30m";
+  if (freqMhz >= 14.0 && freqMhz < 14.35)
+    return "20m";
+  if (freqMhz >= 18.068 && freqMhz < 18.168)
+    return "17m";
+  if (freqMhz >= 21.0 && freqMhz < 21.45)
+    return "15m";
+  if (freqMhz >= 24.89 && freqMhz < 24.99)
+    return "12m";
+  if (freqMhz >= 28.0 && freqMhz < 29.7)
+    return "10m";
+  if (freqMhz >= 50.0 && freqMhz < 54.0)
+    return "6m";
+  if (freqMhz >= 144.0 && freqMhz < 148.0)
+    return "2m";
+  if (freqMhz >= 420.0 && freqMhz < 450.0)
+    return "70cm";
+  return "";
+}
 
-  // Parse length
-  int len = 0;
-  try {
-    std::string lenStr;
-    if (nextColon != std::string::npos && nextColon < close) {
-      // Format: <TAG:LEN:TYPE>
-      lenStr = line.substr(typeStart, nextColon - typeStart);
-    } else {
-      // Format: <TAG:LEN>
-      lenStr = line.substr(typeStart, close - typeStart);
-    }
+static void pushLatestCall(ADIFStats &stats, const std::string &call) {
+  // Maintain latest calls list (most recent first)
+  auto it = std::find(stats.latestCalls.begin(), stats.latestCalls.end(), call);
+  if (it != stats.latestCalls.end()) {
+    stats.latestCalls.erase(it);
+  }
+  stats.latestCalls.insert(stats.latestCalls.begin(), call);
+  if (stats.latestCalls.size() > 10) {
+    stats.latestCalls.resize(10);
+  }
+}
 
-    // Trim whitespace
-    lenStr.erase(0, lenStr.find_first_not_of(" \t"));
-    lenStr.erase(lenStr.find_last_not_of(" \t") + 1);
+bool ADIFProvider::addRecord(const ADIFRecord &rec, ADIFStats &stats) {
+  if (rec[ADIFTag::Call].empty())
+    return false;
 
-    if (lenStr.empty())
-      return "";
+  std::string call(rec[ADIFTag::Call]);
+  std::string mode(rec[ADIFTag::Mode]);
+  std::string freq(rec[ADIFTag::Freq]);
+  stats.totalQSOs++;
 
-    len = StringUtils::safe_stoi(lenStr);
-  } catch (...) {
-    LOG_W("ADIFProvider", "Invalid length for tag {}", tag);
-    return "";
+  // Count by mode
+  if (!mode.empty()) {
+    stats.modeCounts[mode]++;
   }
 
-  size_t valueStart = close + 1;
-  if (valueStart + len > line.length()) {
-    LOG_W("ADIFProvider", "Tag {} length exceeds line boundary", tag);
-    return line.substr(valueStart); // Return what's available
+  // Infer band from frequency if BAND tag missing
+  std::string band(rec[ADIFTag::Band]);
+  if (band.empty() && !freq.empty()) {
+    band = bandFromFreq(freq);
   }
 
-  return line.substr(valueStart, len);
-}
-
-// Parse ADIF header
-static std::string parseHeader(std::ifstream &file) {
-  std::string header;
-  std::string line;
-  bool inHeader = false;
-
-  std::streampos startPos = file.tellg();
+  // Count by band
+  if (!band.empty()) {
+    stats.bandCounts[band]++;
+  }
 
-  while (std::getline(file, line)) {
-    std::string upperLine = line;
-    std::transform(upperLine.begin(), upperLine.end(), upperLine.begin(),
-                   [](unsigned char c) { return std::toupper(c); });
+  pushLatestCall(stats, call);
 
-    if (upperLine.find("<EOH>") != std::string::npos) {
-      inHeader = false;
-      break;
-    }
+  if (worked_) {
+    int dxcc = StringUtils::safe_stoi(std::string(rec[ADIFTag::Dxcc]));
+    if (dxcc <= 0)
+      dxcc = prefixMgr_.findDXCC(call);
+    worked_->add(call, dxcc, WorkedIndex::bandIndexOf(band),
+                 WorkedIndex::modeClassOf(mode));
+  }
 
-    if (upperLine.find("<ADIF_VER:") != std::string::npos || inHeader) {
-      inHeader = true;
-      header += line + "\n";
+  // Store full QSO record (keep most recent 100)
+  QSORecord qso;
+  qso.callsign = call;
+  qso.date = rec[ADIFTag::QsoDate];
+  qso.time = rec[ADIFTag::TimeOn];
+  qso.band = band;
+  qso.mode = mode;
+  qso.freq = freq;
+  qso.rstSent = rec[ADIFTag::RstSent];
+  qso.rstRcvd = rec[ADIFTag::RstRcvd];
+  qso.name = rec[ADIFTag::Name];
+  qso.qth = rec[ADIFTag::Qth];
+  qso.gridsquare = rec[ADIFTag::Gridsquare];
+  qso.comment = rec[ADIFTag::Comment];
+
+  // Resolve location
+  if (!rec[ADIFTag::Lat].empty() && !rec[ADIFTag::Lon].empty()) {
+    // Format is often "N040 12.345" or similar, but simplify for now
+    // assuming decimal or simple string
+    qso.lat = StringUtils::safe_stod(std::string(rec[ADIFTag::Lat]));
+    qso.lon = StringUtils::safe_stod(std::string(rec[ADIFTag::Lon]));
+  } else if (!qso.gridsquare.empty()) {
+    Astronomy::gridToLatLon(qso.gridsquare.c_str(), qso.lat, qso.lon);
+  } else {
+    LatLong ll;
+    if (prefixMgr_.findLocation(call, ll)) {
+      qso.lat = ll.lat;
+      qso.lon = ll.lon;
     }
   }
 
-  if (header.empty()) {
-    // No header found, reset to start
-    file.clear();
-    file.seekg(startPos);
+  // Insert at beginning (newest first)
+  stats.recentQSOs.insert(stats.recentQSOs.begin(), std::move(qso));
+  if (stats.recentQSOs.size() > 100) {
+    stats.recentQSOs.resize(100);
   }
+  return true;
+}
 
-  return header;
+void ADIFProvider::publish(std::string_view trailingCall) {
+  ADIFStats stats = stats_;
+  // A record still being written (no <EOR> yet) is shown but not merged;
+  // it is parsed for real once complete.
+  if (!trailingCall.empty()) {
+    stats.totalQSOs++;
+    pushLatestCall(stats, std::string(trailingCall));
+  }
+  stats.valid = true;
+  store_->update(stats);
 }
 
 void ADIFProvider::processFile(const std::filesystem::path &path) {
-  std::ifstream file(path);
-  if (!file.is_open()) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  MappedFile file(path);
+  if (!file.isOpen()) {
     LOG_E("ADIFProvider", "Failed to open ADIF file: {}", path.string());
     return;
   }
+  std::string_view data = file.data();
 
-  LOG_I("ADIFProvider", "Processing ADIF file: {}", path.string());
-
-  ADIFStats stats;
-  std::string line;
-  std::string record;
-  int lineNum = 0;
-  int recordNum = 0;
-
-  // Parse header
-  std::string header = parseHeader(file);
-  if (!header.empty()) {
-    std::string version = getTagContent(header, "ADIF_VER");
-    if (!version.empty()) {
-      LOG_I("ADIFProvider", "ADIF version: {}", version);
-    }
+  // Resume from the last record if this is the same file, grown (or
+  // unchanged) and with the already-parsed bytes intact.
+  bool resume = path == path_ && offset_ > 0 && data.size() >= offset_ &&
+                fingerprint(data, offset_) == fingerprint_;
+  if (resume && data.size() == offset_)
+    return;
+  if (!resume) {
+    LOG_I("ADIFProvider", "Processing ADIF file: {}", path.string());
+    path_ = path;
+    stats_ = ADIFStats{};
+    offset_ = 0;
+    if (worked_)
+      worked_->clear();
   }
 
-  // Process records
-  while (std::getline(file, line)) {
-    lineNum++;
-
-    // Handle multi-line records
-    size_t eor = line.find("<EOR>");
-    if (eor == std::string::npos) {
-      eor = line.find("<eor>");
-    }
-
-    if (eor != std::string::npos) {
-      record += line.substr(0, eor);
-      recordNum++;
-
-      // Extract common fields
-      std::string call = getTagContent(record, "CALL");
-      std::string mode = getTagContent(record, "MODE");
-      std::string band = getTagContent(record, "BAND");
-      std::string freq = getTagContent(record, "FREQ");
-      std::string qsoDate = getTagContent(record, "QSO_DATE");
-      std::string timeOn = getTagContent(record, "TIME_ON");
-      std::string rstSent = getTagContent(record, "RST_SENT");
-      std::string rstRcvd = getTagContent(record, "RST_RCVD");
-      std::string name = getTagContent(record, "NAME");
-      std::string qth = getTagContent(record, "QTH");
-      std::string gridsquare = getTagContent(record, "GRIDSQUARE");
-      std::string country = getTagContent(record, "COUNTRY");
-      std::string cqZone = getTagContent(record, "CQZ");
-      std::string ituZone = getTagContent(record, "ITUZ");
-      std::string dxcc = getTagContent(record, "DXCC");
-      std::string contest = getTagContent(record, "CONTEST_ID");
-      std::string satName = getTagContent(record, "SAT_NAME");
-      std::string satMode = getTagContent(record, "SAT_MODE");
-      std::string propMode = getTagContent(record, "PROP_MODE");
-      std::string txPwr = getTagContent(record, "TX_PWR");
-      std::string operator_ = getTagContent(record, "OPERATOR");
-      std::string stationCall = getTagContent(record, "STATION_CALLSIGN");
-      std::string myGrid = getTagContent(record, "MY_GRIDSQUARE");
-      std::string comment = getTagContent(record, "COMMENT");
-      std::string notes = getTagContent(record, "NOTES");
-      std::string latStr = getTagContent(record, "LAT");
-      std::string lonStr = getTagContent(record, "LON");
-
-      if (!call.empty()) {
-        stats.totalQSOs++;
-
-        // Count by mode
-        if (!mode.empty()) {
-          stats.modeCounts[mode]++;
-        }
-
-        // Infer band from frequency if BAND tag missing
-        std::string useBand = band;
-        if (useBand.empty() && !freq.empty()) {
-          double freqMhz = StringUtils::safe_stod(freq);
-          if (freqMhz >= 1.8 && freqMhz < 2.0)
-            useBand = "160m";
-          else if (freqMhz >= 3.5 && freqMhz < 4.0)
-            useBand = "80m";
-          else if (freqMhz >= 7.0 && freqMhz < 7.3)
-            useBand = "40m";
-          else if (freqMhz >= 10.1 && freqMhz < 10.15)
-            useBand = "30m";
-          else if (freqMhz >= 14.0 && freqMhz < 14.35)
-            useBand = "20m";
-          else if (freqMhz >= 18.068 && freqMhz < 18.168)
-            useBand = "17m";
-          else if (freqMhz >= 21.0 && freqMhz < 21.45)
-            useBand = "15m";
-          else if (freqMhz >= 24.89 && freqMhz < 24.99)
-            useBand = "12m";
-          else if (freqMhz >= 28.0 && freqMhz < 29.7)
-            useBand = "10m";
-          else if (freqMhz >= 50.0 && freqMhz < 54.0)
-            useBand = "6m";
-          else if (freqMhz >= 144.0 && freqMhz < 148.0)
-            useBand = "2m";
-          else if (freqMhz >= 420.0 && freqMhz < 450.0)
-            useBand = "70cm";
-        }
-
-        // Count by band
-        if (!useBand.empty()) {
-          stats.bandCounts[useBand]++;
-        }
-
-        // Maintain latest calls list (most recent first)
-        auto it =
-            std::find(stats.latestCalls.begin(), stats.latestCalls.end(), call);
-        if (it != stats.latestCalls.end()) {
-          stats.latestCalls.erase(it);
-        }
-        stats.latestCalls.insert(stats.latestCalls.begin(), call);
-        if (stats.latestCalls.size() > 10) {
-          stats.latestCalls.resize(10);
-        }
-
-        // Store full QSO record (keep most recent 100)
-        QSORecord qso;
-        qso.callsign = call;
-        qso.date = qsoDate;
-        qso.time = timeOn;
-        qso.band = useBand;
-        qso.mode = mode;
-        qso.freq = freq;
-        qso.rstSent = rstSent;
-        qso.rstRcvd = rstRcvd;
-        qso.name = name;
-        qso.qth = qth;
-        qso.gridsquare = gridsquare;
-        qso.comment = comment;
-
-        // Resolve location
-        if (!latStr.empty() && !lonStr.empty()) {
-          // Format is often "N040 12.345" or similar, but simplify for now
-          // assuming decimal or simple string
-          qso.lat = StringUtils::safe_stod(latStr);
-          qso.lon = StringUtils::safe_stod(lonStr);
-        } else if (!gridsquare.empty()) {
-          Astronomy::gridToLatLon(gridsquare.c_str(), qso.lat, qso.lon);
-        } else {
-          LatLong ll;
-          if (prefixMgr_.findLocation(call, ll)) {
-            qso.lat = ll.lat;
-            qso.lon = ll.lon;
-          }
-        }
-
-        // Insert at beginning (newest first)
-        stats.recentQSOs.insert(stats.recentQSOs.begin(), qso);
-        if (stats.recentQSOs.size() > 100) {
-          stats.recentQSOs.resize(100);
-        }
-      } else {
-        LOG_W("ADIFProvider", "Record {} has no CALL field", recordNum);
-      }
-
-      // Clear record for next one
-      record = line.substr(eor + 5);
-    } else {
-      // Accumulate multi-line record
-      record += line + " ";
-
-      // Safety check: if record gets too large, something is wrong
-      if (record.length() > 100000) {
-        LOG_E("ADIFProvider", "Record too large (>100KB) at line {}, skipping",
-              lineNum);
-        record.clear();
+  auto started = std::chrono::steady_clock::now();
+  int before = stats_.totalQSOs;
+  ADIFTokenizer tokenizer(data, offset_);
+  ADIFRecord rec;
+  int recordNum = 0;
+  bool headerLogged = resume;
+
+  while (tokenizer.next(rec)) {
+    recordNum++;
+    if (!headerLogged) {
+      headerLogged = true;
+      std::string_view version = tokenizer.header()[ADIFTag::AdifVer];
+      if (!version.empty()) {
+        LOG_I("ADIFProvider", "ADIF version: {}", version);
       }
     }
-  }
-
-  // Handle case where file doesn't end with <EOR>
-  if (!record.empty() && record.find("<") != std::string::npos) {
-    std::string call = getTagContent(record, "CALL");
-    if (!call.empty()) {
-      stats.totalQSOs++;
-      stats.latestCalls.insert(stats.latestCalls.begin(), call);
-      if (stats.latestCalls.size() > 10) {
-        stats.latestCalls.resize(10);
-      }
+    if (!addRecord(rec, stats_)) {
+      LOG_W("ADIFProvider", "Record {} has no CALL field", recordNum);
     }
   }
 
-  stats.valid = true;
-  store_->update(stats);
-
-  LOG_I("ADIFProvider", "Processed {} QSOs from {} records in {} lines",
-        stats.totalQSOs, recordNum, lineNum);
+  offset_ = tokenizer.consumed();
+  fingerprint_ = fingerprint(data, offset_);
+  publish(tokenizer.trailing()[ADIFTag::Call]);
+
+  auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - started)
+                .count();
+  if (resume) {
+    LOG_D("ADIFProvider", "Appended {} QSOs ({} total) in {} ms",
+          stats_.totalQSOs - before, stats_.totalQSOs, ms);
+  } else {
+    LOG_I("ADIFProvider", "Processed {} QSOs from {} records ({} bytes) in "
+          "{} ms", stats_.totalQSOs, recordNum, data.size(), ms);
+  }
 }
@@ -1,20 +1,60 @@
 #pragma once
 
 #include "../core/ADIFData.h"
+#include <atomic>
+#include <cstdint>
 #include <filesystem>
 #include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
 
 class PrefixManager;
+class WorkedIndex;
+struct ADIFRecord;
 
 class ADIFProvider {
 public:
   ADIFProvider(std::shared_ptr<ADIFStore> store, PrefixManager &prefixMgr);
+  ~ADIFProvider();
 
+  // Bring the store up to date with the log. Only records appended since
+  // the last call are parsed; a rewritten or truncated file is re-read in
+  // full. Cheap when nothing changed.
   void fetch(const std::filesystem::path &path);
 
+  // Follow the log for appends (inotify on Linux; elsewhere the periodic
+  // fetch() is all there is).
+  void watch(const std::filesystem::path &path);
+
+  // Keep a worked-before index in step with the log. Set before fetch().
+  void setWorkedIndex(std::shared_ptr<WorkedIndex> index) {
+    worked_ = std::move(index);
+  }
+
 private:
   void processFile(const std::filesystem::path &path);
+  // Fold one record into the stats. False if it has no CALL.
+  bool addRecord(const ADIFRecord &rec, ADIFStats &stats);
+  void publish(std::string_view trailingCall);
+  void watchLoop(std::filesystem::path path);
+
+  // Hash of the bytes that identify what has already been parsed: the
+  // start of the file and the bytes just before the resume offset.
+  static uint64_t fingerprint(std::string_view data, size_t offset);
 
   std::shared_ptr<ADIFStore> store_;
   PrefixManager &prefixMgr_;
+  std::shared_ptr<WorkedIndex> worked_;
+
+  // Tail-follow state. Guarded by mutex_ (fetch() runs on the main thread
+  // and the watcher).
+  std::mutex mutex_;
+  std::filesystem::path path_;
+  ADIFStats stats_;         // running stats for records before offset_
+  size_t offset_ = 0;       // byte offset just past the last parsed <EOR>
+  uint64_t fingerprint_ = 0;
+
+  std::atomic<bool> watching_{false};
+  std::thread watchThread_;
 };
@@ -122,12 +122,35 @@ void ActivityProvider::fetchDXPeds() {
   });
 }
 
+namespace {
+
+void reportWatched(const ActivityData &data, const WatchlistStore *watchlist,
+                   WatchlistHitStore *hits) {
+  if (!watchlist || !hits)
+    return;
+  for (const auto &os : data.ontaSpots) {
+    if (watchlist->match(os.call, os.freqKhz, os.mode) < 0)
+      continue;
+    WatchlistHit hit;
+    hit.call = os.call;
+    hit.freqKhz = static_cast<float>(os.freqKhz);
+    hit.mode = os.mode;
+    hit.source = os.program;
+    hit.time = os.spottedAt;
+    hits->addHit(hit);
+  }
+}
+
+} // namespace
+
 void ActivityProvider::fetchPOTA() {
-  net_.fetchAsync(POTA_API_URL, [](std::string data) {
+  auto watchlist = watchlist_;
+  auto hits = hits_;
+  net_.fetchAsync(POTA_API_URL, [watchlist, hits](std::string data) {
     if (data.empty())
       return;
 
-    WorkerService::getInstance().submitTask([data]() {
+    WorkerService::getInstance().submitTask([data, watchlist, hits]() {
       try {
         auto j = nlohmann::json::parse(data);
         if (!j.is_array())
@@ -183,6 +206,8 @@ void ActivityProvider::fetchPOTA() {
           }
         }
 
+        reportWatched(*update, watchlist.get(), hits.get());
+
         SDL_Event event;
         SDL_zero(event);
         event.type = HamClock::AE_BASE_EVENT + HamClock::AE_ACTIVITY_DATA_READY;
@@ -202,11 +227,13 @@ void ActivityProvider::fetchPOTA() {
 }
 
 void ActivityProvider::fetchSOTA() {
-  net_.fetchAsync(SOTA_API_URL, [](std::string data) {
+  auto watchlist = watchlist_;
+  auto hits = hits_;
+  net_.fetchAsync(SOTA_API_URL, [watchlist, hits](std::string data) {
     if (data.empty())
       return;
 
-    WorkerService::getInstance().submitTask([data]() {
+    WorkerService::getInstance().submitTask([data, watchlist, hits]() {
       try {
         auto j = nlohmann::json::parse(data);
         if (!j.is_array())
@@ -240,6 +267,8 @@ void ActivityProvider::fetchSOTA() {
           }
         }
 
+        reportWatched(*update, watchlist.get(), hits.get());
+
         SDL_Event event;
         SDL_zero(event);
         event.type = HamClock::AE_BASE_EVENT + HamClock::AE_ACTIVITY_DATA_READY;
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "../core/ActivityData.h"
+#include "../core/WatchlistHitStore.h"
+#include "../core/WatchlistStore.h"
 #include "../network/NetworkManager.h"
 #include <memory>
 
@@ -13,6 +15,13 @@ public:
 
   void fetch();
 
+  // Report watched activators among the POTA / SOTA spots.
+  void setWatchlist(std::shared_ptr<WatchlistStore> watchlist,
+                    std::shared_ptr<WatchlistHitStore> hits) {
+    watchlist_ = std::move(watchlist);
+    hits_ = std::move(hits);
+  }
+
 private:
   void fetchDXPeds();
   void fetchPOTA();
@@ -20,6 +29,8 @@ private:
 
   NetworkManager &net_;
   std::shared_ptr<ActivityDataStore> store_;
+  std::shared_ptr<WatchlistStore> watchlist_;
+  std::shared_ptr<WatchlistHitStore> hits_;
 
   static constexpr const char *DX_PEDS_URL =
       "https://www.ng3k.com/Misc/adxo.html";
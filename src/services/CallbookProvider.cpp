@@ -1,88 +1,313 @@
 #include "CallbookProvider.h"
+#include "../core/CallbookCache.h"
+#include "../core/Logger.h"
 #include "../core/StringUtils.h"
+#include <algorithm>
+#include <cctype>
 #include <nlohmann/json.hpp>
+#include <vector>
 
 using json = nlohmann::json;
 
+namespace {
+
+std::string upperTrim(const std::string &s) {
+  std::string out;
+  out.reserve(s.size());
+  for (char c : s) {
+    if (!std::isspace(static_cast<unsigned char>(c)))
+      out += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+  }
+  return out;
+}
+
+std::string joinName(const std::string &first, const std::string &last) {
+  if (first.empty())
+    return last;
+  if (last.empty())
+    return first;
+  return first + " " + last;
+}
+
+// Fill the fields of into that are still empty from from.
+void mergeInto(CallbookData &into, const CallbookData &from) {
+  auto fill = [](std::string &a, const std::string &b) {
+    if (a.empty())
+      a = b;
+  };
+  fill(into.name, from.name);
+  fill(into.address, from.address);
+  fill(into.city, from.city);
+  fill(into.state, from.state);
+  fill(into.zip, from.zip);
+  fill(into.country, from.country);
+  fill(into.grid, from.grid);
+  fill(into.bureau, from.bureau);
+  fill(into.bioUrl, from.bioUrl);
+  fill(into.imageUrl, from.imageUrl);
+  if (into.lat == 0.0f && into.lon == 0.0f) {
+    into.lat = from.lat;
+    into.lon = from.lon;
+  }
+  into.lotw = into.lotw || from.lotw;
+  into.eqsl = into.eqsl || from.eqsl;
+}
+
+} // namespace
+
 CallbookProvider::CallbookProvider(NetworkManager &net,
                                    std::shared_ptr<CallbookStore> store)
-    : net_(net), store_(store) {}
+    : net_(net), store_(store) {
+  CallbookCache::prune(CACHE_MAX_AGE);
+}
+
+void CallbookProvider::setQRZCredentials(const std::string &username,
+                                         const std::string &password) {
+  if (username.empty() || password.empty()) {
+    qrz_.reset();
+    return;
+  }
+  if (!qrz_)
+    qrz_ = std::make_unique<QRZProvider>(net_);
+  qrz_->setCredentials(username, password);
+}
+
+const char *CallbookProvider::sourceName(Source source) {
+  switch (source) {
+  case kQRZ:
+    return "QRZ.com";
+  case kCallook:
+    return "Callook.info";
+  case kHamDB:
+    return "HamDB.org";
+  default:
+    return "";
+  }
+}
+
+std::chrono::seconds CallbookProvider::sourceTtl(Source source) {
+  switch (source) {
+  case kQRZ:
+    return std::chrono::hours(24); // subscription data, refreshed often
+  case kCallook:
+    return std::chrono::hours(24 * 7); // FCC ULS, weekly dumps
+  default:
+    return std::chrono::hours(24 * 7);
+  }
+}
 
 void CallbookProvider::lookup(const std::string &callsign) {
-  if (callsign.empty())
+  std::string call = upperTrim(callsign);
+  if (call.empty())
     return;
 
-  auto result = std::make_shared<CallbookData>();
-  result->callsign = callsign;
-  result->source = "Aggregating...";
-
-  // Chain the lookups
-  fetchCallook(callsign, *result, [this, result, callsign]() {
-    // If Callook failed or was incomplete, try HamDB
-    fetchHamDB(callsign, *result, [this, result]() {
-      result->valid = true;
-      store_->set(*result);
-    });
-  });
+  std::vector<Source> toFetch;
+  std::shared_ptr<Lookup> lk;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    current_ = call;
+
+    // Already being fetched: show what has arrived and let it finish
+    auto it = inFlight_.find(call);
+    if (it != inFlight_.end()) {
+      publish(*it->second, false);
+      return;
+    }
+
+    lk = std::make_shared<Lookup>();
+    lk->call = call;
+    for (int i = 0; i < kSources; ++i) {
+      auto s = static_cast<Source>(i);
+      if (s == kQRZ && !qrz_)
+        continue;
+      CallbookData cached;
+      switch (CallbookCache::get(call, sourceName(s), sourceTtl(s),
+                                 NEGATIVE_TTL, cached)) {
+      case CallbookCache::Hit::Found:
+        lk->results[s] = std::move(cached);
+        break;
+      case CallbookCache::Hit::NotFound:
+        break;
+      case CallbookCache::Hit::Miss:
+        toFetch.push_back(s);
+        break;
+      }
+    }
+
+    lk->remaining = static_cast<int>(toFetch.size());
+    publish(*lk, toFetch.empty());
+    if (toFetch.empty()) {
+      LOG_D("Callbook", "{} served from cache", call);
+      return;
+    }
+    inFlight_[call] = lk;
+  }
+
+  // Query every stale source at once; each answer is merged on arrival
+  for (Source s : toFetch) {
+    auto onDone = [this, lk, s](Answer answer, const CallbookData &data) {
+      complete(lk, s, answer, data);
+    };
+    switch (s) {
+    case kQRZ:
+      fetchQRZ(call, onDone);
+      break;
+    case kCallook:
+      fetchCallook(call, onDone);
+      break;
+    case kHamDB:
+      fetchHamDB(call, onDone);
+      break;
+    default:
+      break;
+    }
+  }
+}
+
+void CallbookProvider::complete(const std::shared_ptr<Lookup> &lk,
+                                Source source, Answer answer,
+                                const CallbookData &data) {
+  if (answer == Answer::Found)
+    CallbookCache::put(lk->call, sourceName(source), &data);
+  else if (answer == Answer::NotFound)
+    CallbookCache::put(lk->call, sourceName(source), nullptr);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (answer == Answer::Found)
+    lk->results[source] = data;
+  bool final = --lk->remaining == 0;
+  if (final)
+    inFlight_.erase(lk->call);
+  publish(*lk, final);
+}
+
+void CallbookProvider::publish(const Lookup &lk, bool final) {
+  if (lk.call != current_)
+    return; // the user has moved on to another call
+
+  CallbookData merged;
+  merged.callsign = lk.call;
+  for (int i = 0; i < kSources; ++i) {
+    if (!lk.results[i])
+      continue;
+    mergeInto(merged, *lk.results[i]);
+    if (!merged.source.empty())
+      merged.source += " + ";
+    merged.source += sourceName(static_cast<Source>(i));
+  }
+
+  if (merged.source.empty()) {
+    if (!final)
+      return; // nothing to show yet
+    merged.source = "Not found";
+  }
+  merged.valid = true;
+  store_->set(merged);
 }
 
 void CallbookProvider::fetchCallook(const std::string &callsign,
-                                    CallbookData &result,
-                                    std::function<void()> onDone) {
-  std::string url = "https://callook.info/" + callsign + "/json";
-
-  net_.fetchAsync(url, [onDone, &result](std::string body) {
-    try {
-      if (!body.empty()) {
-        auto j = json::parse(body);
-        if (j["status"] == "VALID") {
-          result.name = j["name"].get<std::string>();
-          result.address = j["address"]["line1"].get<std::string>();
-          result.city = j["address"]["line2"].get<std::string>();
-          result.grid = j["location"]["gridsquare"].get<std::string>();
-          result.lat = StringUtils::safe_stof(
-              j["location"]["latitude"].get<std::string>());
-          result.lon = StringUtils::safe_stof(
-              j["location"]["longitude"].get<std::string>());
-          result.source = "Callook.info";
+                                    AnswerCb onDone) {
+  std::string url = callookBase_ + callsign + "/json";
+
+  // Results are cached in CallbookCache, not by URL
+  net_.fetchAsync(
+      url,
+      [onDone](std::string body) {
+        CallbookData result;
+        Answer answer = Answer::Failed;
+        try {
+          if (!body.empty()) {
+            auto j = json::parse(body);
+            std::string status = j.value("status", "");
+            if (status == "VALID") {
+              result.name = j.value("name", "");
+              if (j.contains("address")) {
+                result.address = j["address"].value("line1", "");
+                result.city = j["address"].value("line2", "");
+              }
+              if (j.contains("location")) {
+                const auto &loc = j["location"];
+                result.grid = loc.value("gridsquare", "");
+                result.lat = StringUtils::safe_stof(loc.value("latitude", ""));
+                result.lon =
+                    StringUtils::safe_stof(loc.value("longitude", ""));
+              }
+              result.country = "USA";
+              answer = Answer::Found;
+            } else if (status == "INVALID") {
+              answer = Answer::NotFound;
+            }
+          }
+        } catch (...) {
         }
-      }
-    } catch (...) {
-    }
-    onDone();
-  });
+        onDone(answer, result);
+      },
+      0);
 }
 
 void CallbookProvider::fetchHamDB(const std::string &callsign,
-                                  CallbookData &result,
-                                  std::function<void()> onDone) {
+                                  AnswerCb onDone) {
   // HamDB is good for international calls and extra meta
-  std::string url = "http://api.hamdb.org/" + callsign + "/json/hamclock-next";
-
-  net_.fetchAsync(url, [onDone, &result](std::string body) {
-    try {
-      if (!body.empty()) {
-        auto j = json::parse(body);
-        if (j.contains("hamdb") && j["hamdb"]["messages"]["status"] == "OK") {
-          auto call = j["hamdb"]["callsign"];
-
-          // Only overwrite if Callook didn't find it or if we want more data
-          if (result.name.empty())
-            result.name = call["name"].get<std::string>();
-
-          // Fetch social/QSL hints if present (some APIs provide this)
-          if (call.contains("lotw"))
-            result.lotw = (call["lotw"].get<std::string>() == "Y");
-
-          if (result.source.empty()) {
-            result.source = "HamDB.org";
-          } else if (result.source != "HamDB.org") {
-            result.source += " + HamDB";
+  std::string url = hamdbBase_ + callsign + "/json/hamclock-next";
+
+  net_.fetchAsync(
+      url,
+      [onDone](std::string body) {
+        CallbookData result;
+        Answer answer = Answer::Failed;
+        try {
+          if (!body.empty()) {
+            auto j = json::parse(body);
+            std::string status;
+            if (j.contains("hamdb") && j["hamdb"].contains("messages"))
+              status = j["hamdb"]["messages"].value("status", "");
+            if (status == "OK") {
+              const auto &call = j["hamdb"]["callsign"];
+              result.name =
+                  joinName(call.value("fname", ""), call.value("name", ""));
+              result.address = call.value("addr1", "");
+              result.city = call.value("addr2", "");
+              result.state = call.value("state", "");
+              result.zip = call.value("zip", "");
+              result.country = call.value("country", "");
+              result.grid = call.value("grid", "");
+              result.lat = StringUtils::safe_stof(call.value("lat", ""));
+              result.lon = StringUtils::safe_stof(call.value("lon", ""));
+
+              // Fetch social/QSL hints if present (some APIs provide this)
+              if (call.contains("lotw"))
+                result.lotw = (call["lotw"].get<std::string>() == "Y");
+              answer = Answer::Found;
+            } else if (status == "NOT_FOUND") {
+              answer = Answer::NotFound;
+            }
           }
+        } catch (...) {
         }
-      }
-    } catch (...) {
+        onDone(answer, result);
+      },
+      0);
+}
+
+void CallbookProvider::fetchQRZ(const std::string &callsign, AnswerCb onDone) {
+  qrz_->lookup(callsign, [onDone](const QRZLookupResult &r) {
+    CallbookData result;
+    if (!r.found) {
+      bool notFound = r.errorMessage.find("not found") != std::string::npos ||
+                      r.errorMessage.find("Not found") != std::string::npos;
+      onDone(notFound ? Answer::NotFound : Answer::Failed, result);
+      return;
     }
-    onDone();
+    result.name = r.name;
+    result.address = r.addr1;
+    result.city = r.addr2;
+    result.state = r.state;
+    result.zip = r.zip;
+    result.country = r.country;
+    result.grid = r.grid;
+    result.lat = static_cast<float>(r.lat);
+    result.lon = static_cast<float>(r.lon);
+    result.bureau = r.qslMgr;
+    onDone(Answer::Found, result);
   });
 }
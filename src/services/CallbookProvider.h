@@ -2,26 +2,78 @@
 
 #include "../core/CallbookData.h"
 #include "../network/NetworkManager.h"
+#include "QRZProvider.h"
+#include <chrono>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <unordered_map>
 
+// Callbook lookups. All configured sources are queried at once and their
+// answers merged into the store as they arrive; every answer (including
+// "not found") is kept in the persistent CallbookCache, and a lookup of a
+// call that is already in flight joins it instead of fetching again.
 class CallbookProvider {
 public:
   using DataCb = std::function<void(const CallbookData &data)>;
 
   CallbookProvider(NetworkManager &net, std::shared_ptr<CallbookStore> store);
 
+  // Add QRZ.com (XML subscription) as a source.
+  void setQRZCredentials(const std::string &username,
+                         const std::string &password);
+
+  // Base URLs of Callook and HamDB (the call and format are appended);
+  // for mirrors and the tests' stub server.
+  void setEndpoints(const std::string &callookBase,
+                    const std::string &hamdbBase) {
+    callookBase_ = callookBase;
+    hamdbBase_ = hamdbBase;
+  }
+
   // Main entry point for a lookup
   void lookup(const std::string &callsign);
 
 private:
+  // Merge priority: earlier sources win for fields both provide.
+  enum Source { kQRZ = 0, kCallook, kHamDB, kSources };
+
+  struct Lookup {
+    std::string call;
+    std::optional<CallbookData> results[kSources];
+    int remaining = 0;
+  };
+
+  // How a source answered: Failed answers (network or parse errors) are
+  // not cached.
+  enum class Answer { Found, NotFound, Failed };
+  using AnswerCb = std::function<void(Answer, const CallbookData &)>;
+
+  void fetchCallook(const std::string &callsign, AnswerCb onDone);
+  void fetchHamDB(const std::string &callsign, AnswerCb onDone);
+  void fetchQRZ(const std::string &callsign, AnswerCb onDone);
+
+  void complete(const std::shared_ptr<Lookup> &lookup, Source source,
+                Answer answer, const CallbookData &data);
+  // Merge what has arrived and show it if the call is still the current
+  // one. Caller holds mutex_.
+  void publish(const Lookup &lookup, bool final);
+
+  static const char *sourceName(Source source);
+  static std::chrono::seconds sourceTtl(Source source);
+
   NetworkManager &net_;
   std::shared_ptr<CallbookStore> store_;
+  std::unique_ptr<QRZProvider> qrz_;
+  std::string callookBase_ = "https://callook.info/";
+  std::string hamdbBase_ = "http://api.hamdb.org/";
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::shared_ptr<Lookup>> inFlight_;
+  std::string current_; // call the store should show
 
-  // Aggregation steps
-  void fetchCallook(const std::string &callsign, CallbookData &result,
-                    std::function<void()> onDone);
-  void fetchHamDB(const std::string &callsign, CallbookData &result,
-                  std::function<void()> onDone);
+  static constexpr std::chrono::hours NEGATIVE_TTL{24};
+  static constexpr std::chrono::hours CACHE_MAX_AGE{24 * 90};
 };
@@ -1,59 +1,161 @@
 #include "DRAPProvider.h"
+#include "../core/Constants.h"
 #include "../core/Logger.h"
-#include <sstream>
+#include "../core/SolarData.h"
+#include "../core/WorkerService.h"
+#include "NOAAProvider.h"
+#include <SDL_events.h>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
 
-DRAPProvider::DRAPProvider(NetworkManager &net) : net_(net) {}
+namespace {
 
-void DRAPProvider::fetch(DataCb cb) {
+// Scans the plain decimals used by the DRAP product ("-178", "12.3") with
+// integer from_chars, which unlike the floating-point overload is
+// available on every toolchain we build with.
+class NumberScanner {
+public:
+  explicit NumberScanner(std::string_view s)
+      : p_(s.data()), end_(s.data() + s.size()) {}
+
+  bool next(float &out) {
+    while (p_ < end_ && (*p_ == ' ' || *p_ == '\t' || *p_ == '\r'))
+      ++p_;
+    if (p_ == end_)
+      return false;
+
+    bool neg = *p_ == '-';
+    if (neg || *p_ == '+')
+      ++p_;
+    long whole = 0;
+    auto [wp, wec] = std::from_chars(p_, end_, whole);
+    if (wec != std::errc())
+      return false;
+    p_ = wp;
+
+    double v = static_cast<double>(whole);
+    if (p_ < end_ && *p_ == '.') {
+      const char *fs = ++p_;
+      long frac = 0;
+      auto [fp, fec] = std::from_chars(fs, end_, frac);
+      if (fec == std::errc()) {
+        v += frac / std::pow(10.0, static_cast<double>(fp - fs));
+        p_ = fp;
+      }
+    }
+    out = static_cast<float>(neg ? -v : v);
+    return true;
+  }
+
+private:
+  const char *p_;
+  const char *end_;
+};
+
+} // namespace
+
+DRAPProvider::DRAPProvider(NetworkManager &net,
+                           std::shared_ptr<DrapStore> store)
+    : net_(net), store_(std::move(store)) {}
+
+void DRAPProvider::fetch() {
   const char *url =
       "https://services.swpc.noaa.gov/text/drap_global_frequencies.txt";
 
-  net_.fetchAsync(url, [cb](std::string body) {
+  auto store = store_;
+  net_.fetchAsync(url, [store](std::string body) {
     if (body.empty()) {
       LOG_W("DRAPProvider", "Empty response from DRAP data source");
       return;
     }
 
-    try {
-      float max_freq = 0.0f;
-      bool found_any = false;
-
-      std::stringstream ss(body);
-      std::string line;
-
-      while (std::getline(ss, line)) {
-        // Skip comments and empty lines
-        if (line.empty() || line[0] == '#' || line[0] == '\r' ||
-            line[0] == '\n')
-          continue;
-
-        // Look for pipe delimiter
-        size_t pipe_pos = line.find('|');
-        if (pipe_pos != std::string::npos) {
-          // All numbers after pipe are frequencies
-          std::string freqs = line.substr(pipe_pos + 1);
-          std::stringstream ss_vals(freqs);
-          float val;
-
-          while (ss_vals >> val) {
-            if (val > max_freq)
-              max_freq = val;
-            found_any = true;
-          }
-        }
+    WorkerService::getInstance().submitTask([body = std::move(body), store]() {
+      auto grid = parse(body);
+      if (!grid) {
+        LOG_W("DRAPProvider", "No DRAP data found in response");
+        return;
       }
+      LOG_D("DRAPProvider", "DRAP {}x{} grid, max frequency: {:.1f} MHz",
+            grid->w, grid->h, grid->maxMhz);
 
-      if (found_any) {
-        // Format as a simple string with the max frequency
-        char buf[64];
-        std::snprintf(buf, sizeof(buf), "%.1f", max_freq);
-        cb(std::string(buf));
-        LOG_D("DRAPProvider", "DRAP max frequency: {:.1f} MHz", max_freq);
-      } else {
-        LOG_W("DRAPProvider", "No DRAP data found in response");
+      // The space weather summary shows the maximum, rounded
+      auto *update = new SolarData();
+      update->drap = static_cast<int>(std::round(grid->maxMhz));
+      update->valid = true;
+
+      if (store)
+        store->setGrid(std::move(grid));
+
+      SDL_Event event;
+      SDL_zero(event);
+      event.type = HamClock::AE_BASE_EVENT + HamClock::AE_SOLAR_DATA_READY;
+      event.user.code = static_cast<int>(NOAAProvider::UpdateType::DRAP);
+      event.user.data1 = update;
+      SDL_PushEvent(&event);
+    });
+  });
+}
+
+std::shared_ptr<DrapGrid> DRAPProvider::parse(std::string_view body) {
+  // Layout: '#' comments, a row of longitudes, a dashed rule, then one
+  // "lat | values..." row per latitude from north to south.
+  std::vector<float> lons;
+  std::vector<float> lats;
+  std::vector<float> values;
+  float maxMhz = 0.0f;
+
+  size_t pos = 0;
+  while (pos < body.size()) {
+    size_t nl = body.find('\n', pos);
+    if (nl == std::string_view::npos)
+      nl = body.size();
+    std::string_view line = body.substr(pos, nl - pos);
+    pos = nl + 1;
+
+    if (line.empty() || line[0] == '#' || line[0] == '\r')
+      continue;
+
+    size_t pipe = line.find('|');
+    if (pipe == std::string_view::npos) {
+      // Longitude header; the dashed rule scans as nothing
+      if (lons.empty()) {
+        NumberScanner scan(line);
+        for (float v; scan.next(v);)
+          lons.push_back(v);
       }
-    } catch (const std::exception &e) {
-      LOG_E("DRAPProvider", "Error parsing DRAP data: {}", e.what());
+      continue;
     }
-  });
+
+    float lat;
+    if (lons.empty() || !NumberScanner(line.substr(0, pipe)).next(lat))
+      continue;
+    NumberScanner scan(line.substr(pipe + 1));
+    size_t n = 0;
+    for (float v; n < lons.size() && scan.next(v); ++n)
+      values.push_back(v);
+    if (n != lons.size()) {
+      values.resize(values.size() - n); // ragged row
+      continue;
+    }
+    maxMhz = std::max(maxMhz,
+                      *std::max_element(values.end() - n, values.end()));
+    lats.push_back(lat);
+  }
+
+  if (lons.size() < 2 || lats.size() < 2 || lons.back() == lons.front() ||
+      lats.back() == lats.front())
+    return nullptr;
+
+  auto grid = std::make_shared<DrapGrid>();
+  grid->w = static_cast<int>(lons.size());
+  grid->h = static_cast<int>(lats.size());
+  grid->lon0 = lons.front();
+  grid->lonStep = (lons.back() - lons.front()) / (grid->w - 1);
+  grid->lat0 = lats.front();
+  grid->latStep = (lats.back() - lats.front()) / (grid->h - 1);
+  grid->mhz = std::move(values);
+  grid->maxMhz = maxMhz;
+  grid->fetched = std::chrono::system_clock::now();
+  return grid;
 }
@@ -1,17 +1,23 @@
 #pragma once
 
+#include "../core/DrapData.h"
 #include "../network/NetworkManager.h"
 #include <functional>
+#include <memory>
 #include <string>
+#include <string_view>
 
 class DRAPProvider {
 public:
-  using DataCb = std::function<void(const std::string &data)>;
+  DRAPProvider(NetworkManager &net, std::shared_ptr<DrapStore> store);
 
-  DRAPProvider(NetworkManager &net);
+  // Download and parse off the main thread, then publish to the store.
+  void fetch();
 
-  void fetch(DataCb cb);
+  // Parse drap_global_frequencies.txt. nullptr if no grid was found.
+  static std::shared_ptr<DrapGrid> parse(std::string_view body);
 
 private:
   NetworkManager &net_;
+  std::shared_ptr<DrapStore> store_;
 };
@@ -1,4 +1,5 @@
 #include "DXClusterProvider.h"
+#include "../core/WorkedIndex.h"
 #include "../core/Astronomy.h"
 #include "../core/HamClockState.h"
 #include "../core/Logger.h"
@@ -23,7 +24,7 @@ DXClusterProvider::DXClusterProvider(std::shared_ptr<DXClusterDataStore> store,
                                      std::shared_ptr<WatchlistHitStore> hits,
                                      HamClockState *state)
     : store_(store), pm_(pm), watchlist_(watchlist), hits_(hits),
-      state_(state) {}
+      health_(state ? state->services.claim("DXCluster") : nullptr) {}
 
 DXClusterProvider::~DXClusterProvider() { stop(); }
 
@@ -69,17 +70,15 @@ void DXClusterProvider::run() {
 void DXClusterProvider::runTelnet(const std::string &host, int port,
                                   const std::string &login) {
   LOG_I("DXCluster", "Connecting to {}:{}", host, port);
-  if (state_) {
-    auto &s = state_->services["DXCluster"];
-    s.ok = false;
-    s.lastError = "Connecting...";
-  }
+  if (health_)
+    health_->markPending("Connecting...");
+  auto connectStart = std::chrono::steady_clock::now();
 
   int sock = socket(AF_INET, SOCK_STREAM, 0);
   if (sock < 0) {
     LOG_E("DXCluster", "Failed to create socket");
-    if (state_)
-      state_->services["DXCluster"].lastError = "Socket error";
+    if (health_)
+      health_->markFailed("Socket error");
     return;
   }
 
@@ -87,8 +86,8 @@ void DXClusterProvider::runTelnet(const std::string &host, int port,
   struct hostent *he = gethostbyname(host.c_str());
   if (!he) {
     LOG_E("DXCluster", "Could not resolve {}", host);
-    if (state_)
-      state_->services["DXCluster"].lastError = "DNS failed";
+    if (health_)
+      health_->markFailed("DNS failed");
     close(sock);
     return;
   }
@@ -100,8 +99,8 @@ void DXClusterProvider::runTelnet(const std::string &host, int port,
 
   if (connect(sock, (struct sockaddr *)&server_addr, sizeof(server_addr)) < 0) {
     LOG_E("DXCluster", "Connect to {} failed: {}", host, std::strerror(errno));
-    if (state_)
-      state_->services["DXCluster"].lastError = "Connect failed";
+    if (health_)
+      health_->markFailed("Connect failed");
     close(sock);
     return;
   }
@@ -114,8 +113,10 @@ void DXClusterProvider::runTelnet(const std::string &host, int port,
 #endif
 
   LOG_I("DXCluster", "Connected to {}", host);
-  if (state_)
-    state_->services["DXCluster"].lastError = "Connected";
+  if (health_) {
+    health_->recordFetch(std::chrono::steady_clock::now() - connectStart, 0);
+    health_->setMessage("Connected");
+  }
   store_->setConnected(true, "Connected to " + host);
 
   std::string buffer;
@@ -152,16 +153,18 @@ void DXClusterProvider::runTelnet(const std::string &host, int port,
       ssize_t n = recv(sock, tmp, sizeof(tmp) - 1, 0);
       if (n <= 0) {
         LOG_W("DXCluster", "Connection lost");
-        if (state_) {
-          state_->services["DXCluster"].ok = false;
-          state_->services["DXCluster"].lastError = "Connection lost";
-        }
+        if (health_)
+          health_->markFailed("Connection lost");
         break; // Error or closed
       }
 
       tmp[n] = '\0';
       buffer.append(tmp, n);
+      if (health_)
+        health_->addBytes(static_cast<size_t>(n));
 
+      auto parseStart = std::chrono::steady_clock::now();
+      size_t spots = 0;
       size_t pos;
       while ((pos = buffer.find('\n')) != std::string::npos) {
         std::string line = buffer.substr(0, pos);
@@ -170,7 +173,8 @@ void DXClusterProvider::runTelnet(const std::string &host, int port,
           line.pop_back();
 
         if (!line.empty()) {
-          processLine(line);
+          if (processLine(line))
+            ++spots;
 
           // Check for common indicators that we are in
           if (line.find("Welcome") != std::string::npos ||
@@ -181,11 +185,8 @@ void DXClusterProvider::runTelnet(const std::string &host, int port,
                   std::string::npos) { // Spot line also means we are in
             if (!loggedIn) {
               loggedIn = true;
-              if (state_) {
-                auto &s = state_->services["DXCluster"];
-                s.ok = true;
-                s.lastSuccess = std::chrono::system_clock::now();
-              }
+              if (health_)
+                health_->markOk();
               store_->setConnected(true, "Logged in as " + login);
             }
             if (!initialRequestSent) {
@@ -208,6 +209,10 @@ void DXClusterProvider::runTelnet(const std::string &host, int port,
         }
       }
 
+      if (health_ && spots > 0)
+        health_->recordParse(std::chrono::steady_clock::now() - parseStart,
+                             spots);
+
       // Check for prompt without newline at the end of buffer
       if (!loggedIn && !buffer.empty()) {
         if (buffer.find("login:") != std::string::npos ||
@@ -284,8 +289,13 @@ void DXClusterProvider::runUDP(int port) {
         if (n >= 4 && (uint32_t)ntohl(*(uint32_t *)tmp) == 0xADBCCBDA) {
           // TODO: WSJT-X parsing
         } else {
+          if (health_)
+            health_->addBytes(static_cast<size_t>(n));
           std::string line(tmp, n);
-          processLine(line);
+          auto parseStart = std::chrono::steady_clock::now();
+          if (processLine(line) && health_)
+            health_->recordParse(
+                std::chrono::steady_clock::now() - parseStart, 1);
         }
       }
     }
@@ -294,9 +304,9 @@ void DXClusterProvider::runUDP(int port) {
   close(sock);
 }
 
-void DXClusterProvider::processLine(const std::string &line) {
+bool DXClusterProvider::processLine(const std::string &line) {
   if (line.empty())
-    return;
+    return false;
 
   // std::fprintf(stderr, "DXCluster: data: %s\n", line.c_str());
 
@@ -347,22 +357,32 @@ void DXClusterProvider::processLine(const std::string &line) {
           spot.rxLon = ll.lon;
         }
 
+        // Worked-before annotation
+        spot.txDxcc = pm_.findDXCC(spot.txCall);
+        if (worked_)
+          spot.worked = worked_->lookup(spot);
+
         store_->addSpot(spot);
 
         // Watchlist Check
-        if (watchlist_ && hits_ && watchlist_->contains(spot.txCall)) {
+        if (watchlist_ && hits_ &&
+            watchlist_->match(spot.txCall, spot.freqKhz, spot.mode,
+                              spot.txDxcc) >= 0) {
           WatchlistHit hit;
           hit.call = spot.txCall;
           hit.freqKhz = spot.freqKhz;
-          hit.mode = "DX"; // Cluster usually doesn't specify mode clearly
-                           // without parsing comment
+          // Cluster usually doesn't specify mode clearly without parsing
+          // the comment
+          hit.mode = spot.mode.empty() ? "DX" : spot.mode;
           hit.source = "Cluster";
           hit.time = spot.spottedAt;
           hits_->addHit(hit);
         }
+        return true;
       }
     }
   }
+  return false;
 }
 
 nlohmann::json DXClusterProvider::getDebugData() const {
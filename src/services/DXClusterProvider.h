@@ -12,6 +12,8 @@
 #include <thread>
 
 struct HamClockState;
+class ServiceSlot;
+class WorkedIndex;
 
 class DXClusterProvider {
 public:
@@ -26,6 +28,11 @@ public:
   void stop();
 
   bool isRunning() const { return running_; }
+
+  // Annotate incoming spots against the logbook.
+  void setWorkedIndex(std::shared_ptr<WorkedIndex> index) {
+    worked_ = std::move(index);
+  }
   nlohmann::json getDebugData() const;
 
 private:
@@ -33,14 +40,16 @@ private:
   void runTelnet(const std::string &host, int port, const std::string &login);
   void runUDP(int port);
 
-  void processLine(const std::string &line);
+  // True if the line was a spot.
+  bool processLine(const std::string &line);
 
   std::shared_ptr<DXClusterDataStore> store_;
   PrefixManager &pm_;
+  std::shared_ptr<WorkedIndex> worked_;
   std::shared_ptr<WatchlistStore> watchlist_;
   std::shared_ptr<WatchlistHitStore> hits_;
   AppConfig config_;
-  HamClockState *state_;
+  ServiceSlot *health_ = nullptr;
 
   std::thread thread_;
   std::atomic<bool> running_{false};
@@ -140,12 +140,15 @@ void GPSProvider::processLine(const std::string &line) {
 
     if (class_name == "TPV") {
       // Time-Position-Velocity
-      if (j.contains("lat") && j.contains("lon")) {
+      // mode 2/3 is a 2D/3D fix
+      if (j.contains("lat") && j.contains("lon") && j.value("mode", 0) >= 2) {
         double lat = j["lat"];
         double lon = j["lon"];
         LOG_D("GPS", "TPV: lat={}, lon={}", lat, lon);
-        // In a real implementation, we'd update state_->deLat/deLon here
-        // if a "Follow GPS" setting is active.
+        // Jitter below the DE tolerance is dropped here, so a parked
+        // receiver costs nothing downstream
+        if (state_)
+          state_->setDE({lat, lon});
       }
     }
   } catch (...) {
@@ -0,0 +1,451 @@
+#include "HamlibClient.h"
+#include "../core/Logger.h"
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+void closeFd(int fd) {
+#ifdef _WIN32
+  closesocket(fd);
+#else
+  close(fd);
+#endif
+}
+
+bool setNonBlocking(int fd) {
+#ifdef _WIN32
+  u_long on = 1;
+  return ioctlsocket(fd, FIONBIO, &on) == 0;
+#else
+  int flags = fcntl(fd, F_GETFL, 0);
+  return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+}
+
+bool wouldBlock() {
+#ifdef _WIN32
+  int err = WSAGetLastError();
+  return err == WSAEWOULDBLOCK || err == WSAEINPROGRESS;
+#else
+  return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINPROGRESS ||
+         errno == EINTR;
+#endif
+}
+
+int pollFds(pollfd *fds, int n, int timeoutMs) {
+#ifdef _WIN32
+  return WSAPoll(fds, n, timeoutMs);
+#else
+  return poll(fds, n, timeoutMs);
+#endif
+}
+
+std::string_view trim(std::string_view s) {
+  while (!s.empty() && (s.front() == ' ' || s.front() == '\t'))
+    s.remove_prefix(1);
+  while (!s.empty() &&
+         (s.back() == ' ' || s.back() == '\t' || s.back() == '\r'))
+    s.remove_suffix(1);
+  return s;
+}
+
+} // namespace
+
+std::string HamlibClient::Reply::value(std::string_view key) const {
+  for (const auto &[k, v] : values) {
+    if (k == key)
+      return v;
+  }
+  return {};
+}
+
+HamlibClient::HamlibClient(std::string name, std::string host, int port)
+    : name_(std::move(name)), host_(std::move(host)), port_(port) {}
+
+HamlibClient::~HamlibClient() { stop(); }
+
+void HamlibClient::addPoll(std::string cmd, ReplyCb onReply) {
+  if (polls_.size() < kMaxInFlight)
+    polls_.push_back({std::move(cmd), std::move(onReply)});
+}
+
+void HamlibClient::setPollInterval(std::chrono::milliseconds interval) {
+  pollInterval_ = std::max(interval, std::chrono::milliseconds(20));
+}
+
+void HamlibClient::setStatusHandler(StatusCb onStatus) {
+  onStatus_ = std::move(onStatus);
+}
+
+void HamlibClient::start() {
+#ifndef __EMSCRIPTEN__
+  if (running_)
+    return;
+#ifndef _WIN32
+  // set() wakes the I/O thread out of poll() through this pipe
+  if (pipe(wakePipe_) == 0) {
+    setNonBlocking(wakePipe_[0]);
+    setNonBlocking(wakePipe_[1]);
+  } else {
+    wakePipe_[0] = wakePipe_[1] = -1;
+  }
+#endif
+  running_ = true;
+  thread_ = std::thread(&HamlibClient::run, this);
+#endif
+}
+
+void HamlibClient::stop() {
+#ifndef __EMSCRIPTEN__
+  if (!running_)
+    return;
+  running_ = false;
+  wake();
+  if (thread_.joinable())
+    thread_.join();
+#ifndef _WIN32
+  for (int &fd : wakePipe_) {
+    if (fd >= 0)
+      close(fd);
+    fd = -1;
+  }
+#endif
+#endif
+}
+
+void HamlibClient::set(const std::string &key, std::string cmd,
+                       ReplyCb onReply) {
+  if (!connected_)
+    return;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = std::find_if(pending_.begin(), pending_.end(),
+                           [&](const PendingSet &p) { return p.key == key; });
+    if (it != pending_.end()) {
+      it->cmd = std::move(cmd);
+      it->onReply = std::move(onReply);
+      ++coalesced_;
+    } else {
+      pending_.push_back({key, std::move(cmd), std::move(onReply)});
+    }
+  }
+  wake();
+}
+
+void HamlibClient::wake() {
+  wakeCv_.notify_all();
+#ifndef _WIN32
+  if (wakePipe_[1] >= 0) {
+    char b = 1;
+    (void)!write(wakePipe_[1], &b, 1);
+  }
+#endif
+}
+
+void HamlibClient::run() {
+#ifndef __EMSCRIPTEN__
+  using Clock = std::chrono::steady_clock;
+  using std::chrono::duration_cast;
+  using std::chrono::milliseconds;
+  bool downLogged = false;
+
+  while (running_) {
+    if (sockfd_ < 0) {
+      std::string why;
+      if (!connectSocket(why)) {
+        if (!downLogged) {
+          LOG_W(name_, "Cannot connect to {}:{}: {}", host_, port_, why);
+          downLogged = true;
+        }
+        if (onStatus_)
+          onStatus_(false, why);
+        std::unique_lock<std::mutex> lock(mutex_);
+        wakeCv_.wait_for(lock, kRetryDelay, [this] { return !running_; });
+        continue;
+      }
+      downLogged = false;
+      connected_ = true;
+      nextPoll_ = Clock::now();
+      LOG_I(name_, "Connected to {}:{}", host_, port_);
+      if (onStatus_)
+        onStatus_(true, "");
+    }
+
+    auto now = Clock::now();
+    fillPipeline(now);
+    std::string why;
+    if (!flushWrites(why)) {
+      closeSocket(why);
+      continue;
+    }
+
+    // Sleep until there is I/O, set() wakes us, a reply is overdue or the
+    // next poll round is due
+    auto wakeAt = now + milliseconds(1000);
+    if (!inFlight_.empty())
+      wakeAt = inFlight_.front().sentAt + kReplyTimeout;
+    else if (!polls_.empty())
+      wakeAt = nextPoll_;
+    int timeoutMs = static_cast<int>(std::max<long long>(
+        0, duration_cast<milliseconds>(wakeAt - now).count()));
+#ifdef _WIN32
+    timeoutMs = std::min(timeoutMs, 20); // no wake pipe
+#endif
+
+    pollfd fds[2] = {};
+    fds[0].fd = sockfd_;
+    fds[0].events = POLLIN | (wbuf_.empty() ? 0 : POLLOUT);
+    int nfds = 1;
+    if (wakePipe_[0] >= 0) {
+      fds[1].fd = wakePipe_[0];
+      fds[1].events = POLLIN;
+      nfds = 2;
+    }
+    int ret = pollFds(fds, nfds, timeoutMs);
+    if (ret < 0 && !wouldBlock()) {
+      closeSocket("poll failed");
+      continue;
+    }
+#ifndef _WIN32
+    if (nfds == 2 && (fds[1].revents & POLLIN)) {
+      char drain[64];
+      while (read(wakePipe_[0], drain, sizeof(drain)) > 0) {
+      }
+    }
+#endif
+    if ((fds[0].revents & (POLLIN | POLLHUP | POLLERR)) &&
+        !readReplies(why)) {
+      closeSocket(why);
+      continue;
+    }
+    if (!inFlight_.empty() &&
+        Clock::now() - inFlight_.front().sentAt > kReplyTimeout)
+      closeSocket("reply timed out");
+  }
+
+  if (sockfd_ >= 0) {
+    closeFd(sockfd_);
+    sockfd_ = -1;
+  }
+  connected_ = false;
+#endif
+}
+
+void HamlibClient::fillPipeline(std::chrono::steady_clock::time_point now) {
+  std::vector<PendingSet> sets;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = pending_.begin();
+         it != pending_.end() &&
+         inFlight_.size() + sets.size() < kMaxInFlight;) {
+      bool busy =
+          std::any_of(inFlight_.begin(), inFlight_.end(),
+                      [&](const InFlight &f) { return f.key == it->key; });
+      if (busy) {
+        ++it; // keeps coalescing until the previous one is answered
+        continue;
+      }
+      sets.push_back(std::move(*it));
+      it = pending_.erase(it);
+    }
+    if (coalesced_) {
+      LOG_D(name_, "Coalesced {} superseded set commands", coalesced_);
+      coalesced_ = 0;
+    }
+  }
+
+  // Sets go first so a command is never stuck behind a poll round
+  for (auto &s : sets) {
+    wbuf_ += '+';
+    wbuf_ += s.cmd;
+    wbuf_ += '\n';
+    inFlight_.push_back({std::move(s.onReply), false, s.key, now});
+  }
+
+  if (!polls_.empty() && pollsInFlight_ == 0 && now >= nextPoll_ &&
+      inFlight_.size() + polls_.size() <= kMaxInFlight) {
+    for (const auto &p : polls_) {
+      wbuf_ += '+';
+      wbuf_ += p.cmd;
+      wbuf_ += '\n';
+      inFlight_.push_back({p.onReply, true, {}, now});
+    }
+    pollsInFlight_ = polls_.size();
+    nextPoll_ = now + pollInterval_;
+  }
+}
+
+bool HamlibClient::flushWrites(std::string &why) {
+#ifndef __EMSCRIPTEN__
+  int flags = 0;
+#ifdef MSG_NOSIGNAL
+  flags = MSG_NOSIGNAL;
+#endif
+  while (!wbuf_.empty()) {
+    auto n =
+        send(sockfd_, wbuf_.data(), static_cast<int>(wbuf_.size()), flags);
+    if (n > 0) {
+      wbuf_.erase(0, static_cast<size_t>(n));
+    } else if (n < 0 && wouldBlock()) {
+      break;
+    } else {
+      why = std::string("send failed: ") + std::strerror(errno);
+      return false;
+    }
+  }
+#endif
+  return true;
+}
+
+bool HamlibClient::readReplies(std::string &why) {
+#ifndef __EMSCRIPTEN__
+  char chunk[1024];
+  for (;;) {
+    auto n = recv(sockfd_, chunk, sizeof(chunk), 0);
+    if (n > 0) {
+      rbuf_.append(chunk, static_cast<size_t>(n));
+      continue;
+    }
+    if (n == 0) {
+      why = "closed by daemon";
+      return false;
+    }
+    if (wouldBlock())
+      break;
+    why = std::string("receive failed: ") + std::strerror(errno);
+    return false;
+  }
+
+  size_t start = 0;
+  for (size_t nl; (nl = rbuf_.find('\n', start)) != std::string::npos;
+       start = nl + 1) {
+    std::string_view line =
+        trim(std::string_view(rbuf_).substr(start, nl - start));
+    if (line.empty())
+      continue;
+
+    if (line.rfind("RPRT ", 0) == 0) {
+      if (inFlight_.empty()) {
+        why = "unexpected reply";
+        return false;
+      }
+      current_.rprt = std::atoi(std::string(line.substr(5)).c_str());
+      InFlight f = std::move(inFlight_.front());
+      inFlight_.pop_front();
+      if (f.poll)
+        --pollsInFlight_;
+      current_.latency = std::chrono::steady_clock::now() - f.sentAt;
+      if (!current_.ok())
+        LOG_D(name_, "Command failed: RPRT {}", current_.rprt);
+      if (f.onReply)
+        f.onReply(current_);
+      current_ = Reply{};
+      continue;
+    }
+
+    // "Key: value", or the "get_freq:" style header naming the command
+    size_t colon = line.find(':');
+    if (colon != std::string_view::npos)
+      current_.values.emplace_back(std::string(trim(line.substr(0, colon))),
+                                   std::string(trim(line.substr(colon + 1))));
+  }
+  rbuf_.erase(0, start);
+#endif
+  return true;
+}
+
+bool HamlibClient::connectSocket(std::string &why) {
+#ifndef __EMSCRIPTEN__
+  addrinfo hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo *res = nullptr;
+  std::string port = std::to_string(port_);
+  if (getaddrinfo(host_.c_str(), port.c_str(), &hints, &res) != 0 || !res) {
+    why = "cannot resolve " + host_;
+    return false;
+  }
+
+  why = "connection failed";
+  for (addrinfo *ai = res; ai; ai = ai->ai_next) {
+    int fd = static_cast<int>(socket(ai->ai_family, ai->ai_socktype, 0));
+    if (fd < 0)
+      continue;
+    if (!setNonBlocking(fd)) {
+      closeFd(fd);
+      continue;
+    }
+    // Commands are tiny; don't let Nagle hold back a pipelined burst
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY,
+               reinterpret_cast<const char *>(&one), sizeof(one));
+
+    if (connect(fd, ai->ai_addr, static_cast<int>(ai->ai_addrlen)) != 0) {
+      if (!wouldBlock()) {
+        closeFd(fd);
+        continue;
+      }
+      pollfd pfd{};
+      pfd.fd = fd;
+      pfd.events = POLLOUT;
+      int ms = static_cast<int>(
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              kConnectTimeout)
+              .count());
+      int err = 0;
+      socklen_t len = sizeof(err);
+      if (pollFds(&pfd, 1, ms) <= 0 ||
+          getsockopt(fd, SOL_SOCKET, SO_ERROR, reinterpret_cast<char *>(&err),
+                     &len) != 0 ||
+          err != 0) {
+        closeFd(fd);
+        continue;
+      }
+    }
+    sockfd_ = fd;
+    break;
+  }
+  freeaddrinfo(res);
+  return sockfd_ >= 0;
+#else
+  why = "not supported";
+  return false;
+#endif
+}
+
+void HamlibClient::closeSocket(const std::string &why) {
+  if (sockfd_ >= 0) {
+    closeFd(sockfd_);
+    sockfd_ = -1;
+  }
+  connected_ = false;
+  wbuf_.clear();
+  rbuf_.clear();
+  inFlight_.clear();
+  pollsInFlight_ = 0;
+  current_ = Reply{};
+  {
+    // Whatever was waiting is stale by the time we reconnect
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.clear();
+  }
+  LOG_W(name_, "Disconnected: {}", why);
+  if (onStatus_)
+    onStatus_(false, why);
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Client for Hamlib's rigctld/rotctld network daemons. One I/O thread owns
+// the socket and runs a non-blocking state machine:
+//  - Every command is sent in the extended response protocol ("+cmd"), so
+//    each reply ends in "RPRT n". Up to kMaxInFlight requests are pipelined
+//    and replies are matched to them in order.
+//  - Set commands are keyed, with at most one per key in flight. A set()
+//    whose key is still waiting replaces the waiting command (latest value
+//    wins), so a flood from a tuning knob collapses into the knob's last
+//    position.
+//  - Poll commands are re-sent every poll interval, one round at a time.
+//
+// Reply and status callbacks run on the I/O thread.
+class HamlibClient {
+public:
+  struct Reply {
+    int rprt = -1; // hamlib status, 0 = success
+    std::vector<std::pair<std::string, std::string>> values; // "Key: value"
+    std::chrono::steady_clock::duration latency{}; // from send to "RPRT"
+
+    bool ok() const { return rprt == 0; }
+    // Value of the first line with this key, or empty.
+    std::string value(std::string_view key) const;
+  };
+  using ReplyCb = std::function<void(const Reply &reply)>;
+  using StatusCb = std::function<void(bool connected, const std::string &why)>;
+
+  HamlibClient(std::string name, std::string host, int port);
+  ~HamlibClient();
+
+  HamlibClient(const HamlibClient &) = delete;
+  HamlibClient &operator=(const HamlibClient &) = delete;
+
+  // Configure before start().
+  void addPoll(std::string cmd, ReplyCb onReply);
+  void setPollInterval(std::chrono::milliseconds interval);
+  void setStatusHandler(StatusCb onStatus);
+
+  void start();
+  void stop();
+
+  // Queue a set command (without the '+' or newline). Replaces a command
+  // with the same key that has not been sent yet. Dropped while
+  // disconnected, so a stale PTT or move never fires on reconnect.
+  void set(const std::string &key, std::string cmd, ReplyCb onReply = {});
+
+  bool isConnected() const { return connected_.load(); }
+
+  static constexpr size_t kMaxInFlight = 8;
+
+private:
+  struct Poll {
+    std::string cmd;
+    ReplyCb onReply;
+  };
+  struct PendingSet {
+    std::string key;
+    std::string cmd;
+    ReplyCb onReply;
+  };
+  struct InFlight {
+    ReplyCb onReply;
+    bool poll = false;
+    std::string key; // of a set
+    std::chrono::steady_clock::time_point sentAt;
+  };
+
+  void run();
+  bool connectSocket(std::string &why);
+  void closeSocket(const std::string &why);
+  void fillPipeline(std::chrono::steady_clock::time_point now);
+  bool flushWrites(std::string &why);
+  bool readReplies(std::string &why);
+  void wake();
+
+  std::string name_;
+  std::string host_;
+  int port_;
+  std::vector<Poll> polls_;
+  std::chrono::milliseconds pollInterval_{1000};
+  StatusCb onStatus_;
+
+  std::atomic<bool> running_{false};
+  std::atomic<bool> connected_{false};
+  std::thread thread_;
+
+  // Shared with set(); wakeCv_ is used while there is no socket to poll
+  std::mutex mutex_;
+  std::condition_variable wakeCv_;
+  std::vector<PendingSet> pending_;
+  uint64_t coalesced_ = 0;
+
+  // I/O thread only
+  int sockfd_ = -1;
+  int wakePipe_[2] = {-1, -1};
+  std::string wbuf_;
+  std::string rbuf_;
+  std::deque<InFlight> inFlight_;
+  Reply current_;
+  size_t pollsInFlight_ = 0;
+  std::chrono::steady_clock::time_point nextPoll_{};
+
+  static constexpr std::chrono::seconds kConnectTimeout{2};
+  static constexpr std::chrono::seconds kReplyTimeout{2};
+  static constexpr std::chrono::seconds kRetryDelay{5};
+};
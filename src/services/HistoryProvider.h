@@ -7,8 +7,6 @@
 
 class HistoryProvider {
 public:
-  enum class SeriesType { Flux, SSN, Kp };
-
   HistoryProvider(NetworkManager &net, std::shared_ptr<HistoryStore> store);
 
   void fetchFlux();
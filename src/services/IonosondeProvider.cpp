@@ -14,10 +14,6 @@ IonosondeProvider::IonosondeProvider(NetworkManager &netMgr)
 
 void IonosondeProvider::update() {
   uint32_t now = SDL_GetTicks();
-  if (hasData_ && (now - lastUpdateMs_ < UPDATE_INTERVAL_MS)) {
-    return;
-  }
-
   const char *url = "https://prop.kc2g.com/api/stations.json";
   LOG_I("IonosondeProvider", "Fetching ionosonde data from {}", url);
 
@@ -105,6 +101,7 @@ void IonosondeProvider::processData(const std::string &body) {
       std::lock_guard<std::mutex> lock(mutex_);
       stations_ = std::move(newStations);
       hasData_ = true;
+      ++generation_;
       LOG_I("IonosondeProvider", "Processed {} valid ionosonde stations",
             stations_.size());
     }
@@ -2,6 +2,7 @@
 
 #include "../core/IonosondeData.h"
 #include "../network/NetworkManager.h"
+#include <atomic>
 #include <mutex>
 #include <vector>
 
@@ -11,7 +12,7 @@ public:
 
   /**
    * Trigger asynchronous update from KC2G API.
-   * Throttled to 10 minutes.
+   * Cadence is set by the FetchScheduler job.
    */
   void update();
 
@@ -23,6 +24,8 @@ public:
 
   bool hasData() const;
   uint32_t getLastUpdateMs() const { return lastUpdateMs_; }
+  // Bumped whenever new station data replaces the old; safe from any thread.
+  uint64_t generation() const { return generation_.load(); }
 
 private:
   void processData(const std::string &body);
@@ -31,8 +34,8 @@ private:
   std::vector<IonosondeStation> stations_;
   bool hasData_ = false;
   uint32_t lastUpdateMs_ = 0;
+  std::atomic<uint64_t> generation_{0};
   mutable std::mutex mutex_;
 
-  static constexpr uint32_t UPDATE_INTERVAL_MS = 600000; // 10 minutes
   static constexpr double MAX_VALID_DISTANCE_KM = 3000.0;
 };
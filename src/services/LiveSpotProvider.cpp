@@ -58,7 +58,8 @@ void parsePSKReporter(const std::string &body, LiveSpotData &data,
 
         if (grid.size() >= 4) {
           // Store in generic fields (SpotRecord uses receiverGrid for location)
-          data.spots.push_back({freqKhz, grid, call});
+          data.spots.push_back(
+              {freqKhz, grid, call, StringUtils::extractAttr(tag, "mode")});
           if (data.spots.size() >= 500) {
             LOG_W("LiveSpot", "Too many spots in response, capped at 500");
             break;
@@ -74,6 +75,25 @@ void parsePSKReporter(const std::string &body, LiveSpotData &data,
         data.spots.size());
 }
 
+// Record a watchlist hit for each watched station in a fetched batch.
+void reportWatched(const LiveSpotData &data, const WatchlistStore *watchlist,
+                   WatchlistHitStore *hits, const char *source) {
+  if (!watchlist || !hits)
+    return;
+  auto now = std::chrono::system_clock::now();
+  for (const auto &spot : data.spots) {
+    if (watchlist->match(spot.senderCallsign, spot.freqKhz, spot.mode) < 0)
+      continue;
+    WatchlistHit hit;
+    hit.call = spot.senderCallsign;
+    hit.freqKhz = static_cast<float>(spot.freqKhz);
+    hit.mode = spot.mode;
+    hit.source = source;
+    hit.time = now;
+    hits->addHit(hit);
+  }
+}
+
 } // namespace
 
 LiveSpotProvider::LiveSpotProvider(NetworkManager &net,
@@ -82,7 +102,8 @@ LiveSpotProvider::LiveSpotProvider(NetworkManager &net,
                                    HamClockState *state,
                                    std::shared_ptr<DXClusterDataStore> dxStore)
     : net_(net), store_(std::move(store)), dxStore_(std::move(dxStore)),
-      config_(config), state_(state) {}
+      config_(config),
+      health_(state ? state->services.claim("LiveSpot") : nullptr) {}
 
 void LiveSpotProvider::fetch() {
   switch (config_.liveSpotSource) {
@@ -134,38 +155,43 @@ void LiveSpotProvider::fetchPSK() {
                                 param, target, windowStart);
 
   LOG_I("LiveSpot", "Fetching PSK {}", url);
-  if (state_) {
-    state_->services["LiveSpot"].lastError = "Fetching...";
-  }
+  if (health_)
+    health_->setMessage("Fetching...");
 
   auto store = store_;
   auto grid = config_.grid;
-  auto state = state_;
+  auto health = health_;
+  auto started = std::chrono::steady_clock::now();
+  auto watchlist = watchlist_;
+  auto hits = hits_;
   bool ofDe = config_.liveSpotsOfDe;
   int maxAge = config_.liveSpotsMaxAge;
 
   net_.fetchAsync(
       url,
-      [store, grid, state, ofDe, maxAge](std::string body) {
+      [store, grid, health, started, watchlist, hits, ofDe,
+       maxAge](std::string body) {
         LiveSpotData data;
         data.grid = grid.substr(0, 4);
         data.windowMinutes = maxAge;
 
+        if (health)
+          health->recordFetch(std::chrono::steady_clock::now() - started,
+                              body.size());
+
         if (!body.empty()) {
+          auto parseStart = std::chrono::steady_clock::now();
           parsePSKReporter(body, data, ofDe);
-          if (state) {
-            auto &s = state->services["LiveSpot"];
-            s.ok = true;
-            s.lastSuccess = std::chrono::system_clock::now();
-            s.lastError = "";
+          if (health) {
+            health->recordParse(std::chrono::steady_clock::now() - parseStart,
+                                data.spots.size());
+            health->markOk();
           }
+          reportWatched(data, watchlist.get(), hits.get(), "PSK");
         } else {
           LOG_W("LiveSpot", "Empty response from PSK Reporter");
-          if (state) {
-            auto &s = state->services["LiveSpot"];
-            s.ok = false;
-            s.lastError = "Empty response";
-          }
+          if (health)
+            health->markFailed("Empty response");
         }
 
         data.lastUpdated = std::chrono::system_clock::now();
@@ -284,27 +310,33 @@ void LiveSpotProvider::fetchWSPR() {
   std::string url = "http://db1.wspr.live/?query=" + encoded;
   LOG_I("LiveSpot", "Fetching WSPR via db1.wspr.live");
 
-  if (state_)
-    state_->services["LiveSpot"].lastError = "Fetching...";
+  if (health_)
+    health_->setMessage("Fetching...");
 
   auto store = store_;
   auto myGrid4 = grid4;
-  auto state = state_;
+  auto health = health_;
+  auto started = std::chrono::steady_clock::now();
+  auto watchlist = watchlist_;
+  auto hits = hits_;
   int maxAge = config_.liveSpotsMaxAge;
 
   net_.fetchAsync(
       url,
-      [store, myGrid4, state, maxAge](std::string body) {
+      [store, myGrid4, health, started, watchlist, hits,
+       maxAge](std::string body) {
         LiveSpotData data;
         data.grid = myGrid4;
         data.windowMinutes = maxAge;
 
+        if (health)
+          health->recordFetch(std::chrono::steady_clock::now() - started,
+                              body.size());
+
         if (body.empty()) {
           LOG_W("LiveSpot", "Empty response from db1.wspr.live");
-          if (state) {
-            state->services["LiveSpot"].ok = false;
-            state->services["LiveSpot"].lastError = "Empty response";
-          }
+          if (health)
+            health->markFailed("Empty response");
           data.lastUpdated = std::chrono::system_clock::now();
           data.valid = true;
           store->set(data);
@@ -313,6 +345,7 @@ void LiveSpotProvider::fetchWSPR() {
 
         // Parse FORMAT CSV: time, myLoc, mySign, otherLoc, otherSign,
         //                   mode, freq_hz, snr
+        auto parseStart = std::chrono::steady_clock::now();
         std::istringstream ss(body);
         std::string line;
         while (std::getline(ss, line)) {
@@ -337,21 +370,21 @@ void LiveSpotProvider::fetchWSPR() {
           if (idx >= 0) {
             data.bandCounts[idx]++;
             if (otherLoc.size() >= 4) {
-              data.spots.push_back({freqKhz, otherLoc, otherSign});
+              data.spots.push_back({freqKhz, otherLoc, otherSign, "WSPR"});
               if (data.spots.size() >= 500)
                 break;
             }
           }
         }
 
-        if (state) {
-          state->services["LiveSpot"].ok = true;
-          state->services["LiveSpot"].lastSuccess =
-              std::chrono::system_clock::now();
-          state->services["LiveSpot"].lastError = "";
+        if (health) {
+          health->recordParse(std::chrono::steady_clock::now() - parseStart,
+                              data.spots.size());
+          health->markOk();
         }
         LOG_I("LiveSpot", "Parsed {} WSPR spots from db1.wspr.live",
               data.spots.size());
+        reportWatched(data, watchlist.get(), hits.get(), "WSPR");
 
         data.lastUpdated = std::chrono::system_clock::now();
         data.valid = true;
@@ -419,19 +452,15 @@ void LiveSpotProvider::fetchRBN() {
       const std::string &plotGrid = ofDe ? spot.rxGrid : spot.txGrid;
       const std::string &plotCall = ofDe ? spot.rxCall : spot.txCall;
       if (plotGrid.size() >= 4) {
-        data.spots.push_back({spot.freqKhz, plotGrid, plotCall});
+        data.spots.push_back({spot.freqKhz, plotGrid, plotCall, spot.mode});
         if (data.spots.size() >= 500)
           break;
       }
     }
   }
 
-  if (state_) {
-    state_->services["LiveSpot"].ok = true;
-    state_->services["LiveSpot"].lastSuccess =
-        std::chrono::system_clock::now();
-    state_->services["LiveSpot"].lastError = "";
-  }
+  if (health_)
+    health_->markOk();
 
   LOG_I("LiveSpot", "Aggregated {} RBN spots from DX store (ofDe={}, useCall={})",
         data.spots.size(), ofDe, useCall);
@@ -3,6 +3,8 @@
 #include "../core/ConfigManager.h"
 #include "../core/DXClusterData.h"
 #include "../core/LiveSpotData.h"
+#include "../core/WatchlistHitStore.h"
+#include "../core/WatchlistStore.h"
 #include "../network/NetworkManager.h"
 
 #include <memory>
@@ -10,6 +12,7 @@
 #include <spdlog/fmt/fmt.h>
 
 struct HamClockState;
+class ServiceSlot;
 
 class LiveSpotProvider {
 public:
@@ -20,6 +23,13 @@ public:
 
   void fetch();
   void updateConfig(const AppConfig &config) { config_ = config; }
+
+  // Report watched stations among the fetched PSK Reporter / WSPR spots.
+  void setWatchlist(std::shared_ptr<WatchlistStore> watchlist,
+                    std::shared_ptr<WatchlistHitStore> hits) {
+    watchlist_ = std::move(watchlist);
+    hits_ = std::move(hits);
+  }
   nlohmann::json getDebugData() const;
 
 private:
@@ -30,6 +40,8 @@ private:
   NetworkManager &net_;
   std::shared_ptr<LiveSpotDataStore> store_;
   std::shared_ptr<DXClusterDataStore> dxStore_;
+  std::shared_ptr<WatchlistStore> watchlist_;
+  std::shared_ptr<WatchlistHitStore> hits_;
   AppConfig config_;
-  HamClockState *state_;
+  ServiceSlot *health_ = nullptr;
 };
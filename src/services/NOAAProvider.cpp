@@ -7,6 +7,7 @@
 #include "../core/StringUtils.h"
 #include "../core/WorkerService.h"
 #include <SDL_events.h>
+#include <algorithm>
 #include <chrono>
 #include <cstdio>
 #include <nlohmann/json.hpp>
@@ -15,8 +16,14 @@ NOAAProvider::NOAAProvider(NetworkManager &net,
                            std::shared_ptr<SolarDataStore> store,
                            std::shared_ptr<AuroraHistoryStore> auroraStore,
                            HamClockState *state)
-    : net_(net), store_(std::move(store)), auroraStore_(std::move(auroraStore)),
-      state_(state) {}
+    : net_(net), store_(std::move(store)),
+      auroraStore_(std::move(auroraStore)) {
+  if (state) {
+    kIndexHealth_ = state->services.claim("NOAA:KIndex");
+    xrayHealth_ = state->services.claim("NOAA:XRay");
+    protonHealth_ = state->services.claim("NOAA:ProtonFlux");
+  }
+}
 
 // Calculate R-scale (Radio Blackouts) from X-ray flux
 // R1: >= 1e-5, R2: >= 5e-5, R3: >= 1e-4, R4: >= 1e-3, R5: >= 2e-3
@@ -75,34 +82,38 @@ void NOAAProvider::fetch() {
   fetchMag();
   fetchDST();
   fetchAurora();
-  fetchDRAP();
   fetchXRay();
   fetchProtonFlux();
 }
 
 void NOAAProvider::fetchKIndex() {
-  auto state = state_;
-  net_.fetchAsync(K_INDEX_URL, [state](std::string body) {
+  auto health = kIndexHealth_;
+  auto started = std::chrono::steady_clock::now();
+  net_.fetchAsync(K_INDEX_URL, [health, started](std::string body) {
+    if (health)
+      health->recordFetch(std::chrono::steady_clock::now() - started,
+                          body.size());
     if (body.empty()) {
-      if (state) {
-        auto &s = state->services["NOAA:KIndex"];
-        s.ok = false;
-        s.lastError = "Empty response";
-      }
+      if (health)
+        health->markFailed("Empty response");
       return;
     }
 
-    WorkerService::getInstance().submitTask([body, state]() {
+    WorkerService::getInstance().submitTask([body, health]() {
+      auto parseStart = std::chrono::steady_clock::now();
       auto j = nlohmann::json::parse(body, nullptr, false);
       if (j.is_discarded() || !j.is_array() || j.size() < 2) {
-        // We can't easily update state->services from here if it's not
-        // thread-safe. But HamClockState has a mutex for its services map.
+        if (health)
+          health->markFailed("Invalid JSON");
         return;
       }
 
       const auto &row = j.back();
-      if (!row.is_array() || row.size() < 3)
+      if (!row.is_array() || row.size() < 3) {
+        if (health)
+          health->markFailed("Unexpected row format");
         return;
+      }
 
       auto *update = new SolarData();
       double kp = StringUtils::safe_stod(row[1].get<std::string>());
@@ -119,10 +130,10 @@ void NOAAProvider::fetchKIndex() {
       event.user.data1 = update;
       SDL_PushEvent(&event);
 
-      if (state) {
-        auto &s = state->services["NOAA:KIndex"];
-        s.ok = true;
-        s.lastSuccess = std::chrono::system_clock::now();
+      if (health) {
+        health->recordParse(std::chrono::steady_clock::now() - parseStart,
+                            j.size() - 1);
+        health->markOk();
       }
       LOG_I("NOAAProvider", "Offloaded K-Index update: K={}, G-scale=G{}",
             update->k_index, update->noaa_g_scale);
@@ -308,6 +319,85 @@ void NOAAProvider::fetchDST() {
   });
 }
 
+// Streaming scanner for the OVATION "coordinates" array. The payload is
+// ~65k [lon, lat, percent] triples, so this walks the buffer once instead of
+// searching for brackets and running sscanf on every one of them.
+namespace {
+struct NumberScanner {
+  const char *p;
+  const char *end;
+
+  // Advance to the next numeric token and parse it. Returns false at end of
+  // input or when a closing bracket of the outer array is reached.
+  bool next(float &out) {
+    while (p < end) {
+      char c = *p;
+      if ((c >= '0' && c <= '9') || c == '-' || c == '.')
+        break;
+      if (c == ']' && p + 1 < end) {
+        // "]]" closes the coordinates array.
+        const char *q = p + 1;
+        while (q < end && (*q == ' ' || *q == '\n' || *q == '\r' || *q == '\t'))
+          ++q;
+        if (q < end && *q == ']')
+          return false;
+      }
+      ++p;
+    }
+    if (p >= end)
+      return false;
+
+    bool neg = false;
+    if (*p == '-') {
+      neg = true;
+      ++p;
+    }
+    double v = 0.0;
+    while (p < end && *p >= '0' && *p <= '9')
+      v = v * 10.0 + (*p++ - '0');
+    if (p < end && *p == '.') {
+      ++p;
+      double scale = 0.1;
+      while (p < end && *p >= '0' && *p <= '9') {
+        v += (*p++ - '0') * scale;
+        scale *= 0.1;
+      }
+    }
+    out = static_cast<float>(neg ? -v : v);
+    return true;
+  }
+};
+} // namespace
+
+static std::shared_ptr<AuroraGrid> parseOvationGrid(const std::string &body) {
+  size_t pos = body.find("\"coordinates\"");
+  if (pos == std::string::npos)
+    return nullptr;
+  pos = body.find('[', pos);
+  if (pos == std::string::npos)
+    return nullptr;
+
+  auto grid = std::make_shared<AuroraGrid>();
+  NumberScanner scan{body.data() + pos + 1, body.data() + body.size()};
+  int cells = 0;
+  float lon, lat, val;
+  while (scan.next(lon) && scan.next(lat) && scan.next(val)) {
+    int ilon = static_cast<int>(lon) % AuroraGrid::W;
+    if (ilon < 0)
+      ilon += AuroraGrid::W;
+    int ilat = static_cast<int>(lat);
+    if (ilat < -90 || ilat > 90)
+      continue;
+    grid->percent[(ilat + 90) * AuroraGrid::W + ilon] = val;
+    grid->maxPercent = std::max(grid->maxPercent, val);
+    ++cells;
+  }
+  if (cells == 0)
+    return nullptr;
+  grid->fetched = std::chrono::system_clock::now();
+  return grid;
+}
+
 void NOAAProvider::fetchAurora() {
   auto auroraStore = auroraStore_;
   net_.fetchAsync(AURORA_URL, [auroraStore](std::string body) {
@@ -316,29 +406,11 @@ void NOAAProvider::fetchAurora() {
 
     WorkerService::getInstance().submitTask([body, auroraStore]() {
       try {
-        float max_percent = 0;
-        bool found_any = false;
-
-        // Manual parse of JSON grid coordinates
-        // Format: "coordinates":[[lon,lat,val],...]
-        size_t coords_pos = body.find("\"coordinates\"");
-        if (coords_pos != std::string::npos) {
-          size_t p = coords_pos;
-          while ((p = body.find('[', p)) != std::string::npos) {
-            int lon, lat, val;
-            if (sscanf(body.c_str() + p, "[%d,%d,%d]", &lon, &lat, &val) == 3) {
-              if (val > max_percent)
-                max_percent = (float)val;
-              found_any = true;
-            } else if (sscanf(body.c_str() + p, "[%d, %d, %d]", &lon, &lat,
-                              &val) == 3) {
-              if (val > max_percent)
-                max_percent = (float)val;
-              found_any = true;
-            }
-            p++;
-          }
-        }
+        auto grid = parseOvationGrid(body);
+        bool found_any = grid != nullptr;
+        float max_percent = found_any ? grid->maxPercent : 0.0f;
+        if (found_any && auroraStore)
+          auroraStore->setGrid(std::move(grid));
 
         if (found_any) {
           // Push to SolarDataStore
@@ -381,77 +453,31 @@ void NOAAProvider::fetchAurora() {
   });
 }
 
-void NOAAProvider::fetchDRAP() {
-  net_.fetchAsync(DRAP_URL, [](std::string body) {
-    if (body.empty())
-      return;
-
-    WorkerService::getInstance().submitTask([body]() {
-      try {
-        float max_freq = 0;
-        bool found_any = false;
-
-        std::stringstream ss(body);
-        std::string line;
-        while (std::getline(ss, line)) {
-          if (line.empty() || line[0] == '#' || line[0] == '\r')
-            continue;
-
-          size_t pipe_pos = line.find('|');
-          if (pipe_pos != std::string::npos) {
-            std::string freqs = line.substr(pipe_pos + 1);
-            std::stringstream ss_vals(freqs);
-            float val;
-            while (ss_vals >> val) {
-              if (val > max_freq)
-                max_freq = val;
-              found_any = true;
-            }
-          }
-        }
-
-        if (found_any) {
-          auto *update = new SolarData();
-          // Storing float frequency into int field (rounding) per existing
-          // pattern
-          update->drap = static_cast<int>(std::round(max_freq));
-          update->valid = true;
-
-          SDL_Event event;
-          SDL_zero(event);
-          event.type = HamClock::AE_BASE_EVENT + HamClock::AE_SOLAR_DATA_READY;
-          event.user.code = static_cast<int>(UpdateType::DRAP);
-          event.user.data1 = update;
-          SDL_PushEvent(&event);
-        }
-      } catch (...) {
-      }
-    });
-  });
-}
-
 void NOAAProvider::fetchXRay() {
-  auto state = state_;
-  net_.fetchAsync(XRAY_URL, [state](std::string body) {
+  auto health = xrayHealth_;
+  auto started = std::chrono::steady_clock::now();
+  net_.fetchAsync(XRAY_URL, [health, started](std::string body) {
+    if (health)
+      health->recordFetch(std::chrono::steady_clock::now() - started,
+                          body.size());
     if (body.empty()) {
-      if (state) {
-        auto &s = state->services["NOAA:XRay"];
-        s.ok = false;
-        s.lastError = "Empty response";
-      }
+      if (health)
+        health->markFailed("Empty response");
       return;
     }
 
-    WorkerService::getInstance().submitTask([body, state]() {
+    WorkerService::getInstance().submitTask([body, health]() {
       try {
+        auto parseStart = std::chrono::steady_clock::now();
         auto j = nlohmann::json::parse(body, nullptr, false);
         if (j.is_discarded() || !j.is_array() || j.empty()) {
-          if (state) {
-            state->services["NOAA:XRay"].ok = false;
-            state->services["NOAA:XRay"].lastError = "Invalid JSON";
-          }
+          if (health)
+            health->markFailed("Invalid JSON");
           return;
         }
+        if (health)
+          health->recordParse(std::chrono::steady_clock::now() - parseStart,
+                              j.size());
 
         // Find the most recent 0.1-0.8nm band entry
         // Iterate backwards to find the latest valid entry
@@ -483,51 +509,46 @@ void NOAAProvider::fetchXRay() {
           event.user.data1 = update;
           SDL_PushEvent(&event);
 
-          if (state) {
-            auto &s = state->services["NOAA:XRay"];
-            s.ok = true;
-            s.lastSuccess = std::chrono::system_clock::now();
-          }
+          if (health)
+            health->markOk();
         } else {
-          if (state) {
-            state->services["NOAA:XRay"].ok = false;
-            state->services["NOAA:XRay"].lastError = "No 0.1-0.8nm data found";
-          }
+          if (health)
+            health->markFailed("No 0.1-0.8nm data found");
         }
       } catch (const std::exception &e) {
         LOG_E("NOAAProvider", "X-ray parse error: {}", e.what());
-        if (state) {
-          auto &s = state->services["NOAA:XRay"];
-          s.ok = false;
-          s.lastError = e.what();
-        }
+        if (health)
+          health->markFailed(e.what());
       }
     });
   });
 }
 
 void NOAAProvider::fetchProtonFlux() {
-  auto state = state_;
-  net_.fetchAsync(PROTON_URL, [state](std::string body) {
+  auto health = protonHealth_;
+  auto started = std::chrono::steady_clock::now();
+  net_.fetchAsync(PROTON_URL, [health, started](std::string body) {
+    if (health)
+      health->recordFetch(std::chrono::steady_clock::now() - started,
+                          body.size());
     if (body.empty()) {
-      if (state) {
-        auto &s = state->services["NOAA:ProtonFlux"];
-        s.ok = false;
-        s.lastError = "Empty response";
-      }
+      if (health)
+        health->markFailed("Empty response");
       return;
     }
 
-    WorkerService::getInstance().submitTask([body, state]() {
+    WorkerService::getInstance().submitTask([body, health]() {
       try {
+        auto parseStart = std::chrono::steady_clock::now();
         auto j = nlohmann::json::parse(body, nullptr, false);
         if (j.is_discarded() || !j.is_array() || j.empty()) {
-          if (state) {
-            state->services["NOAA:ProtonFlux"].ok = false;
-            state->services["NOAA:ProtonFlux"].lastError = "Invalid JSON";
-          }
+          if (health)
+            health->markFailed("Invalid JSON");
           return;
         }
+        if (health)
+          health->recordParse(std::chrono::steady_clock::now() - parseStart,
+                              j.size());
 
         // Find the most recent >=10 MeV proton flux entry
         double latest_flux = 0.0;
@@ -558,25 +579,16 @@ void NOAAProvider::fetchProtonFlux() {
           event.user.data1 = update;
           SDL_PushEvent(&event);
 
-          if (state) {
-            auto &s = state->services["NOAA:ProtonFlux"];
-            s.ok = true;
-            s.lastSuccess = std::chrono::system_clock::now();
-          }
+          if (health)
+            health->markOk();
         } else {
-          if (state) {
-            state->services["NOAA:ProtonFlux"].ok = false;
-            state->services["NOAA:ProtonFlux"].lastError =
-                "No >=10 MeV data found";
-          }
+          if (health)
+            health->markFailed("No >=10 MeV data found");
         }
       } catch (const std::exception &e) {
         LOG_E("NOAAProvider", "Proton flux parse error: {}", e.what());
-        if (state) {
-          auto &s = state->services["NOAA:ProtonFlux"];
-          s.ok = false;
-          s.lastError = e.what();
-        }
+        if (health)
+          health->markFailed(e.what());
       }
     });
   });
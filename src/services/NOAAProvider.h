@@ -7,6 +7,7 @@
 #include <memory>
 
 struct HamClockState;
+class ServiceSlot;
 
 class NOAAProvider {
 public:
@@ -18,7 +19,7 @@ public:
     Mag,
     DST,
     Aurora,
-    DRAP,
+    DRAP, // posted by DRAPProvider
     XRay,
     ProtonFlux
   };
@@ -37,7 +38,6 @@ private:
   void fetchMag();
   void fetchDST();
   void fetchAurora();
-  void fetchDRAP();
   void fetchXRay();
   void fetchProtonFlux();
 
@@ -56,8 +56,6 @@ private:
       "https://services.swpc.noaa.gov/products/kyoto-dst.json";
   static constexpr const char *AURORA_URL =
       "https://services.swpc.noaa.gov/json/ovation_aurora_latest.json";
-  static constexpr const char *DRAP_URL =
-      "https://services.swpc.noaa.gov/text/drap_global_frequencies.txt";
   static constexpr const char *XRAY_URL =
       "https://services.swpc.noaa.gov/json/goes/primary/xrays-6-hour.json";
   static constexpr const char *PROTON_URL =
@@ -67,5 +65,8 @@ private:
   NetworkManager &net_;
   std::shared_ptr<SolarDataStore> store_;
   std::shared_ptr<AuroraHistoryStore> auroraStore_;
-  HamClockState *state_;
+  // Health slots, nullptr without a state
+  ServiceSlot *kIndexHealth_ = nullptr;
+  ServiceSlot *xrayHealth_ = nullptr;
+  ServiceSlot *protonHealth_ = nullptr;
 };
@@ -10,6 +10,7 @@ void QRZProvider::setCredentials(const std::string &username,
                                  const std::string &password) {
   username_ = username;
   password_ = password;
+  std::lock_guard<std::mutex> lock(sessionMutex_);
   sessionValid_ = false;
   sessionKey_.clear();
   LOG_I("QRZ", "Credentials configured for user: {}", username);
@@ -38,7 +39,12 @@ void QRZProvider::lookup(const std::string &callsign,
     }
 
     // Now perform the lookup
-    std::string url = "https://xmldata.qrz.com/xml/current/?s=" + sessionKey_ +
+    std::string key;
+    {
+      std::lock_guard<std::mutex> lock(sessionMutex_);
+      key = sessionKey_;
+    }
+    std::string url = "https://xmldata.qrz.com/xml/current/?s=" + key +
                       "&callsign=" + callsign;
 
     netMgr_.fetchAsync(
@@ -62,7 +68,12 @@ void QRZProvider::lookup(const std::string &callsign,
 
 void QRZProvider::establishSession(std::function<void(bool)> callback) {
   // If we already have a valid session, use it
-  if (sessionValid_ && !sessionKey_.empty()) {
+  bool valid;
+  {
+    std::lock_guard<std::mutex> lock(sessionMutex_);
+    valid = sessionValid_ && !sessionKey_.empty();
+  }
+  if (valid) {
     callback(true);
     return;
   }
@@ -75,14 +86,17 @@ void QRZProvider::establishSession(std::function<void(bool)> callback) {
       url,
       [this, callback](const std::string &xml) {
         // Extract session key
-        sessionKey_ = extractTag(xml, "Key");
+        std::string key = extractTag(xml, "Key");
+        {
+          std::lock_guard<std::mutex> lock(sessionMutex_);
+          sessionKey_ = key;
+          sessionValid_ = !key.empty();
+        }
 
-        if (!sessionKey_.empty()) {
-          sessionValid_ = true;
+        if (!key.empty()) {
           LOG_I("QRZ", "Session established");
           callback(true);
         } else {
-          sessionValid_ = false;
           std::string error = extractTag(xml, "Error");
           LOG_E("QRZ", "Authentication failed: {}", error);
           callback(false);
@@ -105,6 +119,7 @@ QRZLookupResult QRZProvider::parseResponse(const std::string &xml,
     // If session expired, invalidate it
     if (error.find("Session") != std::string::npos ||
         error.find("Invalid") != std::string::npos) {
+      std::lock_guard<std::mutex> lock(sessionMutex_);
       sessionValid_ = false;
       sessionKey_.clear();
     }
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "../network/NetworkManager.h"
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 
 // QRZ callsign lookup result
@@ -46,6 +48,8 @@ private:
   NetworkManager &netMgr_;
   std::string username_;
   std::string password_;
+  // Session state is shared by lookups completing on network threads
+  std::mutex sessionMutex_;
   std::string sessionKey_;
   bool sessionValid_ = false;
 
@@ -1,4 +1,5 @@
 #include "RBNProvider.h"
+#include "../core/WorkedIndex.h"
 #include "../core/Astronomy.h"
 #include "../core/HamClockState.h"
 #include "../core/Logger.h"
@@ -19,7 +20,8 @@
 
 RBNProvider::RBNProvider(std::shared_ptr<DXClusterDataStore> store,
                          PrefixManager &pm, HamClockState *state)
-    : store_(store), pm_(pm), state_(state) {}
+    : store_(store), pm_(pm),
+      health_(state ? state->services.claim("RBN") : nullptr) {}
 
 RBNProvider::~RBNProvider() { stop(); }
 
@@ -63,25 +65,23 @@ void RBNProvider::run() {
 void RBNProvider::runTelnet(const std::string &host, int port,
                              const std::string &login) {
   LOG_I("RBN", "Connecting to {}:{}", host, port);
-  if (state_) {
-    auto &s = state_->services["RBN"];
-    s.ok = false;
-    s.lastError = "Connecting...";
-  }
+  if (health_)
+    health_->markPending("Connecting...");
+  auto connectStart = std::chrono::steady_clock::now();
 
   int sock = socket(AF_INET, SOCK_STREAM, 0);
   if (sock < 0) {
     LOG_E("RBN", "Failed to create socket");
-    if (state_)
-      state_->services["RBN"].lastError = "Socket error";
+    if (health_)
+      health_->markFailed("Socket error");
     return;
   }
 
   struct hostent *he = gethostbyname(host.c_str());
   if (!he) {
     LOG_E("RBN", "Could not resolve {}", host);
-    if (state_)
-      state_->services["RBN"].lastError = "DNS failed";
+    if (health_)
+      health_->markFailed("DNS failed");
     close(sock);
     return;
   }
@@ -97,8 +97,8 @@ void RBNProvider::runTelnet(const std::string &host, int port,
 #else
     LOG_E("RBN", "Connect to {} failed: {}", host, std::strerror(errno));
 #endif
-    if (state_)
-      state_->services["RBN"].lastError = "Connect failed";
+    if (health_)
+      health_->markFailed("Connect failed");
     close(sock);
     return;
   }
@@ -111,8 +111,9 @@ void RBNProvider::runTelnet(const std::string &host, int port,
 #endif
 
   LOG_I("RBN", "Connected to {}", host);
-  if (state_) {
-    state_->services["RBN"].lastError = "Connected";
+  if (health_) {
+    health_->recordFetch(std::chrono::steady_clock::now() - connectStart, 0);
+    health_->setMessage("Connected");
   }
 
   // Send callsign login immediately
@@ -145,16 +146,18 @@ void RBNProvider::runTelnet(const std::string &host, int port,
       ssize_t n = recv(sock, tmp, sizeof(tmp) - 1, 0);
       if (n <= 0) {
         LOG_W("RBN", "Connection lost");
-        if (state_) {
-          state_->services["RBN"].ok = false;
-          state_->services["RBN"].lastError = "Connection lost";
-        }
+        if (health_)
+          health_->markFailed("Connection lost");
         break;
       }
 
       tmp[n] = '\0';
       buffer.append(tmp, n);
+      if (health_)
+        health_->addBytes(static_cast<size_t>(n));
 
+      auto parseStart = std::chrono::steady_clock::now();
+      size_t spots = 0;
       size_t pos;
       while ((pos = buffer.find('\n')) != std::string::npos) {
         std::string line = buffer.substr(0, pos);
@@ -164,24 +167,25 @@ void RBNProvider::runTelnet(const std::string &host, int port,
           line.pop_back();
 
         if (!line.empty()) {
-          processLine(line);
+          if (processLine(line))
+            ++spots;
 
           if (!loggedIn) {
             if (line.find("Welcome") != std::string::npos ||
                 line.find("DX de ") != std::string::npos) {
               loggedIn = true;
-              if (state_) {
-                auto &s = state_->services["RBN"];
-                s.ok = true;
-                s.lastSuccess = std::chrono::system_clock::now();
-                s.lastError = "";
-              }
+              if (health_)
+                health_->markOk();
               LOG_I("RBN", "Logged in as {}", login);
             }
           }
         }
       }
 
+      if (health_ && spots > 0)
+        health_->recordParse(std::chrono::steady_clock::now() - parseStart,
+                             spots);
+
       // Re-send login on prompt if not yet accepted
       if (!loggedIn && !buffer.empty()) {
         if (buffer.find("login:") != std::string::npos ||
@@ -207,22 +211,22 @@ void RBNProvider::runTelnet(const std::string &host, int port,
   close(sock);
 }
 
-void RBNProvider::processLine(const std::string &line) {
+bool RBNProvider::processLine(const std::string &line) {
   if (line.empty())
-    return;
+    return false;
 
   // Standard DX de format:
   // DX de KA9Q-#:   14020.0  W1AW          CW    20 dB  12 WPM  CQ  0000Z
   const char *dxde = std::strstr(line.c_str(), "DX de ");
   if (!dxde)
-    return;
+    return false;
 
   DXClusterSpot spot;
   char rxCall[32], txCall[32];
   float freq;
 
   if (sscanf(dxde, "DX de %31[^ :]: %f %31s", rxCall, &freq, txCall) != 3)
-    return;
+    return false;
 
   spot.rxCall = rxCall;
   spot.txCall = txCall;
@@ -305,5 +309,23 @@ void RBNProvider::processLine(const std::string &line) {
   LOG_D("RBN", "Spot: {} on {:.1f} kHz {} {:.0f}dB", spot.txCall,
         spot.freqKhz, spot.mode, spot.snr);
 
+  // Worked-before annotation
+  spot.txDxcc = pm_.findDXCC(spot.txCall);
+  if (worked_)
+    spot.worked = worked_->lookup(spot);
+
   store_->addSpot(spot);
+
+  if (watchlist_ && hits_ &&
+      watchlist_->match(spot.txCall, spot.freqKhz, spot.mode, spot.txDxcc) >=
+          0) {
+    WatchlistHit hit;
+    hit.call = spot.txCall;
+    hit.freqKhz = spot.freqKhz;
+    hit.mode = spot.mode;
+    hit.source = "RBN";
+    hit.time = spot.spottedAt;
+    hits_->addHit(hit);
+  }
+  return true;
 }
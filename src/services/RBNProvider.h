@@ -3,12 +3,16 @@
 #include "../core/ConfigManager.h"
 #include "../core/DXClusterData.h"
 #include "../core/PrefixManager.h"
+#include "../core/WatchlistHitStore.h"
+#include "../core/WatchlistStore.h"
 #include <atomic>
 #include <memory>
 #include <string>
 #include <thread>
 
 struct HamClockState;
+class ServiceSlot;
+class WorkedIndex;
 
 // Reverse Beacon Network provider.
 // Connects to the RBN Telnet feed (telnet.reversebeacon.net:7000), parses
@@ -25,14 +29,30 @@ public:
 
   bool isRunning() const { return running_; }
 
+  // Annotate incoming spots against the logbook.
+  void setWorkedIndex(std::shared_ptr<WorkedIndex> index) {
+    worked_ = std::move(index);
+  }
+
+  // Report skimmer spots of watched stations.
+  void setWatchlist(std::shared_ptr<WatchlistStore> watchlist,
+                    std::shared_ptr<WatchlistHitStore> hits) {
+    watchlist_ = std::move(watchlist);
+    hits_ = std::move(hits);
+  }
+
 private:
   void run();
   void runTelnet(const std::string &host, int port, const std::string &login);
-  void processLine(const std::string &line);
+  // True if the line was a spot.
+  bool processLine(const std::string &line);
 
   std::shared_ptr<DXClusterDataStore> store_;
   PrefixManager &pm_;
-  HamClockState *state_;
+  std::shared_ptr<WorkedIndex> worked_;
+  std::shared_ptr<WatchlistStore> watchlist_;
+  std::shared_ptr<WatchlistHitStore> hits_;
+  ServiceSlot *health_ = nullptr;
   AppConfig config_;
 
   std::thread thread_;
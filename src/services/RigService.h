@@ -3,29 +3,28 @@
 #include "../core/ConfigManager.h"
 #include "../core/HamClockState.h"
 #include "../core/RigData.h"
+#include "HamlibClient.h"
 
 #include <atomic>
-#include <condition_variable>
 #include <memory>
-#include <mutex>
-#include <queue>
 #include <string>
-#include <thread>
 
-// Service for interfacing with Hamlib rigctld daemon
-// Implements async producer-consumer pattern for CAT command execution
+// Service for interfacing with Hamlib rigctld daemon. Frequency, mode and
+// PTT are polled into the store; set commands go through HamlibClient, so a
+// burst of them collapses to the latest value per setting.
 class RigService {
 public:
   RigService(std::shared_ptr<RigDataStore> store, const AppConfig &config,
              HamClockState *state = nullptr);
   ~RigService();
 
-  // Start/stop background command processing thread
+  // Start/stop the rigctld connection
   void start();
   void stop();
 
-  // High-level CAT command interface (producer)
-  // These methods queue commands for async execution
+  // High-level CAT command interface
+  // These return once the command is queued; the store follows the rig on
+  // the next poll.
 
   // Set radio frequency (in Hz)
   bool setFrequency(long long freqHz);
@@ -46,37 +45,13 @@ public:
   bool isConnected() const;
 
 private:
+  bool queueSet(const char *key, std::string cmd);
+  void onStatus(bool connected, const std::string &why);
+
   std::shared_ptr<RigDataStore> store_;
   const AppConfig &config_;
-  HamClockState *state_;
+  ServiceSlot *health_ = nullptr;
 
   std::atomic<bool> running_{false};
-  std::atomic<bool> connected_{false};
-
-  // Producer-consumer queue infrastructure
-  std::queue<RigCommandRequest> commandQueue_;
-  std::mutex queueMutex_;
-  std::condition_variable queueCV_;
-  std::thread workerThread_;
-
-  // Worker thread that processes commands from queue
-  void commandWorker();
-
-  // Low-level Hamlib rigctld communication
-  bool connectToRig();
-  void disconnectFromRig();
-  bool sendCommand(const std::string &cmd, std::string &response);
-
-  // Command execution (consumer)
-  bool executeSetFreq(long long freqHz);
-  bool executeGetFreq(long long &freqHz);
-  bool executeSetMode(const std::string &mode, int passbandHz);
-  bool executeGetMode(std::string &mode, int &passbandHz);
-  bool executeSetPTT(bool on);
-
-  // Socket file descriptor
-  int sockfd_ = -1;
-
-  // Maximum queue depth (prevent memory growth)
-  static constexpr size_t MAX_QUEUE_SIZE = 100;
+  std::unique_ptr<HamlibClient> client_;
 };
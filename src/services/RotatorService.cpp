@@ -3,22 +3,15 @@
 #include "../core/OrbitPredictor.h"
 #include "../core/SatelliteManager.h"
 
-#ifdef _WIN32
-#include <winsock2.h>
-#include <ws2tcpip.h>
-#else
-#include <arpa/inet.h>
-#include <netinet/in.h>
-#include <sys/socket.h>
-#include <unistd.h>
-#endif
 #include <chrono>
-#include <cstring>
-#include <thread>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
 
 RotatorService::RotatorService(std::shared_ptr<RotatorDataStore> store,
                                const AppConfig &config, HamClockState *state)
-    : store_(std::move(store)), config_(config), state_(state) {
+    : store_(std::move(store)), config_(config),
+      health_(state ? state->services.claim("Rotator") : nullptr) {
   // Initialize predictor location
   predictor_.setObserver(config.lat, config.lon);
 }
@@ -36,10 +29,20 @@ void RotatorService::start() {
     return;
   }
 
+  client_ = std::make_unique<HamlibClient>("Rotator", config_.rotatorHost,
+                                           config_.rotatorPort);
+  client_->setPollInterval(std::chrono::milliseconds(config_.rotatorPollMs));
+  client_->setStatusHandler([this](bool connected, const std::string &why) {
+    onStatus(connected, why);
+  });
+  client_->addPoll("p", [this](const HamlibClient::Reply &r) {
+    onPosition(r);
+  });
+
   running_ = true;
-  pollThread_ = std::thread(&RotatorService::pollLoop, this);
-  LOG_I("Rotator", "Service started ({}:{})", config_.rotatorHost,
-        config_.rotatorPort);
+  client_->start();
+  LOG_I("Rotator", "Service started ({}:{}, polling every {} ms)",
+        config_.rotatorHost, config_.rotatorPort, config_.rotatorPollMs);
 #endif
 }
 
@@ -49,11 +52,7 @@ void RotatorService::stop() {
     return;
 
   running_ = false;
-  disconnectFromRotator();
-
-  if (pollThread_.joinable()) {
-    pollThread_.join();
-  }
+  client_->stop();
 
   LOG_I("Rotator", "Service stopped");
 #endif
@@ -66,7 +65,6 @@ RotatorData RotatorService::getPosition() const {
   }
 #endif
   return RotatorData{};
-  return RotatorData{};
 }
 
 void RotatorService::autoTrack(const Satellite *sat) {
@@ -104,332 +102,118 @@ bool RotatorService::getAutoTrackEnabled() const {
 }
 
 bool RotatorService::setPosition(double azimuth, double elevation) {
-#ifndef __EMSCRIPTEN__
-  if (!connected_) {
-    LOG_W("Rotator", "Cannot set position: not connected");
+  char cmd[64];
+  std::snprintf(cmd, sizeof(cmd), "P %.1f %.1f", azimuth, elevation);
+  if (!sendMove(cmd))
     return false;
-  }
-
-  bool success = setAzEl(azimuth, elevation);
-
-  if (success) {
-    LOG_I("Rotator", "Position command sent: Az={:.1f} El={:.1f}", azimuth,
-          elevation);
-
-    // Update moving flag in store
-    RotatorData data = store_->get();
-    data.moving = true;
-    store_->set(data);
-  } else {
-    LOG_E("Rotator", "Failed to set position");
-  }
-
-  return success;
-#else
-  (void)azimuth;
-  (void)elevation;
-  return false;
-#endif
+  LOG_I("Rotator", "Position command queued: Az={:.1f} El={:.1f}", azimuth,
+        elevation);
+  return true;
 }
 
 bool RotatorService::stopRotator() {
-#ifndef __EMSCRIPTEN__
-  if (!connected_) {
-    LOG_W("Rotator", "Cannot stop: not connected");
+  // Same key as P, so a stop drops any move still waiting to go out
+  if (!sendMove("S"))
     return false;
-  }
-
-  std::string response;
-  bool success = sendCommand("S\n", response);
-
-  if (success) {
-    LOG_I("Rotator", "Stop command sent");
-
-    // Update moving flag
-    RotatorData data = store_->get();
-    data.moving = false;
-    store_->set(data);
-  }
-
-  return success;
-#else
-  return false;
-#endif
-}
-
-bool RotatorService::isConnected() const {
-#ifndef __EMSCRIPTEN__
-  return connected_.load();
-#else
-  return false;
-#endif
-}
-
-void RotatorService::pollLoop() {
-#ifndef __EMSCRIPTEN__
-  using namespace std::chrono_literals;
-
-  while (running_) {
-    // Try to connect if not connected
-    if (!connected_) {
-      if (connectToRotator()) {
-        LOG_I("Rotator", "Connected to rotctld");
-        connected_ = true;
-
-        if (state_) {
-          state_->services["Rotator"].ok = true;
-          state_->services["Rotator"].lastError = "";
-        }
-      } else {
-        // Connection failed, retry after delay
-        if (state_) {
-          state_->services["Rotator"].ok = false;
-          state_->services["Rotator"].lastError = "Connection failed";
-        }
-        std::this_thread::sleep_for(5s);
-        continue;
-      }
-    }
-
-    // Poll rotator position
-    double az = 0, el = 0;
-    if (getAzEl(az, el)) {
-      RotatorData data;
-      data.azimuth = az;
-      data.elevation = el;
-      data.connected = true;
-      data.moving = false; // Will be set by movement detection or commands
-      data.lastUpdate = std::chrono::system_clock::now();
-      data.valid = true;
-
-      store_->set(data);
-
-      if (state_) {
-        state_->services["Rotator"].ok = true;
-        state_->services["Rotator"].lastSuccess =
-            std::chrono::system_clock::now();
-        state_->services["Rotator"].lastError = "";
-      }
-    } else {
-      // Read failed, disconnect and retry
-      LOG_W("Rotator", "Position query failed, reconnecting...");
-      disconnectFromRotator();
-      connected_ = false;
-
-      if (state_) {
-        state_->services["Rotator"].ok = false;
-        state_->services["Rotator"].lastError = "Position query failed";
-      }
-
-      // Mark data as invalid
-      RotatorData data = store_->get();
-      data.connected = false;
-      data.valid = false;
-      store_->set(data);
-
-      std::this_thread::sleep_for(5s);
-      continue;
-    }
-
-    // Poll every 1000ms (1 Hz update rate)
-    std::this_thread::sleep_for(1000ms);
-
-    // Auto-tracking Loop
-    if (connected_) {
-      std::lock_guard<std::mutex> lock(trackMutex_);
-      if (autoTracking_ && currentSat_) {
-        SatObservation obs = currentSat_->predict();
-
-        // Only track if visible (elevation > 0)
-        if (obs.elevation > 0) {
-          RotatorData current = store_->get();
-          double azErr = std::abs(obs.azimuth - current.azimuth);
-          double elErr = std::abs(obs.elevation - current.elevation);
-
-          // Handle 360 wrap-around for azimuth error
-          if (azErr > 180.0)
-            azErr = 360.0 - azErr;
-
-          // Deadband: 2.0 degrees
-          if (azErr > 2.0 || elErr > 2.0) {
-            if (setAzEl(obs.azimuth, obs.elevation)) {
-              // Update store moving state
-              current.moving = true;
-              store_->set(current);
-            }
-          }
-        }
-      }
-    }
-  }
-
-  disconnectFromRotator();
-#endif
+  LOG_I("Rotator", "Stop command queued");
+  return true;
 }
 
-bool RotatorService::connectToRotator() {
+bool RotatorService::sendMove(const std::string &cmd) {
 #ifndef __EMSCRIPTEN__
-  // Create TCP socket
-  sockfd_ = socket(AF_INET, SOCK_STREAM, 0);
-  if (sockfd_ < 0) {
-    LOG_E("Rotator", "Failed to create socket: {}", strerror(errno));
+  if (!isConnected()) {
+    LOG_W("Rotator", "Cannot send '{}': not connected", cmd);
     return false;
   }
-
-  // Set socket timeout
-#ifdef _WIN32
-  DWORD timeout_ms = 2000;
-  setsockopt(sockfd_, SOL_SOCKET, SO_RCVTIMEO, (const char *)&timeout_ms,
-             sizeof(timeout_ms));
-  setsockopt(sockfd_, SOL_SOCKET, SO_SNDTIMEO, (const char *)&timeout_ms,
-             sizeof(timeout_ms));
-#else
-  struct timeval timeout;
-  timeout.tv_sec = 2;
-  timeout.tv_usec = 0;
-  setsockopt(sockfd_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
-  setsockopt(sockfd_, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
-#endif
-
-  // Connect to rotctld
-  struct sockaddr_in addr;
-  std::memset(&addr, 0, sizeof(addr));
-  addr.sin_family = AF_INET;
-  addr.sin_port = htons(config_.rotatorPort);
-
-  if (inet_pton(AF_INET, config_.rotatorHost.c_str(), &addr.sin_addr) <= 0) {
-    LOG_E("Rotator", "Invalid address: {}", config_.rotatorHost);
-#ifdef _WIN32
-    closesocket(sockfd_);
-#else
-    close(sockfd_);
-#endif
-    sockfd_ = -1;
-    return false;
-  }
-
-  if (connect(sockfd_, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
-    LOG_E("Rotator", "Connection failed: {}", strerror(errno));
-#ifdef _WIN32
-    closesocket(sockfd_);
-#else
-    close(sockfd_);
-#endif
-    sockfd_ = -1;
-    return false;
-  }
-
+  client_->set("move", cmd, [cmd](const HamlibClient::Reply &r) {
+    if (!r.ok())
+      LOG_W("Rotator", "'{}' returned RPRT {}", cmd, r.rprt);
+  });
   return true;
 #else
+  (void)cmd;
   return false;
 #endif
 }
 
-void RotatorService::disconnectFromRotator() {
+bool RotatorService::isConnected() const {
 #ifndef __EMSCRIPTEN__
-  if (sockfd_ >= 0) {
-#ifdef _WIN32
-    closesocket(sockfd_);
+  return client_ && client_->isConnected();
 #else
-    close(sockfd_);
-#endif
-    sockfd_ = -1;
-  }
-  connected_ = false;
+  return false;
 #endif
 }
 
-bool RotatorService::sendCommand(const std::string &cmd,
-                                 std::string &response) {
-#ifndef __EMSCRIPTEN__
-  if (sockfd_ < 0) {
-    return false;
+void RotatorService::onStatus(bool connected, const std::string &why) {
+  if (health_) {
+    if (connected)
+      health_->markOk(why);
+    else
+      health_->markFailed(why);
   }
-
-  // Send command
-  ssize_t sent = send(sockfd_, cmd.c_str(), cmd.length(), 0);
-  if (sent < 0) {
-    LOG_E("Rotator", "Send failed: {}", strerror(errno));
-    return false;
+  if (!connected) {
+    RotatorData data = store_->get();
+    data.connected = false;
+    data.valid = false;
+    data.moving = false;
+    store_->set(data);
   }
+}
 
-  // Read response
-  char buffer[256];
-  std::memset(buffer, 0, sizeof(buffer));
-  ssize_t received = recv(sockfd_, buffer, sizeof(buffer) - 1, 0);
-
-  if (received <= 0) {
-    LOG_E("Rotator", "Receive failed: {}", strerror(errno));
-    return false;
-  }
+void RotatorService::onPosition(const HamlibClient::Reply &reply) {
+  if (health_)
+    health_->recordFetch(reply.latency, 0);
+  if (!reply.ok())
+    return;
 
-  response = std::string(buffer, received);
-  return true;
-#else
-  (void)cmd;
-  (void)response;
-  return false;
-#endif
-}
+  RotatorData prev = store_->get();
+  RotatorData data;
+  data.azimuth = std::strtod(reply.value("Azimuth").c_str(), nullptr);
+  data.elevation = std::strtod(reply.value("Elevation").c_str(), nullptr);
+  data.connected = true;
+  // Moving while the position still changes between polls
+  data.moving = prev.valid &&
+                (std::abs(data.azimuth - prev.azimuth) > kMovingEpsilonDeg ||
+                 std::abs(data.elevation - prev.elevation) > kMovingEpsilonDeg);
+  data.lastUpdate = std::chrono::system_clock::now();
+  data.valid = true;
+  store_->set(data);
 
-bool RotatorService::getAzEl(double &az, double &el) {
-#ifndef __EMSCRIPTEN__
-  // Send 'p' command to get position
-  std::string response;
-  if (!sendCommand("p\n", response)) {
-    return false;
-  }
+  if (health_)
+    health_->markOk();
 
-  // Parse response: "Azimuth: XXX.X\nElevation: YYY.Y\n" or just
-  // "XXX.X\nYYY.Y\n" Hamlib rotctld returns: "Azimuth\nElevation\n" for 'p'
-  // command
-  double azVal = 0, elVal = 0;
+  // Each step samples the pass cache, so stepping at the poll rate costs no
+  // SGP4 work.
+  autoTrackStep();
+}
 
-  // Try simple format first (most common)
-  if (std::sscanf(response.c_str(), "%lf\n%lf", &azVal, &elVal) == 2) {
-    az = azVal;
-    el = elVal;
-    return true;
-  }
+void RotatorService::autoTrackStep() {
+  std::lock_guard<std::mutex> lock(trackMutex_);
+  if (!autoTracking_ || !currentSat_)
+    return;
 
-  // Try verbose format
-  if (std::sscanf(response.c_str(), "Azimuth: %lf\nElevation: %lf", &azVal,
-                  &elVal) == 2) {
-    az = azVal;
-    el = elVal;
-    return true;
-  }
+  // Aim slightly ahead of the satellite to cover the rotator's slew lag.
+  auto now = std::chrono::system_clock::now();
+  double utc = std::chrono::duration<double>(now.time_since_epoch()).count();
+  SatObservation obs = currentSat_->track(utc + kLeadSeconds);
 
-  LOG_W("Rotator", "Failed to parse position response: {}", response);
-  return false;
-#else
-  (void)az;
-  (void)el;
-  return false;
-#endif
-}
+  // Only track if visible (elevation > 0)
+  if (obs.elevation <= 0)
+    return;
 
-bool RotatorService::setAzEl(double az, double el) {
-#ifndef __EMSCRIPTEN__
-  // Send 'P' command to set position
-  char cmd[64];
-  std::snprintf(cmd, sizeof(cmd), "P %.1f %.1f\n", az, el);
+  RotatorData current = store_->get();
+  double azErr = std::abs(obs.azimuth - current.azimuth);
+  double elErr = std::abs(obs.elevation - current.elevation);
 
-  std::string response;
-  if (!sendCommand(cmd, response)) {
-    return false;
-  }
+  // Handle 360 wrap-around for azimuth error
+  if (azErr > 180.0)
+    azErr = 360.0 - azErr;
 
-  // Check for "RPRT 0" (success) in response
-  if (response.find("RPRT 0") != std::string::npos || response.empty()) {
-    return true;
+  // Deadband: 2.0 degrees
+  if (azErr > 2.0 || elErr > 2.0) {
+    char cmd[64];
+    std::snprintf(cmd, sizeof(cmd), "P %.1f %.1f", obs.azimuth,
+                  obs.elevation);
+    sendMove(cmd);
   }
-
-  LOG_W("Rotator", "Set position returned: {}", response);
-  return false;
-#else
-  (void)az;
-  (void)el;
-  return false;
-#endif
 }
@@ -4,22 +4,24 @@
 #include "../core/HamClockState.h"
 #include "../core/OrbitPredictor.h"
 #include "../core/RotatorData.h"
+#include "HamlibClient.h"
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <string>
-#include <thread>
 
 class Satellite; // Forward declaration
 
-// Service for interfacing with Hamlib rotctld daemon
-// Implements async polling and position control via TCP
+// Service for interfacing with Hamlib rotctld daemon. Position is polled
+// through HamlibClient; move commands share its connection and supersede
+// each other, so only the newest target is ever queued.
 class RotatorService {
 public:
   RotatorService(std::shared_ptr<RotatorDataStore> store,
                  const AppConfig &config, HamClockState *state = nullptr);
   ~RotatorService();
 
-  // Start/stop background polling thread
+  // Start/stop the rotctld connection
   void start();
   void stop();
 
@@ -48,10 +50,10 @@ public:
 private:
   std::shared_ptr<RotatorDataStore> store_;
   const AppConfig &config_;
-  HamClockState *state_;
+  ServiceSlot *health_ = nullptr;
 
   std::atomic<bool> running_{false};
-  std::thread pollThread_;
+  std::unique_ptr<HamlibClient> client_;
 
   // Auto-tracking state
   mutable std::mutex trackMutex_;
@@ -61,17 +63,12 @@ private:
       predictor_; // Legacy: keeping for now to avoid breaking existing code
   SatelliteTLE currentTle_; // Legacy
 
-  // Background polling loop
-  void pollLoop();
+  // Position poll reply, on the client's I/O thread
+  void onPosition(const HamlibClient::Reply &reply);
+  void onStatus(bool connected, const std::string &why);
+  void autoTrackStep();
+  bool sendMove(const std::string &cmd);
 
-  // Low-level Hamlib rotctld communication
-  bool connectToRotator();
-  void disconnectFromRotator();
-  bool sendCommand(const std::string &cmd, std::string &response);
-  bool getAzEl(double &az, double &el);
-  bool setAzEl(double az, double el);
-
-  // Socket file descriptor
-  int sockfd_ = -1;
-  std::atomic<bool> connected_{false};
+  static constexpr double kLeadSeconds = 1.0;
+  static constexpr double kMovingEpsilonDeg = 0.05;
 };
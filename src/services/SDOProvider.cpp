@@ -1,17 +1,217 @@
 #include "SDOProvider.h"
+#include "../core/Astronomy.h"
+#include "../core/Logger.h"
+
+#include <SDL.h>
+#include <SDL_image.h>
+#include <algorithm>
+#include <cctype>
 #include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace {
+
+constexpr const char *kBrowseBase = "https://sdo.gsfc.nasa.gov/assets/img/browse/";
+// Archive frames never change once published.
+constexpr int kFrameCacheAge = 24 * 3600;
+constexpr int kIndexCacheAge = 15 * 60;
+
+std::string browseDir(std::time_t t) {
+  std::tm tm{};
+  Astronomy::portable_gmtime(&t, &tm);
+  char buf[16];
+  std::snprintf(buf, sizeof(buf), "%04d/%02d/%02d/", tm.tm_year + 1900,
+                tm.tm_mon + 1, tm.tm_mday);
+  return kBrowseBase + std::string(buf);
+}
+
+// Frames of one wavelength in a browse directory listing, keyed by time.
+// Names look like "20260117_134505_512_0193.jpg".
+void scanIndex(const std::string &body, const std::string &wavelength,
+               const std::string &dir,
+               std::map<std::time_t, std::string> &out) {
+  const std::string suffix = "_512_" + wavelength + ".jpg";
+  constexpr size_t kStampLen = 15; // YYYYMMDD_HHMMSS
+  for (size_t pos = body.find(suffix); pos != std::string::npos;
+       pos = body.find(suffix, pos + suffix.size())) {
+    if (pos < kStampLen)
+      continue;
+    const char *s = body.c_str() + pos - kStampLen;
+    std::tm tm{};
+    char sep = 0;
+    if (std::sscanf(s, "%4d%2d%2d%c%2d%2d%2d", &tm.tm_year, &tm.tm_mon,
+                    &tm.tm_mday, &sep, &tm.tm_hour, &tm.tm_min,
+                    &tm.tm_sec) != 7 ||
+        sep != '_' || !std::isdigit(static_cast<unsigned char>(s[0])))
+      continue;
+    tm.tm_year -= 1900;
+    tm.tm_mon -= 1;
+    out[Astronomy::portable_timegm(&tm)] =
+        dir + std::string(s, kStampLen) + suffix;
+  }
+}
+
+} // namespace
 
 SDOProvider::SDOProvider(NetworkManager &net) : net_(net) {}
 
-void SDOProvider::fetch(const std::string &wavelength, DataCb cb) {
+void SDOProvider::fetchLatest(const std::string &wavelength, int sizePx,
+                              FrameCb cb, const CancelToken &token) {
   char url[256];
   std::snprintf(url, sizeof(url),
                 "https://sdo.gsfc.nasa.gov/assets/img/latest/latest_512_%s.jpg",
                 wavelength.c_str());
+  fetchFrame(url, wavelength, std::chrono::system_clock::now(), sizePx,
+             std::move(cb), token);
+}
+
+void SDOProvider::fetchRecent(
+    const std::string &wavelength, int count, int sizePx,
+    std::vector<std::chrono::system_clock::time_point> have, FrameCb cb,
+    const CancelToken &token) {
+  // The span may reach back into yesterday's directory.
+  std::time_t now = std::time(nullptr);
+  std::time_t from =
+      now - std::chrono::duration_cast<std::chrono::seconds>(kFrameSpacing)
+                    .count() *
+                (count + 1);
+  std::vector<std::string> dirs = {browseDir(now)};
+  if (browseDir(from) != dirs[0])
+    dirs.push_back(browseDir(from));
+
+  struct Listing {
+    std::mutex mutex;
+    std::map<std::time_t, std::string> frames;
+    size_t pending = 0;
+  };
+  auto listing = std::make_shared<Listing>();
+  listing->pending = dirs.size();
+
+  for (const auto &dir : dirs) {
+    net_.fetchAsync(
+        dir,
+        [this, listing, dir, wavelength, count, sizePx, have, cb,
+         token](std::string body) {
+          std::map<std::time_t, std::string> frames;
+          {
+            std::lock_guard<std::mutex> lock(listing->mutex);
+            scanIndex(body, wavelength, dir, listing->frames);
+            if (--listing->pending > 0)
+              return;
+            frames.swap(listing->frames);
+          }
+          if (token.cancelled())
+            return;
+
+          // The first frame in each kFrameSpacing slice of the clock. Later
+          // frames never displace it, so a refresh picks the frames it
+          // picked last time plus whatever is new.
+          auto spacing =
+              std::chrono::duration_cast<std::chrono::seconds>(kFrameSpacing)
+                  .count();
+          std::map<std::time_t, std::pair<std::time_t, std::string>> slices;
+          for (const auto &[t, url] : frames)
+            slices.emplace(t / spacing, std::make_pair(t, url));
+
+          int picked = 0, fetched = 0;
+          for (auto it = slices.rbegin(); it != slices.rend() && picked < count;
+               ++it, ++picked) {
+            auto time =
+                std::chrono::system_clock::from_time_t(it->second.first);
+            if (std::find(have.begin(), have.end(), time) != have.end())
+              continue;
+            fetchFrame(it->second.second, wavelength, time, sizePx, cb, token);
+            ++fetched;
+          }
+          LOG_D("SDO", "{} of {} archive frames picked for {}, {} new", picked,
+                frames.size(), wavelength, fetched);
+        },
+        kIndexCacheAge);
+  }
+}
+
+void SDOProvider::fetchFrame(const std::string &url,
+                             const std::string &wavelength,
+                             std::chrono::system_clock::time_point time,
+                             int sizePx, FrameCb cb, const CancelToken &token) {
+  net_.fetchAsync(
+      url,
+      [wavelength, time, sizePx, cb, token](std::string body) {
+        if (body.empty() || token.cancelled())
+          return;
+        WorkerService::getInstance().submitThen(
+            [body = std::move(body), wavelength, time, sizePx]() {
+              SDOFrame frame = decode(body, sizePx);
+              frame.wavelength = wavelength;
+              frame.time = time;
+              return frame;
+            },
+            [cb](SDOFrame frame) {
+              if (!frame.pixels.empty())
+                cb(std::move(frame));
+            },
+            TaskPriority::Background, token);
+      },
+      kFrameCacheAge);
+}
+
+SDOFrame SDOProvider::decode(const std::string &jpeg, int sizePx) {
+  SDOFrame frame;
+  SDL_RWops *rw = SDL_RWFromConstMem(jpeg.data(), static_cast<int>(jpeg.size()));
+  if (!rw)
+    return frame;
+  SDL_Surface *loaded = IMG_Load_RW(rw, 1);
+  if (!loaded) {
+    LOG_W("SDO", "Image decode failed: {}", IMG_GetError());
+    return frame;
+  }
+  SDL_Surface *src = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+  SDL_FreeSurface(loaded);
+  if (!src)
+    return frame;
+
+  // Square crop of the centre; SDO images are square anyway.
+  int side = std::min(src->w, src->h);
+  int ox = (src->w - side) / 2;
+  int oy = (src->h - side) / 2;
+  int dst = std::clamp(sizePx, 1, side);
 
-  net_.fetchAsync(url, [cb](std::string body) {
-    if (!body.empty()) {
-      cb(body);
+  // Area average: each output pixel is the mean of the source pixels it
+  // covers, which keeps the fine coronal structure from aliasing.
+  frame.size = dst;
+  frame.pixels.resize(static_cast<size_t>(dst) * dst);
+  const uint8_t *base = static_cast<const uint8_t *>(src->pixels);
+  for (int dy = 0; dy < dst; ++dy) {
+    int y0 = oy + dy * side / dst;
+    int y1 = std::max(y0 + 1, oy + (dy + 1) * side / dst);
+    for (int dx = 0; dx < dst; ++dx) {
+      int x0 = ox + dx * side / dst;
+      int x1 = std::max(x0 + 1, ox + (dx + 1) * side / dst);
+      uint32_t r = 0, g = 0, b = 0, n = 0;
+      for (int y = y0; y < y1; ++y) {
+        const uint8_t *p = base + y * src->pitch + x0 * 4;
+        for (int x = x0; x < x1; ++x, p += 4) {
+          r += p[0];
+          g += p[1];
+          b += p[2];
+          ++n;
+        }
+      }
+      uint8_t R = static_cast<uint8_t>(r / n);
+      uint8_t G = static_cast<uint8_t>(g / n);
+      uint8_t B = static_cast<uint8_t>(b / n);
+      uint8_t A = std::max({R, G, B});
+      // RGBA32 is R,G,B,A in memory order on either endianness.
+      uint8_t *out =
+          reinterpret_cast<uint8_t *>(&frame.pixels[dy * dst + dx]);
+      out[0] = R;
+      out[1] = G;
+      out[2] = B;
+      out[3] = A;
     }
-  });
+  }
+  SDL_FreeSurface(src);
+  return frame;
 }
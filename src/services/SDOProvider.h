@@ -1,18 +1,51 @@
 #pragma once
 
+#include "../core/WorkerService.h"
 #include "../network/NetworkManager.h"
+#include <chrono>
+#include <cstdint>
 #include <functional>
 #include <string>
+#include <vector>
+
+// A decoded SDO image, ready to upload: size x size RGBA32 pixels with the
+// alpha taken from brightness, so the disc blends over any background.
+struct SDOFrame {
+  std::string wavelength;
+  std::chrono::system_clock::time_point time;
+  int size = 0;
+  std::vector<uint32_t> pixels;
+};
 
 class SDOProvider {
 public:
-  using DataCb = std::function<void(const std::string &data)>;
+  // Runs on the main thread, once per decoded frame.
+  using FrameCb = std::function<void(SDOFrame frame)>;
 
   SDOProvider(NetworkManager &net);
 
-  // Fetch latest SDO image (wavelength 0193, 304, etc)
-  void fetch(const std::string &wavelength, DataCb cb);
+  // The latest image of a wavelength (0193, 0304, ...), scaled to sizePx.
+  void fetchLatest(const std::string &wavelength, int sizePx, FrameCb cb,
+                   const CancelToken &token);
+
+  // Up to count recent images of a wavelength, one per kFrameSpacing slice
+  // of the clock, so repeated calls pick the same archive frames. Frames
+  // whose time is in `have` are not fetched again. The rest are delivered
+  // as they decode, not in time order.
+  void fetchRecent(const std::string &wavelength, int count, int sizePx,
+                   std::vector<std::chrono::system_clock::time_point> have,
+                   FrameCb cb, const CancelToken &token);
+
+  // Decode a JPEG, derive alpha from brightness and area-average it down
+  // to sizePx square. Empty pixels on failure. Safe on any thread.
+  static SDOFrame decode(const std::string &jpeg, int sizePx);
+
+  static constexpr auto kFrameSpacing = std::chrono::minutes(15);
 
 private:
+  void fetchFrame(const std::string &url, const std::string &wavelength,
+                  std::chrono::system_clock::time_point time, int sizePx,
+                  FrameCb cb, const CancelToken &token);
+
   NetworkManager &net_;
 };
@@ -3,10 +3,13 @@
 #include "../core/WorkerService.h"
 #include <SDL.h>
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstring>
 #include <ctime>
 #include <cstdio>
+#include <future>
+#include <unordered_map>
 
 // ---------------------------------------------------------------------------
 // GRIB2 binary helpers (big-endian)
@@ -24,6 +27,12 @@ static inline uint64_t u64be(const uint8_t* p) {
 static inline int16_t i16be(const uint8_t* p) {
     return (int16_t)u16be(p);
 }
+// GRIB2 signed integers are sign-magnitude, not two's complement.
+static inline int32_t i32be(const uint8_t* p) {
+    uint32_t u = u32be(p);
+    int32_t  m = (int32_t)(u & 0x7FFFFFFFu);
+    return (u & 0x80000000u) ? -m : m;
+}
 static inline float ieee754be(const uint8_t* p) {
     uint32_t u = u32be(p);
     float f;
@@ -48,271 +57,315 @@ static uint32_t readBits(const uint8_t* data, size_t bitOffset, int n) {
 // GRIB2 decoder — Template 5.0 (simple), 5.2 (complex), 5.3 (complex+spatial)
 // ---------------------------------------------------------------------------
 
-bool WxMbProvider::decodeGFS(const std::vector<uint8_t>& data,
-                              GribField& out_prmsl,
-                              GribField& out_ugrd,
-                              GribField& out_vgrd) {
-    int decoded = 0;
-    size_t pos  = 0;
-
-    while (pos + 16 <= data.size() && decoded < 3) {
-        if (data[pos]!='G'||data[pos+1]!='R'||data[pos+2]!='I'||data[pos+3]!='B') {
-            ++pos; continue;
-        }
-        if (data[pos + 7] != 2) { pos += 4; continue; }
-
-        uint64_t msgLen = u64be(data.data() + pos + 8);
-        if (msgLen < 16 || pos + msgLen > data.size()) break;
-
-        size_t  msgEnd    = pos + msgLen;
-        size_t  secPos    = pos + 16;
-        uint8_t discipline = data[pos + 6];
-
-        int      nx = 0, ny = 0;
-        uint8_t  paramCat = 255, paramNum = 255;
-        float    R = 0.0f;
-        int16_t  E = 0, D = 0;
-        uint8_t  nBits = 0;
-        uint32_t nValues = 0;
-        bool     hasBitmap = false;
-        bool     got3=false, got4=false, got5=false, got6=false;
-
-        enum PackType : uint8_t { PACK_NONE, PACK_SIMPLE, PACK_COMPLEX, PACK_COMPLEX_SPATIAL };
-        PackType packType = PACK_NONE;
-        uint8_t  missingMgmt     = 0;
-        uint32_t nGroups         = 0;
-        uint8_t  refGroupWidth   = 0;
-        uint8_t  bitsGroupWidth  = 0;
-        uint32_t refGroupLength  = 0;
-        uint8_t  lengthIncrement = 1;
-        uint32_t trueLastLength  = 0;
-        uint8_t  bitsGroupLength = 0;
-        uint8_t  spatialOrder    = 0;
-        uint8_t  octetsExtra     = 0;
-
-        while (secPos + 5 <= msgEnd) {
-            if (secPos + 4 <= msgEnd &&
-                data[secPos]=='7' && data[secPos+1]=='7' &&
-                data[secPos+2]=='7' && data[secPos+3]=='7') break;
-
-            uint32_t secLen = u32be(data.data() + secPos);
-            uint8_t  secNum = data[secPos + 4];
-            if (secLen < 5 || secPos + secLen > msgEnd) break;
-
-            const uint8_t* body    = data.data() + secPos + 5;
-            size_t         bodyLen = secLen - 5;
-
-            switch (secNum) {
-            case 1: case 2: break;
-
-            case 3:
-                if (bodyLen >= 34 && u16be(body + 7) == 0) {
-                    nx = (int)u32be(body + 25);
-                    ny = (int)u32be(body + 29);
-                    got3 = (nx > 0 && ny > 0);
+enum GfsField { FIELD_NONE = -1, FIELD_PRMSL, FIELD_UGRD, FIELD_VGRD };
+
+// Decode one GRIB2 message (msg points at "GRIB") into out.
+static GfsField decodeMessage(const uint8_t* msg, size_t msgLen, GribField& out) {
+    size_t  secPos     = 16;
+    uint8_t discipline = msg[6];
+
+    int      nx = 0, ny = 0;
+    uint8_t  paramCat = 255, paramNum = 255;
+    float    R = 0.0f;
+    int16_t  E = 0, D = 0;
+    uint8_t  nBits = 0;
+    uint32_t nValues = 0;
+    bool     hasBitmap = false;
+    bool     got3=false, got4=false, got5=false, got6=false;
+
+    enum PackType : uint8_t { PACK_NONE, PACK_SIMPLE, PACK_COMPLEX, PACK_COMPLEX_SPATIAL };
+    PackType packType = PACK_NONE;
+    uint8_t  missingMgmt     = 0;
+    uint32_t nGroups         = 0;
+    uint8_t  refGroupWidth   = 0;
+    uint8_t  bitsGroupWidth  = 0;
+    uint32_t refGroupLength  = 0;
+    uint8_t  lengthIncrement = 1;
+    uint32_t trueLastLength  = 0;
+    uint8_t  bitsGroupLength = 0;
+    uint8_t  spatialOrder    = 0;
+    uint8_t  octetsExtra     = 0;
+
+    while (secPos + 5 <= msgLen) {
+        if (secPos + 4 <= msgLen &&
+            msg[secPos]=='7' && msg[secPos+1]=='7' &&
+            msg[secPos+2]=='7' && msg[secPos+3]=='7') break;
+
+        uint32_t secLen = u32be(msg + secPos);
+        uint8_t  secNum = msg[secPos + 4];
+        if (secLen < 5 || secPos + secLen > msgLen) break;
+
+        const uint8_t* body    = msg + secPos + 5;
+        size_t         bodyLen = secLen - 5;
+
+        switch (secNum) {
+        case 1: case 2: break;
+
+        case 3:
+            if (bodyLen >= 67 && u16be(body + 7) == 0) {
+                nx = (int)u32be(body + 25);
+                ny = (int)u32be(body + 29);
+                got3 = (nx > 1 && ny > 1);
+                if (got3) {
+                    // Grid corners in micro-degrees (Template 3.0)
+                    double la1 = i32be(body + 41) * 1e-6;
+                    double lo1 = i32be(body + 45) * 1e-6;
+                    double la2 = i32be(body + 50) * 1e-6;
+                    double lo2 = i32be(body + 54) * 1e-6;
+                    double span = std::fmod(lo2 - lo1 + 360.0, 360.0);
+                    out.lat0 = la1;
+                    out.lon0 = lo1;
+                    out.dlat = (la2 - la1) / (ny - 1);
+                    out.dlon = span / (nx - 1);
                 }
-                break;
+            }
+            break;
 
-            case 4:
-                if (bodyLen >= 6) {
-                    paramCat = body[4];
-                    paramNum = body[5];
-                    got4 = true;
-                }
-                break;
-
-            case 5:
-                if (bodyLen >= 15) {
-                    nValues       = u32be(body + 0);
-                    uint16_t tmpl = u16be(body + 4);
-                    R     = ieee754be(body + 6);
-                    E     = i16be(body + 10);
-                    D     = i16be(body + 12);
-                    nBits = body[14];
-                    if (tmpl == 0) {
-                        packType = PACK_SIMPLE;
-                        got5 = true;
-                    } else if ((tmpl == 2 || tmpl == 3) && bodyLen >= 42) {
-                        missingMgmt     = body[17];
-                        nGroups         = u32be(body + 26);
-                        refGroupWidth   = body[30];
-                        bitsGroupWidth  = body[31];
-                        refGroupLength  = u32be(body + 32);
-                        lengthIncrement = body[36] ? body[36] : 1;
-                        trueLastLength  = u32be(body + 37);
-                        bitsGroupLength = body[41];
-                        if (tmpl == 3 && bodyLen >= 44) {
-                            spatialOrder = body[42];
-                            octetsExtra  = body[43];
-                        }
-                        packType = (tmpl == 3) ? PACK_COMPLEX_SPATIAL : PACK_COMPLEX;
-                        got5 = true;
+        case 4:
+            if (bodyLen >= 6) {
+                paramCat = body[4];
+                paramNum = body[5];
+                got4 = true;
+            }
+            break;
+
+        case 5:
+            if (bodyLen >= 15) {
+                nValues       = u32be(body + 0);
+                uint16_t tmpl = u16be(body + 4);
+                R     = ieee754be(body + 6);
+                E     = i16be(body + 10);
+                D     = i16be(body + 12);
+                nBits = body[14];
+                if (tmpl == 0) {
+                    packType = PACK_SIMPLE;
+                    got5 = true;
+                } else if ((tmpl == 2 || tmpl == 3) && bodyLen >= 42) {
+                    missingMgmt     = body[17];
+                    nGroups         = u32be(body + 26);
+                    refGroupWidth   = body[30];
+                    bitsGroupWidth  = body[31];
+                    refGroupLength  = u32be(body + 32);
+                    lengthIncrement = body[36] ? body[36] : 1;
+                    trueLastLength  = u32be(body + 37);
+                    bitsGroupLength = body[41];
+                    if (tmpl == 3 && bodyLen >= 44) {
+                        spatialOrder = body[42];
+                        octetsExtra  = body[43];
                     }
+                    packType = (tmpl == 3) ? PACK_COMPLEX_SPATIAL : PACK_COMPLEX;
+                    got5 = true;
                 }
-                break;
+            }
+            break;
 
-            case 6:
-                if (bodyLen >= 1) {
-                    hasBitmap = (body[0] == 0);
-                    got6 = true;
-                }
-                break;
-
-            case 7:
-                if (got3 && got4 && got5 && got6 && !hasBitmap) {
-                    GribField field;
-                    field.nx = nx;
-                    field.ny = ny;
-                    size_t count = (size_t)nx * ny;
-                    if (nValues > 0) count = std::min(count, (size_t)nValues);
-
-                    if (packType == PACK_SIMPLE && nBits > 0) {
-                        count = std::min(count, (bodyLen * 8) / nBits);
-                        field.values.resize(count);
-                        double s2E  = std::pow(2.0, (double)E);
-                        double s10D = std::pow(10.0, (double)D);
-                        for (size_t i = 0; i < count; ++i) {
-                            uint32_t raw = readBits(body, i * nBits, nBits);
-                            field.values[i] = (float)((R + raw * s2E) / s10D);
-                        }
+        case 6:
+            if (bodyLen >= 1) {
+                hasBitmap = (body[0] == 0);
+                got6 = true;
+            }
+            break;
+
+        case 7:
+            if (got3 && got4 && got5 && got6 && !hasBitmap) {
+                GribField& field = out;
+                field.nx = nx;
+                field.ny = ny;
+                size_t count = (size_t)nx * ny;
+                if (nValues > 0) count = std::min(count, (size_t)nValues);
+
+                if (packType == PACK_SIMPLE && nBits > 0) {
+                    count = std::min(count, (bodyLen * 8) / nBits);
+                    field.values.resize(count);
+                    double s2E  = std::pow(2.0, (double)E);
+                    double s10D = std::pow(10.0, (double)D);
+                    for (size_t i = 0; i < count; ++i) {
+                        uint32_t raw = readBits(body, i * nBits, nBits);
+                        field.values[i] = (float)((R + raw * s2E) / s10D);
+                    }
 
-                    } else if ((packType == PACK_COMPLEX || packType == PACK_COMPLEX_SPATIAL)
-                               && nGroups > 0 && missingMgmt == 0) {
-
-                        // Extra descriptors for spatial differencing (Template 5.3)
-                        std::vector<int64_t> initVals;
-                        int64_t minDiff = 0;
-                        size_t  bitPos  = 0;
-
-                        if (packType == PACK_COMPLEX_SPATIAL
-                            && spatialOrder > 0 && octetsExtra > 0) {
-                            int    nExtra  = (int)spatialOrder + 1;
-                            size_t byteOff = 0;
-                            for (int e = 0; e < nExtra; ++e) {
-                                uint64_t val = 0;
-                                for (int b = 0; b < (int)octetsExtra; ++b)
-                                    val = (val << 8) | body[byteOff++];
-                                if (e < (int)spatialOrder) {
-                                    initVals.push_back((int64_t)val);
-                                } else {
-                                    // Sign-magnitude encoding: MSB = sign
-                                    uint64_t signBit = 1ULL << ((int)octetsExtra * 8 - 1);
-                                    if (val & signBit)
-                                        minDiff = -(int64_t)(val & ~signBit);
-                                    else
-                                        minDiff = (int64_t)val;
-                                }
+                } else if ((packType == PACK_COMPLEX || packType == PACK_COMPLEX_SPATIAL)
+                           && nGroups > 0 && missingMgmt == 0) {
+
+                    // Extra descriptors for spatial differencing (Template 5.3)
+                    std::vector<int64_t> initVals;
+                    int64_t minDiff = 0;
+                    size_t  bitPos  = 0;
+
+                    if (packType == PACK_COMPLEX_SPATIAL
+                        && spatialOrder > 0 && octetsExtra > 0) {
+                        int    nExtra  = (int)spatialOrder + 1;
+                        size_t byteOff = 0;
+                        for (int e = 0; e < nExtra; ++e) {
+                            uint64_t val = 0;
+                            for (int b = 0; b < (int)octetsExtra; ++b)
+                                val = (val << 8) | body[byteOff++];
+                            if (e < (int)spatialOrder) {
+                                initVals.push_back((int64_t)val);
+                            } else {
+                                // Sign-magnitude encoding: MSB = sign
+                                uint64_t signBit = 1ULL << ((int)octetsExtra * 8 - 1);
+                                if (val & signBit)
+                                    minDiff = -(int64_t)(val & ~signBit);
+                                else
+                                    minDiff = (int64_t)val;
                             }
-                            bitPos = byteOff * 8;
                         }
+                        bitPos = byteOff * 8;
+                    }
 
-                        // Group reference values (X1)
-                        std::vector<uint32_t> X1(nGroups, 0);
-                        if (nBits > 0) {
-                            for (uint32_t g = 0; g < nGroups; ++g) {
-                                X1[g] = readBits(body, bitPos, nBits);
-                                bitPos += nBits;
-                            }
+                    // Group reference values (X1)
+                    std::vector<uint32_t> X1(nGroups, 0);
+                    if (nBits > 0) {
+                        for (uint32_t g = 0; g < nGroups; ++g) {
+                            X1[g] = readBits(body, bitPos, nBits);
+                            bitPos += nBits;
                         }
+                    }
 
-                        // Group widths
-                        std::vector<uint32_t> W(nGroups, (uint32_t)refGroupWidth);
-                        if (bitsGroupWidth > 0) {
-                            for (uint32_t g = 0; g < nGroups; ++g) {
-                                W[g] = readBits(body, bitPos, bitsGroupWidth) + refGroupWidth;
-                                bitPos += bitsGroupWidth;
-                            }
+                    // Group widths
+                    std::vector<uint32_t> W(nGroups, (uint32_t)refGroupWidth);
+                    if (bitsGroupWidth > 0) {
+                        for (uint32_t g = 0; g < nGroups; ++g) {
+                            W[g] = readBits(body, bitPos, bitsGroupWidth) + refGroupWidth;
+                            bitPos += bitsGroupWidth;
                         }
+                    }
 
-                        // Group lengths
-                        std::vector<uint32_t> L(nGroups, refGroupLength);
-                        if (bitsGroupLength > 0) {
-                            for (uint32_t g = 0; g < nGroups; ++g) {
-                                L[g] = readBits(body, bitPos, bitsGroupLength)
-                                       * lengthIncrement + refGroupLength;
-                                bitPos += bitsGroupLength;
-                            }
+                    // Group lengths
+                    std::vector<uint32_t> L(nGroups, refGroupLength);
+                    if (bitsGroupLength > 0) {
+                        for (uint32_t g = 0; g < nGroups; ++g) {
+                            L[g] = readBits(body, bitPos, bitsGroupLength)
+                                   * lengthIncrement + refGroupLength;
+                            bitPos += bitsGroupLength;
                         }
-                        if (!L.empty()) L.back() = trueLastLength;
-
-                        uint32_t totalVals = 0;
-                        for (uint32_t g = 0; g < nGroups; ++g) totalVals += L[g];
-                        count = std::min(count, (size_t)totalVals);
-
-                        // Packed values → integers
-                        std::vector<int64_t> intVals(count);
-                        {
-                            size_t idx = 0;
-                            for (uint32_t g = 0; g < nGroups && idx < count; ++g) {
-                                uint32_t len   = L[g];
-                                uint32_t w     = W[g];
-                                uint32_t canDo = (uint32_t)std::min((size_t)len, count - idx);
-                                for (uint32_t k = 0; k < canDo; ++k, ++idx) {
-                                    if (w == 0) {
-                                        intVals[idx] = (int64_t)X1[g];
-                                    } else {
-                                        intVals[idx] = (int64_t)X1[g]
-                                            + (int64_t)readBits(body, bitPos, w);
-                                        bitPos += w;
-                                    }
+                    }
+                    if (!L.empty()) L.back() = trueLastLength;
+
+                    uint32_t totalVals = 0;
+                    for (uint32_t g = 0; g < nGroups; ++g) totalVals += L[g];
+                    count = std::min(count, (size_t)totalVals);
+
+                    // Packed values → integers
+                    std::vector<int64_t> intVals(count);
+                    {
+                        size_t idx = 0;
+                        for (uint32_t g = 0; g < nGroups && idx < count; ++g) {
+                            uint32_t len   = L[g];
+                            uint32_t w     = W[g];
+                            uint32_t canDo = (uint32_t)std::min((size_t)len, count - idx);
+                            for (uint32_t k = 0; k < canDo; ++k, ++idx) {
+                                if (w == 0) {
+                                    intVals[idx] = (int64_t)X1[g];
+                                } else {
+                                    intVals[idx] = (int64_t)X1[g]
+                                        + (int64_t)readBits(body, bitPos, w);
+                                    bitPos += w;
                                 }
-                                if (canDo < len && w > 0)
-                                    bitPos += (uint64_t)(len - canDo) * w;
-                            }
-                        }
-
-                        // Spatial un-differencing (Template 5.3)
-                        // algorithm per WMO GRIB2 spec / wgrib2 g2_unpack3.c:
-                        //   order=1: restored[0]=IV[0], restored[n]=restored[n-1]+intVals[n]+minDiff
-                        //   order=2: restored[0]=IV[0], restored[1]=IV[1],
-                        //            restored[n]=2*restored[n-1]-restored[n-2]+intVals[n]+minDiff
-                        if (packType == PACK_COMPLEX_SPATIAL
-                            && spatialOrder > 0 && !initVals.empty()) {
-                            std::vector<int64_t> restored(count, 0);
-                            if (spatialOrder == 1 && count > 0) {
-                                restored[0] = initVals[0];
-                                for (size_t i = 1; i < count; ++i)
-                                    restored[i] = restored[i-1] + intVals[i] + minDiff;
-                            } else if (spatialOrder == 2
-                                       && initVals.size() >= 2 && count >= 2) {
-                                restored[0] = initVals[0];
-                                restored[1] = initVals[1];
-                                for (size_t i = 2; i < count; ++i)
-                                    restored[i] = 2*restored[i-1] - restored[i-2]
-                                                  + intVals[i] + minDiff;
                             }
-                            intVals = std::move(restored);
+                            if (canDo < len && w > 0)
+                                bitPos += (uint64_t)(len - canDo) * w;
                         }
-
-                        // Convert to physical: (R + int * 2^E) / 10^D
-                        double s2E  = std::pow(2.0, (double)E);
-                        double s10D = std::pow(10.0, (double)D);
-                        field.values.resize(count);
-                        for (size_t i = 0; i < count; ++i)
-                            field.values[i] = (float)((R + (double)intVals[i] * s2E) / s10D);
                     }
 
-                    if (!field.values.empty()) {
-                        if (discipline == 0 && paramCat == 3 && paramNum == 1) {
-                            for (auto& v : field.values) v /= 100.0f; // Pa → hPa
-                            out_prmsl = std::move(field);
-                            ++decoded;
-                        } else if (discipline == 0 && paramCat == 2 && paramNum == 2) {
-                            out_ugrd = std::move(field);
-                            ++decoded;
-                        } else if (discipline == 0 && paramCat == 2 && paramNum == 3) {
-                            out_vgrd = std::move(field);
-                            ++decoded;
+                    // Spatial un-differencing (Template 5.3)
+                    // algorithm per WMO GRIB2 spec / wgrib2 g2_unpack3.c:
+                    //   order=1: restored[0]=IV[0], restored[n]=restored[n-1]+intVals[n]+minDiff
+                    //   order=2: restored[0]=IV[0], restored[1]=IV[1],
+                    //            restored[n]=2*restored[n-1]-restored[n-2]+intVals[n]+minDiff
+                    if (packType == PACK_COMPLEX_SPATIAL
+                        && spatialOrder > 0 && !initVals.empty()) {
+                        std::vector<int64_t> restored(count, 0);
+                        if (spatialOrder == 1 && count > 0) {
+                            restored[0] = initVals[0];
+                            for (size_t i = 1; i < count; ++i)
+                                restored[i] = restored[i-1] + intVals[i] + minDiff;
+                        } else if (spatialOrder == 2
+                                   && initVals.size() >= 2 && count >= 2) {
+                            restored[0] = initVals[0];
+                            restored[1] = initVals[1];
+                            for (size_t i = 2; i < count; ++i)
+                                restored[i] = 2*restored[i-1] - restored[i-2]
+                                              + intVals[i] + minDiff;
                         }
+                        intVals = std::move(restored);
                     }
+
+                    // Convert to physical: (R + int * 2^E) / 10^D
+                    double s2E  = std::pow(2.0, (double)E);
+                    double s10D = std::pow(10.0, (double)D);
+                    field.values.resize(count);
+                    for (size_t i = 0; i < count; ++i)
+                        field.values[i] = (float)((R + (double)intVals[i] * s2E) / s10D);
                 }
-                break;
 
-            default: break;
+                if (!field.values.empty() && discipline == 0) {
+                    if (paramCat == 3 && paramNum == 1) {
+                        for (auto& v : field.values) v /= 100.0f; // Pa → hPa
+                        return FIELD_PRMSL;
+                    }
+                    if (paramCat == 2 && paramNum == 2) return FIELD_UGRD;
+                    if (paramCat == 2 && paramNum == 3) return FIELD_VGRD;
+                }
             }
-            secPos += secLen;
+            return FIELD_NONE;
+
+        default: break;
+        }
+        secPos += secLen;
+    }
+    return FIELD_NONE;
+}
+
+bool WxMbProvider::decodeGFS(const std::vector<uint8_t>& data,
+                              GribField& out_prmsl,
+                              GribField& out_ugrd,
+                              GribField& out_vgrd) {
+    // Split into messages first so they can be decoded independently
+    std::vector<std::pair<size_t, size_t>> msgs; // offset, length
+    size_t pos = 0;
+    while (pos + 16 <= data.size()) {
+        if (data[pos]!='G'||data[pos+1]!='R'||data[pos+2]!='I'||data[pos+3]!='B') {
+            ++pos; continue;
+        }
+        if (data[pos + 7] != 2) { pos += 4; continue; }
+
+        uint64_t msgLen = u64be(data.data() + pos + 8);
+        if (msgLen < 16 || pos + msgLen > data.size()) break;
+        msgs.emplace_back(pos, (size_t)msgLen);
+        pos += msgLen;
+    }
+
+    std::vector<GribField> fields(msgs.size());
+    std::vector<GfsField>  kinds(msgs.size(), FIELD_NONE);
+    auto decodeOne = [&](size_t i) {
+        kinds[i] = decodeMessage(data.data() + msgs[i].first, msgs[i].second,
+                                 fields[i]);
+    };
+
+#ifdef __EMSCRIPTEN__
+    // No pthreads in the WASM build
+    for (size_t i = 0; i < msgs.size(); ++i) decodeOne(i);
+#else
+    // One thread per message; the GFS subset is three messages
+    std::vector<std::future<void>> jobs;
+    for (size_t i = 1; i < msgs.size(); ++i)
+        jobs.push_back(std::async(std::launch::async, decodeOne, i));
+    if (!msgs.empty()) decodeOne(0);
+    for (auto& job : jobs) job.get();
+#endif
+
+    int decoded = 0;
+    for (size_t i = 0; i < msgs.size(); ++i) {
+        GribField* dst = kinds[i] == FIELD_PRMSL ? &out_prmsl
+                       : kinds[i] == FIELD_UGRD  ? &out_ugrd
+                       : kinds[i] == FIELD_VGRD  ? &out_vgrd
+                       : nullptr;
+        if (dst && dst->values.empty()) {
+            *dst = std::move(fields[i]);
+            ++decoded;
         }
-        pos = msgEnd;
     }
 
     return decoded >= 3 &&
@@ -322,7 +375,7 @@ bool WxMbProvider::decodeGFS(const std::vector<uint8_t>& data,
 }
 
 // ---------------------------------------------------------------------------
-// Marching squares contour + wind quiver rendering
+// Isobars (multi-level marching squares) + wind arrows
 // ---------------------------------------------------------------------------
 
 // Segment table: bit0=TL, bit1=TR, bit2=BR, bit3=BL
@@ -346,74 +399,135 @@ static const int8_t MC_SEGS[16][2][2] = {
     {{-1,-1},{-1,-1}}, // 15 all inside
 };
 
-static void plotPixel(uint32_t* px, int pitch, int W, int H,
-                      int x, int y, uint32_t col) {
-    if ((unsigned)x < (unsigned)W && (unsigned)y < (unsigned)H)
-        px[y * pitch + x] = col;
-}
+// 960–1040 hPa every 4 hPa
+static constexpr float kIsobarMin    = 960.0f;
+static constexpr float kIsobarStep   = 4.0f;
+static constexpr int   kIsobarLevels = 21;
 
-static void drawLine(uint32_t* px, int pitch, int W, int H,
-                     int x0, int y0, int x1, int y1, uint32_t col) {
-    int dx = std::abs(x1-x0), sx = (x0<x1)?1:-1;
-    int dy = -std::abs(y1-y0), sy = (y0<y1)?1:-1;
-    int err = dx + dy;
-    for (;;) {
-        plotPixel(px, pitch, W, H, x0, y0, col);
-        if (x0==x1 && y0==y1) break;
-        int e2 = 2*err;
-        if (e2 >= dy) { err += dy; x0 += sx; }
-        if (e2 <= dx) { err += dx; y0 += sy; }
-    }
-}
+// Minimum spacing between kept polyline vertices, and wind arrow spacing
+static constexpr double kIsobarSpacingDeg = 0.3;
+static constexpr double kWindSpacingDeg   = 10.0;
 
-SDL_Surface* WxMbProvider::renderToSurface(const GribField& prmsl,
-                                            const GribField& ugrd,
-                                            const GribField& vgrd,
-                                            int W, int H) {
-    SDL_Surface* surf = SDL_CreateRGBSurfaceWithFormat(0, W, H, 32,
-                                                       SDL_PIXELFORMAT_RGBA8888);
-    if (!surf) return nullptr;
-    SDL_FillRect(surf, nullptr, 0); // fully transparent
+namespace {
 
-    uint32_t* pixels = static_cast<uint32_t*>(surf->pixels);
-    int pitch = surf->pitch / 4;
+// One contour crossing of a grid cell. Edge ids are shared by the two cells
+// on either side of a grid edge, which is what lets segments be chained.
+struct ContourSeg {
+    uint32_t edgeA, edgeB;
+    float    ax, ay, bx, by; // grid coordinates
+};
 
-    const int gW = prmsl.nx, gH = prmsl.ny;
+// Chain one level's segments into polylines (grid coordinates).
+void stitchSegments(const std::vector<ContourSeg>& segs,
+                    std::vector<std::vector<SDL_FPoint>>& lines) {
+    std::unordered_map<uint32_t, std::array<int, 2>> byEdge;
+    byEdge.reserve(segs.size() * 2);
+    for (int i = 0; i < (int)segs.size(); ++i) {
+        for (uint32_t e : {segs[i].edgeA, segs[i].edgeB}) {
+            auto [it, inserted] = byEdge.try_emplace(e, std::array<int, 2>{i, -1});
+            if (!inserted) it->second[1] = i;
+        }
+    }
 
-    auto sampleP = [&](int x, int y) -> float {
-        int gx = std::clamp(x * gW / W, 0, gW - 1);
-        int gy = std::clamp(y * gH / H, 0, gH - 1);
-        return prmsl.values[gy * gW + gx];
+    std::vector<uint8_t> used(segs.size(), 0);
+
+    // Follow the chain out of segment `from` through edge `edge`, appending
+    // the far endpoint of every segment visited. Returns the edge it stopped on.
+    auto walk = [&](int from, uint32_t edge, std::vector<SDL_FPoint>& pts) {
+        for (;;) {
+            const auto& pair = byEdge[edge];
+            int next = (pair[0] == from) ? pair[1] : pair[0];
+            if (next < 0 || used[next]) return edge;
+            used[next] = 1;
+            const ContourSeg& s = segs[next];
+            if (s.edgeA == edge) {
+                pts.push_back({s.bx, s.by});
+                edge = s.edgeB;
+            } else {
+                pts.push_back({s.ax, s.ay});
+                edge = s.edgeA;
+            }
+            from = next;
+        }
     };
 
-    uint32_t contourCol = SDL_MapRGBA(surf->format, 255, 255, 255, 200);
+    std::vector<SDL_FPoint> back;
+    for (int i = 0; i < (int)segs.size(); ++i) {
+        if (used[i]) continue;
+        used[i] = 1;
+        const ContourSeg& s = segs[i];
+
+        std::vector<SDL_FPoint> fwd = {{s.ax, s.ay}, {s.bx, s.by}};
+        if (walk(i, s.edgeB, fwd) == s.edgeA && fwd.size() > 2) {
+            fwd.push_back(fwd.front()); // closed loop
+            lines.push_back(std::move(fwd));
+            continue;
+        }
+        back.clear();
+        walk(i, s.edgeA, back);
 
-    // Marching squares: 960–1040 hPa every 4 hPa (21 levels)
-    for (float level = 960.0f; level <= 1040.0f; level += 4.0f) {
-        for (int cy = 0; cy < H - 1; ++cy) {
-            for (int cx = 0; cx < W - 1; ++cx) {
-                float v0 = sampleP(cx,   cy  ); // TL
-                float v1 = sampleP(cx+1, cy  ); // TR
-                float v2 = sampleP(cx+1, cy+1); // BR
-                float v3 = sampleP(cx,   cy+1); // BL
+        std::vector<SDL_FPoint> line(back.rbegin(), back.rend());
+        line.insert(line.end(), fwd.begin(), fwd.end());
+        lines.push_back(std::move(line));
+    }
+}
+
+} // namespace
+
+std::shared_ptr<WxMbOverlay> WxMbProvider::buildOverlay(const GribField& prmsl,
+                                                        const GribField& ugrd,
+                                                        const GribField& vgrd) {
+    const int nx = prmsl.nx, ny = prmsl.ny;
+    if (nx < 2 || ny < 2 || prmsl.values.size() < (size_t)nx * ny ||
+        prmsl.dlon == 0.0)
+        return nullptr;
+
+    auto overlay = std::make_shared<WxMbOverlay>();
+
+    // Global grids wrap so isobars close across the last column
+    const bool wrap = std::abs(nx * prmsl.dlon - 360.0) < prmsl.dlon * 0.5;
+    const int  cols = wrap ? nx : nx - 1;
 
+    auto hEdge = [nx](int x, int y) { return (uint32_t)(y * nx + x) * 2; };
+    auto vEdge = [nx](int x, int y) { return (uint32_t)(y * nx + x) * 2 + 1; };
+    auto interp = [](float va, float vb, float lev) -> float {
+        float d = vb - va;
+        return (std::abs(d) < 1e-4f) ? 0.5f
+               : std::clamp((lev - va) / d, 0.0f, 1.0f);
+    };
+
+    // Single pass over the native grid: each cell only visits the levels
+    // that fall between its corner values.
+    std::vector<std::vector<ContourSeg>> segs(kIsobarLevels);
+    for (int cy = 0; cy < ny - 1; ++cy) {
+        const float* row0 = prmsl.values.data() + (size_t)cy * nx;
+        const float* row1 = row0 + nx;
+        for (int cx = 0; cx < cols; ++cx) {
+            int   cx1 = (cx + 1 == nx) ? 0 : cx + 1;
+            float v0 = row0[cx], v1 = row0[cx1]; // TL, TR
+            float v2 = row1[cx1], v3 = row1[cx]; // BR, BL
+            float lo = std::min({v0, v1, v2, v3});
+            float hi = std::max({v0, v1, v2, v3});
+
+            int k0 = std::max(0, (int)std::ceil((lo - kIsobarMin) / kIsobarStep));
+            int k1 = std::min(kIsobarLevels - 1,
+                              (int)std::floor((hi - kIsobarMin) / kIsobarStep));
+            for (int k = k0; k <= k1; ++k) {
+                float level = kIsobarMin + k * kIsobarStep;
                 int mask = ((v0>=level)?1:0) | ((v1>=level)?2:0) |
                            ((v2>=level)?4:0) | ((v3>=level)?8:0);
                 if (mask == 0 || mask == 15) continue;
 
-                // Compute edge crossing position
-                auto interp = [](float va, float vb, float lev) -> float {
-                    float d = vb - va;
-                    return (std::abs(d) < 1e-4f) ? 0.5f
-                           : std::clamp((lev - va) / d, 0.0f, 1.0f);
-                };
-                auto edgePt = [&](int edge, float& ox, float& oy) {
+                auto edgePt = [&](int edge, float& ox, float& oy) -> uint32_t {
                     switch (edge) {
-                    case 0: ox = cx + interp(v0,v1,level); oy = (float)cy;   break;
-                    case 1: ox = (float)(cx+1); oy = cy + interp(v1,v2,level); break;
-                    case 2: ox = cx+1 - interp(v2,v3,level); oy = (float)(cy+1); break;
-                    case 3: ox = (float)cx; oy = cy+1 - interp(v3,v0,level); break;
-                    default: ox = (float)cx; oy = (float)cy; break;
+                    case 0: ox = cx + interp(v0,v1,level); oy = (float)cy;
+                            return hEdge(cx, cy);
+                    case 1: ox = (float)(cx+1); oy = cy + interp(v1,v2,level);
+                            return vEdge(cx1, cy);
+                    case 2: ox = cx+1 - interp(v2,v3,level); oy = (float)(cy+1);
+                            return hEdge(cx, cy + 1);
+                    default: ox = (float)cx; oy = cy+1 - interp(v3,v0,level);
+                            return vEdge(cx, cy);
                     }
                 };
 
@@ -421,56 +535,64 @@ SDL_Surface* WxMbProvider::renderToSurface(const GribField& prmsl,
                     int ea = MC_SEGS[mask][s][0];
                     int eb = MC_SEGS[mask][s][1];
                     if (ea < 0) break;
-                    float ax, ay, bx, by;
-                    edgePt(ea, ax, ay);
-                    edgePt(eb, bx, by);
-                    drawLine(pixels, pitch, W, H,
-                             (int)std::lround(ax), (int)std::lround(ay),
-                             (int)std::lround(bx), (int)std::lround(by),
-                             contourCol);
+                    ContourSeg seg;
+                    seg.edgeA = edgePt(ea, seg.ax, seg.ay);
+                    seg.edgeB = edgePt(eb, seg.bx, seg.by);
+                    segs[k].push_back(seg);
                 }
             }
         }
     }
 
-    // Wind quivers
-    if (ugrd.nx > 0 && vgrd.nx > 0) {
-        uint32_t arrowCol = SDL_MapRGBA(surf->format, 255, 255, 255, 140);
-        const int step = 25;
-
-        for (int ay = step / 2; ay < H; ay += step) {
-            for (int ax = step / 2; ax < W; ax += step) {
-                int gx = std::clamp(ax * ugrd.nx / W, 0, ugrd.nx - 1);
-                int gy = std::clamp(ay * ugrd.ny / H, 0, ugrd.ny - 1);
-
-                float u = ugrd.values[gy * ugrd.nx + gx];
-                float v = vgrd.values[gy * vgrd.nx + gx];
-                float speed = std::sqrt(u * u + v * v);
-                if (speed < 0.5f) continue;
-
-                float len = std::clamp(speed * 1.2f, 2.0f, 18.0f);
-                // V positive = northward = screen y decreasing (negate)
-                float dx = u / speed * len;
-                float dy = -v / speed * len;
-
-                int x1 = ax + (int)std::lround(dx);
-                int y1 = ay + (int)std::lround(dy);
-                drawLine(pixels, pitch, W, H, ax, ay, x1, y1, arrowCol);
-
-                // Arrowhead: two lines at ±30° from shaft direction
-                float headLen = std::max(3.0f, len * 0.35f);
-                float angle   = std::atan2(dy, dx);
-                for (int sign : {-1, 1}) {
-                    float ha = angle + sign * 0.5236f; // ±30°
-                    int hx = x1 - (int)std::lround(std::cos(ha) * headLen);
-                    int hy = y1 - (int)std::lround(std::sin(ha) * headLen);
-                    drawLine(pixels, pitch, W, H, x1, y1, hx, hy, arrowCol);
-                }
+    auto toLon = [&](double gx) {
+        double lon = prmsl.lon0 + gx * prmsl.dlon;
+        while (lon >= 180.0) lon -= 360.0;
+        while (lon < -180.0) lon += 360.0;
+        return (float)lon;
+    };
+    auto toLat = [&](double gy) { return (float)(prmsl.lat0 + gy * prmsl.dlat); };
+
+    // Drop vertices closer than kIsobarSpacingDeg (in grid units) to the
+    // last kept one; the native 0.25° grid is far denser than the map needs.
+    const float minStep = (float)(kIsobarSpacingDeg / std::abs(prmsl.dlon));
+    std::vector<std::vector<SDL_FPoint>> lines;
+    for (int k = 0; k < kIsobarLevels; ++k) {
+        lines.clear();
+        stitchSegments(segs[k], lines);
+        for (const auto& line : lines) {
+            WxMbOverlay::Isobar iso;
+            iso.hPa = kIsobarMin + k * kIsobarStep;
+            SDL_FPoint last = line.front();
+            iso.points.push_back({toLat(last.y), toLon(last.x)});
+            for (size_t i = 1; i < line.size(); ++i) {
+                const SDL_FPoint& p = line[i];
+                bool isEnd = (i + 1 == line.size());
+                if (!isEnd && std::abs(p.x - last.x) + std::abs(p.y - last.y) < minStep)
+                    continue;
+                iso.points.push_back({toLat(p.y), toLon(p.x)});
+                last = p;
+            }
+            if (iso.points.size() >= 2)
+                overlay->isobars.push_back(std::move(iso));
+        }
+    }
+
+    // Wind arrows on a regular lat/lon lattice
+    if (ugrd.nx == nx && ugrd.ny == ny && vgrd.nx == nx && vgrd.ny == ny &&
+        ugrd.values.size() >= (size_t)nx * ny &&
+        vgrd.values.size() >= (size_t)nx * ny) {
+        int stepX = std::max(1, (int)std::lround(kWindSpacingDeg / std::abs(ugrd.dlon)));
+        int stepY = std::max(1, (int)std::lround(kWindSpacingDeg / std::abs(ugrd.dlat)));
+        for (int gy = stepY / 2; gy < ny; gy += stepY) {
+            for (int gx = stepX / 2; gx < nx; gx += stepX) {
+                size_t i = (size_t)gy * nx + gx;
+                overlay->winds.push_back({toLat(gy), toLon(gx),
+                                          ugrd.values[i], vgrd.values[i]});
             }
         }
     }
 
-    return surf;
+    return overlay;
 }
 
 // ---------------------------------------------------------------------------
@@ -508,10 +630,7 @@ std::string WxMbProvider::buildNomadsUrl() {
 
 WxMbProvider::WxMbProvider(NetworkManager& net) : net_(net) {}
 
-WxMbProvider::~WxMbProvider() {
-    if (pendingSurface_) SDL_FreeSurface(pendingSurface_);
-    if (texture_)        SDL_DestroyTexture(texture_);
-}
+WxMbProvider::~WxMbProvider() = default;
 
 void WxMbProvider::update() {
     std::string url = buildNomadsUrl();
@@ -538,16 +657,16 @@ void WxMbProvider::update() {
                 LOG_I("WxMb", "GFS decoded: {}pt PRMSL, {}pt UGRD",
                       prmsl.values.size(), ugrd.values.size());
 
-                SDL_Surface* surf = renderToSurface(prmsl, ugrd, vgrd, 660, 330);
-                if (!surf) {
-                    LOG_W("WxMb", "renderToSurface failed");
+                auto overlay = buildOverlay(prmsl, ugrd, vgrd);
+                if (!overlay) {
+                    LOG_W("WxMb", "Unsupported GFS grid geometry");
                     return;
                 }
+                LOG_I("WxMb", "Built {} isobars, {} wind arrows",
+                      overlay->isobars.size(), overlay->winds.size());
 
                 std::lock_guard<std::mutex> lk(mutex_);
-                if (pendingSurface_) SDL_FreeSurface(pendingSurface_);
-                pendingSurface_ = surf;
-                dirty_          = true;
+                overlay_        = std::move(overlay);
                 hasData_        = true;
                 lastUrl_        = url;
                 lastUpdateMs_   = (uint64_t)SDL_GetTicks();
@@ -555,34 +674,9 @@ void WxMbProvider::update() {
     }, 0); // TTL=0: WxMbProvider tracks cycle freshness via URL comparison
 }
 
-SDL_Texture* WxMbProvider::getTexture(SDL_Renderer* renderer, int w, int h) {
+std::shared_ptr<const WxMbOverlay> WxMbProvider::getOverlay() const {
     std::lock_guard<std::mutex> lk(mutex_);
-
-    // Return cached texture if still valid and same size
-    if (!dirty_ && texture_ && texW_ == w && texH_ == h)
-        return texture_;
-
-    if (!pendingSurface_)
-        return texture_; // no new data yet
-
-    SDL_Surface* surf  = pendingSurface_;
-    pendingSurface_    = nullptr;
-    dirty_             = false;
-
-    if (texture_) {
-        SDL_DestroyTexture(texture_);
-        texture_ = nullptr;
-    }
-
-    texture_ = SDL_CreateTextureFromSurface(renderer, surf);
-    SDL_FreeSurface(surf);
-
-    if (texture_) {
-        SDL_SetTextureBlendMode(texture_, SDL_BLENDMODE_BLEND);
-        texW_ = w;
-        texH_ = h;
-    }
-    return texture_;
+    return overlay_;
 }
 
 bool WxMbProvider::hasData() const {
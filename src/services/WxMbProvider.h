@@ -1,7 +1,8 @@
 #pragma once
 
 #include "../network/NetworkManager.h"
-#include <SDL.h>
+#include <cstdint>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -9,6 +10,22 @@
 struct GribField {
     std::vector<float> values;
     int nx = 0, ny = 0;
+    double lat0 = 90.0, lon0 = 0.0; // first grid point
+    double dlat = 0.0,  dlon = 0.0; // signed step per row / column
+};
+
+// Isobars and wind arrows in geographic coordinates, so the map can project
+// them at any size and projection.
+struct WxMbOverlay {
+    struct Point { float lat, lon; };
+    struct Isobar {
+        float hPa;
+        std::vector<Point> points;
+    };
+    struct Wind { float lat, lon, u, v; }; // u east, v north (m/s)
+
+    std::vector<Isobar> isobars;
+    std::vector<Wind>   winds;
 };
 
 class WxMbProvider {
@@ -19,38 +36,31 @@ public:
     // Trigger fetch of current GFS cycle; no-op if cycle URL unchanged.
     void update();
 
-    // Returns cached SDL_Texture (RGBA, BLEND) scaled to (w, h), or nullptr.
-    // Must be called from the main/render thread.
-    SDL_Texture* getTexture(SDL_Renderer* renderer, int w, int h);
+    // Latest decoded overlay, or nullptr before the first successful fetch.
+    std::shared_ptr<const WxMbOverlay> getOverlay() const;
 
     bool hasData() const;
     uint64_t getLastUpdateMs() const;
 
 private:
-    // Decode raw GRIB2 bytes into three fields (PRMSL hPa, UGRD m/s, VGRD m/s).
-    // Returns true only if all three fields decoded with simple packing.
+    // Decode raw GRIB2 bytes into three fields (PRMSL hPa, UGRD m/s, VGRD m/s),
+    // one message per thread. Returns true only if all three decoded.
     static bool decodeGFS(const std::vector<uint8_t>& data,
                           GribField& prmsl, GribField& ugrd, GribField& vgrd);
 
-    // Render pressure contours + wind quivers to a new RGBA SDL_Surface (w×h).
-    // Caller owns the returned surface.
-    static SDL_Surface* renderToSurface(const GribField& prmsl,
-                                        const GribField& ugrd,
-                                        const GribField& vgrd,
-                                        int w, int h);
+    // Trace isobars on the native PRMSL grid and sample wind arrows.
+    static std::shared_ptr<WxMbOverlay> buildOverlay(const GribField& prmsl,
+                                                     const GribField& ugrd,
+                                                     const GribField& vgrd);
 
     // Build the NOAA NOMADS GFS filter URL for the current best cycle.
     static std::string buildNomadsUrl();
 
     NetworkManager& net_;
 
-    SDL_Surface*  pendingSurface_ = nullptr; // produced by WorkerService, consumed by getTexture()
-    SDL_Texture*  texture_        = nullptr;
-    bool          dirty_          = false;
+    std::shared_ptr<const WxMbOverlay> overlay_; // produced by WorkerService
     bool          hasData_        = false;
     uint64_t      lastUpdateMs_   = 0;
-    int           texW_           = 0;
-    int           texH_           = 0;
     std::string   lastUrl_;
 
     mutable std::mutex mutex_;
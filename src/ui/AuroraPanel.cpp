@@ -28,7 +28,8 @@ void AuroraPanel::render(SDL_Renderer *renderer) {
   {
     std::lock_guard<std::mutex> lock(auroraMutex);
     if (auroraDataReady) {
-      texMgr_.loadFromMemory(renderer, "aurora_latest", auroraPendingData);
+      texMgr_.loadFromMemory(renderer, "aurora_latest", auroraPendingData,
+                             [this] { lastFetch_ = 0; });
       auroraDataReady = false;
       auroraPendingData.clear();
       imageReady_ = true;
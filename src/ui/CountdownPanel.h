@@ -18,6 +18,7 @@ public:
   bool onMouseUp(int mx, int my, Uint16 mod) override;
   bool onKeyDown(SDL_Keycode key, Uint16 mod) override;
   bool onTextInput(const char *text) override;
+  Uint32 repaintIntervalMs() const override { return 500; } // cursor blink
 
 private:
   void startEditing(bool editingTime);
@@ -1,41 +1,17 @@
 #include "DRAPPanel.h"
-#include "../core/StringUtils.h"
 #include "../core/Theme.h"
 #include <SDL.h>
+#include <algorithm>
 #include <cstdio>
-#include <mutex>
-
-static std::mutex drapMutex;
-static std::string drapValue;
-static bool drapDataReady = false;
 
 DRAPPanel::DRAPPanel(int x, int y, int w, int h, FontManager &fontMgr,
-                     TextureManager &texMgr, DRAPProvider &provider)
+                     TextureManager &texMgr, std::shared_ptr<DrapStore> store)
     : Widget(x, y, w, h), fontMgr_(fontMgr), texMgr_(texMgr),
-      provider_(provider) {}
-
-void DRAPPanel::update() {
-  uint32_t now = SDL_GetTicks();
-  if (now - lastFetch_ > 15 * 60 * 1000 || lastFetch_ == 0) { // 15 mins
-    lastFetch_ = now;
-    provider_.fetch([](const std::string &data) {
-      std::lock_guard<std::mutex> lock(drapMutex);
-      drapValue = data;
-      drapDataReady = true;
-    });
-  }
-}
+      store_(std::move(store)) {}
 
 void DRAPPanel::render(SDL_Renderer *renderer) {
-  // Update current value from provider
-  {
-    std::lock_guard<std::mutex> lock(drapMutex);
-    if (drapDataReady) {
-      currentValue_ = drapValue;
-      dataReady_ = true;
-      drapDataReady = false;
-    }
-  }
+  // DRAPProvider is driven by the fetch scheduler; just show its latest grid
+  auto grid = store_ ? store_->gridSnapshot() : nullptr;
 
   ThemeColors themes = getThemeColors(theme_);
 
@@ -56,17 +32,13 @@ void DRAPPanel::render(SDL_Renderer *renderer) {
   fontMgr_.drawText(renderer, "DRAP Absorption", x_ + 5, y_ + 5, themes.accent,
                     10);
 
-  if (!dataReady_) {
+  if (!grid) {
     fontMgr_.drawText(renderer, "Loading...", x_ + width_ / 2, y_ + height_ / 2,
                       {150, 150, 150, 255}, 12, false, true);
     return;
   }
 
-  // Parse the value to determine color
-  float freq = 0.0f;
-  if (!currentValue_.empty()) {
-    freq = StringUtils::safe_stof(currentValue_);
-  }
+  float freq = grid->maxMhz;
 
   // Color coding: higher DRAP = worse conditions
   // < 5 MHz: Green (good)
@@ -1,28 +1,24 @@
 #pragma once
 
-#include "../services/DRAPProvider.h"
+#include "../core/DrapData.h"
 #include "FontManager.h"
 #include "TextureManager.h"
 #include "Widget.h"
 
-#include <string>
+#include <memory>
 
 struct SDL_Renderer;
 
 class DRAPPanel : public Widget {
 public:
   DRAPPanel(int x, int y, int w, int h, FontManager &fontMgr,
-            TextureManager &texMgr, DRAPProvider &provider);
+            TextureManager &texMgr, std::shared_ptr<DrapStore> store);
 
-  void update() override;
+  void update() override {}
   void render(SDL_Renderer *renderer) override;
 
 private:
   FontManager &fontMgr_;
   TextureManager &texMgr_;
-  DRAPProvider &provider_;
-
-  bool dataReady_ = false;
-  uint32_t lastFetch_ = 0;
-  std::string currentValue_;
+  std::shared_ptr<DrapStore> store_;
 };
@@ -17,6 +17,11 @@ DXClusterPanel::DXClusterPanel(int x, int y, int w, int h, FontManager &fontMgr,
 void DXClusterPanel::update() {
   auto data = store_->snapshot();
   bool dataChanged = (data->lastUpdate != lastUpdate_);
+  // New QSOs in the log change the tags of spots already listed.
+  if (worked_ && worked_->generation() != workedGeneration_) {
+    workedGeneration_ = worked_->generation();
+    dataChanged = true;
+  }
 
   if (dataChanged) {
     rebuildRows(*data);
@@ -34,6 +39,7 @@ void DXClusterPanel::update() {
 
     std::vector<std::string> visible;
     visibleFreqs_.clear();
+    visibleWorked_.clear();
 
     if (allRows_.empty()) {
       visible.push_back(
@@ -46,6 +52,7 @@ void DXClusterPanel::update() {
         if (idx < (int)allRows_.size()) {
           visible.push_back(allRows_[idx]);
           visibleFreqs_.push_back(allFreqs_[idx]);
+          visibleWorked_.push_back(allWorked_[idx]);
         }
       }
     }
@@ -79,24 +86,40 @@ void DXClusterPanel::update() {
 void DXClusterPanel::rebuildRows(const DXClusterData &data) {
   allRows_.clear();
   allFreqs_.clear();
+  allWorked_.clear();
   auto spots = data.spots;
   // Most recent first
   std::reverse(spots.begin(), spots.end());
 
   for (const auto &spot : spots) {
+    uint8_t worked = worked_ ? worked_->lookup(spot) : spot.worked;
+    // Tag column: '!' new DXCC, '+' new band, '*' new mode on the band
+    char tag = ' ';
+    if (worked & kNewDxcc)
+      tag = '!';
+    else if (worked & kNewBand)
+      tag = '+';
+    else if (worked & kNewSlot)
+      tag = '*';
+
     std::stringstream ss;
-    // Format: "14025.0 K1ABC      5m"
+    // Format: "14025.0 !K1ABC     5m"
     ss << std::fixed << std::setprecision(1) << std::setw(8) << spot.freqKhz
-       << " " << std::left << std::setw(11) << spot.txCall << std::right
-       << std::setw(4) << formatAge(spot.spottedAt);
+       << " " << tag << std::left << std::setw(10) << spot.txCall
+       << std::right << std::setw(4) << formatAge(spot.spottedAt);
     allRows_.push_back(ss.str());
     allFreqs_.push_back(spot.freqKhz);
+    allWorked_.push_back(worked);
   }
 }
 
 SDL_Color DXClusterPanel::getRowColor(int index,
                                       const SDL_Color &defaultColor) const {
   if (index >= 0 && index < (int)visibleFreqs_.size()) {
+    // Stations already in the log, with nothing new to offer, are dimmed.
+    uint8_t worked = visibleWorked_[index];
+    if ((worked & kWorkedCall) && !(worked & (kNewDxcc | kNewBand | kNewSlot)))
+      return {120, 120, 120, 255};
     int bandIdx = freqToBandIndex(visibleFreqs_[index]);
     if (bandIdx >= 0) {
       return kBands[bandIdx].color;
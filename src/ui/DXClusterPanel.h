@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../core/DXClusterData.h"
+#include "../core/WorkedIndex.h"
 #include "ListPanel.h"
 #include <SDL.h>
 #include <chrono>
@@ -21,6 +22,11 @@ public:
   bool onMouseUp(int mx, int my, Uint16 mod) override;
   bool onMouseWheel(int scrollY) override;
 
+  // Tag rows as new DXCC / new band / worked before from the logbook.
+  void setWorkedIndex(std::shared_ptr<WorkedIndex> index) {
+    worked_ = std::move(index);
+  }
+
   bool isSetupRequested() const { return setupRequested_; }
   void clearSetupRequest() { setupRequested_ = false; }
 
@@ -42,11 +48,15 @@ private:
   RigService *rigService_;
   const AppConfig *config_;
   std::chrono::system_clock::time_point lastUpdate_{};
+  std::shared_ptr<WorkedIndex> worked_;
+  uint32_t workedGeneration_ = 0;
   bool setupRequested_ = false;
 
   std::vector<std::string> allRows_;
   std::vector<double> allFreqs_;
   std::vector<double> visibleFreqs_;
+  std::vector<uint8_t> allWorked_; // WorkedFlags per row
+  std::vector<uint8_t> visibleWorked_;
   int scrollOffset_ = 0;
   static constexpr int MAX_VISIBLE_ROWS = 15;
 };
@@ -44,13 +44,13 @@ void DXPanel::update() {
                 state_->dxLocation.lon >= 0 ? 'E' : 'W');
   lineText_[2] = buf;
 
-  double bearing =
-      Astronomy::calculateBearing(state_->deLocation, state_->dxLocation);
-  std::snprintf(buf, sizeof(buf), "Az: %.0f%c", bearing, '\xB0'); // degree sign
+  // Cached in the state graph until DE or DX moves
+  PathInfo path = state_->path.get();
+  std::snprintf(buf, sizeof(buf), "Az: %.0f%c", path.bearingDeg,
+                '\xB0'); // degree sign
   lineText_[3] = buf;
 
-  double dist =
-      Astronomy::calculateDistance(state_->deLocation, state_->dxLocation);
+  double dist = path.distanceKm;
   if (useMetric_) {
     if (dist >= 1000.0) {
       std::snprintf(buf, sizeof(buf), "Dist: %.0f km", dist);
@@ -5,6 +5,9 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <unordered_map>
 
 DXSatPane::DXSatPane(int x, int y, int w, int h, FontManager &fontMgr,
                      TextureManager &texMgr,
@@ -252,9 +255,28 @@ void DXSatPane::populateMenu() {
     menuItems_.push_back({"Show DX Info here", kActionShowDX, false});
   } else if (menuState_ == MenuState::SatList) {
     satSnapshot_ = satMgr_.getSatellites();
+
+    // Next usable pass (>= 10 deg) per satellite from the catalog pass table
+    std::time_t now = std::time(nullptr);
+    std::unordered_map<int, std::time_t> nextAos;
+    for (const auto &p : satMgr_.upcomingPasses(satSnapshot_.size() * 8, 10.0))
+      nextAos.try_emplace(p.noradId, p.pass.aosTime);
+
     for (size_t i = 0; i < satSnapshot_.size(); ++i) {
       bool sel = (satSnapshot_[i].name == selectedSatName_);
-      menuItems_.push_back({satSnapshot_[i].name, static_cast<int>(i), sel});
+      std::string label = satSnapshot_[i].name;
+      auto it = nextAos.find(satSnapshot_[i].noradId);
+      if (it != nextAos.end()) {
+        char buf[32];
+        long until = static_cast<long>(it->second - now);
+        if (until <= 0)
+          std::snprintf(buf, sizeof(buf), "  up");
+        else
+          std::snprintf(buf, sizeof(buf), "  %ldh%02ld", until / 3600,
+                        (until % 3600) / 60);
+        label += buf;
+      }
+      menuItems_.push_back({label, static_cast<int>(i), sel});
     }
     if (satSnapshot_.empty()) {
       menuItems_.push_back({"(Loading satellites...)", kActionNone, false});
@@ -91,13 +91,7 @@ public:
   }
 
   void destroyTexture(SDL_Texture *tex) {
-    if (tex) {
-      int w, h;
-      SDL_QueryTexture(tex, nullptr, nullptr, &w, &h);
-      MemoryMonitor::getInstance().markVramDestroyed(static_cast<int64_t>(w) *
-                                                     h * 4);
-      SDL_DestroyTexture(tex);
-    }
+    MemoryMonitor::getInstance().destroyTexture(tex);
   }
 
   // ---- Calibration ----
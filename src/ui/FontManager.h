@@ -147,9 +147,9 @@ public:
       return nullptr;
     }
 
-    // VRAM accounting (w, h are already physical pixels)
-    int64_t bytes = static_cast<int64_t>(surface->w) * surface->h * 4;
-    MemoryMonitor::getInstance().addVram(bytes);
+    // VRAM accounting (w, h are already physical pixels). Caller-owned, so
+    // pinned; drawText() re-registers its cached copies as evictable.
+    MemoryMonitor::getInstance().trackTexture(texture, "FontManager");
 
     // Logical dimensions for caller
     if (outW)
@@ -189,6 +189,7 @@ public:
       // If we have a cached texture and the text is unchanged, just draw it.
       if (it != volatileCache_.end() && it->second.text == text) {
         it->second.lastUsed = SDL_GetTicks();
+        MemoryMonitor::getInstance().touchTexture(it->second.texture);
         SDL_Rect dst = {x, y, it->second.w, it->second.h};
         if (centered) {
           dst.x -= it->second.w / 2;
@@ -211,6 +212,13 @@ public:
       
       // Store the new texture and its text content in the volatile cache.
       volatileCache_[key] = {tex, w, h, SDL_GetTicks(), text};
+      MemoryMonitor::getInstance().trackTexture(
+          tex, "FontManager", [this, key](SDL_Texture *t) {
+            auto vit = volatileCache_.find(key);
+            if (vit != volatileCache_.end() && vit->second.texture == t)
+              volatileCache_.erase(vit);
+            MemoryMonitor::getInstance().destroyTexture(t);
+          });
 
       SDL_Rect dst = {x, y, w, h};
       if (centered) {
@@ -225,6 +233,7 @@ public:
       auto it = textCache_.find(key);
       if (it != textCache_.end()) {
         it->second.lastUsed = SDL_GetTicks();
+        MemoryMonitor::getInstance().touchTexture(it->second.texture);
         SDL_Rect dst = {x, y, it->second.w, it->second.h};
         if (centered) {
           dst.x -= it->second.w / 2;
@@ -244,8 +253,15 @@ public:
       if (textCache_.size() > 300) {
         pruneCache();
       }
-      // Add to cache
+      // Add to cache. Evicted entries are simply re-rasterized on next draw.
       textCache_[key] = {tex, w, h, SDL_GetTicks()};
+      MemoryMonitor::getInstance().trackTexture(
+          tex, "FontManager", [this, key](SDL_Texture *t) {
+            auto tit = textCache_.find(key);
+            if (tit != textCache_.end() && tit->second.texture == t)
+              textCache_.erase(tit);
+            MemoryMonitor::getInstance().destroyTexture(t);
+          });
 
       SDL_Rect dst = {x, y, w, h};
       if (centered) {
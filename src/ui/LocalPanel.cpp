@@ -53,10 +53,9 @@ void LocalPanel::update() {
                 utc.tm_mday, kMonths[utc.tm_mon], 1900 + utc.tm_year);
   lineText_[2] = buf;
 
-  // Sunrise / Sunset
-  int doy = utc.tm_yday + 1;
-  SunTimes st = Astronomy::calculateSunTimes(state_->deLocation.lat,
-                                             state_->deLocation.lon, doy);
+  // Sunrise / Sunset, recomputed by the state graph when DE or the day
+  // changes
+  SunTimes st = state_->deSun.get();
 
   if (st.hasRise && st.hasSet) {
     // Convert UTC sun times to local
@@ -17,6 +17,7 @@ void MapViewMenu::show(AppConfig &config, std::function<void()> onApply) {
   mapStyle_ = config.mapStyle;
   showGrid_ = config.showGrid;
   showBeacons_ = config.showBeacons;
+  showAurora_ = config.showAurora;
   gridType_ = config.gridType;
   propOverlay_ = config.propOverlay;
   weatherOverlay_ = config.weatherOverlay;
@@ -56,6 +57,7 @@ void MapViewMenu::show(AppConfig &config, std::function<void()> onApply) {
   weatherHeaderY_ = y;
 
   beaconsRec_ = {col2X + 10, y + 30, 20, 20};
+  auroraRec_ = {col2X + 10, y + 55, 20, 20};
 
   // Row 4 (VOACAP) - 3 columns
   y += 70;
@@ -143,6 +145,8 @@ void MapViewMenu::render(SDL_Renderer *renderer) {
     propLabel = "Reliability";
   else if (propOverlay_ == PropOverlayType::Toa)
     propLabel = "TOA";
+  else if (propOverlay_ == PropOverlayType::Drap)
+    propLabel = "DRAP";
   drawDropdown(renderer, overlayRec_, propLabel, openCombo_ == COMBO_OVERLAY);
 
   // Weather Section
@@ -160,6 +164,10 @@ void MapViewMenu::render(SDL_Renderer *renderer) {
   renderRadioButton(renderer, beaconsRec_, showBeacons_, "NCDXF Beacons",
                     themes.text);
 
+  // Aurora Toggle
+  renderRadioButton(renderer, auroraRec_, showAurora_, "Aurora Oval",
+                    themes.text);
+
   // VOACAP Extras (Used for VOACAP, Reliability, and TOA)
   if (propOverlay_ == PropOverlayType::Voacap ||
       propOverlay_ == PropOverlayType::Reliability ||
@@ -384,6 +392,8 @@ bool MapViewMenu::onMouseUp(int mx, int my, Uint16) {
                   propOverlay_ = PropOverlayType::Reliability;
                 else if (idx == 4)
                   propOverlay_ = PropOverlayType::Toa;
+                else if (idx == 5)
+                  propOverlay_ = PropOverlayType::Drap;
               }))
             return true;
       
@@ -400,6 +410,11 @@ bool MapViewMenu::onMouseUp(int mx, int my, Uint16) {
                 showBeacons_ = !showBeacons_;
                 return true;
               }
+
+              if (SDL_PointInRect(&pt, &auroraRec_)) {
+                showAurora_ = !showAurora_;
+                return true;
+              }
           
               if (propOverlay_ == PropOverlayType::Voacap ||          propOverlay_ == PropOverlayType::Reliability ||
           propOverlay_ == PropOverlayType::Toa) {
@@ -440,6 +455,7 @@ bool MapViewMenu::onMouseUp(int mx, int my, Uint16) {
     config_->mapStyle = mapStyle_;
           config_->showGrid = showGrid_;
           config_->showBeacons = showBeacons_;
+          config_->showAurora = showAurora_;
           config_->gridType = gridType_;          config_->propOverlay = propOverlay_;
           config_->weatherOverlay = weatherOverlay_;
           config_->propBand = propBand_;    config_->propMode = propMode_;
@@ -22,6 +22,7 @@
 #include <fmt/core.h>
 
 #include <algorithm>
+#include <array>
 
 #include <SDL_video.h>
 #include <chrono>
@@ -34,6 +35,9 @@
 
 static constexpr const char *MAP_KEY = "earth_map";
 static constexpr const char *NIGHT_MAP_KEY = "night_map";
+static constexpr const char *kNightMapUrl =
+    "https://eoimages.gsfc.nasa.gov/images/imagerecords/79000/79765/"
+    "dnb_land_ocean_ice.2012.3600x1800.jpg";
 static constexpr const char *SAT_ICON_KEY = "sat_icon";
 static constexpr const char *LINE_AA_KEY = "line_aa";
 static constexpr int FALLBACK_W = 1024;
@@ -128,8 +132,12 @@ MapWidget::MapWidget(int x, int y, int w, int h, TextureManager &texMgr,
 }
 
   MapWidget::~MapWidget() {
+    propRequest_.cancel();
+    drapRequest_.cancel();
     MemoryMonitor::getInstance().destroyTexture(nightOverlayTexture_);
     MemoryMonitor::getInstance().destroyTexture(propTexture_);
+    MemoryMonitor::getInstance().destroyTexture(auroraTexture_);
+    MemoryMonitor::getInstance().destroyTexture(drapTexture_);
     MemoryMonitor::getInstance().destroyTexture(tooltip_.cachedTexture);
   }
 void MapWidget::recalcMapRect() {
@@ -230,53 +238,46 @@ void MapWidget::update() {
   if (predictor_ && predictor_->isReady() && config_.showSatTrack) {
     if (nowMs - lastSatTrackUpdateMs_ > 5000) {
       lastSatTrackUpdateMs_ = nowMs;
-
-      // Offload the expensive calculation to a worker thread.
-      WorkerService::getInstance().submitTask([this] {
-        auto *track_ptr = new std::vector<GroundTrackPoint>();
-        *track_ptr =
-            predictor_->groundTrack(std::chrono::system_clock::to_time_t(
-                                        std::chrono::system_clock::now()),
-                                    90, 30);
-
-        SDL_Event event;
-        SDL_zero(event);
-        event.type =
-            HamClock::AE_BASE_EVENT + HamClock::AE_SATELLITE_TRACK_READY;
-        event.user.data1 = track_ptr;
-        SDL_PushEvent(&event);
-      });
+      updateSatTrack(std::chrono::system_clock::to_time_t(
+          std::chrono::system_clock::now()));
     }
-  } else if (!cachedSatTrack_.empty()) {
-    cachedSatTrack_.clear();
+  } else if (!satTrack_.empty()) {
+    satTrack_.clear();
     satTrackDirty_ = true;
   }
 
   // Great Circle update (on change)
-  if (state_->dxActive) {
-    if (state_->deLocation.lat != lastDE_.lat ||
-        state_->deLocation.lon != lastDE_.lon ||
-        state_->dxLocation.lat != lastDX_.lat ||
-        state_->dxLocation.lon != lastDX_.lon) {
+  bool deMoved = deWatch_.changed();
+  if (dxWatch_.changed() || deMoved) {
+    DXTarget dx = dxWatch_.get();
+    if (dx.active) {
       int segments = useCompatibilityRenderPath_ ? 100 : 250;
       cachedGreatCircle_ = Astronomy::calculateGreatCirclePath(
-          state_->deLocation, state_->dxLocation, segments);
-      lastDE_ = state_->deLocation;
-      lastDX_ = state_->dxLocation;
-      greatCircleDirty_ = true;
+          deWatch_.get(), dx.loc, segments);
+    } else {
+      cachedGreatCircle_.clear();
     }
-      } else if (!cachedGreatCircle_.empty()) {
-        cachedGreatCircle_.clear();
-        greatCircleDirty_ = true;
-      }
+    greatCircleDirty_ = true;
+  }
   
           // Propagation Overlay updates (every 15 mins or on change)
           if (config_.propOverlay != PropOverlayType::None &&
-              config_.propOverlay != PropOverlayType::Muf) {
+              config_.propOverlay != PropOverlayType::Muf &&
+              config_.propOverlay != PropOverlayType::Drap) {
             bool changed = (lastPropType_ != config_.propOverlay) ||
                            (lastBand_ != config_.propBand) ||
                            (lastMode_ != config_.propMode) ||
                            (lastPower_ != config_.propPower);
+            // Both watches must be read to consume their change
+            if (propOriginWatch_.changed())
+              changed = true;
+            if (solarWatch_ && solarWatch_->changed())
+              changed = true;
+            // New absorption data only matters to the reliability maps
+            if ((config_.propOverlay == PropOverlayType::Reliability ||
+                 config_.propOverlay == PropOverlayType::Voacap) &&
+                drapStore_ && drapStore_->gridSnapshot() != propDrap_)
+              changed = true;
       
             if (changed || (nowMs - lastPropUpdateMs_ > 900000)) {
               updatePropagationOverlay();
@@ -288,6 +289,9 @@ void MapWidget::update() {
             }
           }
       
+          if (config_.propOverlay == PropOverlayType::Drap)
+            updateDrapOverlay();
+
           // WX pressure overlay (check every 10 minutes)
           if (config_.weatherOverlay == WeatherOverlayType::WxMb) {
             uint64_t nowMs64 = static_cast<uint64_t>(SDL_GetTicks());
@@ -334,40 +338,13 @@ void MapWidget::update() {
           kMonthNames[month - 1], month);
     }
 
-    LOG_I("MapWidget", "Starting async fetch for {}", url);
-    netMgr_.fetchAsync(
-        url,
-        [this, url_str = std::string(url)](std::string data) {
-          if (!data.empty()) {
-            LOG_I("MapWidget", "Received {} bytes for {}", data.size(),
-                  url_str);
-            std::lock_guard<std::mutex> lock(mapDataMutex_);
-            pendingMapData_ = std::move(data);
-          } else {
-            LOG_E("MapWidget", "Fetch failed or empty for {}", url_str);
-          }
-        },
-        86400 * 30); // Cache for a month
-
-    const char *nightUrl = "https://eoimages.gsfc.nasa.gov/images/imagerecords/"
-                           "79000/79765/dnb_land_ocean_ice.2012.3600x1800.jpg";
-    LOG_I("MapWidget", "Starting async fetch for Night Lights");
-    netMgr_.fetchAsync(
-        nightUrl,
-        [this, nightUrlStr = std::string(nightUrl)](std::string data) {
-          if (!data.empty()) {
-            LOG_I("MapWidget", "Received {} bytes for Night Lights",
-                  data.size());
-            std::lock_guard<std::mutex> lock(mapDataMutex_);
-            pendingNightMapData_ = std::move(data);
-          } else {
-            LOG_E("MapWidget", "Night Lights fetch failed for {}", nightUrlStr);
-          }
-        },
-        86400 * 365); // Cache for a year
+    mapUrl_ = url;
+    fetchMapImage(mapUrl_, false);
+    fetchMapImage(kNightMapUrl, true);
   }
 
-      if (config_.propOverlay != PropOverlayType::None) {
+      if (config_.propOverlay != PropOverlayType::None &&
+          config_.propOverlay != PropOverlayType::Drap) {
         if (iono_ && iono_->hasData()) {
           uint32_t lastUp = iono_->getLastUpdateMs();
           if (lastUp != lastMufUpdateMs_) {
@@ -419,18 +396,31 @@ bool MapWidget::onMouseUp(int mx, int my, Uint16 mod) {
 
   if (mod & KMOD_SHIFT) {
     // Shift-click: set DE (current location)
-    state_->deLocation = {lat, lon};
-    state_->deGrid = Astronomy::latLonToGrid(lat, lon);
+    state_->setDE({lat, lon});
   } else {
     // Normal click: set DX (target)
-    state_->dxLocation = {lat, lon};
-    state_->dxGrid = Astronomy::latLonToGrid(lat, lon);
-    state_->dxActive = true;
+    state_->setDX({lat, lon});
   }
 
   return true;
 }
 
+void MapWidget::fetchMapImage(const std::string &url, bool night) {
+  LOG_I("MapWidget", "Starting async fetch for {}", url);
+  netMgr_.fetchAsync(
+      url,
+      [this, url, night](std::string data) {
+        if (!data.empty()) {
+          LOG_I("MapWidget", "Received {} bytes for {}", data.size(), url);
+          std::lock_guard<std::mutex> lock(mapDataMutex_);
+          (night ? pendingNightMapData_ : pendingMapData_) = std::move(data);
+        } else {
+          LOG_E("MapWidget", "Fetch failed or empty for {}", url);
+        }
+      },
+      night ? 86400 * 365 : 86400 * 30); // Night lights never change
+}
+
 bool MapWidget::onMouseWheel(int scrollY) {
   if (mapViewMenu_->isVisible()) {
     return mapViewMenu_->onMouseWheel(scrollY);
@@ -510,6 +500,15 @@ void MapWidget::onMouseMove(int mx, int my) {
             tip += std::string(" (") + kBands[bi].name + ")";
           if (!spot.mode.empty())
             tip += " " + spot.mode;
+          uint8_t worked = worked_ ? worked_->lookup(spot) : spot.worked;
+          if (worked & kNewDxcc)
+            tip += " - NEW DXCC";
+          else if (worked & kNewBand)
+            tip += " - new band";
+          else if (worked & kNewSlot)
+            tip += " - new mode";
+          else if (worked & kWorkedCall)
+            tip += " - worked";
           break;
         }
       }
@@ -532,9 +531,8 @@ void MapWidget::onMouseMove(int mx, int my) {
   tooltip_.timestamp = SDL_GetTicks();
 }
 
-void MapWidget::renderMarker(SDL_Renderer *renderer, double lat, double lon,
-                             Uint8 r, Uint8 g, Uint8 b, MarkerShape shape,
-                             bool outline) {
+void MapWidget::renderMarker(double lat, double lon, Uint8 r, Uint8 g,
+                             Uint8 b, MarkerShape shape, bool outline) {
   SDL_FPoint pt = latLonToScreen(lat, lon);
   float radius = 3.0f;
 
@@ -552,16 +550,12 @@ void MapWidget::renderMarker(SDL_Renderer *renderer, double lat, double lon,
     if (outline) {
       // Draw a slightly larger black version as outline
       float oRad = radius + 1.0f;
-      SDL_FRect oDst = {pt.x - oRad, pt.y - oRad, oRad * 2, oRad * 2};
-      SDL_SetTextureColorMod(tex, 0, 0, 0);
-      SDL_SetTextureAlphaMod(tex, 255);
-      SDL_RenderCopyF(renderer, tex, nullptr, &oDst);
+      batch_.sprite(tex, {pt.x - oRad, pt.y - oRad, oRad * 2, oRad * 2},
+                    {0, 0, 0, 255});
     }
 
-    SDL_FRect dst = {pt.x - radius, pt.y - radius, radius * 2, radius * 2};
-    SDL_SetTextureColorMod(tex, r, g, b);
-    SDL_SetTextureAlphaMod(tex, 255);
-    SDL_RenderCopyF(renderer, tex, nullptr, &dst);
+    batch_.sprite(tex, {pt.x - radius, pt.y - radius, radius * 2, radius * 2},
+                  {r, g, b, 255});
   }
 }
 
@@ -644,20 +638,150 @@ void MapWidget::renderGreatCircle(SDL_Renderer *renderer) {
   }
 }
 
-void MapWidget::renderNightOverlay(SDL_Renderer *renderer) {
-  const float sLatRad = sunLat_ * M_PI / 180.0;
-  const float sLonRad = sunLon_ * M_PI / 180.0;
-  const float sinSLat = std::sin(sLatRad);
-  const float cosSLat = std::cos(sLatRad);
+// Darkness LUT over the twilight band: index 0 is the terminator (cosZ = 0),
+// the last entry is the end of the grayline (cosZ = GRAYLINE_COS). Replaces
+// the per-vertex pow() of the original shading.
+static constexpr float GRAYLINE_COS = -0.21f; // ~cos(90+12)
+static constexpr float GRAYLINE_POW = 0.8f;   // Slightly steeper for deeper night
+static constexpr int kGraylineLutSize = 256;
+
+static const Uint8 *graylineLut() {
+  static const auto lut = [] {
+    std::array<Uint8, kGraylineLutSize> t{};
+    for (int i = 0; i < kGraylineLutSize; ++i) {
+      float f = static_cast<float>(i) / (kGraylineLutSize - 1);
+      t[i] = static_cast<Uint8>(std::pow(f, GRAYLINE_POW) * 255.0f + 0.5f);
+    }
+    return t;
+  }();
+  return lut.data();
+}
 
-  // Low-memory mode: reduce mesh density on KMSDRM to minimize GPU allocations
-  const int gridW = useCompatibilityRenderPath_ ? 48 : 96;
-  const int gridH = useCompatibilityRenderPath_ ? 24 : 48;
+void MapWidget::rebuildNightLattice(int cellsW, int cellsH, int sub) {
+  NightMesh &m = nightMesh_;
+  m.rect = mapRect_;
+  m.projection = config_.projection;
+  m.cellsW = cellsW;
+  m.cellsH = cellsH;
+  m.sub = sub;
+  m.latticeW = cellsW * sub + 1;
+  const int latticeH = cellsH * sub + 1;
+  const size_t n = static_cast<size_t>(m.latticeW) * latticeH;
+
+  m.ux.resize(n);
+  m.uy.resize(n);
+  m.uz.resize(n);
+  m.valid.resize(n);
+  m.alpha.resize(n);
+  shadowVerts_.resize(n);
+  lightVerts_.resize(n);
+
+  for (int j = 0; j < latticeH; ++j) {
+    float sy = mapRect_.y + (float)j * mapRect_.h / (latticeH - 1);
+    for (int i = 0; i < m.latticeW; ++i) {
+      float sx = mapRect_.x + (float)i * mapRect_.w / (m.latticeW - 1);
+      size_t idx = static_cast<size_t>(j) * m.latticeW + i;
+
+      double lat, lon;
+      if (screenToLatLon((int)sx, (int)sy, lat, lon)) {
+        double latRad = lat * M_PI / 180.0;
+        double lonRad = lon * M_PI / 180.0;
+        m.ux[idx] = static_cast<float>(std::cos(latRad) * std::cos(lonRad));
+        m.uy[idx] = static_cast<float>(std::cos(latRad) * std::sin(lonRad));
+        m.uz[idx] = static_cast<float>(std::sin(latRad));
+        m.valid[idx] = 1;
+
+        // Projection-aware texture coordinates for night lights
+        float u = static_cast<float>((lon + 180.0) / 360.0);
+        float v = static_cast<float>((90.0 - lat) / 180.0);
+        shadowVerts_[idx] = {{sx, sy}, {255, 255, 255, 0}, {0, 0}};
+        lightVerts_[idx] = {{sx, sy}, {255, 255, 255, 0}, {u, v}};
+      } else {
+        m.ux[idx] = m.uy[idx] = m.uz[idx] = 0.0f;
+        m.valid[idx] = 0;
+        shadowVerts_[idx] = {{sx, sy}, {0, 0, 0, 0}, {0, 0}};
+        lightVerts_[idx] = {{sx, sy}, {0, 0, 0, 0}, {0, 0}};
+      }
+    }
+  }
+}
 
-  // Constants matching original HamClock: 12 deg grayline, 0.75 power curve
-  constexpr float GRAYLINE_COS = -0.21f; // ~cos(90+12)
-  constexpr float GRAYLINE_POW = 0.8f;   // Slightly steeper for deeper night
+void MapWidget::updateNightShading() {
+  NightMesh &m = nightMesh_;
+  const size_t n = m.ux.size();
 
+  const float sLatRad = sunLat_ * M_PI / 180.0;
+  const float sLonRad = sunLon_ * M_PI / 180.0;
+  const float sx = std::cos(sLatRad) * std::cos(sLonRad);
+  const float sy = std::cos(sLatRad) * std::sin(sLonRad);
+  const float sz = std::sin(sLatRad);
+
+  // cos(zenith) = vertex . sun. Plain SoA loops so the compiler vectorizes
+  // both the dot product and the LUT index computation.
+  m.cosZ.resize(n);
+  const float *__restrict ux = m.ux.data();
+  const float *__restrict uy = m.uy.data();
+  const float *__restrict uz = m.uz.data();
+  float *__restrict cz = m.cosZ.data();
+  for (size_t i = 0; i < n; ++i)
+    cz[i] = ux[i] * sx + uy[i] * sy + uz[i] * sz;
+
+  const Uint8 *lut = graylineLut();
+  constexpr float kScale = (kGraylineLutSize - 1) / GRAYLINE_COS;
+  const Uint8 *valid = m.valid.data();
+  Uint8 *alpha = m.alpha.data();
+  for (size_t i = 0; i < n; ++i) {
+    float t = std::clamp(cz[i] * kScale, 0.0f, (float)(kGraylineLutSize - 1));
+    alpha[i] = valid[i] ? lut[static_cast<int>(t + 0.5f)] : 0;
+  }
+
+  for (size_t i = 0; i < n; ++i) {
+    shadowVerts_[i].color.a = alpha[i];
+    lightVerts_[i].color.a = alpha[i];
+  }
+
+  // Adaptive triangulation: fully lit cells are skipped, uniformly dark cells
+  // are drawn as one quad, and only cells containing the grayline use the
+  // refined lattice.
+  nightIndices_.clear();
+  const int w = m.latticeW;
+  auto addQuad = [&](int p0, int p1, int p2, int p3) {
+    nightIndices_.push_back(p0);
+    nightIndices_.push_back(p1);
+    nightIndices_.push_back(p2);
+    nightIndices_.push_back(p2);
+    nightIndices_.push_back(p1);
+    nightIndices_.push_back(p3);
+  };
+  for (int cj = 0; cj < m.cellsH; ++cj) {
+    for (int ci = 0; ci < m.cellsW; ++ci) {
+      const int base = cj * m.sub * w + ci * m.sub;
+      Uint8 lo = 255, hi = 0;
+      for (int b = 0; b <= m.sub; ++b) {
+        for (int a = 0; a <= m.sub; ++a) {
+          Uint8 v = alpha[base + b * w + a];
+          lo = std::min(lo, v);
+          hi = std::max(hi, v);
+        }
+      }
+      if (hi == 0)
+        continue;
+      if (lo == hi) {
+        addQuad(base, base + m.sub, base + m.sub * w,
+                base + m.sub * w + m.sub);
+        continue;
+      }
+      for (int b = 0; b < m.sub; ++b) {
+        for (int a = 0; a < m.sub; ++a) {
+          int p0 = base + b * w + a;
+          addQuad(p0, p0 + 1, p0 + w, p0 + w + 1);
+        }
+      }
+    }
+  }
+}
+
+void MapWidget::renderNightOverlay(SDL_Renderer *renderer) {
   SDL_Rect clip = mapRect_;
   SDL_RenderSetClipRect(renderer, &clip);
 
@@ -673,72 +797,35 @@ void MapWidget::renderNightOverlay(SDL_Renderer *renderer) {
   // Force blend mode for geometry shading
   SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
 
-  // Reuse buffers and only recompute if the sun has moved or size changed
+  // Coarse cells are subdivided kNightSub x kNightSub where they contain the
+  // grayline. Low-memory mode: fewer cells on KMSDRM.
+  constexpr int kNightSub = 4;
+  const int cellsW = useCompatibilityRenderPath_ ? 24 : 48;
+  const int cellsH = cellsW / 2;
+
+  const NightMesh &m = nightMesh_;
   bool needsUpdate =
       (std::abs(lastUpdateSunLat_ - sunLat_) > 0.001 ||
        std::abs(lastUpdateSunLon_ - sunLon_) > 0.001 || shadowVerts_.empty());
 
-  if (shadowVerts_.size() != (size_t)((gridW + 1) * (gridH + 1))) {
-    shadowVerts_.resize((gridW + 1) * (gridH + 1));
-    lightVerts_.resize((gridW + 1) * (gridH + 1));
+  if (m.cellsW != cellsW || m.sub != kNightSub || m.rect.x != mapRect_.x ||
+      m.rect.y != mapRect_.y || m.rect.w != mapRect_.w ||
+      m.rect.h != mapRect_.h || m.projection != config_.projection) {
+    rebuildNightLattice(cellsW, cellsH, kNightSub);
     needsUpdate = true;
   }
 
   if (needsUpdate) {
-    for (int j = 0; j <= gridH; ++j) {
-      float sy = mapRect_.y + (float)j * mapRect_.h / gridH;
-      for (int i = 0; i <= gridW; ++i) {
-        float sx = mapRect_.x + (float)i * mapRect_.w / gridW;
-        int idx = j * (gridW + 1) + i;
-
-        double lat, lon;
-        if (screenToLatLon((int)sx, (int)sy, lat, lon)) {
-          double latRad = lat * M_PI / 180.0;
-          double dLonRad = (lon * M_PI / 180.0) - sLonRad;
-          double cosZ = sinSLat * std::sin(latRad) +
-                        cosSLat * std::cos(latRad) * std::cos(dLonRad);
-          float fd =
-              (cosZ > 0)
-                  ? 1.0f
-                  : (cosZ > GRAYLINE_COS
-                         ? 1.0f - std::pow(cosZ / GRAYLINE_COS, GRAYLINE_POW)
-                         : 0.0f);
-          float nf = 1.0f - fd;
-
-          // Projection-aware texture coordinates for night lights
-          float u = static_cast<float>((lon + 180.0) / 360.0);
-          float v = static_cast<float>((90.0 - lat) / 180.0);
-          shadowVerts_[idx] = {
-              {sx, sy}, {255, 255, 255, (Uint8)(nf * 255)}, {0, 0}};
-          lightVerts_[idx] = {
-              {sx, sy}, {255, 255, 255, (Uint8)(nf * 255)}, {u, v}};
-        } else {
-          shadowVerts_[idx] = {{sx, sy}, {0, 0, 0, 0}, {0, 0}};
-          lightVerts_[idx] = {{sx, sy}, {0, 0, 0, 0}, {0, 0}};
-        }
-      }
-    }
+    updateNightShading();
     lastUpdateSunLat_ = sunLat_;
     lastUpdateSunLon_ = sunLon_;
   }
 
-  if (nightIndices_.size() != (size_t)(gridW * gridH * 6)) {
-    nightIndices_.clear();
-    nightIndices_.reserve(gridW * gridH * 6);
-    for (int j = 0; j < gridH; ++j) {
-      for (int i = 0; i < gridW; ++i) {
-        int p0 = j * (gridW + 1) + i;
-        int p1 = p0 + 1;
-        int p2 = (j + 1) * (gridW + 1) + i;
-        int p3 = p2 + 1;
-        nightIndices_.push_back(p0);
-        nightIndices_.push_back(p1);
-        nightIndices_.push_back(p2);
-        nightIndices_.push_back(p2);
-        nightIndices_.push_back(p1);
-        nightIndices_.push_back(p3);
-      }
-    }
+  // Nothing to shade (every cell fully lit); an empty index list would make
+  // SDL draw the raw vertex array instead.
+  if (nightIndices_.empty()) {
+    SDL_RenderSetClipRect(renderer, nullptr);
+    return;
   }
 
   // Draw shaded overlay using a BLACK texture and WHITE vertex colors
@@ -767,6 +854,13 @@ void MapWidget::renderNightOverlay(SDL_Renderer *renderer) {
   // -------------------------------------------------------------------------
   SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
 
+  const float sLatRad = sunLat_ * M_PI / 180.0;
+  const float sLonRad = sunLon_ * M_PI / 180.0;
+  const float sinSLat = std::sin(sLatRad);
+  const float cosSLat = std::cos(sLatRad);
+  const int gridW = useCompatibilityRenderPath_ ? 48 : 96;
+  const int gridH = useCompatibilityRenderPath_ ? 24 : 48;
+
   // 1. Draw shading
   for (int j = 0; j < gridH; ++j) {
     int y1 = mapRect_.y + j * mapRect_.h / gridH;
@@ -873,7 +967,8 @@ void MapWidget::render(SDL_Renderer *renderer) {
 
     if (!pendingMapData_.empty()) {
       SDL_Texture *mapTex =
-          texMgr_.loadFromMemory(renderer, MAP_KEY, pendingMapData_);
+          texMgr_.loadFromMemory(renderer, MAP_KEY, pendingMapData_,
+                                 [this] { fetchMapImage(mapUrl_, false); });
       if (mapTex) {
         SDL_SetTextureBlendMode(mapTex, SDL_BLENDMODE_NONE);
       } else {
@@ -885,7 +980,8 @@ void MapWidget::render(SDL_Renderer *renderer) {
     }
     if (!pendingNightMapData_.empty()) {
       SDL_Texture *nightTex =
-          texMgr_.loadFromMemory(renderer, NIGHT_MAP_KEY, pendingNightMapData_);
+          texMgr_.loadFromMemory(renderer, NIGHT_MAP_KEY, pendingNightMapData_,
+                                 [this] { fetchMapImage(kNightMapUrl, true); });
       if (!nightTex) {
         LOG_E("MapWidget",
               "Failed to create night map texture from {} bytes: {}",
@@ -950,57 +1046,60 @@ void MapWidget::render(SDL_Renderer *renderer) {
         }
 
         // Also ensure indices are ready
-        if (nightIndices_.size() != (size_t)(gridW * gridH * 6)) {
-          nightIndices_.clear();
-          nightIndices_.reserve(gridW * gridH * 6);
+        if (mapIndices_.size() != (size_t)(gridW * gridH * 6)) {
+          mapIndices_.clear();
+          mapIndices_.reserve(gridW * gridH * 6);
           for (int j = 0; j < gridH; ++j) {
             for (int i = 0; i < gridW; ++i) {
               int p0 = j * (gridW + 1) + i;
               int p1 = p0 + 1;
               int p2 = (j + 1) * (gridW + 1) + i;
               int p3 = p2 + 1;
-              nightIndices_.push_back(p0);
-              nightIndices_.push_back(p1);
-              nightIndices_.push_back(p2);
-              nightIndices_.push_back(p2);
-              nightIndices_.push_back(p1);
-              nightIndices_.push_back(p3);
+              mapIndices_.push_back(p0);
+              mapIndices_.push_back(p1);
+              mapIndices_.push_back(p2);
+              mapIndices_.push_back(p2);
+              mapIndices_.push_back(p1);
+              mapIndices_.push_back(p3);
             }
           }
         }
       }
 
       SDL_RenderGeometry(renderer, mapTex, mapVerts_.data(),
-                         (int)mapVerts_.size(), nightIndices_.data(),
-                         (int)nightIndices_.size());
+                         (int)mapVerts_.size(), mapIndices_.data(),
+                         (int)mapIndices_.size());
     } else {
       SDL_RenderCopy(renderer, mapTex, nullptr, &mapRect_);
     }
   }
 
           renderPropagationOverlay(renderer);
+          renderDrapOverlay(renderer);
+          renderAuroraOverlay(renderer);
           renderMufRtOverlay(renderer);
           renderWxMbOverlay(renderer);
           renderNightOverlay(renderer);
           renderGridOverlay(renderer);
   renderGreatCircle(renderer);
 
-  renderMarker(renderer, state_->deLocation.lat, state_->deLocation.lon, 255,
-               165, 0);
+  batch_.begin(renderer);
+  renderMarker(state_->deLocation.lat, state_->deLocation.lon, 255, 165, 0);
   if (state_->dxActive) {
-    renderMarker(renderer, state_->dxLocation.lat, state_->dxLocation.lon, 0,
-                 255, 0);
+    renderMarker(state_->dxLocation.lat, state_->dxLocation.lon, 0, 255, 0);
   }
+  batch_.flush();
 
-  renderAuroraOverlay(renderer);
   renderSatellite(renderer);
   renderSpotOverlay(renderer);
   renderDXClusterSpots(renderer);
       renderADIFPins(renderer);
       renderONTASpots(renderer);
       renderBeacons(renderer);
-  
-      renderMarker(renderer, sunLat_, sunLon_, 255, 255, 0, MarkerShape::Circle,               true);
+
+  batch_.begin(renderer);
+  renderMarker(sunLat_, sunLon_, 255, 255, 0, MarkerShape::Circle, true);
+  batch_.flush();
 
   renderProjectionSelect(renderer);
   renderRssButton(renderer);
@@ -1102,86 +1201,117 @@ void MapWidget::renderSatFootprint(SDL_Renderer *renderer, double lat,
   SDL_RenderSetClipRect(renderer, nullptr);
 }
 
-void MapWidget::renderSatGroundTrack(SDL_Renderer *renderer) {
-  if (cachedSatTrack_.size() < 2)
-    return;
+void MapWidget::updateSatTrack(std::time_t now) {
+  constexpr int kTrackMinutes = 90;
 
-  SDL_RenderSetClipRect(renderer, &mapRect_);
-  SDL_Texture *lineTex = texMgr_.get(LINE_AA_KEY);
-  if (!lineTex)
+  if (predictor_->generation() != satTrackGeneration_) {
+    satTrackGeneration_ = predictor_->generation();
+    satTrack_.clear();
+    satTrackDirty_ = true;
+  }
+
+  // Drop samples the satellite has passed, keeping the one just behind it
+  // so the track starts at the satellite.
+  size_t expired = 0;
+  while (expired + 1 < satTrack_.size() && satTrack_[expired + 1].t <= now)
+    ++expired;
+  if (expired > 0) {
+    satTrack_.erase(satTrack_.begin(), satTrack_.begin() + expired);
+    if (!satTrackDirty_) {
+      // The segment ending at the new front joined it to a dropped sample.
+      size_t verts = 0;
+      for (size_t i = 0; i <= expired; ++i)
+        verts += satTrackSegVerts_[i];
+      satTrackVerts_.erase(satTrackVerts_.begin(),
+                           satTrackVerts_.begin() + verts);
+      satTrackSegVerts_.erase(satTrackSegVerts_.begin(),
+                              satTrackSegVerts_.begin() + expired);
+      satTrackSegVerts_.front() = 0;
+    }
+  }
+
+  // A stale window (e.g. after a suspend) is cheaper to start over.
+  if (!satTrack_.empty() && satTrack_.back().t < now) {
+    satTrack_.clear();
+    satTrackDirty_ = true;
+  }
+
+  size_t first = satTrack_.size();
+  predictor_->extendGroundTrack(satTrack_, now, now + kTrackMinutes * 60);
+  if (!satTrackDirty_) {
+    for (size_t i = first; i < satTrack_.size(); ++i)
+      appendSatTrackSegment(i);
+  }
+}
+
+void MapWidget::appendSatTrackSegment(size_t i) {
+  if (i == 0) {
+    satTrackSegVerts_.push_back(0);
     return;
+  }
 
-  if (satTrackDirty_) {
-    satTrackVerts_.clear();
-    satTrackIndices_.clear();
+  const float r = 1.5f / 2.0f;
+  const SDL_Color color = {255, 200, 0, 150};
+  size_t before = satTrackVerts_.size();
 
-    float thickness = 1.5f;
-    float r = thickness / 2.0f;
-    SDL_Color color = {255, 200, 0, 150};
+  // Two triangles per quad, unindexed, so the strip can be trimmed from
+  // the front without rebasing indices.
+  auto addQuad = [&](SDL_FPoint p1, SDL_FPoint p2) {
+    float dx = p2.x - p1.x;
+    float dy = p2.y - p1.y;
+    float len = std::sqrt(dx * dx + dy * dy);
+    if (len < 0.1f)
+      return;
 
-    std::vector<SDL_FPoint> segment;
-    auto add_segment_geom = [&](const std::vector<SDL_FPoint> &seg) {
-      for (size_t i = 1; i < seg.size(); i++) {
-        SDL_FPoint p1 = seg[i - 1];
-        SDL_FPoint p2 = seg[i];
-        float dx = p2.x - p1.x;
-        float dy = p2.y - p1.y;
-        float len = std::sqrt(dx * dx + dy * dy);
-        if (len < 0.1f)
-          continue;
+    float nx = -dy / len * r;
+    float ny = dx / len * r;
+    SDL_Vertex v0 = {{p1.x + nx, p1.y + ny}, color, {0, 0}};
+    SDL_Vertex v1 = {{p1.x - nx, p1.y - ny}, color, {0, 1}};
+    SDL_Vertex v2 = {{p2.x + nx, p2.y + ny}, color, {1, 0}};
+    SDL_Vertex v3 = {{p2.x - nx, p2.y - ny}, color, {1, 1}};
+    satTrackVerts_.insert(satTrackVerts_.end(), {v0, v1, v2, v1, v2, v3});
+  };
 
-        float nx = -dy / len * r;
-        float ny = dx / len * r;
+  const GroundTrackPoint &a = satTrack_[i - 1];
+  const GroundTrackPoint &b = satTrack_[i];
+  if (std::fabs(a.lon - b.lon) > 180.0) {
+    // Split at the dateline, interpolating the crossing latitude.
+    double lon1Adj = (b.lon < 0) ? b.lon + 360.0 : b.lon - 360.0;
+    double borderLon = (b.lon < 0) ? 180.0 : -180.0;
+    double f = (borderLon - a.lon) / (lon1Adj - a.lon);
+    double borderLat = a.lat + f * (b.lat - a.lat);
+    addQuad(latLonToScreen(a.lat, a.lon), latLonToScreen(borderLat, borderLon));
+    addQuad(latLonToScreen(borderLat, -borderLon), latLonToScreen(b.lat, b.lon));
+  } else {
+    addQuad(latLonToScreen(a.lat, a.lon), latLonToScreen(b.lat, b.lon));
+  }
+  satTrackSegVerts_.push_back(static_cast<int>(satTrackVerts_.size() - before));
+}
 
-        int base = static_cast<int>(satTrackVerts_.size());
-        satTrackVerts_.push_back({{p1.x + nx, p1.y + ny}, color, {0, 0}});
-        satTrackVerts_.push_back({{p1.x - nx, p1.y - ny}, color, {0, 1}});
-        satTrackVerts_.push_back({{p2.x + nx, p2.y + ny}, color, {1, 0}});
-        satTrackVerts_.push_back({{p2.x - nx, p2.y - ny}, color, {1, 1}});
-
-        satTrackIndices_.push_back(base + 0);
-        satTrackIndices_.push_back(base + 1);
-        satTrackIndices_.push_back(base + 2);
-        satTrackIndices_.push_back(base + 1);
-        satTrackIndices_.push_back(base + 2);
-        satTrackIndices_.push_back(base + 3);
-      }
-    };
+void MapWidget::renderSatGroundTrack(SDL_Renderer *renderer) {
+  if (satTrack_.size() < 2)
+    return;
 
-    for (size_t i = 0; i < cachedSatTrack_.size(); ++i) {
-      if (i > 0) {
-        double lon0 = cachedSatTrack_[i - 1].lon;
-        double lon1 = cachedSatTrack_[i].lon;
-        if (std::fabs(lon0 - lon1) > 180.0) {
-          double lon1_adj = (lon1 < 0) ? lon1 + 360.0 : lon1 - 360.0;
-          double borderLon = (lon1 < 0) ? 180.0 : -180.0;
-          double f = (borderLon - lon0) / (lon1_adj - lon0);
-          double borderLat =
-              cachedSatTrack_[i - 1].lat +
-              f * (cachedSatTrack_[i].lat - cachedSatTrack_[i - 1].lat);
+  SDL_Texture *lineTex = texMgr_.get(LINE_AA_KEY);
+  if (!lineTex)
+    return;
 
-          segment.push_back(latLonToScreen(borderLat, borderLon));
-          add_segment_geom(segment);
-          segment.clear();
-          segment.push_back(latLonToScreen(borderLat, -borderLon));
-        }
-      }
-      segment.push_back(
-          latLonToScreen(cachedSatTrack_[i].lat, cachedSatTrack_[i].lon));
-    }
-    if (segment.size() >= 2) {
-      add_segment_geom(segment);
-    }
+  // Full rebuild only when the projection or map rect changed; otherwise
+  // updateSatTrack() keeps the strip in step with the samples.
+  if (satTrackDirty_) {
+    satTrackVerts_.clear();
+    satTrackSegVerts_.clear();
+    for (size_t i = 0; i < satTrack_.size(); ++i)
+      appendSatTrackSegment(i);
     satTrackDirty_ = false;
   }
 
   if (!satTrackVerts_.empty()) {
+    SDL_RenderSetClipRect(renderer, &mapRect_);
     SDL_RenderGeometry(renderer, lineTex, satTrackVerts_.data(),
-                       (int)satTrackVerts_.size(), satTrackIndices_.data(),
-                       (int)satTrackIndices_.size());
+                       static_cast<int>(satTrackVerts_.size()), nullptr, 0);
+    SDL_RenderSetClipRect(renderer, nullptr);
   }
-
-  SDL_RenderSetClipRect(renderer, nullptr);
 }
 
 void MapWidget::renderSpotOverlay(SDL_Renderer *renderer) {
@@ -1216,17 +1346,15 @@ void MapWidget::renderSpotOverlay(SDL_Renderer *renderer) {
   if (!anySelected)
     return;
 
-  SDL_RenderSetClipRect(renderer, &mapRect_);
   LatLon de = state_->deLocation;
   SDL_Texture *lineTex = texMgr_.get(LINE_AA_KEY);
   SDL_Texture *markerTex = texMgr_.get("marker_square");
   if (!lineTex || !markerTex)
     return;
 
-  spotVerts_.clear();
-  spotIndices_.clear();
-  markerVerts_.clear();
-  markerIndices_.clear();
+  SDL_RenderSetClipRect(renderer, &mapRect_);
+  batch_.begin(renderer);
+  spotMarkers_.clear();
 
   int renderedCount = 0;
   const int MAX_MAP_SPOTS = useCompatibilityRenderPath_ ? 100 : 200;
@@ -1254,30 +1382,12 @@ void MapWidget::renderSpotOverlay(SDL_Renderer *renderer) {
     // Batch Lines
     float thickness = 1.3f;
 
-    float r = thickness / 2.0f;
-
     auto addLine = [&](SDL_FPoint p1, SDL_FPoint p2) {
       float dx = p2.x - p1.x;
       float dy = p2.y - p1.y;
-      float len = std::sqrt(dx * dx + dy * dy);
-      if (len < 0.1f)
+      if (dx * dx + dy * dy < 0.01f)
         return;
-
-      float nx = -dy / len * r;
-      float ny = dx / len * r;
-
-      int base = static_cast<int>(spotVerts_.size());
-      spotVerts_.push_back({{p1.x + nx, p1.y + ny}, color, {0, 0}});
-      spotVerts_.push_back({{p1.x - nx, p1.y - ny}, color, {0, 1}});
-      spotVerts_.push_back({{p2.x + nx, p2.y + ny}, color, {1, 0}});
-      spotVerts_.push_back({{p2.x - nx, p2.y - ny}, color, {1, 1}});
-
-      spotIndices_.push_back(base + 0);
-      spotIndices_.push_back(base + 1);
-      spotIndices_.push_back(base + 2);
-      spotIndices_.push_back(base + 1);
-      spotIndices_.push_back(base + 2);
-      spotIndices_.push_back(base + 3);
+      batch_.texturedLine(lineTex, p1.x, p1.y, p2.x, p2.y, thickness, color);
     };
 
     for (size_t i = 1; i < path.size(); ++i) {
@@ -1305,33 +1415,18 @@ void MapWidget::renderSpotOverlay(SDL_Renderer *renderer) {
       }
     }
 
-    // Batch Marker (as a small quad)
-    SDL_FPoint mPt = latLonToScreen(lat, lon);
-    float mSize = 3.0f;
-    int mBase = static_cast<int>(markerVerts_.size());
-    markerVerts_.push_back({{mPt.x - mSize, mPt.y - mSize}, mColor, {0, 0}});
-    markerVerts_.push_back({{mPt.x + mSize, mPt.y - mSize}, mColor, {1, 0}});
-    markerVerts_.push_back({{mPt.x - mSize, mPt.y + mSize}, mColor, {0, 1}});
-    markerVerts_.push_back({{mPt.x + mSize, mPt.y + mSize}, mColor, {1, 1}});
-
-    markerIndices_.push_back(mBase + 0);
-    markerIndices_.push_back(mBase + 1);
-    markerIndices_.push_back(mBase + 2);
-    markerIndices_.push_back(mBase + 1);
-    markerIndices_.push_back(mBase + 2);
-    markerIndices_.push_back(mBase + 3);
+    // Markers go on top of every path, so queue them for a second pass
+    spotMarkers_.push_back({latLonToScreen(lat, lon), mColor});
   }
 
-  if (!spotVerts_.empty()) {
-    SDL_RenderGeometry(renderer, lineTex, spotVerts_.data(),
-                       (int)spotVerts_.size(), spotIndices_.data(),
-                       (int)spotIndices_.size());
-  }
-  if (!markerVerts_.empty()) {
-    SDL_RenderGeometry(renderer, markerTex, markerVerts_.data(),
-                       (int)markerVerts_.size(), markerIndices_.data(),
-                       (int)markerIndices_.size());
+  // Markers as small quads, all in one draw call
+  const float mSize = 3.0f;
+  for (const auto &[mPt, mColor] : spotMarkers_) {
+    batch_.sprite(markerTex,
+                  {mPt.x - mSize, mPt.y - mSize, mSize * 2, mSize * 2},
+                  mColor);
   }
+  batch_.flush();
 
   SDL_RenderSetClipRect(renderer, nullptr);
 }
@@ -1345,6 +1440,7 @@ void MapWidget::renderDXClusterSpots(SDL_Renderer *renderer) {
 
   SDL_RenderSetClipRect(renderer, &mapRect_);
   SDL_Texture *lineTex = texMgr_.get(LINE_AA_KEY);
+  batch_.begin(renderer);
 
   // Filter spots to render
   std::vector<DXClusterSpot> spotsToRender;
@@ -1392,9 +1488,9 @@ void MapWidget::renderDXClusterSpots(SDL_Renderer *renderer) {
 
             segment.push_back(latLonToScreen(borderLat, borderLon));
             if (segment.size() >= 2) {
-              RenderUtils::drawPolylineTextured(
-                  renderer, lineTex, segment.data(),
-                  static_cast<int>(segment.size()), 1.0f, lineColor);
+              batch_.texturedPolyline(lineTex, segment.data(),
+                                      static_cast<int>(segment.size()), 1.0f,
+                                      lineColor);
             }
             segment.clear();
             segment.push_back(latLonToScreen(borderLat, -borderLon));
@@ -1403,16 +1499,28 @@ void MapWidget::renderDXClusterSpots(SDL_Renderer *renderer) {
         segment.push_back(latLonToScreen(path[i].lat, path[i].lon));
       }
       if (segment.size() >= 2) {
-        RenderUtils::drawPolylineTextured(renderer, lineTex, segment.data(),
-                                          static_cast<int>(segment.size()),
-                                          1.0f, lineColor);
+        batch_.texturedPolyline(lineTex, segment.data(),
+                                static_cast<int>(segment.size()), 1.0f,
+                                lineColor);
       }
     }
 
+    // A new DXCC gets a halo so it stands out from routine spots
+    uint8_t worked = worked_ ? worked_->lookup(spot) : spot.worked;
+    SDL_Texture *haloTex = texMgr_.get("marker_circle");
+    if ((worked & kNewDxcc) && haloTex) {
+      SDL_FPoint pt = latLonToScreen(spot.txLat, spot.txLon);
+      float haloR = std::max(7.0f, std::min(mapRect_.w, mapRect_.h) / 40.0f);
+      batch_.sprite(haloTex,
+                    {pt.x - haloR, pt.y - haloR, haloR * 2, haloR * 2},
+                    {255, 0, 255, 110});
+    }
+
     // Plot transmitter as a small circle with band color
-    renderMarker(renderer, spot.txLat, spot.txLon, color.r, color.g, color.b,
+    renderMarker(spot.txLat, spot.txLon, color.r, color.g, color.b,
                  MarkerShape::Circle, true);
   }
+  batch_.flush();
   SDL_RenderSetClipRect(renderer, nullptr);
 }
 
@@ -1424,6 +1532,7 @@ void MapWidget::renderADIFPins(SDL_Renderer *renderer) {
     return;
 
   SDL_RenderSetClipRect(renderer, &mapRect_);
+  batch_.begin(renderer);
 
   for (const auto &qso : stats.recentQSOs) {
     if (qso.lat == 0.0 && qso.lon == 0.0)
@@ -1448,10 +1557,11 @@ void MapWidget::renderADIFPins(SDL_Renderer *renderer) {
       }
     }
 
-    renderMarker(renderer, qso.lat, qso.lon, color.r, color.g, color.b,
+    renderMarker(qso.lat, qso.lon, color.r, color.g, color.b,
                  MarkerShape::Circle, true);
   }
 
+  batch_.flush();
   SDL_RenderSetClipRect(renderer, nullptr);
 }
 
@@ -1469,6 +1579,7 @@ void MapWidget::renderONTASpots(SDL_Renderer *renderer) {
 
   SDL_RenderSetClipRect(renderer, &mapRect_);
   SDL_Texture *lineTex = texMgr_.get(LINE_AA_KEY);
+  batch_.begin(renderer);
 
   // Lime Green for POTA, Cyan for SOTA
   SDL_Color color = (spot.program == "POTA") ? SDL_Color{50, 255, 50, 255}
@@ -1492,9 +1603,9 @@ void MapWidget::renderONTASpots(SDL_Renderer *renderer) {
 
         segment.push_back(latLonToScreen(borderLat, borderLon));
         if (segment.size() >= 2) {
-          RenderUtils::drawPolylineTextured(renderer, lineTex, segment.data(),
-                                            static_cast<int>(segment.size()),
-                                            1.0f, lineColor);
+          batch_.texturedPolyline(lineTex, segment.data(),
+                                  static_cast<int>(segment.size()), 1.0f,
+                                  lineColor);
         }
         segment.clear();
         segment.push_back(latLonToScreen(borderLat, -borderLon));
@@ -1503,14 +1614,14 @@ void MapWidget::renderONTASpots(SDL_Renderer *renderer) {
     segment.push_back(latLonToScreen(path[i].lat, path[i].lon));
   }
   if (segment.size() >= 2) {
-    RenderUtils::drawPolylineTextured(renderer, lineTex, segment.data(),
-                                      static_cast<int>(segment.size()), 1.0f,
-                                      lineColor);
+    batch_.texturedPolyline(lineTex, segment.data(),
+                            static_cast<int>(segment.size()), 1.0f, lineColor);
   }
 
   // Use Square markers for ONTA to differentiate from DX Cluster (Circle)
-  renderMarker(renderer, spot.lat, spot.lon, color.r, color.g, color.b,
+  renderMarker(spot.lat, spot.lon, color.r, color.g, color.b,
                MarkerShape::Square, true);
+  batch_.flush();
 
   SDL_RenderSetClipRect(renderer, nullptr);
 }
@@ -1536,6 +1647,7 @@ void MapWidget::renderBeacons(SDL_Renderer *renderer) {
   auto active = beacons_->getActiveBeacons();
 
   SDL_RenderSetClipRect(renderer, &mapRect_);
+  batch_.begin(renderer);
 
   for (size_t i = 0; i < NCDXF_BEACONS.size(); ++i) {
     const auto &b = NCDXF_BEACONS[i];
@@ -1551,15 +1663,14 @@ void MapWidget::renderBeacons(SDL_Renderer *renderer) {
 
     if (isTransmitting) {
       // Bright Yellow for transmitting
-      renderMarker(renderer, b.lat, b.lon, 255, 255, 0, MarkerShape::Circle,
-                   true);
+      renderMarker(b.lat, b.lon, 255, 255, 0, MarkerShape::Circle, true);
     } else {
       // Dim Gray for idle
-      renderMarker(renderer, b.lat, b.lon, 100, 100, 100, MarkerShape::Circle,
-                   true);
+      renderMarker(b.lat, b.lon, 100, 100, 100, MarkerShape::Circle, true);
     }
   }
 
+  batch_.flush();
   SDL_RenderSetClipRect(renderer, nullptr);
 }
 
@@ -1571,7 +1682,8 @@ void MapWidget::renderMufRtOverlay(SDL_Renderer *renderer) {
 }
 
 void MapWidget::renderPropagationOverlay(SDL_Renderer *renderer) {
-  if (config_.propOverlay == PropOverlayType::None)
+  if (config_.propOverlay == PropOverlayType::None ||
+      config_.propOverlay == PropOverlayType::Drap)
     return;
 
   if (!propTexture_)
@@ -1644,18 +1756,91 @@ void MapWidget::renderPropagationOverlay(SDL_Renderer *renderer) {
   SDL_RenderSetClipRect(renderer, nullptr);
 }
 
+void MapWidget::projectWxMbOverlay(const WxMbOverlay &overlay) {
+  wxmbIsobars_.clear();
+  wxmbArrows_.clear();
+
+  std::vector<SDL_FPoint> run;
+  for (const auto &iso : overlay.isobars) {
+    run.clear();
+    float prevLon = iso.points.front().lon;
+    for (const auto &pt : iso.points) {
+      // Break the line where it crosses the date line
+      if (std::abs(pt.lon - prevLon) > 180.0f) {
+        if (run.size() >= 2)
+          wxmbIsobars_.push_back(run);
+        run.clear();
+      }
+      run.push_back(latLonToScreen(pt.lat, pt.lon));
+      prevLon = pt.lon;
+    }
+    if (run.size() >= 2)
+      wxmbIsobars_.push_back(run);
+  }
+
+  // Arrow sizes were tuned for a 660px wide map
+  float scale = mapRect_.w / 660.0f;
+  for (const auto &w : overlay.winds) {
+    float speed = std::sqrt(w.u * w.u + w.v * w.v);
+    if (speed < 0.5f)
+      continue;
+
+    // Step along the wind in lat/lon so the arrow follows the projection
+    double cosLat = std::max(0.1, std::cos(w.lat * M_PI / 180.0));
+    SDL_FPoint base = latLonToScreen(w.lat, w.lon);
+    SDL_FPoint ahead = latLonToScreen(w.lat + 0.5 * w.v / speed,
+                                      w.lon + 0.5 * w.u / speed / cosLat);
+    float dx = ahead.x - base.x, dy = ahead.y - base.y;
+    float d = std::sqrt(dx * dx + dy * dy);
+    if (d < 1e-3f)
+      continue;
+
+    float len = std::clamp(speed * 1.2f, 2.0f, 18.0f) * scale;
+    SDL_FPoint tip = {base.x + dx / d * len, base.y + dy / d * len};
+    wxmbArrows_.push_back({base, tip});
+
+    // Arrowhead: two strokes at ±30° from the shaft
+    float headLen = std::max(3.0f * scale, len * 0.35f);
+    float angle = std::atan2(dy, dx);
+    SDL_FPoint h1 = {tip.x - std::cos(angle - 0.5236f) * headLen,
+                     tip.y - std::sin(angle - 0.5236f) * headLen};
+    SDL_FPoint h2 = {tip.x - std::cos(angle + 0.5236f) * headLen,
+                     tip.y - std::sin(angle + 0.5236f) * headLen};
+    wxmbArrows_.push_back({h1, tip, h2});
+  }
+}
+
 void MapWidget::renderWxMbOverlay(SDL_Renderer *renderer) {
   if (config_.weatherOverlay != WeatherOverlayType::WxMb)
     return;
   if (!wxmb_)
     return;
-  SDL_Texture *tex = wxmb_->getTexture(renderer, mapRect_.w, mapRect_.h);
-  if (!tex)
+  auto overlay = wxmb_->getOverlay();
+  if (!overlay)
     return;
-  SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
-  SDL_SetTextureAlphaMod(tex, 180);
+
+  // Re-project only when the data, map rect or projection changes
+  if (overlay != wxmbOverlay_ || wxmbRect_.x != mapRect_.x ||
+      wxmbRect_.y != mapRect_.y || wxmbRect_.w != mapRect_.w ||
+      wxmbRect_.h != mapRect_.h || wxmbProjection_ != config_.projection) {
+    wxmbOverlay_ = overlay;
+    wxmbRect_ = mapRect_;
+    wxmbProjection_ = config_.projection;
+    projectWxMbOverlay(*overlay);
+  }
+
+  SDL_Texture *lineTex = texMgr_.get(LINE_AA_KEY);
   SDL_RenderSetClipRect(renderer, &mapRect_);
-  SDL_RenderCopy(renderer, tex, nullptr, &mapRect_);
+  for (const auto &line : wxmbIsobars_) {
+    RenderUtils::drawPolylineTextured(renderer, lineTex, line.data(),
+                                      static_cast<int>(line.size()), 1.2f,
+                                      {255, 255, 255, 140});
+  }
+  for (const auto &arrow : wxmbArrows_) {
+    RenderUtils::drawPolylineTextured(renderer, lineTex, arrow.data(),
+                                      static_cast<int>(arrow.size()), 1.2f,
+                                      {255, 255, 255, 100});
+  }
   SDL_RenderSetClipRect(renderer, nullptr);
 }
 
@@ -1703,22 +1888,37 @@ void MapWidget::updatePropagationOverlay() {
   
   PropOverlayType overlayType = config_.propOverlay;
   
-  // MUF (RT) uses real-time ionosonde data; VOACAP/Reliability use solar models
-  auto *ionoProvider = (overlayType == PropOverlayType::Muf) ? iono_ : nullptr;
-
-  WorkerService::getInstance().submitTask(
-      [params, sw, ionoProvider, outputType, overlayType]() {
-        auto grid =
-            PropEngine::generateGrid(params, sw, ionoProvider, outputType);
-
-        auto *result = new std::vector<float>(std::move(grid));
-        SDL_Event event;
-        SDL_zero(event);
-        event.type = HamClock::AE_BASE_EVENT + HamClock::AE_PROP_DATA_READY;
-        event.user.code = static_cast<int>(overlayType);
-        event.user.data1 = result;
-        SDL_PushEvent(&event);
-      });
+  // MUF (RT) and VOACAP use real-time ionosonde data; Reliability uses solar
+  // models
+  auto *ionoProvider = (overlayType == PropOverlayType::Muf ||
+                        overlayType == PropOverlayType::Voacap)
+                           ? iono_
+                           : nullptr;
+
+  // Reliability is cut by D-region absorption where DRAP reports it
+  propDrap_.reset();
+  if ((overlayType == PropOverlayType::Reliability ||
+       overlayType == PropOverlayType::Voacap) &&
+      drapStore_)
+    propDrap_ = drapStore_->gridSnapshot();
+
+  // A newer request supersedes one still queued or awaiting the main thread.
+  propRequest_.cancel();
+  propRequest_ = CancelToken();
+  WorkerService::getInstance().submitThen(
+      [params, sw, ionoProvider, outputType, overlayType,
+       drap = propDrap_]() {
+        if (overlayType == PropOverlayType::Voacap)
+          return PropEngine::generateCoverage(params, sw, ionoProvider,
+                                              CoverageOutput::Reliability,
+                                              drap.get());
+        return PropEngine::generateGrid(params, sw, ionoProvider, outputType,
+                                        drap.get());
+      },
+      [this, overlayType](std::vector<float> grid) {
+        onPropDataReady(overlayType, grid);
+      },
+      TaskPriority::Interactive, propRequest_);
 }
 
 void MapWidget::onPropDataReady(PropOverlayType type,
@@ -1730,7 +1930,7 @@ void MapWidget::onPropDataReady(PropOverlayType type,
   // We use standard SDL_Renderer from main, but MapWidget doesn't store it.
   // We'll use the one from the last render call or just create it lazily.
   // Actually, we can't create textures on background threads, and this
-  // method is called on the MAIN thread via SDL_PushEvent handler.
+  // method is called on the MAIN thread from WorkerService::drainCompletions().
 
   // We need a renderer. We'll grab it from the window.
   SDL_Window *win = SDL_GL_GetCurrentWindow();
@@ -1742,11 +1942,14 @@ void MapWidget::onPropDataReady(PropOverlayType type,
     propTexture_ = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32,
                                      SDL_TEXTUREACCESS_STATIC,
                                      PropEngine::MAP_W, PropEngine::MAP_H);
+    MemoryMonitor::getInstance().trackTexture(propTexture_, "MapWidget");
   }
 
   std::vector<uint32_t> pixels(grid.size());
+  bool reliability = type == PropOverlayType::Reliability ||
+                     type == PropOverlayType::Voacap;
   float maxVal;
-  if (type == PropOverlayType::Reliability) maxVal = 100.0f;
+  if (reliability) maxVal = 100.0f;
   else if (type == PropOverlayType::Toa)    maxVal = 40.0f;
   else                                       maxVal = 50.0f; // MUF
 
@@ -1756,7 +1959,7 @@ void MapWidget::onPropDataReady(PropOverlayType type,
     t = std::max(0.0f, std::min(t, 1.0f));
 
     uint8_t r = 0, g = 0, b = 0;
-    if (type == PropOverlayType::Reliability) {
+    if (reliability) {
         // Reliability: Grey -> Yellow -> Green
         if (t < 0.5f) {
             float f = t / 0.5f;
@@ -1981,11 +2184,6 @@ nlohmann::json MapWidget::getDebugData() const {
   return j;
 }
 
-void MapWidget::onSatTrackReady(const std::vector<GroundTrackPoint> &track) {
-  cachedSatTrack_ = track;
-  satTrackDirty_ = true;
-}
-
 void MapWidget::renderGridOverlay(SDL_Renderer *renderer) {
   if (!config_.showGrid)
     return;
@@ -2047,70 +2245,187 @@ void MapWidget::renderGridOverlay(SDL_Renderer *renderer) {
   }
 }
 
+void MapWidget::updateAuroraTexture(SDL_Renderer *renderer,
+                                    const AuroraGrid &grid) {
+  if (!auroraTexture_) {
+    auroraTexture_ =
+        SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32,
+                          SDL_TEXTUREACCESS_STATIC, AuroraGrid::W, AuroraGrid::H);
+    if (!auroraTexture_) {
+      LOG_E("MapWidget", "Failed to create aurora texture: {}",
+            SDL_GetError());
+      return;
+    }
+    // Re-colorized from the current grid snapshot on next use if evicted.
+    MemoryMonitor::getInstance().trackTexture(
+        auroraTexture_, "MapWidget", [this](SDL_Texture *) {
+          MemoryMonitor::getInstance().destroyTexture(auroraTexture_);
+          auroraGrid_.reset();
+        });
+    SDL_SetTextureBlendMode(auroraTexture_, SDL_BLENDMODE_BLEND);
+    SDL_SetTextureScaleMode(auroraTexture_, SDL_ScaleModeLinear);
+  }
+
+  // Texture layout matches the base map: column 0 is 180W, row 0 is 90N.
+  std::vector<uint32_t> pixels(AuroraGrid::W * AuroraGrid::H);
+  for (int row = 0; row < AuroraGrid::H; ++row) {
+    int lat = 90 - row;
+    for (int col = 0; col < AuroraGrid::W; ++col) {
+      int lon = (col + 180) % AuroraGrid::W;
+      float t = std::min(grid.at(lon, lat), 100.0f) / 100.0f;
+
+      // Green -> yellow -> red, fading in from transparent below ~5%.
+      uint8_t r = 0, g = 255, b = 0, a = 0;
+      if (t > 0.05f) {
+        if (t < 0.5f) {
+          r = (uint8_t)(t * 2.0f * 255.0f);
+        } else {
+          r = 255;
+          g = (uint8_t)((1.0f - (t - 0.5f) * 2.0f) * 255.0f);
+        }
+        a = (uint8_t)(std::min(1.0f, 0.35f + t) * 200.0f);
+      }
+      pixels[row * AuroraGrid::W + col] =
+          (uint32_t(a) << 24) | (uint32_t(b) << 16) | (uint32_t(g) << 8) | r;
+    }
+  }
+  SDL_UpdateTexture(auroraTexture_, nullptr, pixels.data(),
+                    AuroraGrid::W * sizeof(uint32_t));
+}
+
 void MapWidget::renderAuroraOverlay(SDL_Renderer *renderer) {
-  if (!auroraStore_)
+  if (!config_.showAurora || !auroraStore_)
     return;
 
-  // For now, we'll fetch the JSON data directly from NOAA
-  // In a production implementation, this should be cached/shared with
-  // NOAAProvider
-  static std::string cachedAuroraData;
-  static uint32_t lastFetchTime = 0;
-  uint32_t now = SDL_GetTicks();
-
-  // Fetch every 30 minutes
-  if (cachedAuroraData.empty() || (now - lastFetchTime) > 1800000) {
-    // For now, skip the fetch and just return
-    // TODO: Share the Aurora JSON data from NOAAProvider
+  // Only re-colorize when NOAAProvider has published a new grid.
+  auto grid = auroraStore_->gridSnapshot();
+  if (!grid)
     return;
+  if (grid != auroraGrid_) {
+    auroraGrid_ = grid;
+    updateAuroraTexture(renderer, *grid);
   }
-
-  // Parse the JSON and render green glows
-  // Format: "coordinates":[[lon,lat,val],...]
-  size_t coords_pos = cachedAuroraData.find("\"coordinates\"");
-  if (coords_pos == std::string::npos)
+  if (!auroraTexture_)
     return;
+  MemoryMonitor::getInstance().touchTexture(auroraTexture_);
 
-  SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+  SDL_RenderSetClipRect(renderer, &mapRect_);
+  if (config_.projection != "equirectangular" && !mapVerts_.empty()) {
+    // Same lat/lon mesh as the base map, so the oval warps with it.
+    SDL_RenderGeometry(renderer, auroraTexture_, mapVerts_.data(),
+                       (int)mapVerts_.size(), mapIndices_.data(),
+                       (int)mapIndices_.size());
+  } else {
+    SDL_RenderCopy(renderer, auroraTexture_, nullptr, &mapRect_);
+  }
+  SDL_RenderSetClipRect(renderer, nullptr);
+}
 
-  size_t p = coords_pos;
-  while ((p = cachedAuroraData.find('[', p)) != std::string::npos) {
-    int lon, lat, val;
-    if (sscanf(cachedAuroraData.c_str() + p, "[%d,%d,%d]", &lon, &lat, &val) ==
-            3 ||
-        sscanf(cachedAuroraData.c_str() + p, "[%d, %d, %d]", &lon, &lat,
-               &val) == 3) {
-      if (val > 0) {
-        // Convert lon (0-359) to -180 to 180
-        double longitude = lon;
-        if (longitude >= 180)
-          longitude -= 360;
-
-        // Map to screen coordinates
-        SDL_FPoint screenPos = latLonToScreen(lat, longitude);
-
-        // Calculate alpha based on value (0-100)
-        Uint8 alpha = static_cast<Uint8>((val * 255) / 100);
-        if (alpha > 255)
-          alpha = 255;
-
-        // Draw green glow
-        SDL_SetRenderDrawColor(renderer, 0, 255, 0, alpha);
-
-        // Draw a small filled circle for the glow
-        int radius = 3;
-        for (int dy = -radius; dy <= radius; dy++) {
-          for (int dx = -radius; dx <= radius; dx++) {
-            if (dx * dx + dy * dy <= radius * radius) {
-              SDL_RenderDrawPoint(renderer, static_cast<int>(screenPos.x) + dx,
-                                  static_cast<int>(screenPos.y) + dy);
-            }
+// Overlay opacity (percent) on top of drapColor's own alpha ramp. Fixed,
+// not config_.mufRtOpacity: that slider is for the MUF/VOACAP overlays.
+static constexpr int kDrapOpacity = 70;
+
+// Highest frequency with 1 dB of absorption, 0..35 MHz: clear where there
+// is none, then blue -> green -> yellow -> red.
+static uint32_t drapColor(float mhz) {
+  if (mhz < 1.0f)
+    return 0;
+  float t = std::min(mhz / 35.0f, 1.0f);
+  uint8_t r = 0, g = 0, b = 0;
+  if (t < 0.33f) {
+    float f = t / 0.33f;
+    g = (uint8_t)(f * 255.0f);
+    b = (uint8_t)((1.0f - f) * 255.0f);
+  } else if (t < 0.66f) {
+    float f = (t - 0.33f) / 0.33f;
+    r = (uint8_t)(f * 255.0f);
+    g = 255;
+  } else {
+    float f = (t - 0.66f) / 0.34f;
+    r = 255;
+    g = (uint8_t)((1.0f - f) * 255.0f);
+  }
+  uint8_t a = (uint8_t)(std::min(1.0f, 0.4f + t) * 190.0f);
+  return (uint32_t(a) << 24) | (uint32_t(b) << 16) | (uint32_t(g) << 8) | r;
+}
+
+void MapWidget::updateDrapOverlay() {
+  if (!drapStore_)
+    return;
+  auto grid = drapStore_->gridSnapshot();
+  if (!grid || grid == drapGrid_)
+    return;
+  drapGrid_ = grid;
+
+  // The 4x2 degree grid is upsampled to half a degree, which is close to
+  // what the map shows; bilinear filtering in the texture covers the rest.
+  drapRequest_.cancel();
+  drapRequest_ = CancelToken();
+  WorkerService::getInstance().submitThen(
+      [grid]() {
+        constexpr int W = 720, H = 360;
+        std::vector<uint32_t> pixels(W * H);
+        for (int row = 0; row < H; ++row) {
+          double lat = 90.0 - (row + 0.5) * 180.0 / H;
+          for (int col = 0; col < W; ++col) {
+            double lon = (col + 0.5) * 360.0 / W - 180.0;
+            pixels[row * W + col] = drapColor(grid->at(lat, lon));
           }
         }
-      }
+        return pixels;
+      },
+      [this](std::vector<uint32_t> pixels) { drapPixels_ = std::move(pixels); },
+      TaskPriority::Interactive, drapRequest_);
+}
+
+void MapWidget::renderDrapOverlay(SDL_Renderer *renderer) {
+  if (config_.propOverlay != PropOverlayType::Drap)
+    return;
+
+  constexpr int W = 720, H = 360;
+  if (!drapTexture_ && !drapPixels_.empty()) {
+    drapTexture_ = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32,
+                                     SDL_TEXTUREACCESS_STREAMING, W, H);
+    if (!drapTexture_) {
+      LOG_E("MapWidget", "Failed to create DRAP texture: {}", SDL_GetError());
+      drapPixels_.clear();
+      return;
     }
-    p++;
+    // Upsampled again from the current grid on next use if evicted.
+    MemoryMonitor::getInstance().trackTexture(
+        drapTexture_, "MapWidget", [this](SDL_Texture *) {
+          MemoryMonitor::getInstance().destroyTexture(drapTexture_);
+          drapGrid_.reset();
+        });
+    SDL_SetTextureBlendMode(drapTexture_, SDL_BLENDMODE_BLEND);
+    SDL_SetTextureScaleMode(drapTexture_, SDL_ScaleModeLinear);
+  }
+  if (!drapTexture_)
+    return;
+
+  if (drapPixels_.size() == static_cast<size_t>(W * H)) {
+    void *dst = nullptr;
+    int pitch = 0;
+    if (SDL_LockTexture(drapTexture_, nullptr, &dst, &pitch) == 0) {
+      for (int row = 0; row < H; ++row)
+        std::memcpy(static_cast<uint8_t *>(dst) + row * pitch,
+                    drapPixels_.data() + row * W, W * sizeof(uint32_t));
+      SDL_UnlockTexture(drapTexture_);
+    }
+    drapPixels_.clear();
+  }
+  MemoryMonitor::getInstance().touchTexture(drapTexture_);
+
+  SDL_SetTextureAlphaMod(drapTexture_, (Uint8)(kDrapOpacity * 2.55f));
+  SDL_RenderSetClipRect(renderer, &mapRect_);
+  if (config_.projection != "equirectangular" && !mapVerts_.empty()) {
+    SDL_RenderGeometry(renderer, drapTexture_, mapVerts_.data(),
+                       (int)mapVerts_.size(), mapIndices_.data(),
+                       (int)mapIndices_.size());
+  } else {
+    SDL_RenderCopy(renderer, drapTexture_, nullptr, &mapRect_);
   }
+  SDL_RenderSetClipRect(renderer, nullptr);
 }
 
 void MapWidget::renderProjectionSelect(SDL_Renderer *renderer) {
@@ -2172,6 +2487,10 @@ void MapWidget::renderOverlayInfo(SDL_Renderer *renderer) {
                        config_.propMode, config_.propPower);
   } else if (config_.propOverlay == PropOverlayType::Toa) {
     text = "TOA Overlay";
+  } else if (config_.propOverlay == PropOverlayType::Drap) {
+    auto grid = drapStore_ ? drapStore_->gridSnapshot() : nullptr;
+    text = grid ? fmt::format("DRAP Absorption (max {:.1f} MHz)", grid->maxMhz)
+                : "DRAP Absorption";
   }
 
   if (config_.weatherOverlay == WeatherOverlayType::Clouds) {
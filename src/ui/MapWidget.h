@@ -3,29 +3,37 @@
 #include "../core/ADIFData.h"
 #include "../core/ActivityData.h"
 #include "../core/AuroraHistoryStore.h"
+#include "../core/DrapData.h"
 #include "../core/ConfigManager.h"
 #include "../core/DXClusterData.h"
 #include "../core/HamClockState.h"
 #include "../core/LiveSpotData.h"
 #include "../core/OrbitPredictor.h"
+#include "../core/Reactive.h"
+#include "../core/SolarData.h"
+#include "../core/WorkedIndex.h"
+#include "../core/WorkerService.h"
 #include "../network/NetworkManager.h"
 #include "FontManager.h"
 #include "MapViewMenu.h"
+#include "RenderUtils.h"
 #include "TextureManager.h"
 #include "Widget.h"
 
 #include <SDL.h>
 
+#include <deque>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 
 class MufRtProvider;
 class CloudProvider;
 class WxMbProvider;
+struct WxMbOverlay;
 class BeaconProvider;
 class IonosondeProvider;
-class SolarDataStore;
 class PaneContainer;
 
 class MapWidget : public Widget {
@@ -56,10 +64,18 @@ public:
     dxcStore_ = std::move(store);
   }
 
+  void setWorkedIndex(std::shared_ptr<WorkedIndex> index) {
+    worked_ = std::move(index);
+  }
+
   void setAuroraStore(std::shared_ptr<AuroraHistoryStore> store) {
     auroraStore_ = std::move(store);
   }
 
+  void setDrapStore(std::shared_ptr<DrapStore> store) {
+    drapStore_ = std::move(store);
+  }
+
   void setADIFStore(std::shared_ptr<ADIFStore> store) {
     adifStore_ = std::move(store);
   }
@@ -72,7 +88,12 @@ public:
   void setCloudProvider(CloudProvider *p) { clouds_ = p; }
   void setBeaconProvider(BeaconProvider *p) { beacons_ = p; }
   void setIonosondeProvider(IonosondeProvider *p) { iono_ = p; }
-  void setSolarDataStore(SolarDataStore *s) { solar_ = s; }
+  void setSolarDataStore(SolarDataStore *s) {
+    solar_ = s;
+    solarWatch_.reset();
+    if (s)
+      solarWatch_.emplace(s->indices());
+  }
 
   void setPanes(const std::vector<PaneContainer *> &panes) { panes_ = panes; }
 
@@ -89,34 +110,43 @@ public:
   nlohmann::json getDebugData() const override;
 
   // Thread-safe method for receiving data from background threads
-  void onSatTrackReady(const std::vector<GroundTrackPoint>& track);
   void onPropDataReady(PropOverlayType type, const std::vector<float> &grid);
 private:
   SDL_FPoint latLonToScreen(double lat, double lon) const;
   bool screenToLatLon(int sx, int sy, double &lat, double &lon) const;
   void recalcMapRect();
   void renderNightOverlay(SDL_Renderer *renderer);
+  void rebuildNightLattice(int cellsW, int cellsH, int sub);
+  void updateNightShading();
   void renderGridOverlay(SDL_Renderer *renderer);
   void renderGreatCircle(SDL_Renderer *renderer);
   enum class MarkerShape { Circle, Square };
-  void renderMarker(SDL_Renderer *renderer, double lat, double lon, Uint8 r,
-                    Uint8 g, Uint8 b, MarkerShape shape = MarkerShape::Circle,
+  // Queues the marker into batch_; the caller begins and flushes it.
+  void renderMarker(double lat, double lon, Uint8 r, Uint8 g, Uint8 b,
+                    MarkerShape shape = MarkerShape::Circle,
                     bool outline = true);
   void renderSatellite(SDL_Renderer *renderer);
   void renderSatFootprint(SDL_Renderer *renderer, double lat, double lon,
                           double footprintKm);
   void renderSatGroundTrack(SDL_Renderer *renderer);
+  void updateSatTrack(std::time_t now);
+  void appendSatTrackSegment(size_t i);
   void renderSpotOverlay(SDL_Renderer *renderer);
   void renderDXClusterSpots(SDL_Renderer *renderer);
   void renderAuroraOverlay(SDL_Renderer *renderer);
+  void updateDrapOverlay();
+  void renderDrapOverlay(SDL_Renderer *renderer);
+  void updateAuroraTexture(SDL_Renderer *renderer, const AuroraGrid &grid);
   void renderADIFPins(SDL_Renderer *renderer);
   void renderONTASpots(SDL_Renderer *renderer);
   void renderBeacons(SDL_Renderer *renderer);
   void renderMufRtOverlay(SDL_Renderer *renderer);
   void renderCloudOverlay(SDL_Renderer *renderer);
   void renderWxMbOverlay(SDL_Renderer *renderer);
+  void projectWxMbOverlay(const WxMbOverlay &overlay);
   void renderPropagationOverlay(SDL_Renderer *renderer);
   void updatePropagationOverlay();
+  void fetchMapImage(const std::string &url, bool night);
 
   TextureManager &texMgr_;
   FontManager &fontMgr_;
@@ -124,12 +154,21 @@ private:
   std::shared_ptr<HamClockState> state_;
   std::shared_ptr<LiveSpotDataStore> spotStore_;
   std::shared_ptr<DXClusterDataStore> dxcStore_;
+  std::shared_ptr<WorkedIndex> worked_;
   std::shared_ptr<AuroraHistoryStore> auroraStore_;
+  std::shared_ptr<DrapStore> drapStore_;
   std::shared_ptr<ADIFStore> adifStore_;
   std::shared_ptr<ActivityDataStore> activityStore_;
   MufRtProvider *mufrt_ = nullptr;
   CloudProvider *clouds_ = nullptr;
   std::unique_ptr<WxMbProvider> wxmb_;
+
+  // WxMb isobars and arrows projected to screen space
+  std::shared_ptr<const WxMbOverlay> wxmbOverlay_;
+  SDL_Rect wxmbRect_ = {0, 0, 0, 0};
+  std::string wxmbProjection_;
+  std::vector<std::vector<SDL_FPoint>> wxmbIsobars_;
+  std::vector<std::vector<SDL_FPoint>> wxmbArrows_;
   BeaconProvider *beacons_ = nullptr;
   IonosondeProvider *iono_ = nullptr;
   SolarDataStore *solar_ = nullptr;
@@ -141,6 +180,7 @@ private:
   SDL_Rect mapRect_ = {};
   bool mapLoaded_ = false;
   int currentMonth_ = 0; // 1-12
+  std::string mapUrl_;
 
   std::mutex mapDataMutex_;
   std::string pendingMapData_;
@@ -154,33 +194,61 @@ private:
 
   // Math caches to save CPU
   std::vector<LatLon> cachedGreatCircle_;
-  std::vector<GroundTrackPoint> cachedSatTrack_;
   std::vector<SDL_Vertex> shadowVerts_;
   std::vector<SDL_Vertex> lightVerts_;
   std::vector<SDL_Vertex> propVerts_;
   std::vector<int> nightIndices_;
+  std::vector<int> mapIndices_;
+
+  // Night overlay lattice. Screen positions, texture coordinates and unit
+  // vectors only depend on the projection and map rect, so they are cached
+  // here; a sun update is a dot product plus a LUT lookup per vertex.
+  struct NightMesh {
+    SDL_Rect rect = {};
+    std::string projection;
+    int cellsW = 0;
+    int cellsH = 0;
+    int sub = 0;      // lattice subdivisions per coarse cell
+    int latticeW = 0; // vertices per lattice row
+    std::vector<float> ux, uy, uz;
+    std::vector<float> cosZ;
+    std::vector<Uint8> valid;
+    std::vector<Uint8> alpha;
+  } nightMesh_;
   std::vector<int> propIndices_;
 
   // Caches for render-ready geometry to avoid per-frame recalculation
   bool greatCircleDirty_ = true;
   std::vector<SDL_Vertex> greatCircleVerts_;
   std::vector<int> greatCircleIndices_;
+  // Sliding-window satellite ground track. Samples that fall behind the
+  // satellite are trimmed from the front and only the new tail is
+  // propagated; satTrackSegVerts_[i] counts the (unindexed) vertices of the
+  // segment ending at sample i so the strip can be trimmed the same way.
+  std::deque<GroundTrackPoint> satTrack_;
+  std::deque<int> satTrackSegVerts_;
+  uint32_t satTrackGeneration_ = 0;
   bool satTrackDirty_ = true;
   std::vector<SDL_Vertex> satTrackVerts_;
-  std::vector<int> satTrackIndices_;
   bool gridDirty_ = true;
   std::vector<SDL_Vertex> gridVerts_;
 
-  // Buffers for batching spots (dynamic per frame)
-  std::vector<SDL_Vertex> spotVerts_;
-  std::vector<int> spotIndices_;
+  // Per-frame markers, spot paths and halos (storage reused across frames)
+  RenderUtils::GeometryBatch batch_;
+  std::vector<std::pair<SDL_FPoint, SDL_Color>> spotMarkers_;
   std::vector<SDL_Vertex> mapVerts_;
   std::string lastProjection_;
-  std::vector<SDL_Vertex> markerVerts_;
-  std::vector<int> markerIndices_;
 
-  LatLon lastDE_ = {0, 0};
-  LatLon lastDX_ = {0, 0};
+  Reactive::Watch<LatLon> deWatch_{state_->de};
+  Reactive::Watch<DXTarget> dxWatch_{state_->dx};
+
+  // The prop overlay follows DE only at the model's resolution, so GPS
+  // drift does not regenerate the whole grid.
+  Reactive::Derived<LatLon, LatLon> propOrigin_{
+      [](const LatLon &de) { return de; },
+      withinDegrees(0.5), state_->de};
+  Reactive::Watch<LatLon> propOriginWatch_{propOrigin_};
+  std::optional<Reactive::Watch<SolarIndices>> solarWatch_;
 
   // Tooltip state
   struct Tooltip {
@@ -206,10 +274,20 @@ private:
   SDL_Texture *nightOverlayTexture_ = nullptr;
   SDL_Texture *mufRtTexture_ = nullptr;
   SDL_Texture *propTexture_ = nullptr;
+  SDL_Texture *auroraTexture_ = nullptr;
+  std::shared_ptr<const AuroraGrid> auroraGrid_;
+  // DRAP overlay: the grid is upsampled to RGBA on a worker, then streamed
+  // into drapTexture_ on the next render
+  SDL_Texture *drapTexture_ = nullptr;
+  std::shared_ptr<const DrapGrid> drapGrid_; // last grid sent for upsampling
+  std::vector<uint32_t> drapPixels_;         // upsampled, not yet uploaded
+  CancelToken drapRequest_;
+  std::shared_ptr<const DrapGrid> propDrap_; // grid in the reliability maps
   uint32_t lastMufUpdateMs_ = 0;
   uint64_t wxLastCheckMs_ = 0;
   uint32_t lastPropUpdateMs_ = 0;
   PropOverlayType lastPropType_ = PropOverlayType::None;
+  CancelToken propRequest_; // in-flight grid; cancelled when superseded
   std::string lastBand_;
   std::string lastMode_;
   int lastPower_ = -1;
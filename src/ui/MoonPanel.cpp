@@ -72,7 +72,9 @@ void MoonPanel::render(SDL_Renderer *renderer) {
   {
     std::lock_guard<std::mutex> lock(imageMutex_);
     if (!pendingImageData_.empty()) {
-      texMgr_.loadFromMemory(renderer, MOON_IMAGE_KEY, pendingImageData_);
+      // Evicted? Forget the URL so update() fetches it again from cache.
+      texMgr_.loadFromMemory(renderer, MOON_IMAGE_KEY, pendingImageData_,
+                             [this] { lastImageUrl_.clear(); });
       pendingImageData_.clear();
     }
   }
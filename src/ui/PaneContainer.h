@@ -48,6 +48,11 @@ public:
       activeWidget_->renderModal(renderer);
   }
 
+  Uint32 repaintIntervalMs() const override {
+    return activeWidget_ ? activeWidget_->repaintIntervalMs()
+                         : Widget::repaintIntervalMs();
+  }
+
   // Callback signature: void(int paneIndex, int mx, int my)
   void setOnSelectionRequested(std::function<void(int, int, int)> cb,
                                int paneIndex) {
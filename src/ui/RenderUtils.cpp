@@ -1,38 +1,221 @@
 #include "RenderUtils.h"
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <vector>
 
 namespace RenderUtils {
 
-void drawThickLine(SDL_Renderer *renderer, float x1, float y1, float x2,
-                   float y2, float thickness, SDL_Color color) {
+namespace {
+
+constexpr int kMinCircleSegments = 16;
+constexpr int kMaxCircleSegments = 64;
+
+// Adaptive segments: more for larger circles
+int circleSegments(float radius) {
+  return std::clamp(static_cast<int>(3.14159f * radius * 1.5f),
+                    kMinCircleSegments, kMaxCircleSegments);
+}
+
+// Points on the unit circle at 2*pi*i/n for i in [0, n), per segment count.
+const std::vector<SDL_FPoint> &unitCircle(int segments) {
+  static const auto tables = [] {
+    std::array<std::vector<SDL_FPoint>, kMaxCircleSegments + 1> t;
+    for (int n = kMinCircleSegments; n <= kMaxCircleSegments; ++n) {
+      t[n].resize(n);
+      for (int i = 0; i < n; ++i) {
+        float theta = 2.0f * 3.1415926535f * static_cast<float>(i) /
+                      static_cast<float>(n);
+        t[n][i] = {std::cos(theta), std::sin(theta)};
+      }
+    }
+    return t;
+  }();
+  return tables[segments];
+}
+
+// Shared arena for the one-shot draw functions below. They flush before
+// returning, so this never holds geometry between calls.
+GeometryBatch &immediate(SDL_Renderer *renderer) {
+  static GeometryBatch batch;
+  batch.begin(renderer);
+  return batch;
+}
+
+} // namespace
+
+// --- GeometryBatch ---
+
+void GeometryBatch::begin(SDL_Renderer *renderer) {
+  flush();
+  renderer_ = renderer;
+  texture_ = nullptr;
+}
+
+void GeometryBatch::flush() {
 #if SDL_VERSION_ATLEAST(2, 0, 18)
+  if (renderer_ && !verts_.empty()) {
+    SDL_RenderGeometry(renderer_, texture_, verts_.data(),
+                       static_cast<int>(verts_.size()), indices_.data(),
+                       static_cast<int>(indices_.size()));
+    ++drawCalls_;
+  }
+#endif
+  verts_.clear();
+  indices_.clear();
+}
+
+void GeometryBatch::use(SDL_Texture *tex) {
+  SDL_BlendMode blend = SDL_BLENDMODE_NONE;
+  if (tex)
+    SDL_GetTextureBlendMode(tex, &blend);
+  else
+    SDL_GetRenderDrawBlendMode(renderer_, &blend);
+
+  if (tex != texture_ || blend != blend_) {
+    flush();
+    texture_ = tex;
+    blend_ = blend;
+  }
+}
+
+void GeometryBatch::quad(SDL_FPoint a, SDL_FPoint b, SDL_FPoint c,
+                         SDL_FPoint d, SDL_Color color, bool textured) {
+  // a-b across the start, c-d across the end (b and d on the same side)
+  int base = static_cast<int>(verts_.size());
+  verts_.push_back({a, color, {0, 0}});
+  verts_.push_back({b, color, textured ? SDL_FPoint{0, 1} : SDL_FPoint{0, 0}});
+  verts_.push_back({c, color, textured ? SDL_FPoint{1, 0} : SDL_FPoint{0, 0}});
+  verts_.push_back({d, color, textured ? SDL_FPoint{1, 1} : SDL_FPoint{0, 0}});
+  for (int i : {0, 1, 2, 1, 2, 3})
+    indices_.push_back(base + i);
+}
+
+void GeometryBatch::circle(float x, float y, float radius, SDL_Color color) {
+  if (radius <= 0)
+    return;
+  use(nullptr);
+
+  const auto &unit = unitCircle(circleSegments(radius));
+  const int n = static_cast<int>(unit.size());
+  int center = static_cast<int>(verts_.size());
+  verts_.push_back({{x, y}, color, {0, 0}});
+  for (const auto &p : unit)
+    verts_.push_back({{x + radius * p.x, y + radius * p.y}, color, {0, 0}});
+  for (int i = 0; i < n; ++i) {
+    indices_.push_back(center);
+    indices_.push_back(center + 1 + i);
+    indices_.push_back(center + 1 + (i + 1) % n);
+  }
+}
+
+void GeometryBatch::thickLine(float x1, float y1, float x2, float y2,
+                              float thickness, SDL_Color color, bool caps) {
+  float dx = x2 - x1;
+  float dy = y2 - y1;
+  float length = std::sqrt(dx * dx + dy * dy);
+  if (length < 0.001f)
+    return;
+  use(nullptr);
+
+  float nx = -dy / length * (thickness / 2.0f);
+  float ny = dx / length * (thickness / 2.0f);
+  quad({x1 + nx, y1 + ny}, {x1 - nx, y1 - ny}, {x2 + nx, y2 + ny},
+       {x2 - nx, y2 - ny}, color, false);
+
+  // Rounded caps for smooth joins
+  if (caps) {
+    circle(x1, y1, thickness / 2.0f, color);
+    circle(x2, y2, thickness / 2.0f, color);
+  }
+}
+
+void GeometryBatch::polyline(const SDL_FPoint *points, int count,
+                             float thickness, SDL_Color color, bool closed) {
+  if (count < 2)
+    return;
+
+  float r = thickness / 2.0f;
+  int segments = closed ? count : count - 1;
+  for (int i = 0; i < segments; ++i) {
+    const SDL_FPoint &p1 = points[i];
+    const SDL_FPoint &p2 = points[(i + 1) % count];
+    float dx = p2.x - p1.x;
+    float dy = p2.y - p1.y;
+    if (std::sqrt(dx * dx + dy * dy) < 0.001f)
+      continue;
+
+    thickLine(p1.x, p1.y, p2.x, p2.y, thickness, color, false);
+    circle(p1.x, p1.y, r, color);
+    if (!closed && i == count - 2)
+      circle(p2.x, p2.y, r, color);
+  }
+}
+
+void GeometryBatch::rect(float x, float y, float w, float h,
+                         SDL_Color color) {
+  use(nullptr);
+  quad({x, y}, {x + w, y}, {x, y + h}, {x + w, y + h}, color, false);
+}
+
+void GeometryBatch::triangle(float x1, float y1, float x2, float y2, float x3,
+                             float y3, SDL_Color color) {
+  use(nullptr);
+  int base = static_cast<int>(verts_.size());
+  verts_.push_back({{x1, y1}, color, {0, 0}});
+  verts_.push_back({{x2, y2}, color, {0, 0}});
+  verts_.push_back({{x3, y3}, color, {0, 0}});
+  for (int i = 0; i < 3; ++i)
+    indices_.push_back(base + i);
+}
+
+void GeometryBatch::texturedLine(SDL_Texture *tex, float x1, float y1,
+                                 float x2, float y2, float thickness,
+                                 SDL_Color color) {
   float dx = x2 - x1;
   float dy = y2 - y1;
   float length = std::sqrt(dx * dx + dy * dy);
   if (length < 0.001f)
     return;
+  use(tex);
 
   float nx = -dy / length * (thickness / 2.0f);
   float ny = dx / length * (thickness / 2.0f);
+  quad({x1 + nx, y1 + ny}, {x1 - nx, y1 - ny}, {x2 + nx, y2 + ny},
+       {x2 - nx, y2 - ny}, color, true);
+}
 
-  SDL_Vertex verts[4];
-  for (int i = 0; i < 4; ++i) {
-    verts[i].color = color;
-    verts[i].tex_coord = {0, 0};
+void GeometryBatch::texturedPolyline(SDL_Texture *tex,
+                                     const SDL_FPoint *points, int count,
+                                     float thickness, SDL_Color color,
+                                     bool closed) {
+  if (count < 2)
+    return;
+  int segments = closed ? count : count - 1;
+  for (int i = 0; i < segments; ++i) {
+    const SDL_FPoint &p1 = points[i];
+    const SDL_FPoint &p2 = points[(i + 1) % count];
+    texturedLine(tex, p1.x, p1.y, p2.x, p2.y, thickness, color);
   }
+}
 
-  verts[0].position = {x1 + nx, y1 + ny};
-  verts[1].position = {x1 - nx, y1 - ny};
-  verts[2].position = {x2 + nx, y2 + ny};
-  verts[3].position = {x2 - nx, y2 - ny};
+void GeometryBatch::sprite(SDL_Texture *tex, const SDL_FRect &dst,
+                           SDL_Color color) {
+  if (!tex)
+    return;
+  use(tex);
+  quad({dst.x, dst.y}, {dst.x, dst.y + dst.h}, {dst.x + dst.w, dst.y},
+       {dst.x + dst.w, dst.y + dst.h}, color, true);
+}
 
-  int indices[] = {0, 1, 2, 1, 2, 3};
-  SDL_RenderGeometry(renderer, nullptr, verts, 4, indices, 6);
+// --- One-shot helpers ---
 
-  // Add rounded caps for smooth joins
-  drawCircle(renderer, x1, y1, thickness / 2.0f, color);
-  drawCircle(renderer, x2, y2, thickness / 2.0f, color);
+void drawThickLine(SDL_Renderer *renderer, float x1, float y1, float x2,
+                   float y2, float thickness, SDL_Color color) {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+  GeometryBatch &batch = immediate(renderer);
+  batch.thickLine(x1, y1, x2, y2, thickness, color);
+  batch.flush();
 #else
   // Fallback to simple line
   SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
@@ -46,43 +229,9 @@ void drawCircle(SDL_Renderer *renderer, float x, float y, float radius,
     return;
 
 #if SDL_VERSION_ATLEAST(2, 0, 18)
-  // Adaptive segments: more for larger circles
-  int segments = static_cast<int>(3.14159f * radius * 1.5f);
-  if (segments < 16)
-    segments = 16;
-  if (segments > 64)
-    segments = 64;
-
-  std::vector<SDL_Vertex> verts;
-  verts.reserve(segments + 2);
-
-  SDL_Vertex center;
-  center.position = {x, y};
-  center.color = color;
-  center.tex_coord = {0, 0};
-  verts.push_back(center);
-
-  for (int i = 0; i <= segments; ++i) {
-    float theta = 2.0f * 3.1415926535f * static_cast<float>(i) /
-                  static_cast<float>(segments);
-    SDL_Vertex v;
-    v.position = {x + radius * std::cos(theta), y + radius * std::sin(theta)};
-    v.color = color;
-    v.tex_coord = {0, 0};
-    verts.push_back(v);
-  }
-
-  std::vector<int> indices;
-  indices.reserve(segments * 3);
-  for (int i = 1; i <= segments; ++i) {
-    indices.push_back(0);
-    indices.push_back(i);
-    indices.push_back(i + 1);
-  }
-
-  SDL_RenderGeometry(renderer, nullptr, verts.data(),
-                     static_cast<int>(verts.size()), indices.data(),
-                     static_cast<int>(indices.size()));
+  GeometryBatch &batch = immediate(renderer);
+  batch.circle(x, y, radius, color);
+  batch.flush();
 #else
   // Fallback to simple outline or point circle (outline is easier)
   drawCircleOutline(renderer, x, y, radius, color);
@@ -92,18 +241,9 @@ void drawCircle(SDL_Renderer *renderer, float x, float y, float radius,
 void drawRect(SDL_Renderer *renderer, float x, float y, float w, float h,
               SDL_Color color) {
 #if SDL_VERSION_ATLEAST(2, 0, 18)
-  SDL_Vertex verts[4];
-  for (int i = 0; i < 4; ++i) {
-    verts[i].color = color;
-    verts[i].tex_coord = {0, 0};
-  }
-  verts[0].position = {x, y};
-  verts[1].position = {x + w, y};
-  verts[2].position = {x, y + h};
-  verts[3].position = {x + w, y + h};
-
-  int indices[] = {0, 1, 2, 1, 2, 3};
-  SDL_RenderGeometry(renderer, nullptr, verts, 4, indices, 6);
+  GeometryBatch &batch = immediate(renderer);
+  batch.rect(x, y, w, h, color);
+  batch.flush();
 #else
   SDL_Rect r = {static_cast<int>(x), static_cast<int>(y), static_cast<int>(w),
                 static_cast<int>(h)};
@@ -125,36 +265,23 @@ void drawCircleOutline(SDL_Renderer *renderer, float x, float y, float radius,
   if (radius <= 0)
     return;
 
-  int segments = static_cast<int>(3.14159f * radius * 1.5f);
-  if (segments < 16)
-    segments = 16;
-  if (segments > 64)
-    segments = 64;
+  const auto &unit = unitCircle(circleSegments(radius));
+  std::array<SDL_FPoint, kMaxCircleSegments + 1> pts;
+  size_t n = unit.size();
+  for (size_t i = 0; i < n; ++i)
+    pts[i] = {x + radius * unit[i].x, y + radius * unit[i].y};
+  pts[n] = pts[0];
 
   SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-  for (int i = 0; i < segments; ++i) {
-    float t1 = 2.0f * 3.1415926535f * static_cast<float>(i) /
-               static_cast<float>(segments);
-    float t2 = 2.0f * 3.1415926535f * static_cast<float>(i + 1) /
-               static_cast<float>(segments);
-    SDL_RenderDrawLineF(renderer, x + radius * std::cos(t1),
-                        y + radius * std::sin(t1), x + radius * std::cos(t2),
-                        y + radius * std::sin(t2));
-  }
+  SDL_RenderDrawLinesF(renderer, pts.data(), static_cast<int>(n + 1));
 }
 
 void drawTriangle(SDL_Renderer *renderer, float x1, float y1, float x2,
                   float y2, float x3, float y3, SDL_Color color) {
 #if SDL_VERSION_ATLEAST(2, 0, 18)
-  SDL_Vertex verts[3];
-  for (int i = 0; i < 3; ++i) {
-    verts[i].color = color;
-    verts[i].tex_coord = {0, 0};
-  }
-  verts[0].position = {x1, y1};
-  verts[1].position = {x2, y2};
-  verts[2].position = {x3, y3};
-  SDL_RenderGeometry(renderer, nullptr, verts, 3, nullptr, 0);
+  GeometryBatch &batch = immediate(renderer);
+  batch.triangle(x1, y1, x2, y2, x3, y3, color);
+  batch.flush();
 #else
   // Fill triangle fallback (primitive)
   SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
@@ -179,65 +306,10 @@ void drawPolyline(SDL_Renderer *renderer, const SDL_FPoint *points, int count,
     return;
 
 #if SDL_VERSION_ATLEAST(2, 0, 18)
-  std::vector<SDL_Vertex> verts;
-  std::vector<int> indices;
-
-  float r = thickness / 2.0f;
-  int segments = closed ? count : count - 1;
-  verts.reserve(segments * 4);
-  indices.reserve(segments * 6);
-
-  for (int i = 0; i < segments; ++i) {
-    int i1 = i;
-    int i2 = (i + 1) % count;
-
-    float dx = points[i2].x - points[i1].x;
-    float dy = points[i2].y - points[i1].y;
-    float len = std::sqrt(dx * dx + dy * dy);
-    if (len < 0.001f)
-      continue;
-
-    float nx = -dy / len * r;
-    float ny = dx / len * r;
-
-    int base = static_cast<int>(verts.size());
-    SDL_Vertex v[4];
-    for (int j = 0; j < 4; ++j) {
-      v[j].color = color;
-      v[j].tex_coord = {0, 0};
-    }
-
-    v[0].position = {points[i1].x + nx, points[i1].y + ny};
-    v[1].position = {points[i1].x - nx, points[i1].y - ny};
-    v[2].position = {points[i2].x + nx, points[i2].y + ny};
-    v[3].position = {points[i2].x - nx, points[i2].y - ny};
-
-    verts.push_back(v[0]);
-    verts.push_back(v[1]);
-    verts.push_back(v[2]);
-    verts.push_back(v[3]);
-
-    indices.push_back(base + 0);
-    indices.push_back(base + 1);
-    indices.push_back(base + 2);
-    indices.push_back(base + 1);
-    indices.push_back(base + 2);
-    indices.push_back(base + 3);
-
-    // Caps are separate draw calls, still expensive but better than nothing.
-    // For extreme optimization, caps should also be batched.
-    drawCircle(renderer, points[i1].x, points[i1].y, r, color);
-    if (!closed && i == count - 2) {
-      drawCircle(renderer, points[i2].x, points[i2].y, r, color);
-    }
-  }
-
-  if (verts.empty())
-    return;
-
-  SDL_RenderGeometry(renderer, nullptr, verts.data(),
-                     static_cast<int>(verts.size()), indices.data(),
-                     static_cast<int>(indices.size()));
+  // Segments and their round joins go out in a single draw call
+  GeometryBatch &batch = immediate(renderer);
+  batch.polyline(points, count, thickness, color, closed);
+  batch.flush();
 #else
   SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
   for (int i = 0; i < (closed ? count : count - 1); ++i) {
@@ -251,31 +323,9 @@ void drawThickLineTextured(SDL_Renderer *renderer, SDL_Texture *tex, float x1,
                            float y1, float x2, float y2, float thickness,
                            SDL_Color color) {
 #if SDL_VERSION_ATLEAST(2, 0, 18)
-  float dx = x2 - x1;
-  float dy = y2 - y1;
-  float length = std::sqrt(dx * dx + dy * dy);
-  if (length < 0.001f)
-    return;
-
-  float nx = -dy / length * (thickness / 2.0f);
-  float ny = dx / length * (thickness / 2.0f);
-
-  SDL_Vertex verts[4];
-  for (int i = 0; i < 4; ++i) {
-    verts[i].color = color;
-  }
-
-  verts[0].position = {x1 + nx, y1 + ny};
-  verts[0].tex_coord = {0, 0};
-  verts[1].position = {x1 - nx, y1 - ny};
-  verts[1].tex_coord = {0, 1};
-  verts[2].position = {x2 + nx, y2 + ny};
-  verts[2].tex_coord = {1, 0};
-  verts[3].position = {x2 - nx, y2 - ny};
-  verts[3].tex_coord = {1, 1};
-
-  int indices[] = {0, 1, 2, 1, 2, 3};
-  SDL_RenderGeometry(renderer, tex, verts, 4, indices, 6);
+  GeometryBatch &batch = immediate(renderer);
+  batch.texturedLine(tex, x1, y1, x2, y2, thickness, color);
+  batch.flush();
 #else
   // Texture fallback: just draw flat line
   drawThickLine(renderer, x1, y1, x2, y2, thickness, color);
@@ -289,60 +339,9 @@ void drawPolylineTextured(SDL_Renderer *renderer, SDL_Texture *tex,
   if (count < 2)
     return;
 
-  std::vector<SDL_Vertex> verts;
-  std::vector<int> indices;
-
-  float r = thickness / 2.0f;
-  int numSegments = (closed ? count : count - 1);
-  verts.reserve(numSegments * 4);
-  indices.reserve(numSegments * 6);
-
-  for (int i = 0; i < numSegments; ++i) {
-    int i1 = i;
-    int i2 = (i + 1) % count;
-
-    float dx = points[i2].x - points[i1].x;
-    float dy = points[i2].y - points[i1].y;
-    float len = std::sqrt(dx * dx + dy * dy);
-    if (len < 0.001f)
-      continue;
-
-    float nx = -dy / len * r;
-    float ny = dx / len * r;
-
-    int base = static_cast<int>(verts.size());
-    SDL_Vertex v[4];
-    for (int j = 0; j < 4; ++j)
-      v[j].color = color;
-
-    v[0].position = {points[i1].x + nx, points[i1].y + ny};
-    v[0].tex_coord = {0, 0};
-    v[1].position = {points[i1].x - nx, points[i1].y - ny};
-    v[1].tex_coord = {0, 1};
-    v[2].position = {points[i2].x + nx, points[i2].y + ny};
-    v[2].tex_coord = {1, 0};
-    v[3].position = {points[i2].x - nx, points[i2].y - ny};
-    v[3].tex_coord = {1, 1};
-
-    verts.push_back(v[0]);
-    verts.push_back(v[1]);
-    verts.push_back(v[2]);
-    verts.push_back(v[3]);
-
-    indices.push_back(base + 0);
-    indices.push_back(base + 1);
-    indices.push_back(base + 2);
-    indices.push_back(base + 1);
-    indices.push_back(base + 2);
-    indices.push_back(base + 3);
-  }
-
-  if (verts.empty())
-    return;
-
-  SDL_RenderGeometry(renderer, tex, verts.data(),
-                     static_cast<int>(verts.size()), indices.data(),
-                     static_cast<int>(indices.size()));
+  GeometryBatch &batch = immediate(renderer);
+  batch.texturedPolyline(tex, points, count, thickness, color, closed);
+  batch.flush();
 #else
   drawPolyline(renderer, points, count, thickness, color, closed);
 #endif
@@ -354,21 +353,31 @@ void drawGear(SDL_Renderer *renderer, float x, float y, float radius,
   float toothLen = r * 0.3f;
   float toothW = r * 0.4f;
 
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+  GeometryBatch &batch = immediate(renderer);
   // Draw 8 teeth
   for (int i = 0; i < 8; ++i) {
     float angle = i * 3.14159265f / 4.0f;
-    float x1 = x + (r - toothLen) * std::cos(angle);
-    float y1 = y + (r - toothLen) * std::sin(angle);
-    float x2 = x + (r + toothLen) * std::cos(angle);
-    float y2 = y + (r + toothLen) * std::sin(angle);
-    drawThickLine(renderer, x1, y1, x2, y2, toothW, color);
+    batch.thickLine(x + (r - toothLen) * std::cos(angle),
+                    y + (r - toothLen) * std::sin(angle),
+                    x + (r + toothLen) * std::cos(angle),
+                    y + (r + toothLen) * std::sin(angle), toothW, color);
+  }
+  // Main body circle and center hole
+  batch.circle(x, y, r, color);
+  batch.circle(x, y, r * 0.35f, centerColor);
+  batch.flush();
+#else
+  for (int i = 0; i < 8; ++i) {
+    float angle = i * 3.14159265f / 4.0f;
+    drawThickLine(renderer, x + (r - toothLen) * std::cos(angle),
+                  y + (r - toothLen) * std::sin(angle),
+                  x + (r + toothLen) * std::cos(angle),
+                  y + (r + toothLen) * std::sin(angle), toothW, color);
   }
-
-  // Main body circle
   drawCircle(renderer, x, y, r, color);
-
-  // Center hole
   drawCircle(renderer, x, y, r * 0.35f, centerColor);
+#endif
 }
 
 } // namespace RenderUtils
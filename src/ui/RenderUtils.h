@@ -2,8 +2,58 @@
 
 #include <SDL.h>
 
+#include <cstdint>
+#include <vector>
+
 namespace RenderUtils {
 
+// Collects primitives into one persistent vertex/index arena and submits
+// them with one SDL_RenderGeometry call per run that shares a texture and
+// blend mode. Storage is kept across frames, so steady-state drawing does
+// not allocate. Anything drawn directly with SDL (copies, text, clip rect
+// changes) must be preceded by flush() to keep the painter's order.
+class GeometryBatch {
+public:
+  // Start collecting for renderer, submitting anything still pending.
+  void begin(SDL_Renderer *renderer);
+  void flush();
+
+  void circle(float x, float y, float radius, SDL_Color color);
+  // Quad with round caps (the caps can be skipped for hairlines).
+  void thickLine(float x1, float y1, float x2, float y2, float thickness,
+                 SDL_Color color, bool caps = true);
+  void polyline(const SDL_FPoint *points, int count, float thickness,
+                SDL_Color color, bool closed = false);
+  void rect(float x, float y, float w, float h, SDL_Color color);
+  void triangle(float x1, float y1, float x2, float y2, float x3, float y3,
+                SDL_Color color);
+
+  // Anti-aliased line using a 1D falloff texture across its width.
+  void texturedLine(SDL_Texture *tex, float x1, float y1, float x2, float y2,
+                    float thickness, SDL_Color color);
+  void texturedPolyline(SDL_Texture *tex, const SDL_FPoint *points, int count,
+                        float thickness, SDL_Color color, bool closed = false);
+  // Texture stretched over dst and tinted by color; the batched equivalent
+  // of SDL_SetTextureColorMod + SDL_RenderCopyF.
+  void sprite(SDL_Texture *tex, const SDL_FRect &dst, SDL_Color color);
+
+  // SDL_RenderGeometry calls made so far.
+  uint64_t drawCalls() const { return drawCalls_; }
+
+private:
+  // Switch to tex (nullptr for solid fills), flushing on a state change.
+  void use(SDL_Texture *tex);
+  void quad(SDL_FPoint a, SDL_FPoint b, SDL_FPoint c, SDL_FPoint d,
+            SDL_Color color, bool textured);
+
+  SDL_Renderer *renderer_ = nullptr;
+  SDL_Texture *texture_ = nullptr;
+  SDL_BlendMode blend_ = SDL_BLENDMODE_NONE;
+  std::vector<SDL_Vertex> verts_;
+  std::vector<int> indices_;
+  uint64_t drawCalls_ = 0;
+};
+
 // Draw a smooth line with a specific thickness using SDL_RenderGeometry.
 void drawThickLine(SDL_Renderer *renderer, float x1, float y1, float x2,
                    float y2, float thickness, SDL_Color color);
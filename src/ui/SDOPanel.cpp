@@ -1,19 +1,17 @@
 #include "SDOPanel.h"
 #include "../core/Astronomy.h"
 #include "../core/Constants.h"
+#include "../core/Logger.h"
+#include "../core/MemoryMonitor.h"
 #include "../core/Theme.h"
 #include "FontCatalog.h"
 #include "RenderUtils.h"
 #include <SDL.h>
 #include <algorithm>
 #include <cstdio>
-#include <mutex>
+#include <ctime>
 #include <nlohmann/json.hpp>
 
-static std::mutex sdoMutex;
-static std::string sdoPendingData;
-static bool sdoDataReady = false;
-
 SDOPanel::SDOPanel(int x, int y, int w, int h, FontManager &fontMgr,
                    TextureManager &texMgr, SDOProvider &provider)
     : Widget(x, y, w, h), fontMgr_(fontMgr), texMgr_(texMgr),
@@ -21,18 +19,20 @@ SDOPanel::SDOPanel(int x, int y, int w, int h, FontManager &fontMgr,
   tempId_ = currentId_;
 }
 
+SDOPanel::~SDOPanel() {
+  request_.cancel();
+  MemoryMonitor::getInstance().destroyTexture(atlas_);
+}
+
 void SDOPanel::update() {
   uint32_t now = SDL_GetTicks();
-  // Hourly fetch or on ID change
 
-  // Hourly fetch or on ID change
-  if (now - lastFetch_ > 60 * 60 * 1000 || lastFetch_ == 0) {
+  // Hourly fetch or on ID change. The movie follows the archive cadence.
+  // Nothing is fetched before render() has sized the frames.
+  uint32_t period = movie_ ? 15 * 60 * 1000 : 60 * 60 * 1000;
+  if (frameSize_ > 0 && (now - lastFetch_ > period || lastFetch_ == 0)) {
     lastFetch_ = now;
-    provider_.fetch(currentId_, [](const std::string &data) {
-      std::lock_guard<std::mutex> lock(sdoMutex);
-      sdoPendingData = data;
-      sdoDataReady = true;
-    });
+    requestFrames();
   }
 
   // Handle rotation (every 30 seconds if enabled)
@@ -47,23 +47,126 @@ void SDOPanel::update() {
       }
     }
     currentId_ = wavelengths_[idx].id;
+    resetFrames();
     // Trigger immediate fetch
     lastFetch_ = 0;
   }
 }
 
-void SDOPanel::render(SDL_Renderer *renderer) {
-  // 1. Check for new data
-  {
-    std::lock_guard<std::mutex> lock(sdoMutex);
-    if (sdoDataReady) {
-      texMgr_.loadFromMemory(renderer, "sdo_latest", sdoPendingData);
-      sdoDataReady = false;
-      sdoPendingData.clear();
-      imageReady_ = true;
+void SDOPanel::requestFrames() {
+  auto onFrame = [this](SDOFrame frame) { addFrame(std::move(frame)); };
+  if (movie_) {
+    // A refresh only downloads and decodes frames we do not hold yet.
+    std::vector<std::chrono::system_clock::time_point> have;
+    for (const auto &f : frames_)
+      have.push_back(f.time);
+    for (const auto &f : pending_)
+      have.push_back(f.time);
+    provider_.fetchRecent(currentId_, kMaxFrames, frameSize_, std::move(have),
+                          onFrame, request_);
+  } else
+    provider_.fetchLatest(currentId_, frameSize_, onFrame, request_);
+}
+
+// Drops the frames and any fetch in flight; the atlas texture is kept and
+// its slots are overwritten.
+void SDOPanel::resetFrames() {
+  request_.cancel();
+  request_ = CancelToken();
+  frames_.clear();
+  pending_.clear();
+}
+
+void SDOPanel::addFrame(SDOFrame frame) {
+  if (frame.wavelength != currentId_ || frame.size != frameSize_)
+    return;
+  pending_.push_back(std::move(frame));
+}
+
+SDL_Rect SDOPanel::slotRect(int slot) const {
+  return {(slot % kAtlasCols) * frameSize_, (slot / kAtlasCols) * frameSize_,
+          frameSize_, frameSize_};
+}
+
+void SDOPanel::uploadPending(SDL_Renderer *renderer) {
+  if (pending_.empty())
+    return;
+
+  if (!atlas_) {
+    atlas_ = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32,
+                               SDL_TEXTUREACCESS_STATIC,
+                               kAtlasCols * frameSize_,
+                               kAtlasRows * frameSize_);
+    if (!atlas_) {
+      LOG_E("SDO", "Failed to create frame atlas: {}", SDL_GetError());
+      pending_.clear();
+      return;
     }
+    // Refetched (mostly from the network cache) if evicted.
+    MemoryMonitor::getInstance().trackTexture(
+        atlas_, "SDOPanel", [this](SDL_Texture *) {
+          MemoryMonitor::getInstance().destroyTexture(atlas_);
+          resetFrames();
+          lastFetch_ = 0;
+        });
+    SDL_SetTextureBlendMode(atlas_, SDL_BLENDMODE_BLEND);
   }
 
+  for (SDOFrame &f : pending_) {
+    // Time order; a repeat of a frame we hold is skipped.
+    auto pos = std::lower_bound(
+        frames_.begin(), frames_.end(), f.time,
+        [](const Frame &a, std::chrono::system_clock::time_point t) {
+          return a.time < t;
+        });
+    if (pos != frames_.end() && pos->time == f.time)
+      continue;
+
+    int slot;
+    if (static_cast<int>(frames_.size()) < kMaxFrames) {
+      // Lowest slot not in use
+      std::vector<bool> used(kMaxFrames, false);
+      for (const auto &fr : frames_)
+        used[fr.slot] = true;
+      slot = static_cast<int>(std::find(used.begin(), used.end(), false) -
+                              used.begin());
+    } else {
+      if (pos == frames_.begin())
+        continue; // older than everything we keep
+      slot = frames_.front().slot;
+      frames_.pop_front();
+      pos = std::lower_bound(
+          frames_.begin(), frames_.end(), f.time,
+          [](const Frame &a, std::chrono::system_clock::time_point t) {
+            return a.time < t;
+          });
+    }
+
+    SDL_Rect r = slotRect(slot);
+    SDL_UpdateTexture(atlas_, &r, f.pixels.data(),
+                      frameSize_ * static_cast<int>(sizeof(uint32_t)));
+    frames_.insert(pos, {f.time, slot});
+  }
+  pending_.clear();
+}
+
+void SDOPanel::render(SDL_Renderer *renderer) {
+  int drawSz = std::min(width_, height_) - 4;
+
+  // Frames are decoded at the panel's size in output pixels (capped so the
+  // atlas fits the smallest texture limit); a new size starts over.
+  float scaleX = 1.0f, scaleY = 1.0f;
+  SDL_RenderGetScale(renderer, &scaleX, &scaleY);
+  int wanted = std::clamp(static_cast<int>(drawSz * scaleX), 16,
+                          std::min(512, kMaxAtlasDim / kAtlasCols));
+  if (wanted != frameSize_) {
+    resetFrames();
+    MemoryMonitor::getInstance().destroyTexture(atlas_);
+    frameSize_ = wanted;
+    lastFetch_ = 0;
+  }
+  uploadPending(renderer);
+
   ThemeColors themes = getThemeColors(theme_);
 
   // 2. Background and Border
@@ -78,21 +181,41 @@ void SDOPanel::render(SDL_Renderer *renderer) {
                          themes.border.b, themes.border.a);
   SDL_RenderDrawRect(renderer, &rect);
 
-  // 3. Draw Image
-  SDL_Texture *tex = texMgr_.get("sdo_latest");
-  if (tex && imageReady_) {
-    int drawSz = std::min(width_, height_) - 4;
+  // 3. Draw Image: the newest frame, or the time-lapse position
+  if (atlas_ && !frames_.empty()) {
+    size_t idx = frames_.size() - 1;
+    if (movie_ && frames_.size() > 1) {
+      size_t step = SDL_GetTicks() / kMovieFrameMs;
+      idx = std::min(step % (frames_.size() + kMovieHoldFrames), idx);
+    }
+    MemoryMonitor::getInstance().touchTexture(atlas_);
+    SDL_Rect src = slotRect(frames_[idx].slot);
     SDL_Rect dst = {x_ + (width_ - drawSz) / 2, y_ + (height_ - drawSz) / 2,
                     drawSz, drawSz};
-    SDL_RenderCopy(renderer, tex, nullptr, &dst);
+    SDL_RenderCopy(renderer, atlas_, &src, &dst);
 
     renderOverlays(renderer, themes);
+    if (movie_)
+      renderFrameTime(renderer, frames_[idx].time);
   } else {
     fontMgr_.drawText(renderer, "Loading SUN...", x_ + width_ / 2,
                       y_ + height_ / 2, themes.textDim, 12, false, true);
   }
 }
 
+// UTC time of the shown time-lapse frame, top centre.
+void SDOPanel::renderFrameTime(SDL_Renderer *renderer,
+                               std::chrono::system_clock::time_point t) {
+  std::time_t tt = std::chrono::system_clock::to_time_t(t);
+  std::tm tm{};
+  Astronomy::portable_gmtime(&tt, &tm);
+  char buf[16];
+  std::snprintf(buf, sizeof(buf), "%02d:%02dZ", tm.tm_hour, tm.tm_min);
+  fontMgr_.drawText(renderer, buf, x_ + width_ / 2,
+                    y_ + 4 + overlayFontSize_ / 2, {255, 165, 0, 255},
+                    overlayFontSize_, false, true);
+}
+
 void SDOPanel::renderModal(SDL_Renderer *renderer) {
   if (menuVisible_) {
     ThemeColors themes = getThemeColors(theme_);
@@ -276,10 +399,7 @@ bool SDOPanel::onMouseUp(int mx, int my, Uint16 mod) {
     // 1. Check buttons FIRST to avoid overlap issues
     if (mx >= okRect_.x && mx < okRect_.x + okRect_.w && my >= okRect_.y &&
         my < okRect_.y + okRect_.h) {
-      currentId_ = tempId_;
-      rotating_ = tempRotating_;
-      menuVisible_ = false;
-      lastFetch_ = 0; // Trigger reload
+      applySelection();
       return true;
     }
 
@@ -325,6 +445,7 @@ bool SDOPanel::onMouseUp(int mx, int my, Uint16 mod) {
     menuVisible_ = true;
     tempId_ = currentId_;
     tempRotating_ = rotating_;
+    tempMovie_ = movie_;
     recalcMenuLayout();
     return true;
   }
@@ -332,13 +453,20 @@ bool SDOPanel::onMouseUp(int mx, int my, Uint16 mod) {
   return false;
 }
 
+void SDOPanel::applySelection() {
+  if (tempId_ != currentId_ || tempMovie_ != movie_)
+    resetFrames();
+  currentId_ = tempId_;
+  rotating_ = tempRotating_;
+  movie_ = tempMovie_;
+  menuVisible_ = false;
+  lastFetch_ = 0; // Trigger reload
+}
+
 bool SDOPanel::onKeyDown(SDL_Keycode key, Uint16 /*mod*/) {
   if (menuVisible_) {
     if (key == SDLK_RETURN || key == SDLK_KP_ENTER) {
-      currentId_ = tempId_;
-      rotating_ = tempRotating_;
-      menuVisible_ = false;
-      lastFetch_ = 0;
+      applySelection();
       return true;
     }
     if (key == SDLK_ESCAPE) {
@@ -374,7 +502,10 @@ nlohmann::json SDOPanel::getDebugData() const {
   data["current_wavelength"] = currentName;
   data["current_id"] = currentId_;
   data["rotating"] = rotating_;
-  data["image_ready"] = imageReady_;
+  data["image_ready"] = !frames_.empty();
+  data["movie"] = movie_;
+  data["frames"] = frames_.size();
+  data["frame_size"] = frameSize_;
 
   // Available wavelengths
   nlohmann::json wavelengths = nlohmann::json::array();
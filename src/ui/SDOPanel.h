@@ -5,12 +5,15 @@
 #include "TextureManager.h"
 #include "Widget.h"
 #include <SDL.h>
+#include <deque>
 #include <string>
+#include <vector>
 
 class SDOPanel : public Widget {
 public:
   SDOPanel(int x, int y, int w, int h, FontManager &fontMgr,
            TextureManager &texMgr, SDOProvider &provider);
+  ~SDOPanel() override;
 
   void setObserver(double lat, double lon) {
     obsLat_ = lat;
@@ -22,6 +25,9 @@ public:
   void onResize(int x, int y, int w, int h) override;
   bool onMouseUp(int mx, int my, Uint16 mod) override;
   bool onKeyDown(SDL_Keycode key, Uint16 mod) override;
+  Uint32 repaintIntervalMs() const override {
+    return movie_ && frames_.size() > 1 ? kMovieFrameMs : 1000;
+  }
 
   // Semantic Debug API
   std::string getName() const override { return "SDOPanel"; }
@@ -36,6 +42,14 @@ private:
   void renderMenu(SDL_Renderer *renderer, const struct ThemeColors &themes);
   void renderOverlays(SDL_Renderer *renderer, const struct ThemeColors &themes);
   void recalcMenuLayout();
+  void applySelection();
+  void requestFrames();
+  void resetFrames();
+  void addFrame(SDOFrame frame);
+  void uploadPending(SDL_Renderer *renderer);
+  SDL_Rect slotRect(int slot) const;
+  void renderFrameTime(SDL_Renderer *renderer,
+                       std::chrono::system_clock::time_point t);
 
   FontManager &fontMgr_;
   TextureManager &texMgr_;
@@ -57,11 +71,32 @@ private:
 
   std::string currentId_ = "0193";
   bool rotating_ = false;
+  bool movie_ = false;
   bool menuVisible_ = false;
-  bool imageReady_ = false;
   uint32_t lastFetch_ = 0;
   uint32_t lastRotate_ = 0;
 
+  // Time-lapse. Decoded frames are packed into one atlas texture of
+  // kAtlasCols x kAtlasRows slots of frameSize_ pixels; playing the movie
+  // only moves the source rect. frames_ is kept in time order and reuses
+  // the slot of the oldest frame once the atlas is full.
+  static constexpr int kAtlasCols = 6;
+  static constexpr int kAtlasRows = 4;
+  static constexpr int kMaxFrames = kAtlasCols * kAtlasRows;
+  static constexpr int kMaxAtlasDim = 2048; // Pi and WASM texture limit
+  static constexpr Uint32 kMovieFrameMs = 250;
+  static constexpr int kMovieHoldFrames = 6; // pause on the newest frame
+
+  struct Frame {
+    std::chrono::system_clock::time_point time;
+    int slot;
+  };
+  std::deque<Frame> frames_;
+  std::vector<SDOFrame> pending_; // decoded, waiting for upload
+  SDL_Texture *atlas_ = nullptr;
+  int frameSize_ = 0; // pixels per slot side, 0 until the first render
+  CancelToken request_;
+
   // Layout
   SDL_Rect menuRect_ = {0, 0, 0, 0};
   std::vector<SDL_Rect> radioRects_;
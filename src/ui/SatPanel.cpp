@@ -40,6 +40,7 @@ void SatPanel::update() {
     lineText_[2].clear();
     lineText_[3].clear();
     passTrack_.clear();
+    passTrackAos_ = passTrackLos_ = 0;
     satAboveHorizon_ = false;
     return;
   }
@@ -53,13 +54,13 @@ void SatPanel::update() {
   // Line 0: Satellite name (centered, large)
   lineText_[0] = predictor_->satName();
 
-  // Current observation
-  SatObservation obs = predictor_->observe();
+  // Current observation (interpolated from the pass cache while up)
+  SatObservation obs = predictor_->trackAt(static_cast<double>(now));
   currentPos_ = {obs.azimuth, obs.elevation};
   satAboveHorizon_ = (obs.elevation > 0.0);
 
-  // Next pass
-  SatPass pass = predictor_->nextPass();
+  // Current or next pass; only searched for again after its LOS
+  SatPass pass = predictor_->cachedPass(now);
 
   // Line 1: "Rise in Xh:XX @ AZZ" or "Up for Xh:XX"
   char buf[64];
@@ -114,7 +115,11 @@ void SatPanel::update() {
     lineText_[4].clear();
   }
 
-  // Build pass trajectory for polar plot
+  // Build pass trajectory for polar plot, once per pass
+  if (pass.aosTime == passTrackAos_ && pass.losTime == passTrackLos_)
+    return;
+  passTrackAos_ = pass.aosTime;
+  passTrackLos_ = pass.losTime;
   passTrack_.clear();
   if (pass.aosTime > 0 && pass.losTime > pass.aosTime) {
     long duration = static_cast<long>(pass.losTime - pass.aosTime);
@@ -122,7 +127,7 @@ void SatPanel::update() {
     passTrack_.reserve(steps + 1);
     for (int s = 0; s <= steps; ++s) {
       std::time_t t = pass.aosTime + (duration * s) / steps;
-      SatObservation o = predictor_->observeAt(t);
+      SatObservation o = predictor_->trackAt(static_cast<double>(t));
       passTrack_.push_back({o.azimuth, o.elevation});
     }
   }
@@ -223,7 +228,7 @@ nlohmann::json SatPanel::getDebugData() const {
   data["elevation"] = currentPos_.el;
 
   // Get next pass info
-  SatPass pass = predictor_->nextPass();
+  SatPass pass = predictor_->cachedPass(std::time(nullptr));
   if (pass.aosTime > 0) {
     std::time_t now = std::time(nullptr);
     if (satAboveHorizon_) {
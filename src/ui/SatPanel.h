@@ -65,6 +65,8 @@ private:
     double el;
   };
   std::vector<AzElPoint> passTrack_;
+  std::time_t passTrackAos_ = 0; // pass the trajectory was built for
+  std::time_t passTrackLos_ = 0;
   AzElPoint currentPos_ = {0, 0};
   bool satAboveHorizon_ = false;
 
@@ -0,0 +1,197 @@
+#include "SoftwarePresenter.h"
+#include "../core/Logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+bool SoftwarePresenter::supported(SDL_Renderer *renderer) {
+  SDL_RendererInfo info;
+  if (!renderer || SDL_GetRendererInfo(renderer, &info) != 0)
+    return false;
+  return (info.flags & SDL_RENDERER_SOFTWARE) && info.name &&
+         std::strcmp(info.name, "software") == 0 &&
+         SDL_GetRenderTarget(renderer) == nullptr;
+}
+
+SoftwarePresenter::SoftwarePresenter(SDL_Window *window,
+                                     SDL_Renderer *renderer,
+                                     bool damageTracking)
+    : window_(window), renderer_(renderer), damageTracking_(damageTracking),
+      lastFrameMs_(SDL_GetTicks()), statsSinceMs_(SDL_GetTicks()) {}
+
+void SoftwarePresenter::beginFrame(const std::vector<Widget *> &widgets) {
+  frameStart_ = SDL_GetPerformanceCounter();
+  SDL_RenderGetScale(renderer_, &scaleX_, &scaleY_);
+
+  bool relayout = slots_.size() != widgets.size();
+  for (size_t i = 0; !relayout && i < widgets.size(); ++i) {
+    SDL_Rect r = widgets[i]->getRect();
+    relayout = !SDL_RectEquals(&r, &slots_[i].rect);
+  }
+  if (relayout) {
+    slots_.assign(widgets.size(), Slot{});
+    for (size_t i = 0; i < widgets.size(); ++i)
+      slots_[i].rect = widgets[i]->getRect();
+    full_ = true;
+  }
+  if (!damageTracking_)
+    full_ = true;
+
+  // Periods are aligned to the wall clock so a seconds display repaints
+  // right as the second changes.
+  uint64_t nowMs = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count());
+  auto periodOf = [nowMs](const Widget *w) {
+    return nowMs / std::max<Uint32>(1, w->repaintIntervalMs());
+  };
+
+  painted_ = false;
+  for (size_t i = 0; i < widgets.size(); ++i) {
+    Slot &s = slots_[i];
+    uint64_t p = periodOf(widgets[i]);
+    s.repaint = full_ || damageAll_ || p != s.period;
+    if (s.repaint)
+      s.period = p;
+    painted_ = painted_ || s.repaint;
+  }
+  damageAll_ = false;
+
+  // Clearing a rect erases whatever overlaps it, so repaint those too
+  for (bool grew = painted_ && !full_; grew;) {
+    grew = false;
+    for (size_t i = 0; i < slots_.size(); ++i) {
+      if (slots_[i].repaint)
+        continue;
+      for (const Slot &o : slots_) {
+        if (o.repaint && SDL_HasIntersection(&slots_[i].rect, &o.rect)) {
+          slots_[i].repaint = true;
+          slots_[i].period = periodOf(widgets[i]);
+          grew = true;
+          break;
+        }
+      }
+    }
+  }
+
+  if (!painted_)
+    return;
+
+  SDL_SetRenderDrawColor(renderer_, 0, 0, 0, 255);
+  if (full_) {
+    SDL_RenderClear(renderer_);
+    return;
+  }
+  SDL_BlendMode mode;
+  SDL_GetRenderDrawBlendMode(renderer_, &mode);
+  SDL_SetRenderDrawBlendMode(renderer_, SDL_BLENDMODE_NONE);
+  for (const Slot &s : slots_) {
+    if (s.repaint)
+      SDL_RenderFillRect(renderer_, &s.rect);
+  }
+  SDL_SetRenderDrawBlendMode(renderer_, mode);
+}
+
+void SoftwarePresenter::present() {
+  Uint64 frameStart = frameStart_;
+  if (painted_) {
+#if SDL_VERSION_ATLEAST(2, 0, 10)
+    SDL_RenderFlush(renderer_); // batched commands must land in the surface
+#endif
+    SDL_Surface *surface = SDL_GetWindowSurface(window_);
+    if (surface) {
+      updates_.clear();
+      bool locked = SDL_MUSTLOCK(surface) && SDL_LockSurface(surface) == 0;
+      for (Slot &s : slots_) {
+        if (!s.repaint)
+          continue;
+        SDL_Rect px = toPixels(s.rect, surface);
+        if (px.w <= 0 || px.h <= 0)
+          continue;
+        uint64_t h = hashPixels(surface, px);
+        if (h != s.hash || full_) {
+          s.hash = h;
+          updates_.push_back(px);
+        }
+      }
+      if (locked)
+        SDL_UnlockSurface(surface);
+
+      if (full_) {
+        SDL_UpdateWindowSurface(window_);
+        statRects_ += 1;
+      } else if (!updates_.empty()) {
+        SDL_UpdateWindowSurfaceRects(window_, updates_.data(),
+                                     static_cast<int>(updates_.size()));
+        statRects_ += static_cast<uint32_t>(updates_.size());
+      }
+      full_ = false;
+    }
+    painted_ = false;
+  }
+  logStats(frameStart);
+
+  // Nothing waits on vsync here, so pace the loop ourselves
+  Uint32 now = SDL_GetTicks();
+  Uint32 elapsed = now - lastFrameMs_;
+  if (elapsed < kFrameMs)
+    SDL_Delay(kFrameMs - elapsed);
+  lastFrameMs_ = SDL_GetTicks();
+}
+
+SDL_Rect SoftwarePresenter::toPixels(const SDL_Rect &r,
+                                     const SDL_Surface *surface) const {
+  int x0 = static_cast<int>(std::floor(r.x * scaleX_));
+  int y0 = static_cast<int>(std::floor(r.y * scaleY_));
+  int x1 = static_cast<int>(std::ceil((r.x + r.w) * scaleX_));
+  int y1 = static_cast<int>(std::ceil((r.y + r.h) * scaleY_));
+  SDL_Rect px = {x0, y0, x1 - x0, y1 - y0};
+  SDL_Rect bounds = {0, 0, surface->w, surface->h};
+  SDL_Rect out;
+  if (!SDL_IntersectRect(&px, &bounds, &out))
+    return {0, 0, 0, 0};
+  return out;
+}
+
+// FNV-1a over 32-bit words; only has to tell frames apart.
+uint64_t SoftwarePresenter::hashPixels(const SDL_Surface *surface,
+                                       const SDL_Rect &r) {
+  const int bpp = surface->format->BytesPerPixel;
+  const size_t rowBytes = static_cast<size_t>(r.w) * bpp;
+  uint64_t h = 14695981039346656037ULL;
+  for (int y = r.y; y < r.y + r.h; ++y) {
+    const auto *row = static_cast<const uint8_t *>(surface->pixels) +
+                      static_cast<size_t>(y) * surface->pitch +
+                      static_cast<size_t>(r.x) * bpp;
+    size_t i = 0;
+    for (; i + 4 <= rowBytes; i += 4) {
+      uint32_t word;
+      std::memcpy(&word, row + i, 4);
+      h = (h ^ word) * 1099511628211ULL;
+    }
+    for (; i < rowBytes; ++i)
+      h = (h ^ row[i]) * 1099511628211ULL;
+  }
+  return h;
+}
+
+void SoftwarePresenter::logStats(Uint64 frameStart) {
+  statBusyMs_ += static_cast<double>(SDL_GetPerformanceCounter() - frameStart) *
+                 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+  ++statFrames_;
+
+  Uint32 now = SDL_GetTicks();
+  if (now - statsSinceMs_ < kStatsPeriodMs)
+    return;
+  LOG_D("Render", "{} frames, {:.2f} ms/frame busy, {:.1f} rects/frame ({})",
+        statFrames_, statBusyMs_ / statFrames_,
+        static_cast<double>(statRects_) / statFrames_,
+        damageTracking_ ? "damage tracking" : "full redraw");
+  statsSinceMs_ = now;
+  statFrames_ = 0;
+  statRects_ = 0;
+  statBusyMs_ = 0.0;
+}
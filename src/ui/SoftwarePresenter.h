@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Widget.h"
+
+#include <SDL.h>
+#include <cstdint>
+#include <vector>
+
+// Frame presentation for the software renderer, which draws straight into
+// the window surface. That surface survives between frames, so only damaged
+// widgets are cleared and repainted (on input, or when their
+// repaintIntervalMs() period rolls over) and only regions whose pixels
+// actually changed are pushed with SDL_UpdateWindowSurfaceRects.
+class SoftwarePresenter {
+public:
+  // True if renderer draws into its window's surface.
+  static bool supported(SDL_Renderer *renderer);
+
+  // damageTracking = false repaints and pushes the whole window every frame,
+  // which is what the plain software path does (kept for comparison).
+  SoftwarePresenter(SDL_Window *window, SDL_Renderer *renderer,
+                    bool damageTracking = true);
+
+  // Repaint every widget next frame; input can change any of them.
+  void damageAll() { damageAll_ = true; }
+  // Clear, repaint and push the whole window next frame.
+  void invalidate() { full_ = true; }
+
+  // Pick the widgets to repaint and clear their rects. Call with the
+  // frame's render scale set.
+  void beginFrame(const std::vector<Widget *> &widgets);
+  bool needsRepaint(size_t i) const { return slots_[i].repaint; }
+  // Push the changed regions, then hold the frame rate down.
+  void present();
+
+private:
+  struct Slot {
+    SDL_Rect rect{};
+    uint64_t period = UINT64_MAX; // wall-clock period last painted in
+    uint64_t hash = 0;            // pixels as last pushed
+    bool repaint = false;
+  };
+
+  SDL_Rect toPixels(const SDL_Rect &r, const SDL_Surface *surface) const;
+  static uint64_t hashPixels(const SDL_Surface *surface, const SDL_Rect &r);
+  void logStats(Uint64 frameStart);
+
+  SDL_Window *window_;
+  SDL_Renderer *renderer_;
+  bool damageTracking_;
+  std::vector<Slot> slots_;
+  std::vector<SDL_Rect> updates_;
+  float scaleX_ = 1.0f;
+  float scaleY_ = 1.0f;
+  bool full_ = true;
+  bool damageAll_ = false;
+  bool painted_ = false;
+
+  Uint64 frameStart_ = 0;
+  Uint32 lastFrameMs_ = 0;
+
+  // Frame cost, logged at debug level
+  Uint32 statsSinceMs_ = 0;
+  uint32_t statFrames_ = 0;
+  uint32_t statRects_ = 0;
+  double statBusyMs_ = 0.0;
+
+  static constexpr Uint32 kFrameMs = 33;         // ~30 fps cap
+  static constexpr Uint32 kStatsPeriodMs = 60000;
+};
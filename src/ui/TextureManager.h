@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <functional>
 #include <map>
 #include <string>
 
@@ -19,7 +20,7 @@ public:
 
   void clearCache() {
     for (auto &[key, tex] : cache_)
-      destroyTexture(tex);
+      MemoryMonitor::getInstance().destroyTexture(tex);
     cache_.clear();
   }
 
@@ -32,8 +33,11 @@ public:
     auto it = cache_.find(key);
     if (it != cache_.end())
       return it->second;
-    
-    pruneIfNecessary();
+
+    renderer_ = renderer;
+    Source &src = sources_[key] = Source{};
+    src.path = path;
+    src.bmp = true;
 
     SDL_Surface *surface = SDL_LoadBMP(path.c_str());
     if (!surface) {
@@ -54,7 +58,9 @@ public:
     if (it != cache_.end())
       return it->second;
 
-    pruneIfNecessary();
+    renderer_ = renderer;
+    Source &src = sources_[key] = Source{};
+    src.path = path;
 
     SDL_Surface *surface = IMG_Load(path.c_str());
     if (!surface) {
@@ -68,19 +74,263 @@ public:
     return texture;
   }
 
-  // Load an image from memory (e.g. bytes from NetworkManager).
+  // Load an image from memory (e.g. bytes from NetworkManager). The bytes are
+  // not kept: if 'refetch' is given the texture is evictable, and restoring
+  // it calls refetch to request the bytes again (normally a NetworkManager
+  // disk-cache hit) and load them here on arrival. Without it the texture is
+  // pinned.
   SDL_Texture *loadFromMemory(SDL_Renderer *renderer, const std::string &key,
-                              const std::string &data) {
-    return loadFromMemory(renderer, key,
-                          reinterpret_cast<const unsigned char *>(data.data()),
-                          static_cast<unsigned int>(data.size()));
+                              const std::string &data,
+                              std::function<void()> refetch = nullptr) {
+    renderer_ = renderer;
+    if (refetch) {
+      Source src;
+      src.refetch = std::move(refetch);
+      sources_[key] = std::move(src);
+    } else {
+      sources_.erase(key);
+    }
+    return decodeFromMemory(
+        renderer, key, reinterpret_cast<const unsigned char *>(data.data()),
+        static_cast<unsigned int>(data.size()));
   }
 
-  // Load an image from memory (e.g. embedded assets).
+  // Load an embedded asset. 'data' must outlive the manager; it is decoded
+  // again in place if the texture is evicted.
   SDL_Texture *loadFromMemory(SDL_Renderer *renderer, const std::string &key,
                               const unsigned char *data, unsigned int size) {
-    pruneIfNecessary();
-    
+    renderer_ = renderer;
+    Source src;
+    src.data = data;
+    src.size = size;
+    sources_[key] = std::move(src);
+    return decodeFromMemory(renderer, key, data, size);
+  }
+
+  // Generate a procedural equirectangular Earth fallback.
+  SDL_Texture *generateEarthFallback(SDL_Renderer *renderer,
+                                     const std::string &key, int width,
+                                     int height) {
+    SDL_Texture *texture =
+        SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32,
+                          SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!texture)
+      return nullptr;
+
+    SDL_SetRenderTarget(renderer, texture);
+    SDL_SetRenderDrawColor(renderer, 10, 20, 60, 255);
+    SDL_RenderClear(renderer);
+    SDL_SetRenderDrawColor(renderer, 40, 60, 100, 255);
+    for (int lonDeg = -180; lonDeg <= 180; lonDeg += 30) {
+      int px = static_cast<int>((lonDeg + 180.0) / 360.0 * width);
+      SDL_RenderDrawLine(renderer, px, 0, px, height);
+    }
+    for (int latDeg = -90; latDeg <= 90; latDeg += 30) {
+      int py = static_cast<int>((90.0 - latDeg) / 180.0 * height);
+      SDL_RenderDrawLine(renderer, 0, py, width, py);
+    }
+    SDL_SetRenderTarget(renderer, nullptr);
+
+    // Render targets have no source to rebuild from, so keep them pinned.
+    MemoryMonitor::getInstance().trackTexture(texture, "TextureManager");
+
+    cache_[key] = texture;
+    return texture;
+  }
+
+  // Generate a procedural 1x64 texture for anti-aliased lines.
+  SDL_Texture *generateLineTexture(SDL_Renderer *renderer,
+                                   const std::string &key) {
+    auto it = cache_.find(key);
+    if (it != cache_.end())
+      return it->second;
+
+    constexpr int h = 64;
+    SDL_Surface *surf =
+        SDL_CreateRGBSurfaceWithFormat(0, 1, h, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!surf)
+      return nullptr;
+    uint32_t *pix = (uint32_t *)surf->pixels;
+    for (int i = 0; i < h; ++i) {
+      float y = (static_cast<float>(i) / (h - 1)) * 2.0f - 1.0f;
+      float alpha = std::exp(-y * y * 8.0f);
+      if (alpha < 0.001f)
+        alpha = 0;
+      pix[i] =
+          SDL_MapRGBA(surf->format, 255, 255, 255, (uint8_t)(alpha * 255.0f));
+    }
+    SDL_Texture *tex = createTexture(renderer, surf, key);
+    SDL_FreeSurface(surf);
+    if (tex) {
+      SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+      cache_[key] = tex;
+    }
+    return tex;
+  }
+
+  // Generate circle and square markers.
+  void generateMarkerTextures(SDL_Renderer *renderer) {
+    if (cache_.count("marker_circle") && cache_.count("marker_square"))
+      return;
+
+    constexpr int sz = 64;
+    constexpr int center = sz / 2;
+    constexpr float r = sz / 2.0f - 2.0f;
+
+    SDL_Surface *cSurf =
+        SDL_CreateRGBSurfaceWithFormat(0, sz, sz, 32, SDL_PIXELFORMAT_RGBA32);
+    SDL_Surface *sSurf =
+        SDL_CreateRGBSurfaceWithFormat(0, sz, sz, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!cSurf || !sSurf) {
+      if (cSurf)
+        SDL_FreeSurface(cSurf);
+      if (sSurf)
+        SDL_FreeSurface(sSurf);
+      return;
+    }
+
+    uint32_t *cPix = (uint32_t *)cSurf->pixels;
+    uint32_t *sPix = (uint32_t *)sSurf->pixels;
+
+    for (int y = 0; y < sz; ++y) {
+      for (int x = 0; x < sz; ++x) {
+        float dx = x - center + 0.5f;
+        float dy = y - center + 0.5f;
+        float dist = std::sqrt(dx * dx + dy * dy);
+        float cA =
+            (dist < r - 1.0f)
+                ? 1.0f
+                : (dist < r + 1.0f ? 1.0f - (dist - (r - 1.0f)) / 2.0f : 0.0f);
+        float d = std::max(std::abs(dx), std::abs(dy));
+        float sA = (d < r - 1.0f)
+                       ? 1.0f
+                       : (d < r + 1.0f ? 1.0f - (d - (r - 1.0f)) / 2.0f : 0.0f);
+
+        cPix[y * sz + x] =
+            SDL_MapRGBA(cSurf->format, 255, 255, 255, (uint8_t)(cA * 255));
+        sPix[y * sz + x] =
+            SDL_MapRGBA(sSurf->format, 255, 255, 255, (uint8_t)(sA * 255));
+      }
+    }
+
+    SDL_Texture *ct = createTexture(renderer, cSurf, "marker_circle");
+    SDL_Texture *st = createTexture(renderer, sSurf, "marker_square");
+    if (ct) {
+      SDL_SetTextureBlendMode(ct, SDL_BLENDMODE_BLEND);
+      cache_["marker_circle"] = ct;
+    }
+    if (st) {
+      SDL_SetTextureBlendMode(st, SDL_BLENDMODE_BLEND);
+      cache_["marker_square"] = st;
+    }
+    SDL_FreeSurface(cSurf);
+    SDL_FreeSurface(sSurf);
+  }
+
+  void generateWhiteTexture(SDL_Renderer *renderer) {
+    if (cache_.count("white"))
+      return;
+    SDL_Surface *s =
+        SDL_CreateRGBSurfaceWithFormat(0, 1, 1, 32, SDL_PIXELFORMAT_RGBA32);
+    *(uint32_t *)s->pixels = SDL_MapRGBA(s->format, 255, 255, 255, 255);
+    SDL_Texture *t = createTexture(renderer, s, "white");
+    SDL_FreeSurface(s);
+    if (t) {
+      SDL_SetTextureBlendMode(t, SDL_BLENDMODE_BLEND);
+      cache_["white"] = t;
+    }
+  }
+
+  void generateBlackTexture(SDL_Renderer *renderer) {
+    if (cache_.count("black"))
+      return;
+    SDL_Surface *s =
+        SDL_CreateRGBSurfaceWithFormat(0, 1, 1, 32, SDL_PIXELFORMAT_RGBA32);
+    *(uint32_t *)s->pixels = SDL_MapRGBA(s->format, 0, 0, 0, 255);
+    SDL_Texture *t = createTexture(renderer, s, "black");
+    SDL_FreeSurface(s);
+    if (t) {
+      SDL_SetTextureBlendMode(t, SDL_BLENDMODE_BLEND);
+      cache_["black"] = t;
+    }
+  }
+
+  // Returns the cached texture, rebuilding it from its source if it was
+  // evicted by the residency manager.
+  SDL_Texture *get(const std::string &key) {
+    auto it = cache_.find(key);
+    if (it != cache_.end()) {
+      MemoryMonitor::getInstance().touchTexture(it->second);
+      return it->second;
+    }
+    return restore(key);
+  }
+
+  void setLowMemCallback(std::function<void()> cb) { lowMemCallback_ = cb; }
+
+private:
+  // Where an evictable texture can be rebuilt from: a file on disk, an
+  // embedded asset, or a callback that fetches the image again.
+  struct Source {
+    std::string path;
+    bool bmp = false;
+    const unsigned char *data = nullptr;
+    unsigned int size = 0;
+    std::function<void()> refetch;
+    bool refetching = false;
+  };
+
+  SDL_Texture *restore(const std::string &key) {
+    auto it = sources_.find(key);
+    if (it == sources_.end() || !renderer_)
+      return nullptr;
+
+    if (it->second.refetch) {
+      // The owner hands the bytes back through loadFromMemory() once they
+      // arrive; until then the texture is simply missing.
+      if (!it->second.refetching) {
+        it->second.refetching = true;
+        LOG_D("TextureManager", "Refetching evicted texture {}", key);
+        it->second.refetch();
+      }
+      return nullptr;
+    }
+
+    SDL_Texture *texture = nullptr;
+    if (!it->second.path.empty()) {
+      SDL_Surface *surface = it->second.bmp
+                                 ? SDL_LoadBMP(it->second.path.c_str())
+                                 : IMG_Load(it->second.path.c_str());
+      if (surface) {
+        texture = createTexture(renderer_, surface, key);
+        SDL_FreeSurface(surface);
+        if (texture)
+          cache_[key] = texture;
+      }
+    } else if (it->second.data) {
+      texture =
+          decodeFromMemory(renderer_, key, it->second.data, it->second.size);
+    }
+
+    if (texture) {
+      LOG_D("TextureManager", "Restored evicted texture {}", key);
+    } else {
+      // Don't retry every frame if the source has gone bad.
+      LOG_W("TextureManager", "Failed to restore {}, dropping source", key);
+      sources_.erase(key);
+    }
+    return texture;
+  }
+
+  void evict(const std::string &key, SDL_Texture *texture) {
+    auto it = cache_.find(key);
+    if (it != cache_.end() && it->second == texture)
+      cache_.erase(it);
+    MemoryMonitor::getInstance().destroyTexture(texture);
+  }
+
+  SDL_Texture *decodeFromMemory(SDL_Renderer *renderer, const std::string &key,
+                                const unsigned char *data, unsigned int size) {
     SDL_RWops *rw = SDL_RWFromConstMem(data, static_cast<int>(size));
     if (!rw) {
       LOG_E("TextureManager", "SDL_RWFromConstMem failed");
@@ -117,7 +367,7 @@ public:
 
     // Specialized Logic: Generate alpha channel from pixel brightness for
     // certain textures.
-    if (key == "nasa_moon" || key == "sdo_latest") {
+    if (key == "nasa_moon") {
       uint8_t *pixels = (uint8_t *)surface->pixels;
       for (int y = 0; y < surface->h; ++y) {
         uint32_t *row = (uint32_t *)(pixels + y * surface->pitch);
@@ -233,7 +483,7 @@ public:
     // to avoid peak VRAM usage.
     auto it = cache_.find(key);
     if (it != cache_.end()) {
-      destroyTexture(it->second);
+      MemoryMonitor::getInstance().destroyTexture(it->second);
       cache_.erase(it);
     }
 
@@ -262,179 +512,13 @@ public:
     return texture;
   }
 
-  // Generate a procedural equirectangular Earth fallback.
-  SDL_Texture *generateEarthFallback(SDL_Renderer *renderer,
-                                     const std::string &key, int width,
-                                     int height) {
-    SDL_Texture *texture =
-        SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32,
-                          SDL_TEXTUREACCESS_TARGET, width, height);
-    if (!texture)
-      return nullptr;
-
-    SDL_SetRenderTarget(renderer, texture);
-    SDL_SetRenderDrawColor(renderer, 10, 20, 60, 255);
-    SDL_RenderClear(renderer);
-    SDL_SetRenderDrawColor(renderer, 40, 60, 100, 255);
-    for (int lonDeg = -180; lonDeg <= 180; lonDeg += 30) {
-      int px = static_cast<int>((lonDeg + 180.0) / 360.0 * width);
-      SDL_RenderDrawLine(renderer, px, 0, px, height);
-    }
-    for (int latDeg = -90; latDeg <= 90; latDeg += 30) {
-      int py = static_cast<int>((90.0 - latDeg) / 180.0 * height);
-      SDL_RenderDrawLine(renderer, 0, py, width, py);
-    }
-    SDL_SetRenderTarget(renderer, nullptr);
-
-    // Track target texture
-    MemoryMonitor::getInstance().addVram(width * height * 4);
-
-    cache_[key] = texture;
-    return texture;
-  }
-
-  // Generate a procedural 1x64 texture for anti-aliased lines.
-  SDL_Texture *generateLineTexture(SDL_Renderer *renderer,
-                                   const std::string &key) {
-    auto it = cache_.find(key);
-    if (it != cache_.end())
-      return it->second;
-
-    constexpr int h = 64;
-    SDL_Surface *surf =
-        SDL_CreateRGBSurfaceWithFormat(0, 1, h, 32, SDL_PIXELFORMAT_RGBA32);
-    if (!surf)
-      return nullptr;
-    uint32_t *pix = (uint32_t *)surf->pixels;
-    for (int i = 0; i < h; ++i) {
-      float y = (static_cast<float>(i) / (h - 1)) * 2.0f - 1.0f;
-      float alpha = std::exp(-y * y * 8.0f);
-      if (alpha < 0.001f)
-        alpha = 0;
-      pix[i] =
-          SDL_MapRGBA(surf->format, 255, 255, 255, (uint8_t)(alpha * 255.0f));
-    }
-    SDL_Texture *tex = createTexture(renderer, surf, key);
-    SDL_FreeSurface(surf);
-    if (tex) {
-      SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
-      cache_[key] = tex;
-    }
-    return tex;
-  }
-
-  // Generate circle and square markers.
-  void generateMarkerTextures(SDL_Renderer *renderer) {
-    if (cache_.count("marker_circle") && cache_.count("marker_square"))
-      return;
-
-    constexpr int sz = 64;
-    constexpr int center = sz / 2;
-    constexpr float r = sz / 2.0f - 2.0f;
-
-    SDL_Surface *cSurf =
-        SDL_CreateRGBSurfaceWithFormat(0, sz, sz, 32, SDL_PIXELFORMAT_RGBA32);
-    SDL_Surface *sSurf =
-        SDL_CreateRGBSurfaceWithFormat(0, sz, sz, 32, SDL_PIXELFORMAT_RGBA32);
-    if (!cSurf || !sSurf) {
-      if (cSurf)
-        SDL_FreeSurface(cSurf);
-      if (sSurf)
-        SDL_FreeSurface(sSurf);
-      return;
-    }
-
-    uint32_t *cPix = (uint32_t *)cSurf->pixels;
-    uint32_t *sPix = (uint32_t *)sSurf->pixels;
-
-    for (int y = 0; y < sz; ++y) {
-      for (int x = 0; x < sz; ++x) {
-        float dx = x - center + 0.5f;
-        float dy = y - center + 0.5f;
-        float dist = std::sqrt(dx * dx + dy * dy);
-        float cA =
-            (dist < r - 1.0f)
-                ? 1.0f
-                : (dist < r + 1.0f ? 1.0f - (dist - (r - 1.0f)) / 2.0f : 0.0f);
-        float d = std::max(std::abs(dx), std::abs(dy));
-        float sA = (d < r - 1.0f)
-                       ? 1.0f
-                       : (d < r + 1.0f ? 1.0f - (d - (r - 1.0f)) / 2.0f : 0.0f);
-
-        cPix[y * sz + x] =
-            SDL_MapRGBA(cSurf->format, 255, 255, 255, (uint8_t)(cA * 255));
-        sPix[y * sz + x] =
-            SDL_MapRGBA(sSurf->format, 255, 255, 255, (uint8_t)(sA * 255));
-      }
-    }
-
-    SDL_Texture *ct = createTexture(renderer, cSurf, "marker_circle");
-    SDL_Texture *st = createTexture(renderer, sSurf, "marker_square");
-    if (ct) {
-      SDL_SetTextureBlendMode(ct, SDL_BLENDMODE_BLEND);
-      cache_["marker_circle"] = ct;
-    }
-    if (st) {
-      SDL_SetTextureBlendMode(st, SDL_BLENDMODE_BLEND);
-      cache_["marker_square"] = st;
-    }
-    SDL_FreeSurface(cSurf);
-    SDL_FreeSurface(sSurf);
-  }
-
-  void generateWhiteTexture(SDL_Renderer *renderer) {
-    if (cache_.count("white"))
-      return;
-    SDL_Surface *s =
-        SDL_CreateRGBSurfaceWithFormat(0, 1, 1, 32, SDL_PIXELFORMAT_RGBA32);
-    *(uint32_t *)s->pixels = SDL_MapRGBA(s->format, 255, 255, 255, 255);
-    SDL_Texture *t = createTexture(renderer, s, "white");
-    SDL_FreeSurface(s);
-    if (t) {
-      SDL_SetTextureBlendMode(t, SDL_BLENDMODE_BLEND);
-      cache_["white"] = t;
-    }
-  }
-
-  void generateBlackTexture(SDL_Renderer *renderer) {
-    if (cache_.count("black"))
-      return;
-    SDL_Surface *s =
-        SDL_CreateRGBSurfaceWithFormat(0, 1, 1, 32, SDL_PIXELFORMAT_RGBA32);
-    *(uint32_t *)s->pixels = SDL_MapRGBA(s->format, 0, 0, 0, 255);
-    SDL_Texture *t = createTexture(renderer, s, "black");
-    SDL_FreeSurface(s);
-    if (t) {
-      SDL_SetTextureBlendMode(t, SDL_BLENDMODE_BLEND);
-      cache_["black"] = t;
-    }
-  }
-
-  SDL_Texture *get(const std::string &key) const {
-    auto it = cache_.find(key);
-    return it != cache_.end() ? it->second : nullptr;
-  }
-
-  void setLowMemCallback(std::function<void()> cb) { lowMemCallback_ = cb; }
-
-private:
-  void pruneIfNecessary() {
-    const size_t MAX_TEXTURE_CACHE_SIZE = 50;
-    if (cache_.size() >= MAX_TEXTURE_CACHE_SIZE) {
-        LOG_W("TextureManager", "Texture cache size ({}) exceeds limit ({}), pruning.", cache_.size(), MAX_TEXTURE_CACHE_SIZE);
-        pruneCache();
-    }
-  }
-
-  void pruneCache() {
-    // Crude eviction: clear the whole cache. A proper LRU would be better.
-    clearCache();
-  }
-
   SDL_Texture *createTexture(SDL_Renderer *renderer, SDL_Surface *surface,
                              const std::string &key) {
     if (!surface)
       return nullptr;
+    auto &mem = MemoryMonitor::getInstance();
+    mem.reserveVram(static_cast<int64_t>(surface->w) * surface->h * 4);
+
     SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
     if (!texture) {
       LOG_E("TextureManager", "SDL_CreateTextureFromSurface failed for {}: {}",
@@ -442,24 +526,18 @@ private:
       return nullptr;
     }
 
-    // Track estimated VRAM (assuming 4 bytes per pixel for typical textures)
-    int64_t bytes = surface->w * surface->h * 4;
-    MemoryMonitor::getInstance().addVram(bytes);
-
+    // Loaded images can be rebuilt from their source; generated ones are
+    // small and pinned.
+    MemoryMonitor::Evictor evictor;
+    if (sources_.count(key))
+      evictor = [this, key](SDL_Texture *t) { evict(key, t); };
+    mem.trackTexture(texture, "TextureManager", std::move(evictor));
     return texture;
   }
 
-  void destroyTexture(SDL_Texture *texture) {
-    if (!texture)
-      return;
-    int w, h;
-    SDL_QueryTexture(texture, nullptr, nullptr, &w, &h);
-    MemoryMonitor::getInstance().markVramDestroyed(static_cast<int64_t>(w) * h *
-                                                   4);
-    SDL_DestroyTexture(texture);
-  }
-
   std::map<std::string, SDL_Texture *> cache_;
+  std::map<std::string, Source> sources_;
+  SDL_Renderer *renderer_ = nullptr;
   int maxW_ = 0;
   int maxH_ = 0;
   std::function<void()> lowMemCallback_;
@@ -24,6 +24,9 @@ public:
   bool onMouseUp(int mx, int my, Uint16 mod) override;
   bool onKeyDown(SDL_Keycode key, Uint16 mod) override;
   bool onTextInput(const char *text) override;
+  Uint32 repaintIntervalMs() const override {
+    return editing_ ? 500 : Widget::repaintIntervalMs(); // cursor blink
+  }
 
   // Semantic Debug API
   std::string getName() const override { return "TimePanel"; }
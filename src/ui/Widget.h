@@ -60,6 +60,12 @@ public:
   virtual void renderModal(SDL_Renderer *renderer) { (void)renderer; }
   virtual void setMetric(bool metric) { useMetric_ = metric; }
 
+  // With the software presenter a widget is repainted only when input
+  // arrives or its wall-clock period rolls over (periods are aligned, so
+  // 1000 means "on every new second"). Widgets that blink or animate
+  // faster override this.
+  virtual Uint32 repaintIntervalMs() const { return 1000; }
+
   // Semantic Debug API
   virtual std::string getName() const { return "Widget"; }
   virtual std::vector<std::string> getActions() const { return {}; }
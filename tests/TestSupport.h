@@ -0,0 +1,47 @@
+#pragma once
+
+// Minimal helpers shared by the tests and benchmarks: CHECK records a failure
+// and keeps going, test::exitCode() turns the tally into main()'s result.
+
+#include <chrono>
+#include <cstdio>
+
+namespace test {
+
+inline int &failures() {
+  static int count = 0;
+  return count;
+}
+
+inline int exitCode() {
+  if (failures() == 0) {
+    std::printf("OK\n");
+    return 0;
+  }
+  std::printf("%d check(s) failed\n", failures());
+  return 1;
+}
+
+// Wall-clock milliseconds since construction.
+class Stopwatch {
+public:
+  Stopwatch() : start_(std::chrono::steady_clock::now()) {}
+  double ms() const {
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start_)
+        .count();
+  }
+
+private:
+  std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace test
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      std::printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond);     \
+      ++::test::failures();                                                    \
+    }                                                                          \
+  } while (0)
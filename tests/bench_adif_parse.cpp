@@ -0,0 +1,124 @@
+// Parse a 200k-QSO ADIF log: the mmap + single-pass tokenizer against the
+// per-tag search ADIFProvider used before (upper-case a copy of the record,
+// find "<TAG:", once for each of the fields it reads).
+
+#include "TestSupport.h"
+#include "core/ADIFTokenizer.h"
+#include "core/MappedFile.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace {
+
+constexpr int kQsos = 200000;
+
+const char *const kLegacyTags[] = {
+    "CALL",     "MODE",       "SUBMODE",   "BAND",      "FREQ",
+    "QSO_DATE", "TIME_ON",    "RST_SENT",  "RST_RCVD",  "NAME",
+    "QTH",      "GRIDSQUARE", "COUNTRY",   "CQZ",       "ITUZ",
+    "DXCC",     "CONTEST_ID", "SAT_NAME",  "SAT_MODE",  "PROP_MODE",
+    "TX_PWR",   "OPERATOR",   "STATION_CALLSIGN", "MY_GRIDSQUARE",
+    "COMMENT",  "LAT",        "LON"};
+
+std::filesystem::path writeLog() {
+  auto path = std::filesystem::temp_directory_path() / "hamclock_bench.adi";
+  std::ofstream f(path, std::ios::binary);
+  f << "Benchmark log\n<ADIF_VER:5>3.1.4 <PROGRAMID:5>bench <EOH>\n";
+  static const char *const bands[] = {"160m", "80m", "40m", "20m", "15m"};
+  static const char *const modes[] = {"FT8", "CW", "SSB", "RTTY"};
+  char buf[512];
+  for (int i = 0; i < kQsos; ++i) {
+    const char *band = bands[i % 5];
+    const char *mode = modes[i % 4];
+    int n = std::snprintf(
+        buf, sizeof(buf),
+        "<CALL:6>K%c%04d <QSO_DATE:8:D>2024%02d%02d <TIME_ON:6>%02d%02d00 "
+        "<BAND:%zu>%s <MODE:%zu>%s <FREQ:9:N>14.074000 <RST_SENT:3>-10 "
+        "<RST_RCVD:3>-12 <GRIDSQUARE:4>FN%02d <DXCC:3>291 <CQZ:1>5 "
+        "<STATION_CALLSIGN:5>N0CAL <MY_GRIDSQUARE:6>JO22xx "
+        "<COMMENT:19>tnx fer QSO 73 <gl> <EOR>\n",
+        'A' + i % 26, i % 10000, 1 + i % 12, 1 + i % 28, i % 24, i % 60,
+        std::char_traits<char>::length(band), band,
+        std::char_traits<char>::length(mode), mode, i % 100);
+    f.write(buf, n);
+  }
+  return path;
+}
+
+std::string legacyTag(const std::string &record, const std::string &tag) {
+  std::string upper = record;
+  std::transform(upper.begin(), upper.end(), upper.begin(),
+                 [](unsigned char c) { return std::toupper(c); });
+  size_t pos = upper.find("<" + tag + ":");
+  if (pos == std::string::npos)
+    return "";
+  size_t colon = pos + tag.size() + 1;
+  size_t close = record.find('>', colon);
+  if (close == std::string::npos)
+    return "";
+  size_t len = std::strtoul(record.c_str() + colon + 1, nullptr, 10);
+  return record.substr(close + 1, len);
+}
+
+} // namespace
+
+int main() {
+  const auto path = writeLog();
+  const auto bytes = std::filesystem::file_size(path);
+
+  size_t tokenized = 0;
+  size_t callBytes = 0;
+  test::Stopwatch fast;
+  {
+    MappedFile file(path);
+    CHECK(file.isOpen());
+    ADIFTokenizer tokenizer(file.data());
+    ADIFRecord rec;
+    while (tokenizer.next(rec)) {
+      if (!rec[ADIFTag::Call].empty())
+        ++tokenized;
+      callBytes += rec[ADIFTag::Call].size() + rec[ADIFTag::Band].size();
+    }
+  }
+  double fastMs = fast.ms();
+
+  size_t legacy = 0;
+  test::Stopwatch slow;
+  {
+    std::ifstream f(path, std::ios::binary);
+    std::string line, record;
+    while (std::getline(f, line)) {
+      record += line;
+      if (record.find("<EOR>") == std::string::npos)
+        continue;
+      std::string call;
+      for (const char *tag : kLegacyTags) {
+        std::string v = legacyTag(record, tag);
+        if (tag == kLegacyTags[0])
+          call = std::move(v);
+      }
+      if (!call.empty())
+        ++legacy;
+      record.clear();
+    }
+  }
+  double slowMs = slow.ms();
+
+  std::printf("%d QSOs, %.1f MB\n", kQsos, bytes / 1024.0 / 1024.0);
+  std::printf("tokenizer:     %8.1f ms (%.0f MB/s)\n", fastMs,
+              bytes / 1024.0 / 1024.0 / (fastMs / 1000.0));
+  std::printf("per-tag find:  %8.1f ms\n", slowMs);
+  std::printf("speed-up:      %8.1fx\n", slowMs / fastMs);
+
+  CHECK(tokenized == kQsos);
+  CHECK(legacy == kQsos);
+  CHECK(callBytes > 0);
+  std::filesystem::remove(path);
+  return test::exitCode();
+}
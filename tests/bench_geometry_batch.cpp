@@ -0,0 +1,169 @@
+// 1,000 spot markers (black outline + coloured dot) per frame through an
+// offscreen software renderer: one SDL_RenderGeometry call per circle with
+// freshly allocated vertex/index vectors, as RenderUtils::drawCircle used
+// to do, against one GeometryBatch for the whole frame.
+
+#define SDL_MAIN_HANDLED
+#include "TestSupport.h"
+#include "ui/RenderUtils.h"
+
+#include <SDL.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace {
+
+std::atomic<uint64_t> g_allocs{0};
+
+constexpr int kMarkers = 1000;
+constexpr int kFrames = 50;
+constexpr int kWidth = 800;
+constexpr int kHeight = 480;
+
+// The pre-batch drawCircle: two vectors and a cos/sin per segment.
+uint64_t g_legacyCalls = 0;
+void legacyCircle(SDL_Renderer *renderer, float x, float y, float radius,
+                  SDL_Color color) {
+  int segments =
+      std::clamp(static_cast<int>(3.14159f * radius * 1.5f), 16, 64);
+  std::vector<SDL_Vertex> verts;
+  verts.reserve(segments + 2);
+  verts.push_back({{x, y}, color, {0, 0}});
+  for (int i = 0; i <= segments; ++i) {
+    float theta = 2.0f * 3.1415926535f * static_cast<float>(i) /
+                  static_cast<float>(segments);
+    verts.push_back({{x + radius * std::cos(theta),
+                      y + radius * std::sin(theta)},
+                     color,
+                     {0, 0}});
+  }
+  std::vector<int> indices;
+  indices.reserve(segments * 3);
+  for (int i = 1; i <= segments; ++i) {
+    indices.push_back(0);
+    indices.push_back(i);
+    indices.push_back(i + 1);
+  }
+  SDL_RenderGeometry(renderer, nullptr, verts.data(),
+                     static_cast<int>(verts.size()), indices.data(),
+                     static_cast<int>(indices.size()));
+  ++g_legacyCalls;
+}
+
+struct Marker {
+  float x, y;
+  SDL_Color color;
+};
+
+struct Result {
+  double msPerFrame;
+  double callsPerFrame;
+  double allocsPerFrame;
+};
+
+template <typename DrawFrame>
+Result measure(SDL_Renderer *renderer, DrawFrame &&drawFrame,
+               uint64_t &calls) {
+  drawFrame(); // warm-up: first-use tables and arena growth
+  uint64_t calls0 = calls;
+  uint64_t allocs0 = g_allocs.load();
+  test::Stopwatch sw;
+  for (int f = 0; f < kFrames; ++f) {
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+    drawFrame();
+  }
+  return {sw.ms() / kFrames, double(calls - calls0) / kFrames,
+          double(g_allocs.load() - allocs0) / kFrames};
+}
+
+} // namespace
+
+void *operator new(std::size_t size) {
+  g_allocs.fetch_add(1, std::memory_order_relaxed);
+  if (void *p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+int main() {
+  SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(
+      0, kWidth, kHeight, 32, SDL_PIXELFORMAT_RGBA32);
+  SDL_Renderer *renderer =
+      surface ? SDL_CreateSoftwareRenderer(surface) : nullptr;
+  if (!renderer) {
+    std::printf("software renderer unavailable: %s\n", SDL_GetError());
+    return 1;
+  }
+  SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+
+  std::vector<Marker> markers;
+  std::srand(1);
+  for (int i = 0; i < kMarkers; ++i) {
+    float x = float(std::rand() % kWidth);
+    float y = float(std::rand() % kHeight);
+    Uint8 r = Uint8(std::rand()), g = Uint8(std::rand());
+    markers.push_back({x, y, {r, g, 255, 255}});
+  }
+  const float radius = 4.0f;
+  const SDL_Color black = {0, 0, 0, 255};
+
+  Result legacy = measure(
+      renderer,
+      [&] {
+        for (const auto &m : markers) {
+          legacyCircle(renderer, m.x, m.y, radius + 1.0f, black);
+          legacyCircle(renderer, m.x, m.y, radius, m.color);
+        }
+      },
+      g_legacyCalls);
+
+  RenderUtils::GeometryBatch batch;
+  uint64_t batchCalls = 0;
+  Result batched = measure(
+      renderer,
+      [&] {
+        batch.begin(renderer);
+        for (const auto &m : markers) {
+          batch.circle(m.x, m.y, radius + 1.0f, black);
+          batch.circle(m.x, m.y, radius, m.color);
+        }
+        batch.flush();
+        batchCalls = batch.drawCalls();
+      },
+      batchCalls);
+
+  std::printf("%d markers, %dx%d software renderer, %d frames\n", kMarkers,
+              kWidth, kHeight, kFrames);
+  std::printf("               ms/frame  draw calls  allocations\n");
+  std::printf("per-call     %10.2f  %10.0f  %11.0f\n", legacy.msPerFrame,
+              legacy.callsPerFrame, legacy.allocsPerFrame);
+  std::printf("batched      %10.2f  %10.0f  %11.0f\n", batched.msPerFrame,
+              batched.callsPerFrame, batched.allocsPerFrame);
+
+  // The last frame drew the batched markers: the final one is on top.
+  SDL_RenderFlush(renderer);
+  Uint32 px = static_cast<Uint32 *>(
+      surface->pixels)[int(markers.back().y) * (surface->pitch / 4) +
+                       int(markers.back().x)];
+  Uint8 r, g, b;
+  SDL_GetRGB(px, surface->format, &r, &g, &b);
+  CHECK(r == markers.back().color.r && g == markers.back().color.g);
+
+  CHECK(legacy.callsPerFrame == 2 * kMarkers);
+  CHECK(batched.callsPerFrame == 1);
+  CHECK(batched.allocsPerFrame == 0);
+  CHECK(legacy.allocsPerFrame >= 4 * kMarkers);
+
+  SDL_DestroyRenderer(renderer);
+  SDL_FreeSurface(surface);
+  return test::exitCode();
+}
@@ -0,0 +1,110 @@
+// Catalog-wide pass prediction for ~150 satellites over the 24 h window:
+// the cold first refresh, then the hourly incremental one that only scans
+// the new tail of the window.
+
+#include "TestSupport.h"
+#include "core/SatPassEngine.h"
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+// 2024-10-18 12:00:00 UTC, the epoch of every synthetic element set.
+constexpr std::time_t kEpoch = 1729252800;
+
+char checksum(const std::string &line) {
+  int sum = 0;
+  for (char c : line) {
+    if (c >= '0' && c <= '9')
+      sum += c - '0';
+    else if (c == '-')
+      sum += 1;
+  }
+  return static_cast<char>('0' + sum % 10);
+}
+
+SatelliteTLE makeTle(int norad, double incl, double raan, double ecc,
+                     double argp, double ma, double revsPerDay) {
+  char l1[80], l2[80];
+  std::snprintf(l1, sizeof(l1),
+                "1 %05dU 24001A   24292.50000000  .00001000  00000-0  "
+                "10000-3 0  999",
+                norad);
+  std::snprintf(l2, sizeof(l2), "2 %05d %8.4f %8.4f %07d %8.4f %8.4f %11.8f%05d",
+                norad, incl, raan, static_cast<int>(ecc * 1e7), argp, ma,
+                revsPerDay, 1000);
+  SatelliteTLE tle;
+  tle.name = "SAT-" + std::to_string(norad);
+  tle.noradId = norad;
+  tle.line1 = l1;
+  tle.line1 += checksum(tle.line1);
+  tle.line2 = l2;
+  tle.line2 += checksum(tle.line2);
+  return tle;
+}
+
+// A spread resembling the amateur + weather catalog: mostly LEO, a few
+// MEO, and geosynchronous birds that are never scanned.
+std::vector<SatelliteTLE> makeCatalog() {
+  std::vector<SatelliteTLE> tles;
+  int norad = 90000;
+  for (int i = 0; i < 126; ++i) {
+    double incl = 45.0 + (i % 7) * 8.0;
+    double revs = 14.2 + (i % 13) * 0.12;
+    tles.push_back(makeTle(norad++, incl, (i * 37) % 360, 0.0012, 90.0,
+                           (i * 53) % 360, revs));
+  }
+  for (int i = 0; i < 16; ++i)
+    tles.push_back(makeTle(norad++, 55.0, i * 22.5, 0.01, 0.0, i * 45.0,
+                           2.0056));
+  for (int i = 0; i < 8; ++i)
+    tles.push_back(makeTle(norad++, 0.05, 0.0, 0.0002, 0.0, i * 45.0,
+                           1.0027));
+  return tles;
+}
+
+} // namespace
+
+int main() {
+  const std::vector<SatelliteTLE> tles = makeCatalog();
+
+  SatPassEngine engine;
+  engine.setObserver(52.0, 4.4, 10.0);
+  engine.setCatalog(tles);
+
+  test::Stopwatch cold;
+  engine.refresh(kEpoch);
+  double coldMs = cold.ms();
+  std::vector<UpcomingPass> passes =
+      engine.nextPasses(100000, 0.0, kEpoch);
+
+  test::Stopwatch warm;
+  engine.refresh(kEpoch + 3600);
+  double warmMs = warm.ms();
+  std::vector<UpcomingPass> later =
+      engine.nextPasses(100000, 0.0, kEpoch + 3600);
+
+  std::printf("%zu satellites, %d h window\n", tles.size(),
+              SatPassEngine::kWindowHours);
+  std::printf("cold refresh:        %8.1f ms, %zu passes\n", coldMs,
+              passes.size());
+  std::printf("incremental refresh: %8.1f ms, %zu passes\n", warmMs,
+              later.size());
+
+  // A mid-latitude observer sees each LEO bird several times a day.
+  CHECK(passes.size() > 300);
+  for (size_t i = 0; i < passes.size(); ++i) {
+    const SatPass &p = passes[i].pass;
+    CHECK(p.aosTime < p.losTime);
+    CHECK(p.maxEl > 0.0 && p.maxEl <= 90.0);
+    if (i > 0)
+      CHECK(passes[i - 1].pass.aosTime <= p.aosTime);
+  }
+  // Extending the window by an hour rescans one hour, not 24.
+  CHECK(warmMs < coldMs);
+  CHECK(!later.empty() && later.back().pass.aosTime > passes.back().pass.aosTime);
+  return test::exitCode();
+}
@@ -0,0 +1,209 @@
+// Per-frame CPU cost of the software renderer on a headless window
+// (SDL_VIDEODRIVER=dummy) with a dashboard-like set of widgets: a clock
+// whose pixels change every second, static data panels and a scaled map
+// texture with spot markers. Compares the plain clear/draw/present loop,
+// SoftwarePresenter repainting everything, and SoftwarePresenter with damage
+// tracking. The presenter sleeps to hold ~30 fps, so cost is process CPU
+// time, not wall time.
+
+#define SDL_MAIN_HANDLED
+#include "TestSupport.h"
+#include "ui/SoftwarePresenter.h"
+#include "ui/Widget.h"
+
+#include <SDL.h>
+
+#include <cstdio>
+#include <ctime>
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr int kWidth = 800;
+constexpr int kHeight = 480;
+constexpr int kFrames = 90; // ~3 s at the presenter's frame cap
+
+uint64_t g_renders = 0;
+
+// A data panel: background, title bar and rows of "text" copied from a
+// glyph strip, as the real panels do with cached text textures. A ticking
+// panel (the clock) changes its text every second.
+class FakePanel : public Widget {
+public:
+  FakePanel(int x, int y, int w, int h, SDL_Texture *glyphs, bool ticking)
+      : Widget(x, y, w, h), glyphs_(glyphs), ticking_(ticking) {}
+
+  void update() override {}
+
+  void render(SDL_Renderer *renderer) override {
+    ++g_renders;
+    SDL_Rect r = getRect();
+    SDL_SetRenderDrawColor(renderer, 16, 24, 48, 255);
+    SDL_RenderFillRect(renderer, &r);
+    SDL_Rect title = {r.x, r.y, r.w, 14};
+    SDL_SetRenderDrawColor(renderer, 40, 80, 160, 255);
+    SDL_RenderFillRect(renderer, &title);
+
+    unsigned seed = ticking_ ? static_cast<unsigned>(std::time(nullptr)) : 7u;
+    for (int y = r.y + 18; y + 8 <= r.y + r.h; y += 10) {
+      for (int x = r.x + 4; x + 6 <= r.x + r.w; x += 6) {
+        seed = seed * 1103515245u + 12345u;
+        SDL_Rect src = {static_cast<int>((seed >> 16) % 10) * 6, 0, 6, 8};
+        SDL_Rect dst = {x, y, 6, 8};
+        SDL_RenderCopy(renderer, glyphs_, &src, &dst);
+      }
+    }
+  }
+
+private:
+  SDL_Texture *glyphs_;
+  bool ticking_;
+};
+
+// The map: a large texture scaled into the rect plus spot markers.
+class FakeMap : public Widget {
+public:
+  FakeMap(int x, int y, int w, int h, SDL_Texture *map)
+      : Widget(x, y, w, h), map_(map) {}
+
+  void update() override {}
+
+  void render(SDL_Renderer *renderer) override {
+    ++g_renders;
+    SDL_Rect r = getRect();
+    SDL_RenderCopy(renderer, map_, nullptr, &r);
+    SDL_SetRenderDrawColor(renderer, 255, 200, 0, 255);
+    for (int i = 0; i < 300; ++i) {
+      SDL_Rect spot = {r.x + (i * 97) % (r.w - 4), r.y + (i * 53) % (r.h - 4),
+                       4, 4};
+      SDL_RenderFillRect(renderer, &spot);
+    }
+  }
+
+private:
+  SDL_Texture *map_;
+};
+
+SDL_Texture *makeTexture(SDL_Renderer *renderer, int w, int h) {
+  SDL_Surface *s =
+      SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_RGBA32);
+  if (!s)
+    return nullptr;
+  auto *px = static_cast<Uint32 *>(s->pixels);
+  for (int y = 0; y < h; ++y)
+    for (int x = 0; x < w; ++x)
+      px[y * (s->pitch / 4) + x] =
+          SDL_MapRGBA(s->format, Uint8(x * 7), Uint8(y * 5), Uint8(x ^ y),
+                      ((x + y) % 3) ? 255 : 0);
+  SDL_Texture *t = SDL_CreateTextureFromSurface(renderer, s);
+  SDL_FreeSurface(s);
+  return t;
+}
+
+struct Result {
+  double cpuMsPerFrame;
+  double rendersPerFrame;
+};
+
+template <typename Frame> Result measure(Frame &&frame) {
+  frame(); // warm-up: first-use conversions and the initial full frame
+  uint64_t renders0 = g_renders;
+  std::clock_t cpu0 = std::clock();
+  for (int f = 0; f < kFrames; ++f) {
+    SDL_PumpEvents();
+    frame();
+  }
+  double cpuMs = 1000.0 * double(std::clock() - cpu0) / CLOCKS_PER_SEC;
+  return {cpuMs / kFrames, double(g_renders - renders0) / kFrames};
+}
+
+} // namespace
+
+int main() {
+  SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+  if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+    std::printf("SDL_Init failed: %s\n", SDL_GetError());
+    return 1;
+  }
+  SDL_Window *window =
+      SDL_CreateWindow("bench", SDL_WINDOWPOS_UNDEFINED,
+                       SDL_WINDOWPOS_UNDEFINED, kWidth, kHeight, 0);
+  SDL_Renderer *renderer =
+      window ? SDL_CreateRenderer(window, -1, SDL_RENDERER_SOFTWARE) : nullptr;
+  if (!renderer) {
+    std::printf("software renderer unavailable: %s\n", SDL_GetError());
+    return 1;
+  }
+  CHECK(SoftwarePresenter::supported(renderer));
+  SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+
+  SDL_Texture *glyphs = makeTexture(renderer, 60, 8);
+  SDL_Texture *map = makeTexture(renderer, 1024, 512);
+  CHECK(glyphs && map);
+
+  std::vector<std::unique_ptr<Widget>> owned;
+  for (int i = 0; i < 4; ++i)
+    owned.push_back(
+        std::make_unique<FakePanel>(i * 200, 0, 200, 150, glyphs, i == 0));
+  owned.push_back(std::make_unique<FakeMap>(0, 150, 800, 330, map));
+  std::vector<Widget *> widgets;
+  for (auto &w : owned)
+    widgets.push_back(w.get());
+
+  auto drawAll = [&](SoftwarePresenter *presenter) {
+    for (size_t i = 0; i < widgets.size(); ++i) {
+      if (presenter && !presenter->needsRepaint(i))
+        continue;
+      SDL_Rect clip = widgets[i]->getRect();
+      SDL_RenderSetClipRect(renderer, &clip);
+      widgets[i]->render(renderer);
+    }
+    SDL_RenderSetClipRect(renderer, nullptr);
+  };
+
+  Result plain = measure([&] {
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+    drawAll(nullptr);
+    SDL_RenderPresent(renderer);
+  });
+
+  SoftwarePresenter fullPresenter(window, renderer, false);
+  Result full = measure([&] {
+    fullPresenter.beginFrame(widgets);
+    drawAll(&fullPresenter);
+    fullPresenter.present();
+  });
+
+  SoftwarePresenter damagePresenter(window, renderer, true);
+  Result damage = measure([&] {
+    damagePresenter.beginFrame(widgets);
+    drawAll(&damagePresenter);
+    damagePresenter.present();
+  });
+
+  std::printf("%zu widgets, %dx%d dummy window, %d frames\n", widgets.size(),
+              kWidth, kHeight, kFrames);
+  std::printf("                   CPU ms/frame  widget repaints/frame\n");
+  std::printf("clear+present      %12.2f  %21.2f\n", plain.cpuMsPerFrame,
+              plain.rendersPerFrame);
+  std::printf("presenter, full    %12.2f  %21.2f\n", full.cpuMsPerFrame,
+              full.rendersPerFrame);
+  std::printf("presenter, damage  %12.2f  %21.2f\n", damage.cpuMsPerFrame,
+              damage.rendersPerFrame);
+  std::printf("damage tracking saves %.0f%% of the full-redraw CPU time\n",
+              100.0 * (1.0 - damage.cpuMsPerFrame / full.cpuMsPerFrame));
+
+  CHECK(full.rendersPerFrame == double(widgets.size()));
+  // Everything repaints once a second, i.e. about once in 30 frames.
+  CHECK(damage.rendersPerFrame < widgets.size() / 5.0);
+  CHECK(damage.cpuMsPerFrame < full.cpuMsPerFrame);
+
+  SDL_DestroyTexture(map);
+  SDL_DestroyTexture(glyphs);
+  SDL_DestroyRenderer(renderer);
+  SDL_DestroyWindow(window);
+  SDL_Quit();
+  return test::exitCode();
+}
@@ -0,0 +1,211 @@
+// ADIF 3 correctness corpus for ADIFTokenizer: headers, case, type
+// indicators, values that look like markup, the non-standard <TAG>value
+// form, resuming from consumed(), and malformed input.
+
+#include "TestSupport.h"
+#include "core/ADIFTokenizer.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+std::vector<ADIFRecord> records(std::string_view data, size_t offset = 0) {
+  std::vector<ADIFRecord> out;
+  ADIFTokenizer t(data, offset);
+  ADIFRecord r;
+  while (t.next(r))
+    out.push_back(r);
+  return out;
+}
+
+void testTagLookup() {
+  CHECK(adifTagFromName("CALL") == ADIFTag::Call);
+  CHECK(adifTagFromName("call") == ADIFTag::Call);
+  CHECK(adifTagFromName("Station_Callsign") == ADIFTag::StationCallsign);
+  CHECK(adifTagFromName("eor") == ADIFTag::Eor);
+  CHECK(adifTagFromName("CALLX") == ADIFTag::Unknown);
+  CHECK(adifTagFromName("CAL") == ADIFTag::Unknown);
+  CHECK(adifTagFromName("") == ADIFTag::Unknown);
+  CHECK(adifTagFromName("APP_LOTW_RXQSL") == ADIFTag::Unknown);
+}
+
+void testHeader() {
+  // Free text (with a stray '<') before the first tag, user-defined field
+  // declarations and mixed-case EOH.
+  std::string data = "Exported by TestLog 1.0 for K1ABC, 5 < 6\r\n"
+                     "<ADIF_VER:5>3.1.4 <PROGRAMID:7>TestLog\r\n"
+                     "<USERDEF1:3:N>EPC\r\n"
+                     "<Eoh>\r\n"
+                     "<CALL:5>K1ABC<EOR>\r\n";
+  ADIFTokenizer t(data);
+  ADIFRecord r;
+  CHECK(t.next(r));
+  CHECK(t.header()[ADIFTag::AdifVer] == "3.1.4");
+  CHECK(t.header()[ADIFTag::Call].empty());
+  CHECK(r[ADIFTag::Call] == "K1ABC");
+  CHECK(r[ADIFTag::AdifVer].empty());
+  CHECK(!t.next(r));
+}
+
+void testNoHeader() {
+  std::string data = "<CALL:4>W1AW<BAND:3>40m<EOR>";
+  ADIFTokenizer t(data);
+  ADIFRecord r;
+  CHECK(t.next(r));
+  CHECK(t.header().empty());
+  CHECK(r[ADIFTag::Call] == "W1AW");
+  CHECK(r[ADIFTag::Band] == "40m");
+}
+
+void testCaseAndTypes() {
+  std::string data = "<call:5>K1ABC <Mode:3:S>FT8 <QSO_DATE:8:D>20240101 "
+                     "<time_on:6:T>123456 <FREQ:9:N>14.074000 "
+                     "<Lat:11:L>N042 18.250 <eor>"
+                     "<CALL:4>DL1X<MODE:2>CW<eOr>";
+  auto recs = records(data);
+  CHECK(recs.size() == 2);
+  if (recs.size() != 2)
+    return;
+  CHECK(recs[0][ADIFTag::Call] == "K1ABC");
+  CHECK(recs[0][ADIFTag::Mode] == "FT8");
+  CHECK(recs[0][ADIFTag::QsoDate] == "20240101");
+  CHECK(recs[0][ADIFTag::TimeOn] == "123456");
+  CHECK(recs[0][ADIFTag::Freq] == "14.074000");
+  CHECK(recs[0][ADIFTag::Lat] == "N042 18.250");
+  CHECK(recs[1][ADIFTag::Call] == "DL1X");
+  CHECK(recs[1][ADIFTag::Mode] == "CW");
+  // Fields never leak from one record into the next.
+  CHECK(recs[1][ADIFTag::Freq].empty());
+}
+
+void testValuesThatLookLikeMarkup() {
+  // The length is authoritative: the value may contain '<', '>', tag-like
+  // text and line breaks.
+  std::string data = "<CALL:4>N0CL<COMMENT:9>a<b>c<eor<NOTES:13:M>line 1\r\n"
+                     "line2<EOR>";
+  auto recs = records(data);
+  CHECK(recs.size() == 1);
+  if (recs.empty())
+    return;
+  CHECK(recs[0][ADIFTag::Comment] == "a<b>c<eor");
+  CHECK(recs[0][ADIFTag::Notes] == "line 1\r\nline2");
+}
+
+void testUnknownFieldsSkippedByLength() {
+  // An application-defined field whose value reads like a CALL tag.
+  std::string data =
+      "<APP_TEST_X:10><CALL:3>XY<CALL:4>K1AB<MY_RIG:7>IC-7300<EOR>";
+  auto recs = records(data);
+  CHECK(recs.size() == 1);
+  if (!recs.empty())
+    CHECK(recs[0][ADIFTag::Call] == "K1AB");
+}
+
+void testZeroLengthAndWhitespace() {
+  std::string data = "\r\n  <QTH:0>  <CALL:4>W1AW\r\n\t<NAME:0><EOR>\r\n\r\n";
+  auto recs = records(data);
+  CHECK(recs.size() == 1);
+  if (recs.empty())
+    return;
+  CHECK(recs[0][ADIFTag::Call] == "W1AW");
+  CHECK(recs[0][ADIFTag::Qth].empty());
+  CHECK(recs[0][ADIFTag::Name].empty());
+}
+
+void testNonStandardTagValue() {
+  // <TAG>value without a length: the value runs to the next tag, trailing
+  // whitespace trimmed.
+  std::string data = "<CALL:4>W1AW <NAME>Hiram Percy \r\n<QTH>Newington<EOR>";
+  auto recs = records(data);
+  CHECK(recs.size() == 1);
+  if (recs.empty())
+    return;
+  CHECK(recs[0][ADIFTag::Name] == "Hiram Percy");
+  CHECK(recs[0][ADIFTag::Qth] == "Newington");
+}
+
+void testTrailingAndResume() {
+  std::string data = "<ADIF_VER:5>3.1.4<EOH>\n"
+                     "<CALL:5>K1ABC<EOR>\n"
+                     "<CALL:5>K2ABC<EOR>\n"
+                     "<CALL:5>K3ABC<MODE:2>C";
+  ADIFTokenizer t(data);
+  ADIFRecord r;
+  CHECK(t.next(r));
+  size_t afterFirst = t.consumed();
+  CHECK(data.compare(afterFirst - 5, 5, "<EOR>") == 0);
+  CHECK(t.next(r) && r[ADIFTag::Call] == "K2ABC");
+  size_t afterSecond = t.consumed();
+  CHECK(!t.next(r));
+  // The unterminated record is not returned and not consumed.
+  CHECK(t.trailing()[ADIFTag::Call] == "K3ABC");
+  CHECK(t.trailing()[ADIFTag::Mode] == "C");
+  CHECK(t.consumed() == afterSecond);
+
+  // Resuming mid-file (as tail-follow does) picks up the next record.
+  auto rest = records(data, afterFirst);
+  CHECK(rest.size() == 1);
+  if (!rest.empty())
+    CHECK(rest[0][ADIFTag::Call] == "K2ABC");
+}
+
+void testMalformedLengths() {
+  // Digits that overflow size_t must neither wrap nor crash: the field is
+  // clamped to the end of input.
+  {
+    std::string data = "<CALL:4>W1AW<EOR><COMMENT:99999999999999999999999999"
+                       "999999>rest of file<CALL:4>K1AB<EOR>";
+    ADIFTokenizer t(data);
+    ADIFRecord r;
+    CHECK(t.next(r) && r[ADIFTag::Call] == "W1AW");
+    CHECK(!t.next(r));
+    CHECK(t.trailing()[ADIFTag::Comment] == "rest of file<CALL:4>K1AB<EOR>");
+  }
+  // A length running past the end is clamped.
+  {
+    std::string data = "<CALL:40>K1AB";
+    ADIFTokenizer t(data);
+    ADIFRecord r;
+    CHECK(!t.next(r));
+    CHECK(t.trailing()[ADIFTag::Call] == "K1AB");
+  }
+  // Non-numeric lengths are ignored and parsing resynchronises on the next
+  // tag.
+  {
+    std::string data = "<CALL:4x>W1AW<CALL:>N0CL<BAND:3>20m<EOR>";
+    auto recs = records(data);
+    CHECK(recs.size() == 1);
+    if (!recs.empty()) {
+      CHECK(recs[0][ADIFTag::Call].empty());
+      CHECK(recs[0][ADIFTag::Band] == "20m");
+    }
+  }
+  // Unclosed tag at end of input.
+  {
+    std::string data = "<CALL:4>W1AW<EOR><CALL:4";
+    auto recs = records(data);
+    CHECK(recs.size() == 1);
+  }
+  // Empty input and a lone '<'.
+  CHECK(records("").empty());
+  CHECK(records("<").empty());
+  CHECK(records("<>").empty());
+}
+
+} // namespace
+
+int main() {
+  testTagLookup();
+  testHeader();
+  testNoHeader();
+  testCaseAndTypes();
+  testValuesThatLookLikeMarkup();
+  testUnknownFieldsSkippedByLength();
+  testZeroLengthAndWhitespace();
+  testNonStandardTagValue();
+  testTrailingAndResume();
+  testMalformedLengths();
+  return test::exitCode();
+}
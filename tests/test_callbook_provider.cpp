@@ -0,0 +1,168 @@
+// CallbookProvider against a local stub of Callook and HamDB that answers
+// after a fixed delay and counts requests, including how many are open at
+// once: both sources are queried concurrently, answers and "not found" are
+// served from CallbookCache afterwards, and lookups of a call that is
+// already in flight do not fetch again.
+
+#include "TestSupport.h"
+#include "core/CallbookCache.h"
+#include "core/CallbookData.h"
+#include "core/DatabaseManager.h"
+#include "network/NetworkManager.h"
+#include "services/CallbookProvider.h"
+
+#include <httplib.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace {
+
+constexpr int kDelayMs = 300;
+
+std::atomic<int> g_requests{0};
+std::atomic<int> g_inFlight{0};
+std::atomic<int> g_peakInFlight{0};
+
+// Counts a request as open for the lifetime of a handler.
+struct InFlight {
+  InFlight() {
+    g_requests++;
+    int now = ++g_inFlight;
+    int peak = g_peakInFlight;
+    while (now > peak && !g_peakInFlight.compare_exchange_weak(peak, now)) {
+    }
+  }
+  ~InFlight() { g_inFlight--; }
+};
+
+bool known(const std::string &call) { return call != "N0PE"; }
+
+void serveCallook(const httplib::Request &req, httplib::Response &res) {
+  InFlight counted;
+  std::this_thread::sleep_for(std::chrono::milliseconds(kDelayMs));
+  std::string call = req.matches[1];
+  if (!known(call)) {
+    res.set_content(R"({"status":"INVALID"})", "application/json");
+    return;
+  }
+  res.set_content(R"({"status":"VALID","name":"HIRAM P MAXIM",)"
+                  R"("address":{"line1":"225 MAIN ST","line2":"NEWINGTON, CT"},)"
+                  R"("location":{"gridsquare":"FN31pr",)"
+                  R"("latitude":"41.714775","longitude":"-72.727260"}})",
+                  "application/json");
+}
+
+void serveHamDB(const httplib::Request &req, httplib::Response &res) {
+  InFlight counted;
+  std::this_thread::sleep_for(std::chrono::milliseconds(kDelayMs));
+  std::string call = req.matches[1];
+  if (!known(call)) {
+    res.set_content(R"({"hamdb":{"messages":{"status":"NOT_FOUND"}}})",
+                    "application/json");
+    return;
+  }
+  res.set_content(R"({"hamdb":{"messages":{"status":"OK"},"callsign":{)"
+                  R"("call":")" + call + R"(","fname":"Hiram","name":"Maxim",)"
+                  R"("state":"CT","zip":"06111","country":"United States",)"
+                  R"("grid":"FN31pr","lat":"41.71","lon":"-72.73"}}})",
+                  "application/json");
+}
+
+// Wait (up to 5 s) until the store shows the final answer for call.
+bool waitFor(const CallbookStore &store, const std::string &call,
+             const std::string &source) {
+  test::Stopwatch sw;
+  while (sw.ms() < 5000) {
+    CallbookData d = store.get();
+    if (d.callsign == call && d.source == source)
+      return true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return false;
+}
+
+} // namespace
+
+int main() {
+  auto dbPath = std::filesystem::temp_directory_path() /
+                "hamclock_test_callbook.db";
+  std::filesystem::remove(dbPath);
+  CHECK(DatabaseManager::instance().init(dbPath));
+
+  httplib::Server server;
+  server.Get(R"(/callook/([^/]+)/json)", serveCallook);
+  server.Get(R"(/hamdb/([^/]+)/json/hamclock-next)", serveHamDB);
+  int port = server.bind_to_any_port("127.0.0.1");
+  CHECK(port > 0);
+  std::thread serverThread([&] { server.listen_after_bind(); });
+
+  const std::string base = "http://127.0.0.1:" + std::to_string(port);
+  const std::string both = "Callook.info + HamDB.org";
+  NetworkManager net;
+  auto store = std::make_shared<CallbookStore>();
+  CallbookProvider provider(net, store);
+  provider.setEndpoints(base + "/callook/", base + "/hamdb/");
+
+  // Cold lookup: both sources in parallel, so both requests are open at
+  // the server at the same time.
+  test::Stopwatch cold;
+  provider.lookup("w1aw");
+  CHECK(waitFor(*store, "W1AW", both));
+  double coldMs = cold.ms();
+  int coldRequests = g_requests.load();
+  int coldPeak = g_peakInFlight.load();
+
+  CallbookData d = store->get();
+  CHECK(d.valid);
+  CHECK(d.name == "HIRAM P MAXIM"); // Callook wins over HamDB
+  CHECK(d.state == "CT");           // only HamDB has it
+  CHECK(d.grid == "FN31pr");
+
+  // Repeat lookup: answered from the cache without a request.
+  store->set(CallbookData{});
+  test::Stopwatch warm;
+  provider.lookup("W1AW ");
+  CHECK(waitFor(*store, "W1AW", both));
+  double warmMs = warm.ms();
+  int warmRequests = g_requests.load() - coldRequests;
+
+  // Lookups of a call already in flight join it.
+  int before = g_requests.load();
+  for (int i = 0; i < 5; ++i)
+    provider.lookup("K1ABC");
+  CHECK(waitFor(*store, "K1ABC", both));
+  int joinedRequests = g_requests.load() - before;
+
+  // "Not found" is cached too.
+  before = g_requests.load();
+  provider.lookup("N0PE");
+  CHECK(waitFor(*store, "N0PE", "Not found"));
+  store->set(CallbookData{});
+  provider.lookup("N0PE");
+  CHECK(waitFor(*store, "N0PE", "Not found"));
+  int negativeRequests = g_requests.load() - before;
+
+  std::printf("stub delay %d ms per request\n", kDelayMs);
+  std::printf("cold lookup:    %7.1f ms, %d requests, %d at once\n", coldMs,
+              coldRequests, coldPeak);
+  std::printf("cached lookup:  %7.1f ms, %d requests\n", warmMs, warmRequests);
+  std::printf("5x in flight:   %d requests\n", joinedRequests);
+  std::printf("not found x2:   %d requests\n", negativeRequests);
+
+  CHECK(coldRequests == 2);
+  CHECK(coldPeak == 2); // sequential sources would peak at 1
+  CHECK(warmRequests == 0);
+  CHECK(joinedRequests == 2);
+  CHECK(negativeRequests == 2);
+
+  server.stop();
+  serverThread.join();
+  std::filesystem::remove(dbPath);
+  return test::exitCode();
+}
@@ -0,0 +1,221 @@
+// HamlibClient against a fake rigctld on 127.0.0.1 that takes 15 ms per
+// command, like a radio's CAT port, and records when each command arrived
+// and was answered: poll rounds are pipelined, a tuning-knob flood of set()
+// calls collapses to a few F commands ending on the last value, polls keep
+// running through the flood, and sets made while disconnected are dropped.
+
+#include "TestSupport.h"
+#include "services/HamlibClient.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double msSince(Clock::time_point t0, Clock::time_point t) {
+  return std::chrono::duration<double, std::milli>(t - t0).count();
+}
+
+// Single-connection rigctld speaking the extended response protocol.
+class FakeRigctld {
+public:
+  struct Command {
+    std::string line;
+    Clock::time_point arrived;
+    Clock::time_point answered;
+  };
+
+  static constexpr auto kCommandTime = std::chrono::milliseconds(15);
+
+  FakeRigctld() {
+    listenFd_ = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t len = sizeof(addr);
+    if (bind(listenFd_, reinterpret_cast<sockaddr *>(&addr), len) == 0 &&
+        listen(listenFd_, 1) == 0 &&
+        getsockname(listenFd_, reinterpret_cast<sockaddr *>(&addr), &len) ==
+            0)
+      port_ = ntohs(addr.sin_port);
+    thread_ = std::thread(&FakeRigctld::serve, this);
+  }
+
+  ~FakeRigctld() {
+    shutdown(listenFd_, SHUT_RDWR);
+    close(listenFd_);
+    thread_.join();
+  }
+
+  int port() const { return port_; }
+  long freq() const { return freq_.load(); }
+
+  std::vector<Command> log() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return log_;
+  }
+
+private:
+  void serve() {
+    int fd = accept(listenFd_, nullptr, nullptr);
+    if (fd < 0)
+      return;
+    std::string buf;
+    char chunk[1024];
+    for (ssize_t n; (n = recv(fd, chunk, sizeof(chunk), 0)) > 0;) {
+      Clock::time_point arrived = Clock::now();
+      buf.append(chunk, static_cast<size_t>(n));
+      for (size_t nl; (nl = buf.find('\n')) != std::string::npos;) {
+        std::string line = buf.substr(0, nl);
+        buf.erase(0, nl + 1);
+        std::this_thread::sleep_for(kCommandTime);
+        std::string reply = answer(line) + "RPRT 0\n";
+        send(fd, reply.data(), reply.size(), MSG_NOSIGNAL);
+        std::lock_guard<std::mutex> lock(mutex_);
+        log_.push_back({line, arrived, Clock::now()});
+      }
+    }
+    close(fd);
+  }
+
+  std::string answer(const std::string &line) {
+    if (line == "+f")
+      return "get_freq:\nFrequency: " + std::to_string(freq_.load()) + "\n";
+    if (line == "+m")
+      return "get_mode:\nMode: USB\nPassband: 2400\n";
+    if (line == "+t")
+      return "get_ptt:\nPTT: 0\n";
+    if (line.rfind("+F ", 0) == 0) {
+      freq_ = std::stol(line.substr(3));
+      return "set_freq: " + line.substr(3) + "\n";
+    }
+    return "";
+  }
+
+  int listenFd_ = -1;
+  int port_ = 0;
+  std::thread thread_;
+  std::atomic<long> freq_{14074000};
+  mutable std::mutex mutex_;
+  std::vector<Command> log_;
+};
+
+template <typename Pred> bool waitUntil(Pred &&pred, int timeoutMs = 3000) {
+  test::Stopwatch sw;
+  while (sw.ms() < timeoutMs) {
+    if (pred())
+      return true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return false;
+}
+
+} // namespace
+
+int main() {
+  FakeRigctld rig;
+  CHECK(rig.port() > 0);
+
+  HamlibClient client("Rig", "127.0.0.1", rig.port());
+  std::atomic<int> freqReplies{0};
+  std::atomic<long> polledFreq{0};
+  std::atomic<int64_t> pollLatencyUs{0};
+  client.addPoll("f", [&](const HamlibClient::Reply &r) {
+    polledFreq = std::stol(r.value("Frequency"));
+    if (freqReplies++ == 0)
+      pollLatencyUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                          r.latency)
+                          .count();
+  });
+  client.addPoll("m", {});
+  client.addPoll("t", {});
+  client.setPollInterval(std::chrono::milliseconds(100));
+
+  // Not connected yet: dropped rather than sent late.
+  client.set("freq", "F 7000000");
+  Clock::time_point t0 = Clock::now();
+  client.start();
+  CHECK(waitUntil([&] { return freqReplies > 0; }));
+  CHECK(client.isConnected());
+  CHECK(polledFreq == 14074000);
+
+  // A poll round goes out as one burst: the daemon has all three commands
+  // before it has answered the first.
+  CHECK(waitUntil([&] { return rig.log().size() >= 3; }));
+  std::vector<FakeRigctld::Command> first = rig.log();
+  CHECK(first.size() >= 3);
+  if (first.size() >= 3) {
+    CHECK(first[0].line == "+f" && first[1].line == "+m" &&
+          first[2].line == "+t");
+    CHECK(first[2].arrived < first[0].answered);
+  }
+  // The first command of the round is answered after one command time.
+  CHECK(pollLatencyUs < 2 * 15000);
+
+  // Tuning-knob flood: 500 steps, 0.3 ms apart.
+  Clock::time_point floodStart = Clock::now();
+  long last = 0;
+  std::atomic<int> setReplies{0};
+  for (int i = 0; i < 500; ++i) {
+    last = 14000000 + i * 10;
+    client.set("freq", "F " + std::to_string(last),
+               [&](const HamlibClient::Reply &r) {
+                 if (r.ok())
+                   ++setReplies;
+               });
+    std::this_thread::sleep_for(std::chrono::microseconds(300));
+  }
+  Clock::time_point floodEnd = Clock::now();
+  CHECK(waitUntil([&] { return rig.freq() == last; }));
+  std::this_thread::sleep_for(std::chrono::milliseconds(250));
+  client.stop();
+
+  std::vector<FakeRigctld::Command> log = rig.log();
+  int sets = 0, pollsDuringFlood = 0;
+  std::string lastSet;
+  for (const auto &c : log) {
+    if (c.line.rfind("+F ", 0) == 0) {
+      ++sets;
+      lastSet = c.line;
+    } else if (c.arrived > floodStart && c.arrived < floodEnd) {
+      ++pollsDuringFlood;
+    }
+  }
+
+  std::printf("daemon: %lld ms per command\n",
+              static_cast<long long>(FakeRigctld::kCommandTime.count()));
+  std::printf("first poll round (ms from start: arrived -> answered)\n");
+  for (size_t i = 0; i < first.size() && i < 3; ++i)
+    std::printf("  %-4s %7.1f -> %7.1f\n", first[i].line.c_str(),
+                msSince(t0, first[i].arrived), msSince(t0, first[i].answered));
+  std::printf("first f reply latency: %.1f ms\n", pollLatencyUs / 1000.0);
+  std::printf("knob flood: 500 set() over %.0f ms -> %d F commands, "
+              "%d polls in between, last %s\n",
+              msSince(floodStart, floodEnd), sets, pollsDuringFlood,
+              lastSet.c_str());
+
+  CHECK(lastSet == "+F " + std::to_string(last));
+  CHECK(sets == setReplies);
+  // One F per daemon round trip at most (plus slack for scheduling).
+  CHECK(sets <= 1 + static_cast<int>(msSince(floodStart, floodEnd) / 15) + 2);
+  CHECK(sets >= 2);
+  CHECK(pollsDuringFlood > 0);
+  // The set made before connecting never reached the daemon.
+  for (const auto &c : log)
+    CHECK(c.line != "+F 7000000");
+  return test::exitCode();
+}